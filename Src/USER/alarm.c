@@ -0,0 +1,119 @@
+#include "alarm.h"
+
+#define ALARM_DAY_MINUTES 1440
+#define ALARM_WEEK_MINUTES 10080
+#define ALARM_NONE 0xFFFF
+
+/*
+ * 钟声使用DS3231的闹钟1，每次只设置最近的一个：星期、时、分匹配且秒为0时触发，INT引脚从Standby模式唤醒。
+ * 触发、稍后提醒、修改时间或钟声后调用ALARM_Schedule()设置下一个，不需要额外的定时唤醒。
+ * 时间按一周内的分钟数计算，星期一0:00为0。
+ */
+
+/* 当前时间在一周内的分钟数，12小时制转换为24小时制 */
+static uint16_t week_minutes(const struct RTC_Time *time)
+{
+    uint8_t hours;
+
+    hours = time->Hours;
+    if (time->Is_12hr != 0)
+    {
+        hours = (hours == 12) ? 0 : hours;
+        hours += (time->PM != 0) ? 12 : 0;
+    }
+    return (time->Day - 1) * ALARM_DAY_MINUTES + hours * 60 + time->Minutes;
+}
+
+/**
+ * @brief  计算距离下一个钟声的时间。
+ * @param  alarms 钟声数组。
+ * @param  count 钟声数量。
+ * @param  time 当前时间，星期为1 ~ 7。
+ * @return 距离下一个钟声的分钟数（1 ~ 10080），当前分钟的钟声算作下周，ALARM_NONE（0xFFFF）为全部关闭。
+ */
+uint16_t ALARM_GetNext(const struct ALARM_Entry *alarms, uint8_t count, const struct RTC_Time *time)
+{
+    uint8_t i, day;
+    uint16_t now, next, delta, alarm_time;
+
+    now = week_minutes(time);
+    next = ALARM_NONE;
+    for (i = 0; i < count; i++)
+    {
+        if (alarms[i].Hours > 23 || alarms[i].Minutes > 59)
+        {
+            continue;
+        }
+        alarm_time = alarms[i].Hours * 60 + alarms[i].Minutes;
+        for (day = 0; day < 7; day++, alarm_time += ALARM_DAY_MINUTES)
+        {
+            if ((alarms[i].Weekdays & (0x01 << day)) == 0)
+            {
+                continue;
+            }
+            delta = (alarm_time > now) ? alarm_time - now : alarm_time + ALARM_WEEK_MINUTES - now;
+            if (delta < next)
+            {
+                next = delta;
+            }
+        }
+    }
+    return next;
+}
+
+/**
+ * @brief  将下一个钟声或稍后提醒写入RTC闹钟1，没有时关闭闹钟1中断。
+ * @param  alarms 钟声数组。
+ * @param  count 钟声数量。
+ * @param  time 当前时间，闹钟的12/24小时制与其相同。
+ * @param  snooze_min 稍后提醒的分钟数，0为不提醒，比下一个钟声晚时忽略。
+ * @return 1：写入失败，0：写入成功。
+ */
+uint8_t ALARM_Schedule(const struct ALARM_Entry *alarms, uint8_t count, const struct RTC_Time *time, uint8_t snooze_min)
+{
+    uint8_t ret;
+    uint16_t next, target;
+    struct RTC_Alarm alarm;
+
+    next = ALARM_GetNext(alarms, count, time);
+    if (snooze_min != 0 && snooze_min < next)
+    {
+        next = snooze_min;
+    }
+    RTC_ModifyA1IE(0);
+    RTC_ClearA1F();
+    if (next == ALARM_NONE)
+    {
+        return 0;
+    }
+
+    target = week_minutes(time) + next;
+    if (target >= ALARM_WEEK_MINUTES)
+    {
+        target -= ALARM_WEEK_MINUTES;
+    }
+    alarm.Seconds = 0;
+    alarm.DY = 1; /* 按星期匹配 */
+    alarm.Date = 0;
+    alarm.Day = 1;
+    while (target >= ALARM_DAY_MINUTES)
+    {
+        target -= ALARM_DAY_MINUTES;
+        alarm.Day += 1;
+    }
+    alarm.Hours = target / 60;
+    alarm.Minutes = target - alarm.Hours * 60;
+    alarm.Is_12hr = time->Is_12hr;
+    alarm.PM = 0;
+    if (alarm.Is_12hr != 0)
+    {
+        alarm.PM = (alarm.Hours >= 12);
+        alarm.Hours = (alarm.Hours % 12 == 0) ? 12 : alarm.Hours % 12;
+    }
+
+    ret = RTC_SetAlarm1(&alarm);
+    ret |= RTC_ModifyAM1Mask(0x00); /* 秒、分、时、星期全部匹配 */
+    ret |= RTC_ModifyA1IE(1);
+    ret |= RTC_ModifyINTCN(1);
+    return ret;
+}
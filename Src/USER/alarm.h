@@ -0,0 +1,25 @@
+#ifndef _ALARM_H_
+#define _ALARM_H_
+
+#include "main.h"
+#include "ds3231.h"
+
+/* 可修改 */
+#define ALARM_COUNT 4       /* 钟声数量 */
+#define ALARM_SNOOZE_MIN 5  /* 稍后提醒的时间（分钟） */
+/* 结束 */
+
+#define ALARM_WEEKDAY_ALL 0x7F
+
+/* 每周重复的钟声，时间为24小时制 */
+struct ALARM_Entry
+{
+    uint8_t Hours;
+    uint8_t Minutes;
+    uint8_t Weekdays; /* 位0为星期一 ~ 位6为星期日，0为关闭 */
+};
+
+uint16_t ALARM_GetNext(const struct ALARM_Entry *alarms, uint8_t count, const struct RTC_Time *time);
+uint8_t ALARM_Schedule(const struct ALARM_Entry *alarms, uint8_t count, const struct RTC_Time *time, uint8_t snooze_min);
+
+#endif
@@ -2,6 +2,9 @@
 
 static int16_t VREFINT_offset = 0;
 
+#define ADC_DMA_FLAG_TC (DMA_ISR_TCIF1 << ((ADC_DMA_CHANNEL - LL_DMA_CHANNEL_1) * 4))
+#define ADC_DMA_FLAG_GI (DMA_IFCR_CGIF1 << ((ADC_DMA_CHANNEL - LL_DMA_CHANNEL_1) * 4))
+
 #define WAIT_TIMEOUT(val)                                       \
     timeout = ADC_TIMEOUT_MS;                                   \
     systick_tmp = SysTick->CTRL;                                \
@@ -33,81 +36,42 @@ void delay_100ns(volatile uint16_t nsX100)
 
 /**
  * @brief  根据内部参考电压计算VDDA电压。
- * @param  vrefint 内部参考电压的ADC读数。
+ * @param  vrefint 内部参考电压的ADC过采样读数。
  * @return VDDA电压，单位为毫伏。
  */
 static float conv_vrefint_to_vdda(uint16_t vrefint)
 {
-    return VREFINT_CAL_VREF * ((*VREFINT_CAL_ADDR) + VREFINT_offset) / (float)vrefint;
+    return VREFINT_CAL_VREF * (((*VREFINT_CAL_ADDR) + VREFINT_offset) * (int32_t)ADC_OVS_SCALE) / (float)vrefint;
 }
 
 /**
  * @brief  将ADC读数转换为电压。
  * @param  vdda VDDA电压，单位为毫伏。
- * @param  adc 要转换通道的ADC读数。
+ * @param  adc 要转换通道的ADC过采样读数。
  * @return 通道电压，单位为伏。
  */
 static float conv_adc_to_voltage(float vdda, uint16_t adc)
 {
-    return (vdda * adc / 4095) / 1000;
+    return (vdda * adc / ADC_FULL_SCALE) / 1000;
 }
 
 /**
  * @brief  将内置温度传感器读出的数据转换为温度。
  * @param  vdda VDDA电压，单位为毫伏。
- * @param  adc 温度传感器的ADC读数。
+ * @param  adc 温度传感器的ADC过采样读数。
  * @return 内置温度传感器的温度，单位为度。
  */
 static float conv_adc_to_temp(float vdda, uint16_t adc)
 {
     float temp;
 
-    temp = (adc * vdda / TEMPSENSOR_CAL_VREFANALOG) - *TEMPSENSOR_CAL1_ADDR;
+    temp = (adc * vdda / (TEMPSENSOR_CAL_VREFANALOG * ADC_OVS_SCALE)) - *TEMPSENSOR_CAL1_ADDR;
     temp = temp * (TEMPSENSOR_CAL2_TEMP - TEMPSENSOR_CAL1_TEMP);
     temp = temp / (*TEMPSENSOR_CAL2_ADDR - *TEMPSENSOR_CAL1_ADDR);
     temp = temp + TEMPSENSOR_CAL1_TEMP;
     return temp;
 }
 
-/**
- * @brief  去掉float数组的最高值和最低值，并计算剩余数据的平均值。
- * @param  data 数组指针。
- * @param  data_size 数组大小，最小为3，低于3返回0。
- * @return 数组内数据的平均值。
- */
-static float conv_float_avg(float *data, uint8_t data_size)
-{
-    uint8_t i, min_index, max_index;
-    float avg;
-
-    if (data_size < 3)
-    {
-        return 0;
-    }
-    min_index = 0;
-    max_index = data_size - 1;
-    for (i = 0; i < data_size; i++)
-    {
-        if (data[min_index] > data[i])
-        {
-            min_index = i;
-        }
-        else if (data[max_index] < data[i])
-        {
-            max_index = i;
-        }
-    }
-    avg = 0;
-    for (i = 0; i < data_size; i++)
-    {
-        if (i != min_index && i != max_index)
-        {
-            avg += data[i] / (data_size - 2);
-        }
-    }
-    return avg;
-}
-
 /**
  * @brief  打开ADC。
  * @return 1：打开失败，0：打开成功。
@@ -130,6 +94,16 @@ uint8_t ADC_Enable(void)
         LL_ADC_SetCommonPathInternalCh(__LL_ADC_COMMON_INSTANCE(ADC_NUM), LL_ADC_PATH_INTERNAL_TEMPSENSOR | LL_ADC_PATH_INTERNAL_VREFINT);
         delay_100ns(LL_ADC_DELAY_TEMPSENSOR_STAB_US * 10); /* 等待温度传感器稳定 */
         /* 结束 */
+        /* 过采样只能在ADC关闭时设置，每个通道转换ADC_OVS_RATIO次后输出一个结果 */
+        LL_ADC_SetOverSamplingScope(ADC_NUM, LL_ADC_OVS_GRP_REGULAR_CONTINUED);
+        LL_ADC_ConfigOverSamplingRatioShift(ADC_NUM, ADC_OVS_RATIO, ADC_OVS_SHIFT);
+        LL_ADC_SetOverSamplingDiscont(ADC_NUM, LL_ADC_OVS_REG_CONT);
+        /* 转换结果由DMA搬运，CPU只需等待序列完成 */
+        LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+        LL_DMA_DisableChannel(ADC_DMA, ADC_DMA_CHANNEL);
+        LL_DMA_SetPeriphRequest(ADC_DMA, ADC_DMA_CHANNEL, LL_DMA_REQUEST_0);
+        LL_DMA_ConfigTransfer(ADC_DMA, ADC_DMA_CHANNEL, LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_MODE_NORMAL | LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT | LL_DMA_PDATAALIGN_HALFWORD | LL_DMA_MDATAALIGN_HALFWORD | LL_DMA_PRIORITY_LOW);
+        LL_DMA_SetPeriphAddress(ADC_DMA, ADC_DMA_CHANNEL, LL_ADC_DMA_GetRegAddr(ADC_NUM, LL_ADC_DMA_REG_REGULAR_DATA));
         LL_ADC_Enable(ADC_NUM);
         WAIT_TIMEOUT((LL_ADC_IsActiveFlag_ADRDY(ADC_NUM) == 0 || LL_PWR_IsActiveFlag_VREFINTRDY() == 0));
     }
@@ -153,6 +127,8 @@ uint8_t ADC_Disable(void)
             LL_ADC_REG_StopConversion(ADC_NUM);
             WAIT_TIMEOUT(LL_ADC_REG_IsStopConversionOngoing(ADC_NUM) != 0);
         }
+        LL_DMA_DisableChannel(ADC_DMA, ADC_DMA_CHANNEL);
+        LL_ADC_REG_SetDMATransfer(ADC_NUM, LL_ADC_REG_DMA_TRANSFER_NONE);
         LL_ADC_Disable(ADC_NUM);
         WAIT_TIMEOUT(LL_ADC_IsEnabled(ADC_NUM) != 0);
         LL_ADC_ClearFlag_ADRDY(ADC_NUM);
@@ -196,9 +172,10 @@ uint8_t ADC_GetCalFactor(void)
 /**
  * @brief  转换一次指定通道的数值。
  * @param  channels 要转换的通道，留空则使用ADC寄存器内当前保存的通道。可以一次选择多个，例如：LL_ADC_CHANNEL_1 | LL_ADC_CHANNEL_VREFINT。
- * @param  data 转换结果存放指针。
+ * @param  data 转换结果存放指针，结果为硬件过采样后的数值，有效位数为ADC_OVS_BITS。
  * @param  conv_count 转换次数，一般和要转换的通道数相同，也可以为要转换通道数的倍数，这样会转换多次。
  * @return 1：转换失败，0：转换成功。
+ * @note   多个通道按通道编号从小到大的顺序转换，结果由DMA写入data，转换期间CPU只查询序列完成标志。
  */
 uint8_t ADC_StartConversionSequence(uint32_t channels, uint16_t *data, uint8_t conv_count)
 {
@@ -216,6 +193,7 @@ uint8_t ADC_StartConversionSequence(uint32_t channels, uint16_t *data, uint8_t c
     }
     LL_ADC_ClearFlag_EOS(ADC_NUM);
     LL_ADC_ClearFlag_EOC(ADC_NUM);
+    LL_ADC_ClearFlag_OVR(ADC_NUM);
     for (i = 0; i < 65535; i++)
     {
         if (LL_PWR_IsActiveFlag_VREFINTRDY() != 0) /* 等待VREFINT准备完成 */
@@ -231,22 +209,34 @@ uint8_t ADC_StartConversionSequence(uint32_t channels, uint16_t *data, uint8_t c
         }
         return 1;
     }
-    for (i = 0; i < conv_count; i++)
+
+    /* 单次模式的DMA请求在传输完成后停止，每次转换前重新设置 */
+    LL_DMA_DisableChannel(ADC_DMA, ADC_DMA_CHANNEL);
+    WRITE_REG(ADC_DMA->IFCR, ADC_DMA_FLAG_GI);
+    LL_DMA_SetMemoryAddress(ADC_DMA, ADC_DMA_CHANNEL, (uint32_t)data);
+    LL_DMA_SetDataLength(ADC_DMA, ADC_DMA_CHANNEL, conv_count);
+    LL_DMA_EnableChannel(ADC_DMA, ADC_DMA_CHANNEL);
+    LL_ADC_REG_SetDMATransfer(ADC_NUM, LL_ADC_REG_DMA_TRANSFER_NONE);
+    LL_ADC_REG_SetDMATransfer(ADC_NUM, LL_ADC_REG_DMA_TRANSFER_LIMITED);
+
+    while (READ_BIT(ADC_DMA->ISR, ADC_DMA_FLAG_TC) == 0)
     {
         if (LL_ADC_REG_IsConversionOngoing(ADC_NUM) == 0)
         {
             LL_ADC_REG_StartConversion(ADC_NUM);
         }
-        WAIT_TIMEOUT(LL_ADC_IsActiveFlag_EOC(ADC_NUM) == 0);
-        data[i] = LL_ADC_REG_ReadConversionData12(ADC_NUM) & 0x0FFF;
-        LL_ADC_ClearFlag_EOC(ADC_NUM);
+        WAIT_TIMEOUT(LL_ADC_IsActiveFlag_EOS(ADC_NUM) == 0 && READ_BIT(ADC_DMA->ISR, ADC_DMA_FLAG_TC) == 0);
+        LL_ADC_ClearFlag_EOS(ADC_NUM);
     }
     if (LL_ADC_REG_IsConversionOngoing(ADC_NUM) != 0)
     {
         LL_ADC_REG_StopConversion(ADC_NUM);
         WAIT_TIMEOUT(LL_ADC_REG_IsStopConversionOngoing(ADC_NUM) != 0);
     }
+    LL_DMA_DisableChannel(ADC_DMA, ADC_DMA_CHANNEL);
+    WRITE_REG(ADC_DMA->IFCR, ADC_DMA_FLAG_GI);
     LL_ADC_ClearFlag_EOS(ADC_NUM);
+    LL_ADC_ClearFlag_EOC(ADC_NUM);
     return 0;
 }
 
@@ -256,19 +246,13 @@ uint8_t ADC_StartConversionSequence(uint32_t channels, uint16_t *data, uint8_t c
  */
 float ADC_GetTemp(void)
 {
-    uint8_t i;
     uint16_t adc_val[2];
-    float temp_tmp[5];
 
-    for (i = 0; i < sizeof(temp_tmp) / sizeof(float); i++)
+    if (ADC_StartConversionSequence(LL_ADC_CHANNEL_TEMPSENSOR | LL_ADC_CHANNEL_VREFINT, adc_val, sizeof(adc_val) / sizeof(uint16_t)) != 0)
     {
-        if (ADC_StartConversionSequence(LL_ADC_CHANNEL_TEMPSENSOR | LL_ADC_CHANNEL_VREFINT, adc_val, sizeof(adc_val) / sizeof(uint16_t)) != 0)
-        {
-            return 0;
-        }
-        temp_tmp[i] = conv_adc_to_temp(conv_vrefint_to_vdda(adc_val[0]), adc_val[1]);
+        return 0;
     }
-    return conv_float_avg(temp_tmp, sizeof(temp_tmp) / sizeof(float));
+    return conv_adc_to_temp(conv_vrefint_to_vdda(adc_val[0]), adc_val[1]);
 }
 
 /**
@@ -277,41 +261,30 @@ float ADC_GetTemp(void)
  */
 float ADC_GetVDDA(void)
 {
-    uint8_t i;
     uint16_t adc_val[1];
-    float temp_tmp[5];
 
-    for (i = 0; i < sizeof(temp_tmp) / sizeof(float); i++)
+    if (ADC_StartConversionSequence(LL_ADC_CHANNEL_VREFINT, adc_val, sizeof(adc_val) / sizeof(uint16_t)) != 0)
     {
-        if (ADC_StartConversionSequence(LL_ADC_CHANNEL_VREFINT, adc_val, sizeof(adc_val) / sizeof(uint16_t)) != 0)
-        {
-            return 0;
-        }
-        temp_tmp[i] = conv_vrefint_to_vdda(adc_val[0]) / 1000;
+        return 0;
     }
-    return conv_float_avg(temp_tmp, sizeof(temp_tmp) / sizeof(float));
+    return conv_vrefint_to_vdda(adc_val[0]) / 1000;
 }
 
 /**
  * @brief  获取指定通道的电压。
  * @param  channel 要转换的通道，一次只可以选择一个，例如：LL_ADC_CHANNEL_1。
  * @return 通道电压，单位为伏。
+ * @note   通道和内部参考电压在同一个序列中转换，每个读数都经过硬件过采样，不再需要软件多次平均。
  */
 float ADC_GetChannel(uint32_t channel)
 {
-    uint8_t i;
     uint16_t adc_val[2];
-    float temp_tmp[5];
 
-    for (i = 0; i < sizeof(temp_tmp) / sizeof(float); i++)
+    if (ADC_StartConversionSequence(channel | LL_ADC_CHANNEL_VREFINT, adc_val, sizeof(adc_val) / sizeof(uint16_t)) != 0)
     {
-        if (ADC_StartConversionSequence(channel | LL_ADC_CHANNEL_VREFINT, adc_val, sizeof(adc_val) / sizeof(uint16_t)) != 0)
-        {
-            return 0;
-        }
-        temp_tmp[i] = conv_adc_to_voltage(conv_vrefint_to_vdda(adc_val[1]), adc_val[0]);
+        return 0;
     }
-    return conv_float_avg(temp_tmp, sizeof(temp_tmp) / sizeof(float));
+    return conv_adc_to_voltage(conv_vrefint_to_vdda(adc_val[1]), adc_val[0]);
 }
 
 /**
@@ -338,7 +311,7 @@ void ADC_DisableVrefintOutput(void)
  */
 float ADC_GetVrefintFactory(void)
 {
-    return VREFINT_CAL_VREF * *VREFINT_CAL_ADDR / 4095.0;
+    return VREFINT_CAL_VREF * *VREFINT_CAL_ADDR / 4095.0f;
 }
 
 /**
@@ -347,7 +320,7 @@ float ADC_GetVrefintFactory(void)
  */
 float ADC_GetVrefintStep(void)
 {
-    return VREFINT_CAL_VREF / 4095.0;
+    return VREFINT_CAL_VREF / 4095.0f;
 }
 
 /**
@@ -7,10 +7,18 @@
 #define ADC_NUM ADC1
 #define ADC_CHANNEL_BATTERY LL_ADC_CHANNEL_1
 #define ADC_VREFINT_OUT_PIN LL_SYSCFG_VREFINT_CONNECT_IO2
+#define ADC_DMA DMA1
+#define ADC_DMA_CHANNEL LL_DMA_CHANNEL_1    /* ADC可使用DMA通道1或2 */
+#define ADC_OVS_RATIO LL_ADC_OVS_RATIO_4    /* 硬件过采样倍数 */
+#define ADC_OVS_SHIFT LL_ADC_OVS_SHIFT_NONE /* 硬件过采样结果右移位数 */
+#define ADC_OVS_BITS 14                     /* 过采样结果的有效位数，等于 12 + log2(过采样倍数) - 右移位数，范围为：12 ~ 16 */
 /* 结束 */
 
 #define ADC_TIMEOUT_MS 1000
 
+#define ADC_OVS_SCALE (1UL << (ADC_OVS_BITS - 12)) /* 过采样结果相对12位读数的倍数 */
+#define ADC_FULL_SCALE (4095UL * ADC_OVS_SCALE)    /* 过采样结果满量程 */
+
 uint8_t ADC_Enable(void);
 uint8_t ADC_Disable(void);
 uint8_t ADC_StartCal(void);
@@ -0,0 +1,122 @@
+#include "battery.h"
+
+struct bat_point
+{
+    uint16_t mv; /* 单节电池电压，单位为毫伏 */
+    uint8_t percent;
+};
+
+struct bat_curve
+{
+    const struct bat_point *points;
+    uint8_t count;
+    uint8_t load_comp_mv; /* 电子纸刷新完成后电压尚未恢复，换算前加上的补偿电压，单位为毫伏 */
+};
+
+/* 小电流放电曲线，电压从高到低排列 */
+static const struct bat_point curve_alkaline[] = {
+    {1580, 100}, {1500, 90}, {1450, 80}, {1400, 70}, {1350, 56}, {1300, 42}, {1250, 28}, {1200, 16}, {1150, 8}, {1100, 4}, {1000, 0}};
+static const struct bat_point curve_nimh[] = {
+    {1400, 100}, {1310, 90}, {1280, 80}, {1260, 70}, {1240, 60}, {1225, 50}, {1210, 40}, {1195, 30}, {1175, 20}, {1140, 10}, {1080, 4}, {1000, 0}};
+static const struct bat_point curve_lithium[] = {
+    {1780, 100}, {1700, 95}, {1600, 88}, {1530, 75}, {1480, 55}, {1440, 35}, {1400, 20}, {1340, 10}, {1250, 4}, {1000, 0}};
+
+static const struct bat_curve bat_curves[] = {
+    {curve_alkaline, sizeof(curve_alkaline) / sizeof(struct bat_point), 30}, /* BAT_CHEM_ALKALINE */
+    {curve_nimh, sizeof(curve_nimh) / sizeof(struct bat_point), 10},         /* BAT_CHEM_NIMH */
+    {curve_lithium, sizeof(curve_lithium) / sizeof(struct bat_point), 20},   /* BAT_CHEM_LITHIUM */
+};
+
+/**
+ * @brief  跨唤醒滤波电池电压。
+ * @param  filtered 上次滤波后的电压，单位为伏。
+ * @param  voltage 本次读取的电压，单位为伏。
+ * @return 滤波后的电压，单位为伏。
+ * @note   一阶低通滤波，读数保存在备份寄存器中，每次唤醒只需计算一次。
+ */
+float BAT_Filter(float filtered, float voltage)
+{
+    if (filtered < 0.1f || filtered > 3.6f) /* 上次数据无效，直接使用本次读数 */
+    {
+        return voltage;
+    }
+    return filtered + (voltage - filtered) * (1.0f / (1 << BAT_FILTER_SHIFT));
+}
+
+/**
+ * @brief  根据放电曲线将电池电压转换为剩余电量。
+ * @param  voltage 电池电压，单位为伏，应为电子纸刷新完成后读取的电压。
+ * @return 剩余电量，单位为％。
+ */
+uint8_t BAT_GetPercent(float voltage)
+{
+    uint8_t i;
+    int32_t mv;
+    const struct bat_curve *curve;
+    const struct bat_point *upper, *lower;
+
+    curve = &bat_curves[BAT_CHEMISTRY];
+    mv = (int32_t)(voltage * 1000 / BAT_CELL_COUNT + 0.5f) + curve->load_comp_mv;
+    if (mv >= curve->points[0].mv)
+    {
+        return curve->points[0].percent;
+    }
+    for (i = 1; i < curve->count; i++)
+    {
+        if (mv >= curve->points[i].mv) /* 在两点之间线性插值 */
+        {
+            upper = &curve->points[i - 1];
+            lower = &curve->points[i];
+            return lower->percent + (mv - lower->mv) * (upper->percent - lower->percent) / (upper->mv - lower->mv);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief  估算电池剩余天数。
+ * @param  time 当前时间。
+ * @param  percent 当前剩余电量，单位为％。
+ * @return 剩余天数，BAT_DAYS_UNKNOWN：数据不足无法估算。
+ * @note   首次调用时在EEPROM记录参考点，之后根据参考点到现在的平均放电速度估算，至少需要24小时和2％的电量变化。
+ */
+uint16_t BAT_GetDaysLeft(const struct RTC_Time *time, uint8_t percent)
+{
+    uint32_t now, ref_stamp, ref_info, hours, days;
+    uint8_t ref_percent;
+
+    now = HIST_GetHourStamp(time);
+    if (now == 0)
+    {
+        return BAT_DAYS_UNKNOWN;
+    }
+    ref_stamp = EEPROM_ReadDWORD(BAT_EEPROM_ADDR_DWORD);
+    ref_info = EEPROM_ReadDWORD(BAT_EEPROM_ADDR_DWORD + 1);
+    ref_percent = ref_info & 0xFF;
+    if ((ref_info >> 8) != 0xA5A5A5 || ref_stamp > now || ref_percent > 100) /* 没有参考点或时间被调整到参考点之前 */
+    {
+        ref_info = 0xA5A5A500 | percent;
+        EEPROM_WriteBuffer(BAT_EEPROM_ADDR_DWORD * 4, &now, 4);
+        EEPROM_WriteBuffer((BAT_EEPROM_ADDR_DWORD + 1) * 4, &ref_info, 4); /* 标记最后写入 */
+        return BAT_DAYS_UNKNOWN;
+    }
+    hours = now - ref_stamp;
+    if (hours < 24 || ref_percent < percent + 2)
+    {
+        return BAT_DAYS_UNKNOWN;
+    }
+    days = (uint32_t)percent * hours / ((ref_percent - percent) * 24UL);
+    if (days >= BAT_DAYS_UNKNOWN)
+    {
+        days = BAT_DAYS_UNKNOWN - 1;
+    }
+    return days;
+}
+
+/**
+ * @brief  清除剩余天数估算参考点，更换电池后调用。
+ */
+void BAT_ResetEstimate(void)
+{
+    EEPROM_EraseRange(BAT_EEPROM_ADDR_DWORD, BAT_EEPROM_ADDR_DWORD + 1);
+}
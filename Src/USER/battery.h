@@ -0,0 +1,27 @@
+#ifndef _BATTERY_H_
+#define _BATTERY_H_
+
+#include "main.h"
+#include "eeprom.h"
+#include "ds3231.h"
+#include "history.h"
+
+/* 可修改 */
+#define BAT_CHEMISTRY BAT_CHEM_ALKALINE /* 电池类型，可设置为：BAT_CHEM_ALKALINE、BAT_CHEM_NIMH、BAT_CHEM_LITHIUM */
+#define BAT_CELL_COUNT 1                /* 串联电池节数 */
+#define BAT_FILTER_SHIFT 2              /* 跨唤醒滤波系数，每次新读数的权重为 1/(2^BAT_FILTER_SHIFT) */
+#define BAT_EEPROM_ADDR_DWORD 0xFE      /* 剩余天数估算参考点在EEPROM中的地址（四字节地址），占用2个四字节 */
+/* 结束 */
+
+#define BAT_CHEM_ALKALINE 0
+#define BAT_CHEM_NIMH 1
+#define BAT_CHEM_LITHIUM 2
+
+#define BAT_DAYS_UNKNOWN 0xFFFF
+
+float BAT_Filter(float filtered, float voltage);
+uint8_t BAT_GetPercent(float voltage);
+uint16_t BAT_GetDaysLeft(const struct RTC_Time *time, uint8_t percent);
+void BAT_ResetEstimate(void);
+
+#endif
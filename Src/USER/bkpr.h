@@ -7,6 +7,8 @@
 #define RTC_BACKUPREG_BASEADDR 0x40002850 /* 0x40002800 + 0x50 = 0x40002850 */
 /* 结束 */
 
+#define BKPR_SIZE 20 /* 容量（字节） */
+
 uint8_t BKPR_ReadByte(uint8_t addr);
 uint16_t BKPR_ReadWORD(uint8_t addr);
 uint32_t BKPR_ReadDWORD(uint8_t addr);
@@ -0,0 +1,324 @@
+#include "button.h"
+
+/*
+ * 按键的边沿由EXTI中断写入环形缓冲区，中断只写入头、读取者只写入尾，不需要关中断。
+ * BTN_GetEvent()和BTN_Wait()在主循环中读取边沿并分类为事件，事件放入另一个缓冲区。
+ * 第一个边沿立即产生按下或松开，之后BTN_DEBOUNCE_MS内的边沿视为抖动，结束时再读取一次电平。
+ * 时间只在BTN_Wait()中累计：有按键按住或正在消抖时以BTN_TICK_MS为间隔进入Stop模式，
+ * 全部空闲时进入Stop模式直到超时或按键中断唤醒。
+ */
+#define BTN_EDGE_QUEUE_SIZE 16 /* 2的幂 */
+#define BTN_EVENT_QUEUE_SIZE 8 /* 2的幂 */
+#define BTN_EDGE_PRESSED 0x80  /* 边沿记录的最高位为中断时的电平，低位为按键序号 */
+
+#define BTN_FLAG_PRESSED 0x01
+#define BTN_FLAG_LONG 0x02   /* 已产生BTN_EVENT_LONG */
+#define BTN_FLAG_IGNORE 0x04 /* BTN_Flush()时已按住，松开前不产生事件 */
+
+struct BTN_State
+{
+    uint8_t flags;
+    uint8_t count;    /* 连击次数 */
+    uint8_t repeat;   /* 连发次数 */
+    uint8_t lock_ms;  /* 消抖剩余时间 */
+    uint8_t interval; /* 当前连发间隔 */
+    uint16_t hold_ms; /* 按住的时间，松开后为松开的时间 */
+    uint16_t next_ms; /* 下次连发时的按住时间 */
+};
+
+const static uint32_t btn_exti[BTN_KEY_COUNT] = {BTN_SET_EXTI, BTN_UP_EXTI, BTN_DOWN_EXTI};
+
+static volatile uint8_t edge_queue[BTN_EDGE_QUEUE_SIZE];
+static volatile uint8_t edge_head = 0; /* 只由中断修改 */
+static volatile uint8_t edge_tail = 0; /* 只由读取者修改 */
+static volatile uint8_t edge_overflow = 0;
+
+static struct BTN_Event event_queue[BTN_EVENT_QUEUE_SIZE];
+static uint8_t event_head = 0;
+static uint8_t event_tail = 0;
+
+static struct BTN_State btn_state[BTN_KEY_COUNT];
+
+static void push_event(uint8_t key, uint8_t type, uint8_t count)
+{
+    uint8_t head;
+
+    head = (event_head + 1) & (BTN_EVENT_QUEUE_SIZE - 1);
+    if (head == event_tail) /* 缓冲区已满，丢弃新的事件 */
+    {
+        return;
+    }
+    event_queue[event_head].Key = key;
+    event_queue[event_head].Type = type;
+    event_queue[event_head].Count = count;
+    event_head = head;
+}
+
+/**
+ * @brief  按键状态改变。
+ * @param  key 按键序号。
+ * @param  pressed 1：按下，0：松开。
+ */
+static void change_state(uint8_t key, uint8_t pressed)
+{
+    struct BTN_State *state;
+
+    state = &btn_state[key];
+    state->lock_ms = BTN_DEBOUNCE_MS;
+    if (pressed != 0)
+    {
+        state->count = (state->count != 0 && state->count != 0xFF && state->hold_ms < BTN_DOUBLE_MS) ? state->count + 1 : 1;
+        state->flags = BTN_FLAG_PRESSED;
+        state->repeat = 0;
+        state->hold_ms = 0;
+        state->next_ms = BTN_REPEAT_DELAY_MS;
+        state->interval = BTN_REPEAT_START_MS;
+        push_event(key, BTN_EVENT_PRESS, state->count);
+        if (state->count == 2)
+        {
+            push_event(key, BTN_EVENT_DOUBLE, 2);
+        }
+    }
+    else
+    {
+        if ((state->flags & BTN_FLAG_IGNORE) == 0)
+        {
+            push_event(key, BTN_EVENT_RELEASE, state->count);
+        }
+        state->flags = 0;
+        state->hold_ms = 0;
+    }
+}
+
+/* 处理中断记录的边沿，消抖期间的边沿丢弃 */
+static void process_edges(void)
+{
+    uint8_t edge, key;
+
+    if (edge_overflow != 0) /* 丢失了边沿，按当前电平同步 */
+    {
+        edge_tail = edge_head;
+        edge_overflow = 0;
+        for (key = 0; key < BTN_KEY_COUNT; key++)
+        {
+            if (btn_state[key].lock_ms == 0 && BTN_IsPressed(key) != (btn_state[key].flags & BTN_FLAG_PRESSED))
+            {
+                change_state(key, BTN_IsPressed(key));
+            }
+        }
+    }
+    while (edge_tail != edge_head)
+    {
+        edge = edge_queue[edge_tail];
+        edge_tail = (edge_tail + 1) & (BTN_EDGE_QUEUE_SIZE - 1);
+        key = edge & ~BTN_EDGE_PRESSED;
+        if (btn_state[key].lock_ms != 0)
+        {
+            continue;
+        }
+        if (((edge & BTN_EDGE_PRESSED) != 0) != (btn_state[key].flags & BTN_FLAG_PRESSED)) /* 与当前状态相同的边沿为抖动的后半 */
+        {
+            change_state(key, (edge & BTN_EDGE_PRESSED) != 0);
+        }
+    }
+}
+
+/* 有按键按住或正在消抖时需要计时 */
+static uint8_t is_busy(void)
+{
+    uint8_t key;
+
+    for (key = 0; key < BTN_KEY_COUNT; key++)
+    {
+        if (btn_state[key].lock_ms != 0 || (btn_state[key].flags & BTN_FLAG_PRESSED) != 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief  经过一段时间，处理消抖结束、长按、连发和双击超时。
+ * @param  ms 经过的时间。
+ */
+static void process_time(uint16_t ms)
+{
+    uint8_t key;
+    struct BTN_State *state;
+
+    for (key = 0; key < BTN_KEY_COUNT; key++)
+    {
+        state = &btn_state[key];
+        if (state->lock_ms != 0)
+        {
+            state->lock_ms = (state->lock_ms > ms) ? state->lock_ms - ms : 0;
+            if (state->lock_ms == 0 && BTN_IsPressed(key) != (state->flags & BTN_FLAG_PRESSED)) /* 消抖期间状态又改变了 */
+            {
+                change_state(key, BTN_IsPressed(key));
+            }
+        }
+        if (state->hold_ms < 0xFFFF - ms)
+        {
+            state->hold_ms += ms;
+        }
+        if ((state->flags & (BTN_FLAG_PRESSED | BTN_FLAG_IGNORE)) == BTN_FLAG_PRESSED)
+        {
+            if ((state->flags & BTN_FLAG_LONG) == 0 && state->hold_ms >= BTN_LONG_MS)
+            {
+                state->flags |= BTN_FLAG_LONG;
+                push_event(key, BTN_EVENT_LONG, state->count);
+            }
+            if (state->hold_ms >= state->next_ms)
+            {
+                if (state->repeat != 0xFF)
+                {
+                    state->repeat += 1;
+                }
+                push_event(key, BTN_EVENT_REPEAT, state->repeat);
+                state->next_ms = state->hold_ms + state->interval;
+                if (state->interval >= BTN_REPEAT_MIN_MS + BTN_REPEAT_STEP_MS)
+                {
+                    state->interval -= BTN_REPEAT_STEP_MS;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief  设置按键引脚的外部中断，上升沿和下降沿都触发。
+ */
+void BTN_Init(void)
+{
+    uint8_t key;
+
+    LL_SYSCFG_SetEXTISource(BTN_SET_EXTI_PORT, BTN_SET_EXTI_LINE);
+    LL_SYSCFG_SetEXTISource(BTN_UP_EXTI_PORT, BTN_UP_EXTI_LINE);
+    LL_SYSCFG_SetEXTISource(BTN_DOWN_EXTI_PORT, BTN_DOWN_EXTI_LINE);
+    for (key = 0; key < BTN_KEY_COUNT; key++)
+    {
+        LL_EXTI_EnableRisingTrig_0_31(btn_exti[key]);
+        LL_EXTI_EnableFallingTrig_0_31(btn_exti[key]);
+        LL_EXTI_ClearFlag_0_31(btn_exti[key]);
+        LL_EXTI_EnableIT_0_31(btn_exti[key]);
+        btn_state[key].flags = (BTN_IsPressed(key) != 0) ? (BTN_FLAG_PRESSED | BTN_FLAG_IGNORE) : 0; /* 唤醒时按住的按键不产生事件 */
+    }
+    NVIC_ClearPendingIRQ(BTN_IRQ_A);
+    NVIC_ClearPendingIRQ(BTN_IRQ_B);
+    NVIC_SetPriority(BTN_IRQ_A, 1);
+    NVIC_SetPriority(BTN_IRQ_B, 1);
+    NVIC_EnableIRQ(BTN_IRQ_A);
+    NVIC_EnableIRQ(BTN_IRQ_B);
+}
+
+/**
+ * @brief  丢弃未读取的事件，正在按住的按键松开前不再产生事件，用于进入新页面时。
+ */
+void BTN_Flush(void)
+{
+    uint8_t key;
+
+    process_edges();
+    event_tail = event_head;
+    for (key = 0; key < BTN_KEY_COUNT; key++)
+    {
+        btn_state[key].count = 0;
+        if ((btn_state[key].flags & BTN_FLAG_PRESSED) != 0)
+        {
+            btn_state[key].flags |= BTN_FLAG_IGNORE;
+        }
+    }
+}
+
+/**
+ * @brief  读取一个按键事件，不等待。
+ * @param  event 读取到的事件。
+ * @return 事件类型，BTN_EVENT_NONE为没有事件。
+ */
+uint8_t BTN_GetEvent(struct BTN_Event *event)
+{
+    process_edges();
+    if (event_tail == event_head)
+    {
+        return BTN_EVENT_NONE;
+    }
+    *event = event_queue[event_tail];
+    event_tail = (event_tail + 1) & (BTN_EVENT_QUEUE_SIZE - 1);
+    return event->Type;
+}
+
+/**
+ * @brief  在Stop模式中等待，有按键事件时提前返回。
+ * @param  ms 最长等待时间。
+ * @return 实际等待的时间，单位为毫秒。
+ */
+uint16_t BTN_Wait(uint16_t ms)
+{
+    uint16_t slice, remain;
+
+    remain = ms;
+    while (remain != 0)
+    {
+        process_edges();
+        if (event_tail != event_head)
+        {
+            break;
+        }
+        if (is_busy() != 0)
+        {
+            slice = (remain > BTN_TICK_MS) ? BTN_TICK_MS : remain;
+            LP_DelayStop(slice);
+        }
+        else
+        {
+            slice = LP_WaitStop(remain); /* 按键中断提前唤醒时只累计实际经过的时间 */
+        }
+        remain -= slice;
+        process_time(slice);
+    }
+    return ms - remain;
+}
+
+/**
+ * @brief  读取按键当前的电平，不消抖。
+ * @param  key BTN_KEY_*。
+ * @return 1：按下，0：松开。
+ */
+uint8_t BTN_IsPressed(uint8_t key)
+{
+    switch (key)
+    {
+    case BTN_KEY_SET:
+        return LL_GPIO_IsInputPinSet(BTN_SET_GPIO_Port, BTN_SET_Pin) == 0;
+    case BTN_KEY_UP:
+        return LL_GPIO_IsInputPinSet(BTN_UP_GPIO_Port, BTN_UP_Pin) == 0;
+    default:
+        return LL_GPIO_IsInputPinSet(BTN_DOWN_GPIO_Port, BTN_DOWN_Pin) == 0;
+    }
+}
+
+/**
+ * @brief  外部中断处理，在按键引脚所在EXTI线的中断函数中调用。
+ */
+void BTN_IRQHandler(void)
+{
+    uint8_t key, head;
+
+    for (key = 0; key < BTN_KEY_COUNT; key++)
+    {
+        if (LL_EXTI_IsActiveFlag_0_31(btn_exti[key]) == 0)
+        {
+            continue;
+        }
+        LL_EXTI_ClearFlag_0_31(btn_exti[key]);
+        head = (edge_head + 1) & (BTN_EDGE_QUEUE_SIZE - 1);
+        if (head == edge_tail)
+        {
+            edge_overflow = 1;
+            continue;
+        }
+        edge_queue[edge_head] = key | (BTN_IsPressed(key) ? BTN_EDGE_PRESSED : 0);
+        edge_head = head;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef _BUTTON_H_
+#define _BUTTON_H_
+
+#include "main.h"
+#include "lowpower.h"
+
+/* 可修改 */
+#define BTN_SET_EXTI_PORT LL_SYSCFG_EXTI_PORTA
+#define BTN_SET_EXTI_LINE LL_SYSCFG_EXTI_LINE15
+#define BTN_SET_EXTI LL_EXTI_LINE_15
+#define BTN_UP_EXTI_PORT LL_SYSCFG_EXTI_PORTB
+#define BTN_UP_EXTI_LINE LL_SYSCFG_EXTI_LINE3
+#define BTN_UP_EXTI LL_EXTI_LINE_3
+#define BTN_DOWN_EXTI_PORT LL_SYSCFG_EXTI_PORTB
+#define BTN_DOWN_EXTI_LINE LL_SYSCFG_EXTI_LINE4
+#define BTN_DOWN_EXTI LL_EXTI_LINE_4
+#define BTN_IRQ_A EXTI2_3_IRQn  /* UP */
+#define BTN_IRQ_B EXTI4_15_IRQn /* DOWN和SET */
+
+#define BTN_TICK_MS 10          /* 有按键按住或消抖时BTN_Wait()的计时间隔 */
+#define BTN_DEBOUNCE_MS 24      /* 边沿之后忽略抖动的时间 */
+#define BTN_LONG_MS 800         /* 按住超过此时间产生BTN_EVENT_LONG */
+#define BTN_DOUBLE_MS 300       /* 松开后此时间内再次按下产生BTN_EVENT_DOUBLE */
+#define BTN_REPEAT_DELAY_MS 400 /* 按住后开始连发的时间 */
+#define BTN_REPEAT_START_MS 150 /* 第一次连发的间隔，之后每次减少BTN_REPEAT_STEP_MS */
+#define BTN_REPEAT_STEP_MS 10
+#define BTN_REPEAT_MIN_MS 30 /* 最短连发间隔 */
+/* 结束 */
+
+#define BTN_KEY_SET 0
+#define BTN_KEY_UP 1
+#define BTN_KEY_DOWN 2
+#define BTN_KEY_COUNT 3
+
+#define BTN_EVENT_NONE 0
+#define BTN_EVENT_PRESS 1   /* 按下，消抖前立即产生，Count为连击次数 */
+#define BTN_EVENT_RELEASE 2 /* 松开，Count为按下时的连击次数 */
+#define BTN_EVENT_LONG 3    /* 按住BTN_LONG_MS，每次按下只产生一次 */
+#define BTN_EVENT_REPEAT 4  /* 按住后连发，间隔逐渐缩短，Count为连发次数（最大255） */
+#define BTN_EVENT_DOUBLE 5  /* 双击，在第二次按下的BTN_EVENT_PRESS之后产生 */
+
+struct BTN_Event
+{
+    uint8_t Key;   /* BTN_KEY_* */
+    uint8_t Type;  /* BTN_EVENT_* */
+    uint8_t Count; /* 见BTN_EVENT_* */
+};
+
+void BTN_Init(void);
+void BTN_Flush(void);
+uint8_t BTN_GetEvent(struct BTN_Event *event);
+uint16_t BTN_Wait(uint16_t ms);
+uint8_t BTN_IsPressed(uint8_t key);
+void BTN_IRQHandler(void);
+
+#endif
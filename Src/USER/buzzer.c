@@ -1,5 +1,69 @@
 #include "buzzer.h"
-#include <math.h>
+
+/* 各音量的占空比放大256倍，占空比为 音量^2 / 200，最大音量时为50% */
+const static uint8_t Buzzer_Duty[BUZZER_MAX_VOL + 1] = {0, 1, 5, 12, 20, 32, 46, 63, 82, 104, 128};
+
+static uint8_t buzzer_volume = 0; /* BUZZER_SetVolume()设置的音量 */
+static uint8_t output_volume = 0; /* 当前输出的音量，修改频率后按此音量重新计算比较值 */
+
+static const struct BUZZER_Note *volatile playing_note = NULL; /* 正在播放的音符，NULL为没有播放 */
+static volatile uint32_t note_periods = 0;                      /* 当前音符剩余的定时器周期数 */
+
+/**
+ * @brief  按音量设置比较值。
+ * @param  vol 音量，范围为：0 ~ BUZZER_MAX_VOL。
+ */
+static void set_output_volume(uint8_t vol)
+{
+    output_volume = vol;
+    BUZZER_OC_SET_FUNC(BUZZER_TIMER, (LL_TIM_GetAutoReload(BUZZER_TIMER) * Buzzer_Duty[vol]) >> 8);
+}
+
+/**
+ * @brief  开始播放一个音符，休止符时关闭输出但定时器继续计数。
+ * @param  note 音符指针。
+ */
+static void start_note(const struct BUZZER_Note *note)
+{
+    uint32_t freq;
+
+    freq = (note->Freq != 0) ? note->Freq : BUZZER_REST_FREQ;
+    BUZZER_SetFrqe(freq);
+    if (note->Volume <= BUZZER_MAX_VOL)
+    {
+        set_output_volume(note->Volume);
+    }
+    else
+    {
+        set_output_volume(buzzer_volume);
+    }
+    note_periods = (freq * note->Time_ms + 500) / 1000; /* 每个音符计算一次 */
+    if (note_periods == 0)
+    {
+        note_periods = 1;
+    }
+    if (note->Freq != 0)
+    {
+        LL_TIM_CC_EnableChannel(BUZZER_TIMER, BUZZER_CHANNEL);
+    }
+    else
+    {
+        LL_TIM_CC_DisableChannel(BUZZER_TIMER, BUZZER_CHANNEL);
+    }
+}
+
+/**
+ * @brief  停止播放，关闭更新中断。
+ */
+static void stop_play(void)
+{
+    LL_TIM_DisableIT_UPDATE(BUZZER_TIMER);
+    LL_TIM_CC_DisableChannel(BUZZER_TIMER, BUZZER_CHANNEL);
+    LL_TIM_ClearFlag_UPDATE(BUZZER_TIMER);
+    NVIC_ClearPendingIRQ(BUZZER_IRQ);
+    playing_note = NULL;
+    set_output_volume(buzzer_volume);
+}
 
 /**
  * @brief  打开蜂鸣器定时器。
@@ -16,6 +80,7 @@ void BUZZER_Enable(void)
  */
 void BUZZER_Disable(void)
 {
+    stop_play();
     LL_TIM_CC_DisableChannel(BUZZER_TIMER, BUZZER_CHANNEL);
     LL_TIM_DisableCounter(BUZZER_TIMER);
 }
@@ -45,49 +110,113 @@ void BUZZER_SetFrqe(uint32_t freq)
     {
         LL_TIM_SetCounter(BUZZER_TIMER, 0);
     }
+    set_output_volume(output_volume); /* 比较值随重载值变化，保持占空比不变 */
 }
 
 /**
  * @brief  设置蜂鸣器音量。
- * @param  vol 蜂鸣器音量，范围为：0 ~ 10。
+ * @param  vol 蜂鸣器音量，范围为：0 ~ 10，超出时为10。
+ * @note   音量按平方变化，占空比查表得到，不使用浮点数计算。
  */
 void BUZZER_SetVolume(uint8_t vol)
 {
-    uint32_t autoreload;
+    if (vol > BUZZER_MAX_VOL)
+    {
+        vol = BUZZER_MAX_VOL;
+    }
+    buzzer_volume = vol;
+    set_output_volume(vol);
+}
 
-    autoreload = LL_TIM_GetAutoReload(BUZZER_TIMER);
-    vol = vol % 11;
-    BUZZER_OC_SET_FUNC(BUZZER_TIMER, ((autoreload / 2.0) / 100) * pow(vol, 2.0));
+/**
+ * @brief  打开蜂鸣器，在关闭前持续鸣响。
+ */
+void BUZZER_Start(void)
+{
+    LL_TIM_SetCounter(BUZZER_TIMER, LL_TIM_GetAutoReload(BUZZER_TIMER) / 2);
+    LL_TIM_CC_EnableChannel(BUZZER_TIMER, BUZZER_CHANNEL);
 }
 
 /**
- * @brief  蜂鸣器响一声。
- * @param  time_ms 持续时间。
+ * @brief  关闭蜂鸣器，停止鸣响和正在播放的音符。
  */
-void BUZZER_Beep(uint16_t time_ms)
+void BUZZER_Stop(void)
 {
-    if (time_ms != 0)
+    stop_play();
+}
+
+/**
+ * @brief  在后台播放音符数组，由定时器更新中断切换音符，调用后立即返回。
+ * @param  notes 音符数组，以Time_ms为0的音符结束，播放期间需要保持有效（一般为const数组）。
+ * @note   正在播放时调用会停止之前的播放。定时器未打开（BUZZER_Enable()）时不播放。
+ * @note   Stop模式下定时器停止，播放期间需要使用Sleep模式等待，见LP_STOP_BLOCKED()。
+ */
+void BUZZER_Play(const struct BUZZER_Note *notes)
+{
+    stop_play();
+    if (notes->Time_ms == 0 || LL_TIM_IsEnabledCounter(BUZZER_TIMER) == 0)
     {
-        LL_TIM_SetCounter(BUZZER_TIMER, LL_TIM_GetAutoReload(BUZZER_TIMER) / 2);
-        LL_TIM_CC_EnableChannel(BUZZER_TIMER, BUZZER_CHANNEL);
+        return;
     }
-    LL_mDelay(time_ms);
-    LL_TIM_CC_DisableChannel(BUZZER_TIMER, BUZZER_CHANNEL);
+    playing_note = notes;
+    LL_TIM_SetCounter(BUZZER_TIMER, 0);
+    start_note(notes);
+    LL_TIM_ClearFlag_UPDATE(BUZZER_TIMER);
+    LL_TIM_EnableIT_UPDATE(BUZZER_TIMER);
+    NVIC_SetPriority(BUZZER_IRQ, 1);
+    NVIC_EnableIRQ(BUZZER_IRQ);
 }
 
 /**
- * @brief  打开蜂鸣器，在关闭前持续鸣响。
+ * @brief  是否正在播放。
+ * @return 1：正在播放，0：已停止。
  */
-void BUZZER_Start(void)
+uint8_t BUZZER_IsPlaying(void)
 {
-    LL_TIM_SetCounter(BUZZER_TIMER, LL_TIM_GetAutoReload(BUZZER_TIMER) / 2);
-    LL_TIM_CC_EnableChannel(BUZZER_TIMER, BUZZER_CHANNEL);
+    return playing_note != NULL;
 }
 
 /**
- * @brief  关闭蜂鸣器，停止鸣响。
+ * @brief  在Sleep模式中等待播放完成。
  */
-void BUZZER_Stop(void)
+void BUZZER_Wait(void)
 {
-    LL_TIM_CC_DisableChannel(BUZZER_TIMER, BUZZER_CHANNEL);
+    LL_LPM_EnableSleep();
+    while (playing_note != NULL)
+    {
+        __WFI(); /* 由定时器更新中断唤醒 */
+    }
+}
+
+/**
+ * @brief  定时器更新中断处理，在BUZZER_TIMER的中断函数中调用。
+ */
+void BUZZER_IRQHandler(void)
+{
+    const struct BUZZER_Note *note;
+
+    if (LL_TIM_IsActiveFlag_UPDATE(BUZZER_TIMER) == 0)
+    {
+        return;
+    }
+    LL_TIM_ClearFlag_UPDATE(BUZZER_TIMER);
+    note = playing_note;
+    if (note == NULL)
+    {
+        LL_TIM_DisableIT_UPDATE(BUZZER_TIMER);
+        return;
+    }
+    note_periods -= 1;
+    if (note_periods != 0)
+    {
+        return;
+    }
+    note += 1;
+    if (note->Time_ms == 0) /* 播放完成 */
+    {
+        stop_play();
+        return;
+    }
+    playing_note = note;
+    start_note(note);
 }
@@ -5,19 +5,38 @@
 
 /* 可修改 */
 #define BUZZER_TIMER TIM2
+#define BUZZER_IRQ TIM2_IRQn
 #define BUZZER_CHANNEL LL_TIM_CHANNEL_CH3
 #define BUZZER_OC_SET_FUNC LL_TIM_OC_SetCompareCH3
 #define BUZZER_CLOCK 1000000
+#define BUZZER_REST_FREQ 1000 /* 休止符期间定时器的计数频率，决定休止符的时间精度 */
 /* 结束 */
 
 #define BUZZER_MAX_VOL 10
+#define BUZZER_VOL_DEFAULT 0xFF /* 使用BUZZER_SetVolume()设置的音量 */
+
+#ifndef NULL
+#define NULL 0
+#endif
+
+/* 音符，数组以Time_ms为0的音符结束 */
+struct BUZZER_Note
+{
+    uint16_t Freq;    /* 频率，0为休止符 */
+    uint8_t Volume;   /* 0 ~ BUZZER_MAX_VOL，或BUZZER_VOL_DEFAULT */
+    uint16_t Time_ms; /* 持续时间 */
+};
 
 void BUZZER_Enable(void);
 void BUZZER_Disable(void);
 void BUZZER_Start(void);
 void BUZZER_Stop(void);
-void BUZZER_Beep(uint16_t time_ms);
 void BUZZER_SetVolume(uint8_t vol);
 void BUZZER_SetFrqe(uint32_t freq);
 
+void BUZZER_Play(const struct BUZZER_Note *notes);
+uint8_t BUZZER_IsPlaying(void);
+void BUZZER_Wait(void);
+void BUZZER_IRQHandler(void);
+
 #endif
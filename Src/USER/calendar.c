@@ -0,0 +1,117 @@
+#include "calendar.h"
+#include "solarterm.h"
+
+/*
+ * Cortex-M0+没有除法指令，这里的除法和取余全部用乘法加移位或查表代替，避免调用库中的软件除法：
+ * y / 100 = (y * 1311) >> 17，y < 2300时成立
+ * x / 60 = (x * 34953) >> 21，x < 74939时成立，覆盖2000 ~ 2199年的天数
+ */
+
+/* 干支序号对应的天干（高4位）和地支（低4位） */
+const static uint8_t cycle_table[60] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0x0A, 0x1B,
+    0x20, 0x31, 0x42, 0x53, 0x64, 0x75, 0x86, 0x97, 0x08, 0x19, 0x2A, 0x3B,
+    0x40, 0x51, 0x62, 0x73, 0x84, 0x95, 0x06, 0x17, 0x28, 0x39, 0x4A, 0x5B,
+    0x60, 0x71, 0x82, 0x93, 0x04, 0x15, 0x26, 0x37, 0x48, 0x59, 0x6A, 0x7B,
+    0x80, 0x91, 0x02, 0x13, 0x24, 0x35, 0x46, 0x57, 0x68, 0x79, 0x8A, 0x9B};
+
+/* 以3月为一年的第一个月时，各月1日之前的天数 */
+const static uint16_t month_offset[12] = {306, 337, 0, 31, 61, 92, 122, 153, 184, 214, 245, 275};
+
+static uint8_t Mod60(uint32_t x)
+{
+    return x - ((x * 34953UL) >> 21) * 60;
+}
+
+/**
+ * @brief  计算公历日期的日序号（公元0年3月1日起的天数）。
+ * @param  year 公历年份，小于2300。
+ * @param  month 公历月份。
+ * @param  date 公历日期。
+ * @return 日序号，两个日期的日序号之差为相隔的天数。
+ */
+uint32_t CAL_GetDayNumber(uint16_t year, uint8_t month, uint8_t date)
+{
+    uint16_t century;
+
+    if (month <= 2) /* 1、2月算作上一年的最后两个月，闰日在年末 */
+    {
+        year -= 1;
+    }
+    century = (year * 1311UL) >> 17;
+    return year * 365UL + (year >> 2) - century + (century >> 2) + month_offset[month - 1] + date - 1;
+}
+
+/**
+ * @brief  计算2000年1月1日起的天数。
+ * @param  year 公历年份，范围为2000 ~ 2299。
+ * @param  month 公历月份。
+ * @param  date 公历日期。
+ * @return 天数。
+ */
+uint32_t CAL_GetDays2000(uint16_t year, uint8_t month, uint8_t date)
+{
+    return CAL_GetDayNumber(year, month, date) - CAL_DAY_NUMBER_2000;
+}
+
+/**
+ * @brief  获取干支序号的天干。
+ * @param  cycle 干支序号，0 ~ 59。
+ * @return 天干，用于Lunar_StemStrig。
+ */
+uint8_t CAL_GetStem(uint8_t cycle)
+{
+    return cycle_table[cycle] >> 4;
+}
+
+/**
+ * @brief  获取干支序号的地支。
+ * @param  cycle 干支序号，0 ~ 59。
+ * @return 地支，用于Lunar_BranchStrig和Lunar_ZodiacString。
+ */
+uint8_t CAL_GetBranch(uint8_t cycle)
+{
+    return cycle_table[cycle] & 0x0F;
+}
+
+/**
+ * @brief  获取年干支。
+ * @param  year 年份，农历年份对应农历纪年。
+ * @return 干支序号。
+ */
+uint8_t CAL_GetYearCycle(uint16_t year)
+{
+    return Mod60(year);
+}
+
+/**
+ * @brief  获取月干支，以节气中的“节”（立春、惊蛰等）为月份的分界。
+ * @param  year 公历年份，范围为TERM_YEAR_MIN ~ TERM_YEAR_MAX。
+ * @param  month 公历月份。
+ * @param  date 公历日期。
+ * @return 干支序号，0xFF：日期超出范围。
+ */
+uint8_t CAL_GetMonthCycle(uint16_t year, uint8_t month, uint8_t date)
+{
+    uint8_t days, months;
+
+    if (TERM_GetNext(year, month, 1, &days) == TERM_NONE) /* 本月的“节”在1 + days日 */
+    {
+        return 0xFF;
+    }
+    /* 2000年1月小寒前为丙子月（序号16），之后每过一个“节”加1 */
+    months = (date > days) ? 1 : 0;
+    return Mod60((year - 2000) * 12UL + month + months + 15);
+}
+
+/**
+ * @brief  获取日干支。
+ * @param  year 公历年份，范围为2000 ~ 2199。
+ * @param  month 公历月份。
+ * @param  date 公历日期。
+ * @return 干支序号。
+ */
+uint8_t CAL_GetDayCycle(uint16_t year, uint8_t month, uint8_t date)
+{
+    return Mod60(CAL_GetDays2000(year, month, date) + 58); /* 2000年1月1日为戊午日 */
+}
@@ -0,0 +1,22 @@
+#ifndef _CALENDAR_H_
+#define _CALENDAR_H_
+
+#include "main.h"
+
+/*
+ * 干支序号与农历年份对60取余的结果一致：序号对10取余用于Lunar_StemStrig，对12取余用于Lunar_BranchStrig和Lunar_ZodiacString，
+ * 甲子为4，而不是通常的0。
+ */
+#define CAL_CYCLE_JIAZI 4
+
+#define CAL_DAY_NUMBER_2000 730425UL /* 2000年1月1日的日序号 */
+
+uint32_t CAL_GetDayNumber(uint16_t year, uint8_t month, uint8_t date);
+uint32_t CAL_GetDays2000(uint16_t year, uint8_t month, uint8_t date);
+uint8_t CAL_GetStem(uint8_t cycle);
+uint8_t CAL_GetBranch(uint8_t cycle);
+uint8_t CAL_GetYearCycle(uint16_t year);
+uint8_t CAL_GetMonthCycle(uint16_t year, uint8_t month, uint8_t date);
+uint8_t CAL_GetDayCycle(uint16_t year, uint8_t month, uint8_t date);
+
+#endif
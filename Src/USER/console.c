@@ -0,0 +1,247 @@
+#include "console.h"
+#include "numedit.h"
+
+/*
+ * 串口命令行：收到的字节组成一行，以'\r'或'\n'结束，按空格分割为参数后在命令表中查找并执行。
+ * 不回显输入，每个命令先输出结果，最后一行为"OK"或"ERR ..."，便于脚本批量配置。
+ */
+static const struct CON_Command *con_commands;
+static uint8_t con_count;
+static char con_line[CON_LINE_SIZE];
+static uint8_t con_length;
+static uint8_t con_discard; /* 本行已溢出，丢弃到行尾 */
+
+/* 分割参数并执行一行命令 */
+static uint8_t execute_line(void)
+{
+    char *argv[CON_ARGS_MAX];
+    char *ptr;
+    uint8_t argc, i, result;
+
+    argc = 0;
+    ptr = con_line;
+    while (*ptr != '\0')
+    {
+        if (*ptr == ' ' || *ptr == '\t')
+        {
+            *ptr++ = '\0';
+            continue;
+        }
+        if (argc >= CON_ARGS_MAX)
+        {
+            SERIAL_SendStringRN("ERR TOO MANY ARGS");
+            return CON_RESULT_ERROR;
+        }
+        argv[argc++] = ptr;
+        while (*ptr != '\0' && *ptr != ' ' && *ptr != '\t')
+        {
+            ptr++;
+        }
+    }
+    if (argc == 0) /* 空行，例如"\r\n"的第二个字符 */
+    {
+        return CON_RESULT_OK;
+    }
+    for (i = 0; i < con_count; i++)
+    {
+        if (CON_IsEqual(argv[0], con_commands[i].name) != 0)
+        {
+            break;
+        }
+    }
+    if (i == con_count)
+    {
+        SERIAL_SendStringRN("ERR UNKNOWN COMMAND");
+        return CON_RESULT_ERROR;
+    }
+    result = con_commands[i].handler(argc, argv);
+    if (result == CON_RESULT_ERROR)
+    {
+        SERIAL_SendString("ERR USAGE: ");
+        SERIAL_SendString(con_commands[i].name);
+        SERIAL_SendString(" ");
+        SERIAL_SendStringRN(con_commands[i].usage);
+    }
+    else
+    {
+        SERIAL_SendStringRN("OK");
+    }
+    return result;
+}
+
+/**
+ * @brief  设置命令表并清空正在接收的行。
+ * @param  commands 命令表。
+ * @param  count 命令数量。
+ */
+void CON_Init(const struct CON_Command *commands, uint8_t count)
+{
+    uint8_t rx_data;
+
+    con_commands = commands;
+    con_count = count;
+    con_length = 0;
+    con_discard = 0;
+    while (SERIAL_ReadByte(&rx_data) == 0) /* 丢弃连接前收到的数据 */
+    {
+    }
+    SERIAL_GetOverflow();
+}
+
+/**
+ * @brief  处理接收缓冲区中的数据，收到完整的一行时执行命令，不等待。
+ * @return CON_POLL_*。
+ */
+uint8_t CON_Poll(void)
+{
+    uint8_t rx_data, status;
+
+    status = CON_POLL_IDLE;
+    if (SERIAL_GetOverflow() != 0) /* 丢失了数据，本行已不完整 */
+    {
+        con_discard = 1;
+        status = CON_POLL_ACTIVE;
+    }
+    while (SERIAL_ReadByte(&rx_data) == 0)
+    {
+        status = CON_POLL_ACTIVE;
+        if (rx_data == '\r' || rx_data == '\n')
+        {
+            con_line[con_length] = '\0';
+            if (con_discard != 0)
+            {
+                SERIAL_SendStringRN("ERR LINE LOST");
+            }
+            else if (execute_line() == CON_RESULT_EXIT)
+            {
+                return CON_POLL_EXIT;
+            }
+            con_length = 0;
+            con_discard = 0;
+        }
+        else if (rx_data == '\b' || rx_data == 0x7F) /* 退格 */
+        {
+            if (con_length != 0)
+            {
+                con_length -= 1;
+            }
+        }
+        else if (con_length + 1 < CON_LINE_SIZE)
+        {
+            con_line[con_length++] = rx_data;
+        }
+        else
+        {
+            con_discard = 1;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief  输出全部命令和用法。
+ */
+void CON_PrintHelp(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < con_count; i++)
+    {
+        SERIAL_SendString(con_commands[i].name);
+        SERIAL_SendString(" ");
+        SERIAL_SendStringRN(con_commands[i].usage);
+    }
+}
+
+/**
+ * @brief  比较两个字符串。
+ * @return 1：相同，0：不同。
+ */
+uint8_t CON_IsEqual(const char *str1, const char *str2)
+{
+    while (*str1 != '\0' && *str1 == *str2)
+    {
+        str1++;
+        str2++;
+    }
+    return *str1 == *str2;
+}
+
+/**
+ * @brief  解析十进制定点小数，例如decimals为2时"-1.5"解析为-150。
+ * @param  str 字符串，可带正负号，小数位数不能超过decimals。
+ * @param  decimals 小数位数，0时只接受整数。
+ * @param  value 放大10^decimals倍后的整数。
+ * @return 1：格式错误，0：解析成功。
+ */
+uint8_t CON_ParseFixed(const char *str, uint8_t decimals, int32_t *value)
+{
+    int32_t result;
+    uint8_t negative, digits, fraction;
+
+    negative = (*str == '-');
+    if (*str == '-' || *str == '+')
+    {
+        str++;
+    }
+    result = 0;
+    digits = 0;
+    fraction = 0xFF; /* 小数点后的位数，0xFF为还没有小数点 */
+    for (; *str != '\0'; str++)
+    {
+        if (*str == '.' && fraction == 0xFF && decimals != 0)
+        {
+            fraction = 0;
+            continue;
+        }
+        if (*str < '0' || *str > '9' || digits + decimals >= 9 || (fraction != 0xFF && fraction >= decimals))
+        {
+            return 1;
+        }
+        result = result * 10 + (*str - '0');
+        digits += 1;
+        if (fraction != 0xFF)
+        {
+            fraction += 1;
+        }
+    }
+    if (digits == 0)
+    {
+        return 1;
+    }
+    result *= NUM_Pow10(decimals - ((fraction == 0xFF) ? 0 : fraction));
+    *value = (negative != 0) ? -result : result;
+    return 0;
+}
+
+/**
+ * @brief  解析以sep分隔的多个非负整数，例如"2024-06-01"或"07:30:00"。
+ * @param  str 字符串。
+ * @param  sep 分隔符。
+ * @param  values 解析结果。
+ * @param  count 数值数量，必须完全一致。
+ * @return 1：格式错误，0：解析成功。
+ */
+uint8_t CON_ParseFields(const char *str, char sep, int32_t *values, uint8_t count)
+{
+    uint8_t i, digits;
+
+    for (i = 0; i < count; i++)
+    {
+        values[i] = 0;
+        for (digits = 0; *str >= '0' && *str <= '9' && digits < 9; digits++)
+        {
+            values[i] = values[i] * 10 + (*str - '0');
+            str++;
+        }
+        if (digits == 0 || *str != ((i + 1 < count) ? sep : '\0'))
+        {
+            return 1;
+        }
+        if (*str != '\0')
+        {
+            str++;
+        }
+    }
+    return 0;
+}
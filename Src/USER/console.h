@@ -0,0 +1,34 @@
+#ifndef _CONSOLE_H_
+#define _CONSOLE_H_
+
+#include "main.h"
+#include "serial.h"
+
+/* 可修改 */
+#define CON_LINE_SIZE 64 /* 一行命令的最大长度，包含结尾的'\0' */
+#define CON_ARGS_MAX 6   /* 一行命令的最多参数数量，包含命令名 */
+/* 结束 */
+
+#define CON_RESULT_OK 0    /* 命令执行成功，回复"OK" */
+#define CON_RESULT_ERROR 1 /* 参数错误或执行失败，回复"ERR"和命令用法 */
+#define CON_RESULT_EXIT 2  /* 命令执行成功并退出命令行 */
+
+#define CON_POLL_IDLE 0   /* 没有收到数据 */
+#define CON_POLL_ACTIVE 1 /* 收到了数据，可能已执行命令 */
+#define CON_POLL_EXIT 2   /* 执行了退出命令 */
+
+struct CON_Command
+{
+    const char *name;
+    const char *usage;                              /* 参数说明，用于help和错误回复 */
+    uint8_t (*handler)(uint8_t argc, char *argv[]); /* argv[0]为命令名，返回CON_RESULT_* */
+};
+
+void CON_Init(const struct CON_Command *commands, uint8_t count);
+uint8_t CON_Poll(void);
+void CON_PrintHelp(void);
+uint8_t CON_IsEqual(const char *str1, const char *str2);
+uint8_t CON_ParseFixed(const char *str, uint8_t decimals, int32_t *value);
+uint8_t CON_ParseFields(const char *str, char sep, int32_t *values, uint8_t count);
+
+#endif
@@ -0,0 +1,36 @@
+#include "crc16.h"
+
+/* CRC-16/CCITT-FALSE半字节查表，多项式0x1021，每字节查表两次（每次处理4位） */
+static const uint16_t crc16_table[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+
+/**
+ * @brief  将一个字节加入CRC-16/CCITT-FALSE校验值。
+ * @param  crc 初始值（CRC16_INIT）或之前数据的校验值。
+ * @param  data 要加入的字节。
+ * @return 校验值。
+ */
+uint16_t CRC16_Update(uint16_t crc, uint8_t data)
+{
+    crc = (crc << 4) ^ crc16_table[(crc >> 12) ^ (data >> 4)];
+    crc = (crc << 4) ^ crc16_table[(crc >> 12) ^ (data & 0x0F)];
+    return crc;
+}
+
+/**
+ * @brief  计算一段数据的CRC-16/CCITT-FALSE校验值。
+ * @param  crc 初始值（CRC16_INIT）或上一段数据的校验值。
+ * @param  data 数据指针。
+ * @param  data_size 数据大小。
+ * @return 校验值。
+ */
+uint16_t CRC16_Calc(uint16_t crc, const uint8_t *data, uint16_t data_size)
+{
+    while (data_size--)
+    {
+        crc = CRC16_Update(crc, *data);
+        data += 1;
+    }
+    return crc;
+}
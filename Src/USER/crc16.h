@@ -0,0 +1,11 @@
+#ifndef _CRC16_H_
+#define _CRC16_H_
+
+#include "main.h"
+
+#define CRC16_INIT 0xFFFF /* CRC-16/CCITT-FALSE初始值 */
+
+uint16_t CRC16_Update(uint16_t crc, uint8_t data);
+uint16_t CRC16_Calc(uint16_t crc, const uint8_t *data, uint16_t data_size);
+
+#endif
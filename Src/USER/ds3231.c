@@ -1,7 +1,7 @@
 #include "ds3231.h"
 
 #include "serial.h"
-#include <stdio.h>
+#include <string.h>
 /**
  * @brief  BIN转BCD。
  * @param  bin 要转换的数值。
@@ -56,15 +56,12 @@ static void check_range(uint8_t *number, uint8_t max, uint8_t min)
 uint8_t RTC_ReadREG(uint8_t reg)
 {
     uint8_t read_temp;
+    struct I2C_Xfer xfer = {RTC_I2C_ADDR, 1, 1, &reg, &read_temp, I2C_TIMEOUT_MS};
 
-    if (I2C_Start(RTC_I2C_ADDR, 0, 1) != 0 ||
-        I2C_WriteByte(reg) != 0 ||
-        I2C_Start(RTC_I2C_ADDR, 1, 1) != 0)
+    if (I2C_Transfer(&xfer, 1) != 0)
     {
         return 0x00;
     }
-    read_temp = I2C_ReadByte();
-    I2C_Stop();
     return read_temp;
 }
 
@@ -76,13 +73,13 @@ uint8_t RTC_ReadREG(uint8_t reg)
  */
 uint8_t RTC_WriteREG(uint8_t reg, uint8_t data)
 {
-    if (I2C_Start(RTC_I2C_ADDR, 0, 2) != 0 ||
-        I2C_WriteByte(reg) != 0 ||
-        I2C_WriteByte(data) != 0)
+    uint8_t write_temp[2] = {reg, data};
+    struct I2C_Xfer xfer = {RTC_I2C_ADDR, sizeof(write_temp), 0, write_temp, NULL, I2C_TIMEOUT_MS};
+
+    if (I2C_Transfer(&xfer, 1) != 0)
     {
         return 1;
     }
-    I2C_Stop();
     return 0;
 }
 
@@ -95,19 +92,12 @@ uint8_t RTC_WriteREG(uint8_t reg, uint8_t data)
  */
 uint8_t RTC_ReadREG_Multi(uint8_t start_reg, uint8_t read_size, uint8_t *read_data)
 {
-    uint8_t i;
+    struct I2C_Xfer xfer = {RTC_I2C_ADDR, 1, read_size, &start_reg, read_data, I2C_TIMEOUT_MS};
 
-    if (I2C_Start(RTC_I2C_ADDR, 0, 1) != 0 ||
-        I2C_WriteByte(start_reg) != 0 ||
-        I2C_Start(RTC_I2C_ADDR, 1, read_size) != 0)
+    if (I2C_Transfer(&xfer, 1) != 0)
     {
         return 1;
     }
-    for (i = 0; i < read_size; i++)
-    {
-        read_data[i] = I2C_ReadByte();
-    }
-    I2C_Stop();
     return 0;
 }
 
@@ -120,24 +110,20 @@ uint8_t RTC_ReadREG_Multi(uint8_t start_reg, uint8_t read_size, uint8_t *read_da
  */
 uint8_t RTC_WriteREG_Multi(uint8_t start_reg, uint8_t write_size, const uint8_t *write_data)
 {
-    uint8_t i, err;
+    uint8_t write_temp[RTC_REG_TPL + 2]; /* 寄存器地址和全部寄存器 */
+    struct I2C_Xfer xfer = {RTC_I2C_ADDR, write_size + 1, 0, write_temp, NULL, I2C_TIMEOUT_MS};
 
-    if (I2C_Start(RTC_I2C_ADDR, 0, write_size + 1) != 0 ||
-        I2C_WriteByte(start_reg) != 0)
+    if (write_size > RTC_REG_TPL + 1)
     {
         return 1;
     }
-    err = 0;
-    for (i = 0; i < write_size; i++)
+    write_temp[0] = start_reg;
+    memcpy(write_temp + 1, write_data, write_size);
+    if (I2C_Transfer(&xfer, 1) != 0)
     {
-        if (I2C_WriteByte(write_data[i]) != 0)
-        {
-            err = 1;
-            break;
-        }
+        return 1;
     }
-    I2C_Stop();
-    return err;
+    return 0;
 }
 
 /**
@@ -910,14 +896,14 @@ float RTC_GetTemp(void)
     temp_tmp |= RTC_ReadREG(RTC_REG_TPL) >> 6;
     if ((temp_tmp & 0x0200) != 0)
     {
-        temp_tmp &= 0x01FF;        /* 去除负号标志 */
-        temp_tmp ^= 0x01FF;        /* 转正数 */
-        temp_tmp += 1;             /* 转正数 */
-        return -(temp_tmp * 0.25); /* 计算温度并变为负数 */
+        temp_tmp &= 0x01FF;         /* 去除负号标志 */
+        temp_tmp ^= 0x01FF;         /* 转正数 */
+        temp_tmp += 1;              /* 转正数 */
+        return -(temp_tmp * 0.25f); /* 计算温度并变为负数 */
     }
     else
     {
-        return temp_tmp * 0.25; /* 计算温度 */
+        return temp_tmp * 0.25f; /* 计算温度 */
     }
 }
 
@@ -30,6 +30,7 @@
 #define RTC_REG_AGI 0x10
 #define RTC_REG_TPM 0x11
 #define RTC_REG_TPL 0x12
+#define RTC_REG_COUNT 0x13 /* 寄存器数量 */
 
 struct RTC_Time
 {
@@ -12,6 +12,8 @@
         return 1;           \
     }
 
+static uint16_t program_time_ms = 0;
+
 /**
  * @brief  等待EEPROM空闲。
  * @return 1：等待超时，0：EEPROM空闲。
@@ -23,12 +25,16 @@ static uint8_t eeprom_wait_busy(void)
 
     timeout = EEPROM_TIMEOUT_MS;
     systick_tmp = SysTick->CTRL;
-    ((void)systick_tmp);
+    if ((systick_tmp & SysTick_CTRL_COUNTFLAG_Msk) != 0U) /* 批量写入开始时已清除计数标志，读取时清除的标志产生于上次等待之后，也计入编程耗时 */
+    {
+        program_time_ms += 1;
+    }
     while (timeout != 0 && (FLASH->SR & FLASH_SR_BSY) != 0)
     {
         if ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0U)
         {
             timeout -= 1;
+            program_time_ms += 1;
         }
     }
     if (timeout == 0)
@@ -243,35 +249,121 @@ uint8_t EEPROM_EraseDWORD(uint16_t addr)
     return 0;
 }
 
+/**
+ * @brief  向指定地址写入任意长度的数据。
+ * @param  addr EEPROM地址，对于2K存储容量的EEPROM，起始地址为0，最大地址为2047。
+ * @param  data 要写入的数据指针，不要求对齐。
+ * @param  data_size 要写入数据的大小。
+ * @return 1：写入错误，0：写入完成。
+ * @note   整个过程只解锁和锁定一次，按地址对齐情况尽量使用四字节写入，内容相同的部分不写入，全部写入完成后统一校验。
+ */
+uint8_t EEPROM_WriteBuffer(uint16_t addr, const void *data, uint16_t data_size)
+{
+    const uint8_t *data_ptr;
+    uint16_t i, step;
+    uint32_t dword_tmp;
+    volatile uint32_t systick_tmp;
+
+    program_time_ms = 0;
+    systick_tmp = SysTick->CTRL; /* 清除调用前的计数标志，不计入编程耗时 */
+    ((void)systick_tmp);
+    EEPROM_UNLOCK();
+    data_ptr = data;
+    for (i = 0; i < data_size; i += step)
+    {
+        if (((addr + i) & 0x03) == 0 && data_size - i >= 4)
+        {
+            step = 4;
+            dword_tmp = data_ptr[i] | ((uint32_t)data_ptr[i + 1] << 8) | ((uint32_t)data_ptr[i + 2] << 16) | ((uint32_t)data_ptr[i + 3] << 24);
+            if (*(__IO uint32_t *)(EEPROM_BASE_ADDR + addr + i) == dword_tmp)
+            {
+                continue;
+            }
+            *(__IO uint32_t *)(EEPROM_BASE_ADDR + addr + i) = dword_tmp;
+        }
+        else if (((addr + i) & 0x01) == 0 && data_size - i >= 2)
+        {
+            step = 2;
+            dword_tmp = data_ptr[i] | ((uint16_t)data_ptr[i + 1] << 8);
+            if (*(__IO uint16_t *)(EEPROM_BASE_ADDR + addr + i) == dword_tmp)
+            {
+                continue;
+            }
+            *(__IO uint16_t *)(EEPROM_BASE_ADDR + addr + i) = dword_tmp;
+        }
+        else
+        {
+            step = 1;
+            if (*(__IO uint8_t *)(EEPROM_BASE_ADDR + addr + i) == data_ptr[i])
+            {
+                continue;
+            }
+            *(__IO uint8_t *)(EEPROM_BASE_ADDR + addr + i) = data_ptr[i];
+        }
+        if (eeprom_wait_busy() != 0)
+        {
+            break;
+        }
+    }
+    EEPROM_LOCK();
+    for (i = 0; i < data_size; i++)
+    {
+        if (*(__IO uint8_t *)(EEPROM_BASE_ADDR + addr + i) != data_ptr[i])
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 /**
  * @brief  以四字节为单位，擦除指定地址范围内的数据。
  * @param  addr EEPROM地址，对于2K存储容量的EEPROM，起始地址为0，最大地址为511。
  * @return 大于0：擦除时出错的循环次数，减1为出错的地址，0：擦除完成。
  * @note   内置EEPROM不需要先擦除再写入，可以直接写入数据。
+ * @note   已经为0的四字节不再擦除，全部擦除完成后统一校验。
  */
 uint16_t EEPROM_EraseRange(uint16_t start_addr_DWORD, uint16_t end_addr_DWORD)
 {
-    uint8_t err;
     uint16_t i;
+    volatile uint32_t systick_tmp;
 
+    program_time_ms = 0;
+    systick_tmp = SysTick->CTRL; /* 清除调用前的计数标志，不计入编程耗时 */
+    ((void)systick_tmp);
     EEPROM_UNLOCK();
     FLASH->PECR |= FLASH_PECR_ERASE | FLASH_PECR_DATA;
-    err = 0;
     end_addr_DWORD += 1;
     for (i = start_addr_DWORD; i < end_addr_DWORD; i++)
     {
+        if (*(__IO uint32_t *)(EEPROM_BASE_ADDR + (i * 4)) == 0)
+        {
+            continue;
+        }
         *(__IO uint32_t *)(EEPROM_BASE_ADDR + (i * 4)) = 0;
-        if (eeprom_wait_busy() != 0 || *(__IO uint32_t *)(EEPROM_BASE_ADDR + (i * 4)) != 0)
+        if (eeprom_wait_busy() != 0)
         {
-            err = 1;
             break;
         }
     }
     FLASH->PECR &= ~(FLASH_PECR_ERASE | FLASH_PECR_DATA);
     EEPROM_LOCK();
-    if (err != 0)
+    for (i = start_addr_DWORD; i < end_addr_DWORD; i++)
     {
-        return i + 1;
+        if (*(__IO uint32_t *)(EEPROM_BASE_ADDR + (i * 4)) != 0)
+        {
+            return i + 1;
+        }
     }
     return 0;
 }
+
+/**
+ * @brief  获取上一次批量写入或擦除的编程耗时。
+ * @return 耗时，单位为毫秒，精度为1毫秒。
+ * @note   只统计EEPROM_WriteBuffer和EEPROM_EraseRange，耗时由SysTick计数标志累计，期间不能有其他代码读取SysTick->CTRL。
+ */
+uint16_t EEPROM_GetProgramTime(void)
+{
+    return program_time_ms;
+}
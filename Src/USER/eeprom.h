@@ -10,6 +10,7 @@
 /* 结束 */
 
 #define EEPROM_TIMEOUT_MS 1000
+#define EEPROM_SIZE 2048 /* 容量（字节） */
 
 uint8_t EEPROM_ReadByte(uint16_t addr);
 uint16_t EEPROM_ReadWORD(uint16_t addr);
@@ -18,10 +19,12 @@ uint32_t EEPROM_ReadDWORD(uint16_t addr);
 uint8_t EEPROM_WriteByte(uint16_t addr, uint8_t data);
 uint8_t EEPROM_WriteWORD(uint16_t addr, uint16_t data);
 uint8_t EEPROM_WriteDWORD(uint16_t addr, uint32_t data);
+uint8_t EEPROM_WriteBuffer(uint16_t addr, const void *data, uint16_t data_size);
 
 uint8_t EEPROM_EraseByte(uint16_t addr);
 uint8_t EEPROM_EraseWORD(uint16_t addr);
 uint8_t EEPROM_EraseDWORD(uint16_t addr);
 uint16_t EEPROM_EraseRange(uint16_t start_addr_DWORD, uint16_t end_addr_DWORD);
+uint16_t EEPROM_GetProgramTime(void);
 
 #endif
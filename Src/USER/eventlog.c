@@ -0,0 +1,356 @@
+#include "eventlog.h"
+#include <string.h>
+
+#define LOG_BLOCK_MARK 0x4C470000                    /* 块头部高16位固定标记 */
+#define LOG_BLOCK_SIZE (LOG_BLOCK_DWORDS * 4)         /* 块大小（字节） */
+#define LOG_DATA_START 8                              /* 块内记录起始位置（字节） */
+#define LOG_RECORD_MAX_SIZE 11                        /* 事件1字节，时间和参数的变长编码各最多5字节 */
+
+/*
+ * 记录格式：事件编号（1字节，不为0）+ 相对块起始时间的分钟数（变长编码）+ 参数（变长编码）
+ * 变长编码每字节保存7位，低位在前，最高位为1表示后面还有数据。
+ * EEPROM擦除后为0，读到事件编号为0即为块内记录结束。
+ */
+
+/**
+ * @brief  获取块的EEPROM字节地址。
+ * @param  block 块编号。
+ * @return EEPROM字节地址。
+ */
+static uint16_t block_addr(uint8_t block)
+{
+    return (LOG_EEPROM_ADDR_DWORD + block * LOG_BLOCK_DWORDS) * 4;
+}
+
+/**
+ * @brief  查找序号最新的有效块。
+ * @param  seq 最新块的序号。
+ * @return 最新块编号，LOG_BLOCK_COUNT：没有有效块。
+ */
+static uint8_t find_newest(uint16_t *seq)
+{
+    uint8_t i, newest;
+    uint32_t header;
+
+    newest = LOG_BLOCK_COUNT;
+    *seq = 0;
+    for (i = 0; i < LOG_BLOCK_COUNT; i++)
+    {
+        header = EEPROM_ReadDWORD(block_addr(i) / 4);
+        if ((header & 0xFFFF0000) != LOG_BLOCK_MARK)
+        {
+            continue;
+        }
+        if (newest == LOG_BLOCK_COUNT || (int16_t)((header & 0xFFFF) - *seq) > 0)
+        {
+            newest = i;
+            *seq = header & 0xFFFF;
+        }
+    }
+    return newest;
+}
+
+/**
+ * @brief  从EEPROM读取一个变长编码数值。
+ * @param  addr EEPROM字节地址，读取后指向下一个数据。
+ * @param  end 块结束地址。
+ * @return 读取到的数值。
+ */
+static uint32_t varint_read(uint16_t *addr, uint16_t end)
+{
+    uint8_t shift, byte;
+    uint32_t value;
+
+    value = 0;
+    shift = 0;
+    while (*addr < end)
+    {
+        byte = EEPROM_ReadByte(*addr);
+        *addr += 1;
+        if (shift < 32)
+        {
+            value |= (uint32_t)(byte & 0x7F) << shift;
+        }
+        shift += 7;
+        if ((byte & 0x80) == 0)
+        {
+            break;
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief  将数值变长编码写入缓冲区。
+ * @param  buffer 缓冲区指针。
+ * @param  value 要编码的数值。
+ * @return 编码后的大小。
+ */
+static uint8_t varint_write(uint8_t *buffer, uint32_t value)
+{
+    uint8_t size;
+
+    size = 0;
+    while (value >= 0x80)
+    {
+        buffer[size++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    buffer[size++] = value;
+    return size;
+}
+
+/**
+ * @brief  读取块内的一条记录。
+ * @param  block 块编号。
+ * @param  offset 块内字节位置，读取后指向下一条记录。
+ * @param  entry 记录存储结构体。
+ * @return 1：块内没有更多记录，0：读取成功。
+ */
+static uint8_t block_read_entry(uint8_t block, uint8_t *offset, struct LOG_Entry *entry)
+{
+    uint16_t addr, end;
+
+    addr = block_addr(block);
+    end = addr + LOG_BLOCK_SIZE;
+    if (*offset < LOG_DATA_START)
+    {
+        *offset = LOG_DATA_START;
+    }
+    addr += *offset;
+    if (addr >= end || EEPROM_ReadByte(addr) == 0)
+    {
+        return 1;
+    }
+    entry->Event = EEPROM_ReadByte(addr);
+    addr += 1;
+    entry->Minutes = EEPROM_ReadDWORD(block_addr(block) / 4 + 1);
+    if (entry->Minutes != 0)
+    {
+        entry->Minutes += varint_read(&addr, end);
+    }
+    else
+    {
+        varint_read(&addr, end);
+    }
+    entry->Arg = varint_read(&addr, end);
+    *offset = addr - block_addr(block);
+    return 0;
+}
+
+/**
+ * @brief  获取2000年1月1日0时起的分钟数。
+ * @param  time 时间存储结构体。
+ * @return 分钟数，0为时间无效。
+ */
+static uint32_t get_minutes(const struct RTC_Time *time)
+{
+    uint32_t hour_stamp;
+
+    hour_stamp = HIST_GetHourStamp(time);
+    if (hour_stamp == 0)
+    {
+        return 0;
+    }
+    return (hour_stamp - 1) * 60 + time->Minutes + 1;
+}
+
+/**
+ * @brief  检查记录是否为频率限制时间内的相同事件和参数。
+ * @param  entry 已有的记录。
+ * @param  event 事件编号。
+ * @param  arg 事件参数。
+ * @param  now 当前分钟数，0为时间未知。
+ * @return 1：需要限制，0：不需要限制。
+ */
+static uint8_t entry_is_recent(const struct LOG_Entry *entry, uint8_t event, uint32_t arg, uint32_t now)
+{
+    return entry->Event == event && entry->Arg == arg && now != 0 && entry->Minutes != 0 && now >= entry->Minutes && now - entry->Minutes < LOG_RATE_LIMIT_MIN;
+}
+
+/**
+ * @brief  添加一条事件记录。
+ * @param  time 当前时间，时间无效时记录为时间未知。
+ * @param  event 事件编号，范围为：1 ~ 255。
+ * @param  arg 事件参数。
+ * @return LOG_RESULT_OK：记录成功，LOG_RESULT_ERROR：写入失败，LOG_RESULT_LIMITED：相同事件刚记录过，本次不记录。
+ * @note   每次调用扫描最新块查找写入位置，块开始不到 LOG_RATE_LIMIT_MIN 分钟时继续扫描上一块检查频率限制，
+ *         事件不频繁时最多多扫描一块，不需要在RAM中保存状态。
+ */
+uint8_t LOG_Add(const struct RTC_Time *time, uint8_t event, uint32_t arg)
+{
+    uint8_t block, prev, offset, prev_offset, size, new_block;
+    uint8_t buffer[LOG_RECORD_MAX_SIZE];
+    uint16_t seq, prev_seq;
+    uint32_t now, base, prev_base, header[2];
+    struct LOG_Entry entry;
+
+    if (event == 0)
+    {
+        return LOG_RESULT_ERROR;
+    }
+    now = get_minutes(time);
+    block = find_newest(&seq);
+    new_block = 1;
+    offset = LOG_DATA_START;
+    if (block != LOG_BLOCK_COUNT)
+    {
+        base = EEPROM_ReadDWORD(block_addr(block) / 4 + 1);
+        new_block = 0;
+        offset = 0;
+        while (block_read_entry(block, &offset, &entry) == 0) /* 查找块内记录结束位置，同时检查频率限制 */
+        {
+            if (entry_is_recent(&entry, event, arg, now) != 0)
+            {
+                return LOG_RESULT_LIMITED;
+            }
+        }
+        prev = block;
+        prev_seq = seq;
+        prev_base = base;
+        while (prev_base != 0 && now >= prev_base && now - prev_base < LOG_RATE_LIMIT_MIN) /* 块开始不到限制时间，上一块末尾的记录可能仍在限制时间内 */
+        {
+            prev = (prev == 0) ? LOG_BLOCK_COUNT - 1 : prev - 1;
+            prev_seq -= 1;
+            if (prev == block || EEPROM_ReadDWORD(block_addr(prev) / 4) != (LOG_BLOCK_MARK | prev_seq))
+            {
+                break;
+            }
+            prev_offset = 0;
+            while (block_read_entry(prev, &prev_offset, &entry) == 0)
+            {
+                if (entry_is_recent(&entry, event, arg, now) != 0)
+                {
+                    return LOG_RESULT_LIMITED;
+                }
+            }
+            prev_base = EEPROM_ReadDWORD(block_addr(prev) / 4 + 1);
+        }
+        if (offset < LOG_DATA_START)
+        {
+            offset = LOG_DATA_START;
+        }
+        if ((now != 0) != (base != 0) || now < base || offset + LOG_RECORD_MAX_SIZE > LOG_BLOCK_SIZE) /* 空间不足或时间倒退，使用新块 */
+        {
+            new_block = 1;
+            block = (block + 1) % LOG_BLOCK_COUNT;
+            seq += 1;
+        }
+    }
+    else
+    {
+        block = 0;
+        seq = 1;
+    }
+
+    if (new_block != 0)
+    {
+        if (EEPROM_EraseRange(block_addr(block) / 4, block_addr(block) / 4 + LOG_BLOCK_DWORDS - 1) != 0)
+        {
+            return LOG_RESULT_ERROR;
+        }
+        base = now;
+        header[0] = LOG_BLOCK_MARK | seq;
+        header[1] = base;
+        if (EEPROM_WriteBuffer(block_addr(block) + 4, &header[1], 4) != 0 || EEPROM_WriteBuffer(block_addr(block), &header[0], 4) != 0) /* 标记最后写入 */
+        {
+            return LOG_RESULT_ERROR;
+        }
+        offset = LOG_DATA_START;
+    }
+
+    buffer[0] = event;
+    size = 1;
+    size += varint_write(buffer + size, now - base);
+    size += varint_write(buffer + size, arg);
+    if (EEPROM_WriteBuffer(block_addr(block) + offset, buffer, size) != 0)
+    {
+        return LOG_RESULT_ERROR;
+    }
+    return LOG_RESULT_OK;
+}
+
+/**
+ * @brief  按时间顺序读取下一条事件记录。
+ * @param  cursor 读取位置，首次读取前设置为0，之后由本函数更新。
+ * @param  entry 记录存储结构体。
+ * @return 1：没有更多记录，0：读取成功。
+ */
+uint8_t LOG_ReadNext(uint16_t *cursor, struct LOG_Entry *entry)
+{
+    uint8_t index, oldest, block, offset;
+    uint16_t seq;
+
+    oldest = find_newest(&seq);
+    if (oldest == LOG_BLOCK_COUNT)
+    {
+        return 1;
+    }
+    oldest = (oldest + 1) % LOG_BLOCK_COUNT;
+    index = *cursor >> 8; /* 高8位为从最旧块开始的块序号，低8位为块内位置 */
+    offset = *cursor & 0xFF;
+    while (index < LOG_BLOCK_COUNT)
+    {
+        block = (oldest + index) % LOG_BLOCK_COUNT;
+        if ((EEPROM_ReadDWORD(block_addr(block) / 4) & 0xFFFF0000) == LOG_BLOCK_MARK && block_read_entry(block, &offset, entry) == 0)
+        {
+            *cursor = ((uint16_t)index << 8) | offset;
+            return 0;
+        }
+        index += 1;
+        offset = 0;
+    }
+    *cursor = (uint16_t)index << 8;
+    return 1;
+}
+
+/**
+ * @brief  将2000年1月1日0时起的分钟数+1转换为时间。
+ * @param  minutes 分钟数+1，0为时间未知。
+ * @param  time 时间存储结构体，时间未知时月份为0。
+ */
+void LOG_MinutesToTime(uint32_t minutes, struct RTC_Time *time)
+{
+    static const uint8_t month_days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    uint32_t days;
+    uint16_t year_days;
+    uint8_t month_day;
+
+    memset(time, 0, sizeof(struct RTC_Time));
+    if (minutes == 0)
+    {
+        return;
+    }
+    minutes -= 1;
+    time->Minutes = minutes % 60;
+    time->Hours = (minutes / 60) % 24;
+    days = minutes / 1440;
+    time->Day = ((days + 5) % 7) + 1; /* 与RTC_Time相同，以1为星期一，2000年1月1日为星期六 */
+    time->Year = 0;
+    while (1)
+    {
+        year_days = ((time->Year % 4) == 0 && time->Year != 100) ? 366 : 365;
+        if (days < year_days)
+        {
+            break;
+        }
+        days -= year_days;
+        time->Year += 1;
+    }
+    time->Month = 1;
+    while (1)
+    {
+        month_day = month_days[time->Month - 1];
+        if (time->Month == 2 && (time->Year % 4) == 0 && time->Year != 100)
+        {
+            month_day += 1;
+        }
+        if (days < month_day)
+        {
+            break;
+        }
+        days -= month_day;
+        time->Month += 1;
+    }
+    time->Date = days + 1;
+}
@@ -0,0 +1,40 @@
+#ifndef _EVENTLOG_H_
+#define _EVENTLOG_H_
+
+#include "main.h"
+#include "eeprom.h"
+#include "ds3231.h"
+#include "history.h"
+
+/* 可修改 */
+#define LOG_EEPROM_ADDR_DWORD 0x140 /* 事件记录在EEPROM中的起始地址（四字节地址），占用 LOG_BLOCK_COUNT * LOG_BLOCK_DWORDS 个四字节 */
+#define LOG_BLOCK_COUNT 11          /* 记录块数量，写满后擦除最旧的块 */
+#define LOG_BLOCK_DWORDS 16         /* 每个记录块大小（四字节），包含2个四字节头部 */
+#define LOG_RATE_LIMIT_MIN 60       /* 相同事件和参数在此时间（分钟）内只记录一次 */
+/* 结束 */
+
+#define LOG_EVENT_RESET 0x01         /* 复位，参数为LP_GetResetFlags()返回的复位标志 */
+#define LOG_EVENT_SETTING_RESET 0x02 /* 设置恢复默认，参数为0：读取失败，1：手动清除全部数据 */
+#define LOG_EVENT_LOW_BATTERY 0x03   /* 低电量关机，参数为电池电压，单位为毫伏 */
+#define LOG_EVENT_I2C_RECOVER 0x04   /* I2C死锁恢复，参数为本次唤醒的恢复次数 */
+#define LOG_EVENT_EPD_TIMEOUT 0x05   /* 电子纸刷新超时，参数为本次唤醒的超时次数 */
+#define LOG_EVENT_SENSOR_FAIL 0x06   /* 温湿度传感器读取失败 */
+#define LOG_EVENT_ALARM 0x07         /* 钟声响铃，参数为0：停止，1：稍后提醒，2：无人处理超时 */
+#define LOG_EVENT_I2C_FAIL 0x08      /* I2C设备传输失败，参数为设备地址 << 8 | 最后一次失败的结果（I2C_RESULT_...） */
+
+#define LOG_RESULT_OK 0
+#define LOG_RESULT_ERROR 1
+#define LOG_RESULT_LIMITED 2
+
+struct LOG_Entry
+{
+    uint32_t Minutes; /* 2000年1月1日0时起的分钟数+1，0为时间未知 */
+    uint8_t Event;
+    uint32_t Arg;
+};
+
+uint8_t LOG_Add(const struct RTC_Time *time, uint8_t event, uint32_t arg);
+uint8_t LOG_ReadNext(uint16_t *cursor, struct LOG_Entry *entry);
+void LOG_MinutesToTime(uint32_t minutes, struct RTC_Time *time);
+
+#endif
@@ -0,0 +1,97 @@
+#include "festival.h"
+#include "festival_table.h"
+
+/*
+ * 每类节日按月存放一个32位位图：公历和农历为日期，0位表示农历该月最后一天；星期节日为 (第几个 - 1) * 7 + 星期几 - 1；
+ * 节气节日只有一个位图，位为节气序号。
+ * 位图命中后，节日序号 = 该月的起始序号 + 位图中更低位置1的个数，查找耗时固定，不需要逐项比较。
+ */
+
+static uint8_t CountBits(uint32_t data)
+{
+    data = data - ((data >> 1) & 0x55555555);
+    data = (data & 0x33333333) + ((data >> 2) & 0x33333333);
+    data = (data + (data >> 4)) & 0x0F0F0F0F;
+    return (data * 0x01010101) >> 24;
+}
+
+static uint8_t MapLookup(const uint32_t *map, const uint8_t *base, uint8_t month, uint8_t bit)
+{
+    uint32_t data;
+
+    if (bit > 31)
+    {
+        return FEST_NONE;
+    }
+    data = map[month - 1];
+    if ((data & (1UL << bit)) == 0)
+    {
+        return FEST_NONE;
+    }
+    return base[month - 1] + CountBits(data & ((1UL << bit) - 1));
+}
+
+/**
+ * @brief  获取当天的节日。
+ * @param  solar_month 公历月份。
+ * @param  solar_date 公历日期。
+ * @param  day 星期，1 ~ 7，7为星期日，其他值时不查找星期节日。
+ * @param  lunar 当天的农历日期。
+ * @param  term 当天的节气，TERM_NONE为不是节气。
+ * @return 节日序号，用于FEST_GetName()，FEST_NONE：没有节日。
+ * @note   同一天有多个节日时按农历、节气、公历、星期的顺序返回第一个。
+ */
+uint8_t FEST_GetFestival(uint8_t solar_month, uint8_t solar_date, uint8_t day, const struct Lunar_Date *lunar, uint8_t term)
+{
+    uint8_t festival;
+
+    if (solar_month < 1 || solar_month > 12 || solar_date < 1 || solar_date > 31)
+    {
+        return FEST_NONE;
+    }
+    if (lunar->Month != 0 && lunar->IsLeap == 0)
+    {
+        festival = MapLookup(fest_lunar_map, fest_lunar_base, lunar->Month, lunar->Date);
+        if (festival == FEST_NONE && lunar->Date == LUNAR_GetMonthDays(lunar))
+        {
+            festival = MapLookup(fest_lunar_map, fest_lunar_base, lunar->Month, 0);
+        }
+        if (festival != FEST_NONE)
+        {
+            return festival;
+        }
+    }
+    if (term != TERM_NONE)
+    {
+        festival = MapLookup(fest_term_map, fest_term_base, 1, term);
+        if (festival != FEST_NONE)
+        {
+            return festival;
+        }
+    }
+    festival = MapLookup(fest_solar_map, fest_solar_base, solar_month, solar_date);
+    if (festival != FEST_NONE)
+    {
+        return festival;
+    }
+    if (day >= 1 && day <= 7)
+    {
+        /* (solar_date - 1) / 7 在0 ~ 30范围内等于 (solar_date - 1) * 37 >> 8 */
+        festival = MapLookup(fest_week_map, fest_week_base, solar_month, (((solar_date - 1) * 37) >> 8) * 7 + day - 1);
+    }
+    return festival;
+}
+
+/**
+ * @brief  获取节日名称。
+ * @param  festival 节日序号。
+ * @return 节日名称，序号无效时为空字符串。
+ */
+const char *FEST_GetName(uint8_t festival)
+{
+    if (festival >= FEST_COUNT)
+    {
+        return "";
+    }
+    return fest_name[festival];
+}
@@ -0,0 +1,15 @@
+#ifndef _FESTIVAL_H_
+#define _FESTIVAL_H_
+
+#include "main.h"
+#include "lunar.h"
+#include "solarterm.h"
+
+/* 节日规则在 资源/节日数据生成/节日规则.txt 中修改，由脚本生成festival_table.h */
+
+#define FEST_NONE 0xFF
+
+uint8_t FEST_GetFestival(uint8_t solar_month, uint8_t solar_date, uint8_t day, const struct Lunar_Date *lunar, uint8_t term);
+const char *FEST_GetName(uint8_t festival);
+
+#endif
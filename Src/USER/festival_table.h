@@ -0,0 +1,33 @@
+/* 此文件由 资源/节日数据生成/节日数据生成.py 根据 节日规则.txt 生成，不要手动修改 */
+#ifndef _FESTIVAL_TABLE_H_
+#define _FESTIVAL_TABLE_H_
+
+#define FEST_COUNT 19
+
+const static uint32_t fest_solar_map[12] = {
+    0x00000002, 0x00000000, 0x00000000, 0x00000000, 0x00000002, 0x00000002,
+    0x00000000, 0x00000000, 0x00000400, 0x00000002, 0x00000000, 0x00000000};
+const static uint8_t fest_solar_base[12] = {
+    0, 1, 1, 1, 1, 2, 3, 3, 3, 4, 5, 5};
+
+const static uint32_t fest_lunar_map[12] = {
+    0x00008002, 0x00000004, 0x00000000, 0x00000000, 0x00000020, 0x00000000,
+    0x00008080, 0x00008000, 0x00000200, 0x00000000, 0x00000000, 0x00800101};
+const static uint8_t fest_lunar_base[12] = {
+    5, 7, 8, 8, 8, 9, 9, 11, 12, 13, 13, 13};
+
+const static uint32_t fest_week_map[12] = {
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00002000, 0x00100000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000};
+const static uint8_t fest_week_base[12] = {
+    16, 16, 16, 16, 16, 17, 18, 18, 18, 18, 18, 18};
+
+const static uint32_t fest_term_map[1] = {0x00000040};
+const static uint8_t fest_term_base[1] = {18};
+
+const static char fest_name[19][10] = {
+    "元旦", "劳动节", "儿童节", "教师节", "国庆节", "春节", "元宵节", "龙抬头",
+    "端午节", "七夕", "中元节", "中秋节", "重阳节", "除夕", "腊八节", "小年",
+    "母亲节", "父亲节", "清明节"};
+
+#endif
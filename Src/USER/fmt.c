@@ -0,0 +1,248 @@
+#include "fmt.h"
+
+/*
+ * 代替snprintf的数值和字符串格式化，输出与对应的printf格式相同：
+ * FMT_Uint/FMT_Int为"%*u"和"%*d"，FMT_Fixed为"%*.*f"（数值已放大10^decimals倍），FMT_Hex为"%0*X"。
+ * Cortex-M0+没有除法指令，十进制转换用减去10的幂代替除法，每一位最多减9次。
+ */
+#define FMT_DIGITS_MAX 10 /* uint32_t最多10位十进制数 */
+
+const static uint32_t fmt_pow10[FMT_DIGITS_MAX] = {
+    1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL, 1000UL, 100UL, 10UL, 1UL};
+
+const static float fmt_scale[4] = {1.0f, 10.0f, 100.0f, 1000.0f};
+
+const static char fmt_hex[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+
+/* 转换为十进制数字，高位在前，不足min_count位时前面补0，返回位数 */
+static uint8_t ToDigits(char *digits, uint32_t value, uint8_t min_count)
+{
+    uint8_t i, count;
+    char digit;
+
+    i = 0;
+    while (i < FMT_DIGITS_MAX - 1 && value < fmt_pow10[i] && FMT_DIGITS_MAX - i > min_count) /* 跳过前面的0 */
+    {
+        i++;
+    }
+    count = 0;
+    for (; i < FMT_DIGITS_MAX; i++)
+    {
+        digit = '0';
+        while (value >= fmt_pow10[i])
+        {
+            value -= fmt_pow10[i];
+            digit++;
+        }
+        digits[count++] = digit;
+    }
+    return count;
+}
+
+/* 按宽度和标志输出符号和数字，decimals不为0时在最后decimals位数字前插入小数点 */
+static void PutNumber(struct FMT_Buffer *buf, char sign, const char *digits, uint8_t count, uint8_t decimals, uint8_t width, uint8_t flags)
+{
+    uint8_t i, length;
+
+    length = count + (sign != '\0') + (decimals != 0);
+    if ((flags & FMT_LEFT) == 0 && (flags & FMT_ZERO) == 0)
+    {
+        for (; length < width; length++)
+        {
+            FMT_Char(buf, ' ');
+        }
+    }
+    if (sign != '\0')
+    {
+        FMT_Char(buf, sign);
+    }
+    if ((flags & FMT_LEFT) == 0)
+    {
+        for (; length < width; length++)
+        {
+            FMT_Char(buf, '0');
+        }
+    }
+    for (i = 0; i < count; i++)
+    {
+        if (decimals != 0 && i == count - decimals)
+        {
+            FMT_Char(buf, '.');
+        }
+        FMT_Char(buf, digits[i]);
+    }
+    for (; length < width; length++)
+    {
+        FMT_Char(buf, ' ');
+    }
+}
+
+/**
+ * @brief  初始化缓冲区，写入空字符串。
+ * @param  buf 缓冲区。
+ * @param  str 调用者提供的字符串空间。
+ * @param  size 字符串空间大小，不能为0。
+ */
+void FMT_Init(struct FMT_Buffer *buf, char *str, uint16_t size)
+{
+    buf->Str = str;
+    buf->Size = size;
+    buf->Length = 0;
+    str[0] = '\0';
+}
+
+void FMT_Char(struct FMT_Buffer *buf, char c)
+{
+    if (buf->Length + 1 < buf->Size)
+    {
+        buf->Str[buf->Length] = c;
+        buf->Length += 1;
+        buf->Str[buf->Length] = '\0';
+    }
+}
+
+/**
+ * @brief  追加UTF8字符串。
+ * @param  buf 缓冲区。
+ * @param  str 要追加的字符串。
+ * @note   空间不足时在完整的字符处截断，不会留下半个汉字。
+ */
+void FMT_String(struct FMT_Buffer *buf, const char *str)
+{
+    uint8_t n;
+
+    while (*str != '\0')
+    {
+        if ((*str & 0xE0) == 0xC0)
+        {
+            n = 2;
+        }
+        else if ((*str & 0xF0) == 0xE0)
+        {
+            n = 3;
+        }
+        else if ((*str & 0xF8) == 0xF0)
+        {
+            n = 4;
+        }
+        else
+        {
+            n = 1;
+        }
+        if (buf->Length + n >= buf->Size)
+        {
+            break;
+        }
+        while (n != 0 && *str != '\0')
+        {
+            buf->Str[buf->Length++] = *str++;
+            n--;
+        }
+    }
+    buf->Str[buf->Length] = '\0';
+}
+
+/**
+ * @brief  在末尾补空格直到长度为length，用于左对齐的字符串列（"%-*s"）。
+ * @param  buf 缓冲区。
+ * @param  length 补齐后的长度（字节）。
+ */
+void FMT_Pad(struct FMT_Buffer *buf, uint16_t length)
+{
+    while (buf->Length < length && buf->Length + 1 < buf->Size)
+    {
+        FMT_Char(buf, ' ');
+    }
+}
+
+/**
+ * @brief  追加无符号十进制数，与"%*u"相同。
+ * @param  buf 缓冲区。
+ * @param  value 数值。
+ * @param  width 最小宽度，0为不限制。
+ * @param  flags FMT_ZERO、FMT_LEFT和FMT_SIGN的组合。
+ */
+void FMT_Uint(struct FMT_Buffer *buf, uint32_t value, uint8_t width, uint8_t flags)
+{
+    char digits[FMT_DIGITS_MAX];
+
+    PutNumber(buf, (flags & FMT_SIGN) ? '+' : '\0', digits, ToDigits(digits, value, 1), 0, width, flags);
+}
+
+/**
+ * @brief  追加有符号十进制数，与"%*d"相同。
+ * @param  buf 缓冲区。
+ * @param  value 数值。
+ * @param  width 最小宽度（包含符号），0为不限制。
+ * @param  flags FMT_ZERO、FMT_LEFT和FMT_SIGN的组合。
+ */
+void FMT_Int(struct FMT_Buffer *buf, int32_t value, uint8_t width, uint8_t flags)
+{
+    FMT_Fixed(buf, value, 0, width, flags);
+}
+
+/**
+ * @brief  追加定点小数，与"%*.*f"相同。
+ * @param  buf 缓冲区。
+ * @param  value 放大10^decimals倍后的整数，例如decimals为2时，-105表示-1.05。
+ * @param  decimals 小数位数，0 ~ 9，0时没有小数点。
+ * @param  width 最小宽度（包含符号和小数点），0为不限制。
+ * @param  flags FMT_ZERO、FMT_LEFT和FMT_SIGN的组合。
+ * @note   -0.5之类整数部分为0的负数也会显示负号。
+ */
+void FMT_Fixed(struct FMT_Buffer *buf, int32_t value, uint8_t decimals, uint8_t width, uint8_t flags)
+{
+    char digits[FMT_DIGITS_MAX];
+    char sign;
+    uint32_t abs_value;
+
+    if (value < 0)
+    {
+        sign = '-';
+        abs_value = 0 - (uint32_t)value;
+    }
+    else
+    {
+        sign = (flags & FMT_SIGN) ? '+' : '\0';
+        abs_value = value;
+    }
+    PutNumber(buf, sign, digits, ToDigits(digits, abs_value, decimals + 1), decimals, width, flags);
+}
+
+/**
+ * @brief  追加大写十六进制数，不带"0x"前缀，与"%0*X"相同。
+ * @param  buf 缓冲区。
+ * @param  value 数值。
+ * @param  digits 最少位数，不足时前面补0。
+ */
+void FMT_Hex(struct FMT_Buffer *buf, uint32_t value, uint8_t digits)
+{
+    uint8_t count;
+
+    count = 1;
+    while (count < 8 && (value >> (count * 4)) != 0)
+    {
+        count++;
+    }
+    for (; digits > count; digits--)
+    {
+        FMT_Char(buf, '0');
+    }
+    while (count != 0)
+    {
+        count--;
+        FMT_Char(buf, fmt_hex[(value >> (count * 4)) & 0x0F]);
+    }
+}
+
+/**
+ * @brief  将浮点数放大10^decimals倍并四舍五入（远离0），用于FMT_Fixed()。
+ * @param  value 浮点数。
+ * @param  decimals 小数位数，0 ~ 3。
+ * @return 放大后的整数。
+ */
+int32_t FMT_Scale(float value, uint8_t decimals)
+{
+    value *= fmt_scale[decimals];
+    return (int32_t)(value < 0 ? value - 0.5f : value + 0.5f);
+}
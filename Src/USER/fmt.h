@@ -0,0 +1,29 @@
+#ifndef _FMT_H_
+#define _FMT_H_
+
+#include "main.h"
+
+/* 格式标志，与printf的标志含义相同 */
+#define FMT_ZERO 0x01 /* 宽度不足时在数字前补0，"0" */
+#define FMT_LEFT 0x02 /* 左对齐，宽度不足时在右侧补空格，"-"，优先于FMT_ZERO */
+#define FMT_SIGN 0x04 /* 非负数也显示正号，"+" */
+
+/* 写入调用者提供的缓冲区，超出大小的内容被丢弃，字符串总是以'\0'结尾 */
+struct FMT_Buffer
+{
+    char *Str;
+    uint16_t Size;   /* 缓冲区大小，包含结尾的'\0' */
+    uint16_t Length; /* 已写入的长度，不包含结尾的'\0' */
+};
+
+void FMT_Init(struct FMT_Buffer *buf, char *str, uint16_t size);
+void FMT_Char(struct FMT_Buffer *buf, char c);
+void FMT_String(struct FMT_Buffer *buf, const char *str);
+void FMT_Pad(struct FMT_Buffer *buf, uint16_t length);
+void FMT_Uint(struct FMT_Buffer *buf, uint32_t value, uint8_t width, uint8_t flags);
+void FMT_Int(struct FMT_Buffer *buf, int32_t value, uint8_t width, uint8_t flags);
+void FMT_Fixed(struct FMT_Buffer *buf, int32_t value, uint8_t decimals, uint8_t width, uint8_t flags);
+void FMT_Hex(struct FMT_Buffer *buf, uint32_t value, uint8_t digits);
+int32_t FMT_Scale(float value, uint8_t decimals);
+
+#endif
@@ -0,0 +1,171 @@
+#include "frame.h"
+
+#define FRAME_STATE_SOF 0
+#define FRAME_STATE_TYPE 1
+#define FRAME_STATE_LENGTH 2
+#define FRAME_STATE_DATA 3
+#define FRAME_STATE_CRC_L 4
+#define FRAME_STATE_CRC_H 5
+
+static const struct FRAME_Command *frame_commands;
+static uint8_t frame_count;
+static uint8_t frame_state;
+static uint8_t frame_type;
+static uint8_t frame_length;
+static uint8_t frame_index;
+static uint16_t frame_crc;
+static uint8_t frame_data[FRAME_PAYLOAD_MAX];
+
+/* 查找并执行请求，发送回复 */
+static void execute_frame(void)
+{
+    uint8_t i, result, error[2];
+
+    for (i = 0; i < frame_count; i++)
+    {
+        if (frame_commands[i].type == frame_type)
+        {
+            break;
+        }
+    }
+    result = (i < frame_count) ? frame_commands[i].handler(frame_data, &frame_length) : FRAME_ERROR_TYPE;
+    if (result == FRAME_OK)
+    {
+        FRAME_Send(frame_type | FRAME_TYPE_REPLY, frame_data, frame_length);
+    }
+    else
+    {
+        error[0] = frame_type;
+        error[1] = result;
+        FRAME_Send(FRAME_TYPE_ERROR, error, 2);
+    }
+}
+
+/**
+ * @brief  设置请求处理表并丢弃接收缓冲区中的数据。
+ * @param  commands 请求处理表。
+ * @param  count 数量。
+ */
+void FRAME_Init(const struct FRAME_Command *commands, uint8_t count)
+{
+    uint8_t rx_data;
+
+    frame_commands = commands;
+    frame_count = count;
+    frame_state = FRAME_STATE_SOF;
+    while (SERIAL_ReadByte(&rx_data) == 0)
+    {
+    }
+    SERIAL_GetOverflow();
+}
+
+/**
+ * @brief  处理接收缓冲区中的数据，收到完整的帧时执行请求并回复，不等待。
+ * @return FRAME_POLL_*。
+ */
+uint8_t FRAME_Poll(void)
+{
+    uint8_t rx_data, status;
+
+    status = FRAME_POLL_IDLE;
+    if (SERIAL_GetOverflow() != 0) /* 丢失了数据，等待下一帧 */
+    {
+        frame_state = FRAME_STATE_SOF;
+        status = FRAME_POLL_ACTIVE;
+    }
+    while (SERIAL_ReadByte(&rx_data) == 0)
+    {
+        status = FRAME_POLL_ACTIVE;
+        switch (frame_state)
+        {
+        case FRAME_STATE_SOF: /* 帧头之前的数据丢弃 */
+            if (rx_data == FRAME_SOF)
+            {
+                frame_crc = CRC16_INIT;
+                frame_state = FRAME_STATE_TYPE;
+            }
+            break;
+        case FRAME_STATE_TYPE:
+            frame_type = rx_data;
+            frame_crc = CRC16_Update(frame_crc, rx_data);
+            frame_state = FRAME_STATE_LENGTH;
+            break;
+        case FRAME_STATE_LENGTH:
+            frame_length = rx_data;
+            frame_index = 0;
+            frame_crc = CRC16_Update(frame_crc, rx_data);
+            if (frame_length > FRAME_PAYLOAD_MAX)
+            {
+                frame_state = FRAME_STATE_SOF;
+            }
+            else
+            {
+                frame_state = (frame_length != 0) ? FRAME_STATE_DATA : FRAME_STATE_CRC_L;
+            }
+            break;
+        case FRAME_STATE_DATA:
+            frame_data[frame_index++] = rx_data;
+            frame_crc = CRC16_Update(frame_crc, rx_data);
+            if (frame_index == frame_length)
+            {
+                frame_state = FRAME_STATE_CRC_L;
+            }
+            break;
+        case FRAME_STATE_CRC_L:
+            frame_crc ^= rx_data;
+            frame_state = FRAME_STATE_CRC_H;
+            break;
+        default:
+            frame_state = FRAME_STATE_SOF;
+            frame_crc ^= (uint16_t)rx_data << 8;
+            if (frame_crc != 0)
+            {
+                frame_data[0] = frame_type;
+                frame_data[1] = FRAME_ERROR_CRC;
+                FRAME_Send(FRAME_TYPE_ERROR, frame_data, 2);
+            }
+            else if (frame_type == FRAME_TYPE_EXIT)
+            {
+                FRAME_Send(FRAME_TYPE_EXIT | FRAME_TYPE_REPLY, frame_data, 0);
+                return FRAME_POLL_EXIT;
+            }
+            else
+            {
+                execute_frame();
+            }
+            break;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief  丢弃接收了一部分的帧，用于一段时间没有收到数据时。
+ */
+void FRAME_Resync(void)
+{
+    frame_state = FRAME_STATE_SOF;
+}
+
+/**
+ * @brief  发送一帧。
+ * @param  type 类型。
+ * @param  data 数据。
+ * @param  length 数据长度，不超过FRAME_PAYLOAD_MAX。
+ */
+void FRAME_Send(uint8_t type, const uint8_t *data, uint8_t length)
+{
+    uint8_t header[3], crc[2];
+    uint16_t crc16;
+
+    header[0] = FRAME_SOF;
+    header[1] = type;
+    header[2] = length;
+    crc16 = CRC16_Calc(CRC16_INIT, header + 1, 2);
+    crc16 = CRC16_Calc(crc16, data, length);
+    crc[0] = crc16 & 0xFF;
+    crc[1] = crc16 >> 8;
+    SERIAL_SendData(header, 3);
+    SERIAL_SendData(data, length);
+    SERIAL_SendData(crc, 2);
+}
@@ -0,0 +1,44 @@
+#ifndef _FRAME_H_
+#define _FRAME_H_
+
+#include "main.h"
+#include "serial.h"
+#include "crc16.h"
+
+/* 可修改 */
+#define FRAME_PAYLOAD_MAX 130 /* 数据最大长度，读取时为2字节地址加128字节数据 */
+/* 结束 */
+
+/*
+ * 帧格式：FRAME_SOF | 类型 | 数据长度N | 数据[N] | CRC低字节 | CRC高字节
+ * CRC为CRC-16/CCITT-FALSE（多项式0x1021，初值0xFFFF），覆盖类型、长度和数据，多字节数值均为小端序。
+ * 回复的类型为请求类型或上FRAME_TYPE_REPLY，失败时回复FRAME_TYPE_ERROR，数据为请求类型和FRAME_ERROR_*。
+ */
+#define FRAME_SOF 0xA5
+#define FRAME_TYPE_EXIT 0x7E  /* 退出二进制模式，回复后返回 */
+#define FRAME_TYPE_ERROR 0x7F /* 错误回复 */
+#define FRAME_TYPE_REPLY 0x80
+
+#define FRAME_OK 0
+#define FRAME_ERROR_TYPE 1   /* 未知的类型 */
+#define FRAME_ERROR_LENGTH 2 /* 数据长度错误 */
+#define FRAME_ERROR_RANGE 3  /* 地址或数量超出范围 */
+#define FRAME_ERROR_IO 4     /* 读写失败 */
+#define FRAME_ERROR_CRC 5    /* CRC错误，类型为收到的类型 */
+
+#define FRAME_POLL_IDLE 0   /* 没有收到数据 */
+#define FRAME_POLL_ACTIVE 1 /* 收到了数据，可能已处理请求 */
+#define FRAME_POLL_EXIT 2   /* 收到了FRAME_TYPE_EXIT */
+
+struct FRAME_Command
+{
+    uint8_t type;
+    uint8_t (*handler)(uint8_t *data, uint8_t *length); /* data为请求数据，处理后改为回复数据，空间为FRAME_PAYLOAD_MAX，返回FRAME_OK或FRAME_ERROR_* */
+};
+
+void FRAME_Init(const struct FRAME_Command *commands, uint8_t count);
+uint8_t FRAME_Poll(void);
+void FRAME_Resync(void);
+void FRAME_Send(uint8_t type, const uint8_t *data, uint8_t length);
+
+#endif
@@ -1,19 +1,38 @@
 ﻿#include "func.h"
 
-#include <stdio.h>
+#include <stddef.h>
 #include <string.h>
-#include <stdlib.h>
-#include <math.h>
 
-const struct Func_Setting DefaultSetting = {0x00, 1, 3, 1.50, 1.20, 0.00, 0.00, 0, 0}; /* 设置未完成，蜂鸣器开关，蜂鸣器音量，警告电压，关机电压，温度传感器偏移，湿度传感器偏移，内置参考电压偏移，实时时钟老化偏移 */
+const struct Func_Setting DefaultSetting = {0x00, 1, 3, 1.50, 1.20, 0.00, 0.00, 0, 0, 0, {{0, 0, 0}}}; /* 设置未完成，蜂鸣器开关，蜂鸣器音量，警告电压，关机电压，温度传感器偏移，湿度传感器偏移，内置参考电压偏移，实时时钟老化偏移，主界面表盘，钟声（全部关闭） */
 const struct RTC_Time DefaultTime = {0, 0, 12, 4, 1, 10, 20, 0, 0};                    /* 2020年10月1日，星期4，12:00:00，Is_12hr = 0，PM = 0  */
 
+/* 提示音，{频率, 音量, 时间}，BUZZER_VOL_DEFAULT为设置中的音量 */
+const static struct BUZZER_Note Beep_FastNotes[] = {{4000, BUZZER_VOL_DEFAULT, 5}, {0, 0, 0}};
+const static struct BUZZER_Note Beep_ButtonNotes[] = {{4000, BUZZER_VOL_DEFAULT, 20}, {0, 0, 0}};
+const static struct BUZZER_Note Beep_OKNotes[] = {{1000, BUZZER_VOL_DEFAULT, 40}, {4000, BUZZER_VOL_DEFAULT, 40}, {0, 0, 0}};
+const static struct BUZZER_Note Beep_LongNotes[] = {{4000, BUZZER_VOL_DEFAULT, 500}, {0, 0, 0}};
+const static struct BUZZER_Note Beep_ErrorNotes[] = {{1000, BUZZER_VOL_DEFAULT, 500}, {0, BUZZER_VOL_DEFAULT, 500}, {0, 0, 0}};
+const static struct BUZZER_Note Beep_FullInitNotes[] = {
+    {4000, BUZZER_VOL_DEFAULT, 50}, {0, BUZZER_VOL_DEFAULT, 50},
+    {4000, BUZZER_VOL_DEFAULT, 50}, {0, BUZZER_VOL_DEFAULT, 50},
+    {4000, BUZZER_VOL_DEFAULT, 50}, {0, BUZZER_VOL_DEFAULT, 1000},
+    {0, 0, 0}};
+
+/* 钟声不使用设置中的音量，也不受蜂鸣器开关影响 */
+const static struct BUZZER_Note Alarm_Notes[] = {
+    {4000, ALARM_VOLUME, 100}, {0, ALARM_VOLUME, 100},
+    {4000, ALARM_VOLUME, 100}, {0, ALARM_VOLUME, 100},
+    {4000, ALARM_VOLUME, 100}, {0, ALARM_VOLUME, 100},
+    {4000, ALARM_VOLUME, 100}, {0, ALARM_VOLUME, 500},
+    {0, 0, 0}};
+
 static uint8_t ResetInfo;
 static struct RTC_Time Time;
 static struct Lunar_Date Lunar;
 static struct TH_Value Sensor;
 static struct Func_Setting Setting;
 static char String[256];
+static uint8_t EPD_TimeoutCount; /* 本次唤醒中主界面刷新超时的次数，RAM在待机模式下不保持 */
 
 /* 软延时 */
 static void Delay_100ns(volatile uint16_t nsX100);
@@ -21,33 +40,31 @@ static void Delay_100ns(volatile uint16_t nsX100);
 /* 菜单相关 */
 static void UpdateHomeDisplay(void);
 static void FullInit(void);
+static void Alarm_Ring(void);
+static void Alarm_Update(uint8_t snooze_min);
 static void Menu_DrawMenuFrame(char *title, uint8_t button_style);
 static void Menu_DrawSubmenuSaveSelect(uint8_t select);
 static void Menu_MainMenu(void);
 static void Menu_Guide(void);
 static void Menu_SetTime(void);
-static void Menu_SetBuzzer(void);
-static void Menu_SetBattery(void);
-static void Menu_SetSensor(void);
+static void Menu_SetAlarm(void);
 static void Menu_SetVrefint(void);
-static void Menu_SetRTCAging(void);
 static void Menu_Info(void);
 static void Menu_ResetAll(void);
 static void Menu_SetHWVer(void);
-static void EPD_DrawBattery(uint16_t x, uint8_t y_x8, float max_voltage, float min_voltage, float voltage);
+static void Menu_ClearScreen(void);
+static void EPD_DrawBattery(uint16_t x, uint8_t y_x8, uint8_t percent, uint8_t warn);
 
 /* 设置保存 */
 static void SaveSetting(const struct Func_Setting *setting);
 static void ReadSetting(struct Func_Setting *setting);
+static void ApplySetting(const struct Func_Setting *setting);
 
-/* 按键消抖读取 */
+/* 按键消抖读取，界面中使用button.c的按键事件 */
 static uint8_t BTN_ReadUP(void);
-static uint8_t BTN_ReadUPFast(void);
 static uint8_t BTN_ReadDOWN(void);
-static uint8_t BTN_ReadSET(void);
 static void BTN_WaitSET(void);
-static void BTN_WaitAll(void);
-static uint8_t BTN_ModifySingleDigit(uint8_t *number, uint8_t modify_digit, uint8_t max_val, uint8_t min_val);
+static void BTN_WaitPress(uint8_t key);
 
 /* 蜂鸣器控制 */
 static void BEEP_Fast(void);
@@ -59,6 +76,7 @@ static void Power_EnableGDEH029A1(void);
 static void Power_Enable_SHT30_I2C(void);
 static uint8_t Power_EnableADC(void);
 static void Power_EnableBUZZER(void);
+static void Power_EnableUSART(void);
 static void Power_DisableGDEH029A1(void);
 static void Power_Disable_I2C_SHT30(void);
 static uint8_t Power_DisableADC(void);
@@ -69,6 +87,15 @@ static void Power_DisableUSART(void);
 static void DumpRTCReg(void);
 static void DumpEEPROM(void);
 static void DumpBKPR(void);
+static void DumpHistory(void);
+static void DumpBattery(void);
+static void DumpEventLog(void);
+static void DumpI2C(void);
+
+/* 串口命令 */
+static uint8_t Console_Detect(void);
+static void Console_Session(uint8_t (*poll)(void), void (*resync)(void));
+static void Console_Run(void);
 
 /**
  * @brief  延时100ns的倍数（不准确，只是大概）。
@@ -88,6 +115,7 @@ static void Delay_100ns(volatile uint16_t nsX100)
 void Init(void) /* 系统复位后首先进入此函数并执行一次 */
 {
     ResetInfo = LP_GetResetInfo(); /* 获取复位信息并保存 */
+    BTN_Init();                    /* 按键外部中断，唤醒时按住的按键不产生事件 */
 
     Power_Enable_SHT30_I2C(); /* 默认打开SHT30和I2C电源 */
     Power_EnableADC();        /* 默认打开ADC电源 */
@@ -104,24 +132,24 @@ void Init(void) /* 系统复位后首先进入此函数并执行一次 */
 
     /* 读取保存的设置，如果没有则使用默认设置代替 */
     ReadSetting(&Setting);
-
-    /* 设置电池和传感器偏移量 */
-    TH_SetTemperatureOffset(Setting.sensor_temp_offset);
-    TH_SetHumidityOffset(Setting.sensor_rh_offset);
-    ADC_SetVrefintOffset(Setting.vrefint_offset);
-    if (RTC_GetAging() != Setting.rtc_aging_offset)
-    {
-        RTC_ModifyAging(Setting.rtc_aging_offset);
-    }
+    ApplySetting(&Setting);
 }
 
 void Loop(void) /* 在Init()执行完成后循环执行，这里只执行一次就进入Standby模式 */
 {
+    uint8_t button_wake = 0, console;
+
     switch (ResetInfo)
     {
     case LP_RESET_POWERON:                                                    /* 安装电池或按下复位按键 */
     case LP_RESET_NORMALRESET:                                                /* 安装电池或按下复位按键 */
         BKPR_ResetAll();                                                      /* 复位备份寄存器 */
+        RTC_GetTime(&Time);                                                   /* 记录复位事件 */
+        LOG_Add(&Time, LOG_EVENT_RESET, LP_GetResetFlags());
+        if (ResetInfo == LP_RESET_POWERON)                                    /* 安装了新电池，重新估算剩余天数 */
+        {
+            BAT_ResetEstimate();
+        }
         if (RTC_GetOSF() != 0 || Setting.available != SETTING_AVALIABLE_FLAG) /* 根据RTC的振荡器停止标志和设定完成标志决定是否显示欢迎界面 */
         {
             Power_EnableGDEH029A1();
@@ -134,23 +162,50 @@ void Loop(void) /* 在Init()执行完成后循环执行，这里只执行一次
             Setting.available = SETTING_AVALIABLE_FLAG; /* 设置完成以后标记设置已完成并保存 */
             SaveSetting(&Setting);                      /* 设置完成以后标记设置已完成并保存 */
         }
+        Alarm_Update(0); /* 复位后重新设置下一个钟声 */
         break;
-    case LP_RESET_WKUPSTANDBY:                                               /* 由“设置”按钮或RTC闹钟从Standby模式唤醒 */
-        if (RTC_GetA2F() != 0 || (BTN_ReadUP() != 0 && BTN_ReadDOWN() == 0)) /* 同时按下“菜单”和“上”按钮立刻更新显示 */
+    case LP_RESET_WKUPSTANDBY: /* 由“设置”按钮或RTC闹钟从Standby模式唤醒 */
+        if (RTC_GetA1F() != 0) /* 钟声时间到 */
+        {
+            Alarm_Ring();
+        }
+        else if (RTC_GetA2F() != 0 || (BTN_ReadUP() != 0 && BTN_ReadDOWN() == 0)) /* 同时按下“菜单”和“上”按钮立刻更新显示 */
         {
             RTC_ClearA2F(); /* 清除RTC闹钟中断 */
         }
         else /* 单独按下菜单键则显示主菜单 */
         {
+            button_wake = 1;
             Power_EnableGDEH029A1();
             Menu_MainMenu();
         }
         break;
     }
 
+    console = Console_Detect(); /* 连接了串口适配器时在刷新显示期间打开接收，收到数据或由“设置”键唤醒才进入串口命令 */
+    if (console != 0)
+    {
+        Power_EnableUSART();
+    }
+
     Power_EnableGDEH029A1();
 
     UpdateHomeDisplay(); /* 更新主界面显示内容 */
+    if (console != 0)
+    {
+        if (button_wake != 0 || SERIAL_GetRXCount() != 0)
+        {
+            Console_Run();
+            UpdateHomeDisplay(); /* 串口命令可能修改了时间或设置 */
+        }
+        SERIAL_DisableRX();
+        Power_DisableUSART();
+    }
+    while (RTC_GetA1F() != 0) /* 菜单或刷新期间钟声时间到，不处理的话中断引脚保持有效，无法再唤醒 */
+    {
+        Alarm_Ring();
+        UpdateHomeDisplay();
+    }
 
     Power_DisableGDEH029A1(); /* 关闭电源，准备在“设置”按钮释放以后进入Standby模式 */
     Power_Disable_I2C_SHT30();
@@ -170,45 +225,443 @@ void Loop(void) /* 在Init()执行完成后循环执行，这里只执行一次
 
 /* ==================== 主要功能 ==================== */
 
+/*
+ * 主界面由const布局表描述：静态线条和若干控件，每个控件有固定的窗口，控件内容只绘制在窗口内，
+ * 单独重绘一个控件时先清除它的窗口即可，窗口也就是该控件的刷新区域。
+ * 12/24小时制的位置差异也放在表中：控件带有显示条件，由当前的时间格式决定是否绘制。
+ * 可选的表盘登记在Home_Faces中，每个表盘声明需要的数据，唤醒时只读取当前表盘显示的数据。
+ */
+#define HOME_WIDGET_DATE 0        /* 公历日期和星期 */
+#define HOME_WIDGET_TIME 1        /* 时:分 */
+#define HOME_WIDGET_AMPM 2        /* 上午在窗口顶部，下午在窗口底部 */
+#define HOME_WIDGET_TEMP 3        /* 温度 */
+#define HOME_WIDGET_RH 4          /* 湿度 */
+#define HOME_WIDGET_BATTERY 5     /* 电池图标 */
+#define HOME_WIDGET_LUNAR 6       /* 农历日期，节日或节气当天显示名称 */
+#define HOME_WIDGET_INFO 7        /* 右下角信息，由HOME_INFO_STYLE决定 */
+#define HOME_WIDGET_BIGTIME 8     /* 2倍大小的时:分 */
+#define HOME_WIDGET_CLOCK 9       /* 月/日、星期和时间 */
+#define HOME_WIDGET_TEMP_LARGE 10 /* 2倍大小的温度 */
+#define HOME_WIDGET_RH_LARGE 11   /* 2倍大小的湿度 */
+#define HOME_WIDGET_TEMP_HIST 12  /* 24小时温度最高/最低值和趋势图 */
+#define HOME_WIDGET_RH_HIST 13    /* 24小时湿度最高/最低值和趋势图 */
+
+#define HOME_SHOW_ALWAYS 0x00
+#define HOME_SHOW_24HR 0x01 /* 只在24小时制时显示 */
+#define HOME_SHOW_12HR 0x02 /* 只在12小时制时显示 */
+
+#define HOME_NEED_SENSOR 0x01 /* 读取温湿度传感器并加入历史记录 */
+#define HOME_NEED_LUNAR 0x02  /* 计算农历、节气和节日 */
+
+#define HOME_FACE_COUNT 3
+
+struct Home_Line
+{
+    uint16_t x;
+    uint8_t y; /* 像素 */
+    uint8_t vertical;
+    uint16_t length;
+    uint8_t width;
+};
+
+struct Home_Widget
+{
+    uint8_t type; /* HOME_WIDGET_* */
+    uint8_t show; /* HOME_SHOW_* */
+    uint16_t x;   /* 窗口 */
+    uint8_t y_x8;
+    uint16_t width;
+    uint8_t height_x8;
+    uint8_t gap; /* 字符间距 */
+};
+
+struct Home_Layout
+{
+    uint8_t line_count;
+    uint8_t widget_count;
+    const struct Home_Line *lines;
+    const struct Home_Widget *widgets;
+};
+
+/* 电池电压每次唤醒都会读取，用于低电量时停止运行，不需要声明 */
+struct Home_Face
+{
+    uint8_t need; /* HOME_NEED_* */
+    const struct Home_Layout *layout;
+};
+
+/* 绘制控件需要的数据，由UpdateHomeDisplay()按表盘的需要准备 */
+struct Home_Data
+{
+    float battery_voltage;
+    uint16_t days_left; /* 电池剩余天数，BAT_DAYS_UNKNOWN为数据不足 */
+    int16_t cel_tenths; /* 温湿度四舍五入到0.1，HOME_NEED_SENSOR */
+    int16_t rh_tenths;
+    const char *lunar_title; /* HOME_NEED_LUNAR */
+};
+
+const static struct Home_Line Home_DefaultLines[] = {
+    {0, 28, 0, 296, 2},
+    {0, 104, 0, 296, 2},
+    {213, 67, 0, 76, 2},
+    {202, 39, 1, 56, 2}};
+
+const static struct Home_Widget Home_DefaultWidgets[] = {
+    {HOME_WIDGET_DATE, HOME_SHOW_ALWAYS, 0, 0, 250, 3, 1},
+    {HOME_WIDGET_BATTERY, HOME_SHOW_ALWAYS, 258, 0, 38, 3, 0},
+    {HOME_WIDGET_AMPM, HOME_SHOW_12HR, 0, 5, 28, 7, 2},
+    {HOME_WIDGET_TIME, HOME_SHOW_12HR, 34, 5, 165, 7, 6},
+    {HOME_WIDGET_TIME, HOME_SHOW_24HR, 22, 5, 165, 7, 6},
+    {HOME_WIDGET_TEMP, HOME_SHOW_ALWAYS, 213, 5, 76, 3, 0},
+    {HOME_WIDGET_RH, HOME_SHOW_ALWAYS, 213, 9, 76, 3, 0},
+    {HOME_WIDGET_LUNAR, HOME_SHOW_ALWAYS, 0, 14, 172, 2, 2},
+    {HOME_WIDGET_INFO, HOME_SHOW_ALWAYS, 172, 14, 124, 2, (HOME_INFO_STYLE == 1) ? 1 : 2}};
+
+const static struct Home_Layout Home_DefaultLayout = {
+    sizeof(Home_DefaultLines) / sizeof(Home_DefaultLines[0]), sizeof(Home_DefaultWidgets) / sizeof(Home_DefaultWidgets[0]),
+    Home_DefaultLines, Home_DefaultWidgets};
+
+const static struct Home_Widget Home_ClockWidgets[] = {
+    {HOME_WIDGET_BIGTIME, HOME_SHOW_ALWAYS, 5, 1, 286, 14, 4}};
+
+const static struct Home_Layout Home_ClockLayout = {
+    0, sizeof(Home_ClockWidgets) / sizeof(Home_ClockWidgets[0]), NULL, Home_ClockWidgets};
+
+const static struct Home_Line Home_SensorLines[] = {
+    {0, 28, 0, 296, 2},
+    {0, 84, 0, 296, 2},
+    {147, 32, 1, 96, 2}};
+
+const static struct Home_Widget Home_SensorWidgets[] = {
+    {HOME_WIDGET_CLOCK, HOME_SHOW_ALWAYS, 0, 0, 250, 3, 1},
+    {HOME_WIDGET_BATTERY, HOME_SHOW_ALWAYS, 258, 0, 38, 3, 0},
+    {HOME_WIDGET_TEMP_LARGE, HOME_SHOW_ALWAYS, 8, 4, 136, 6, 0},
+    {HOME_WIDGET_RH_LARGE, HOME_SHOW_ALWAYS, 160, 4, 136, 6, 0},
+    {HOME_WIDGET_TEMP_HIST, HOME_SHOW_ALWAYS, 4, 11, 140, 5, 0},
+    {HOME_WIDGET_RH_HIST, HOME_SHOW_ALWAYS, 153, 11, 140, 5, 0}};
+
+const static struct Home_Layout Home_SensorLayout = {
+    sizeof(Home_SensorLines) / sizeof(Home_SensorLines[0]), sizeof(Home_SensorWidgets) / sizeof(Home_SensorWidgets[0]),
+    Home_SensorLines, Home_SensorWidgets};
+
+/* 序号保存在Setting.home_face中 */
+const static struct Home_Face Home_Faces[HOME_FACE_COUNT] = {
+    {HOME_NEED_SENSOR | HOME_NEED_LUNAR, &Home_DefaultLayout}, /* 日历，主界面原有的布局 */
+    {0, &Home_ClockLayout},                                    /* 只显示时间 */
+    {HOME_NEED_SENSOR, &Home_SensorLayout}};                   /* 温湿度和24小时记录 */
+
+const static char *const Home_FaceNames[HOME_FACE_COUNT] = {"默认", "时钟", "数据"};
+
+/* 电子纸RAM内的主界面，只在本次唤醒且电子纸未断电时有效 */
+struct Home_Shown
+{
+    uint8_t valid; /* 0：RAM内不是主界面，例如显示过菜单或电子纸已断电 */
+    uint8_t face;
+    uint8_t is_12hr;
+    uint8_t year;
+    uint8_t month;
+    uint8_t date;
+};
+
+static struct Home_Shown Home_Shown;
+
+/* 只随日期变化的控件，局部刷新时跳过 */
+static uint8_t Home_IsDaily(const struct Home_Widget *widget)
+{
+#if (HOME_INFO_STYLE == 1 || HOME_INFO_STYLE == 2)
+    return widget->type == HOME_WIDGET_DATE || widget->type == HOME_WIDGET_LUNAR;
+#else
+    return widget->type == HOME_WIDGET_DATE || widget->type == HOME_WIDGET_LUNAR || widget->type == HOME_WIDGET_INFO;
+#endif
+}
+
+static uint8_t Home_IsVisible(const struct Home_Widget *widget)
+{
+    if (widget->show == HOME_SHOW_ALWAYS)
+    {
+        return 1;
+    }
+    return (Time.Is_12hr != 0) ? (widget->show == HOME_SHOW_12HR) : (widget->show == HOME_SHOW_24HR);
+}
+
+/* 温湿度显示为4个字符，超出范围时不显示小数 */
+static void Home_FormatTenths(struct FMT_Buffer *buf, int16_t tenths, const char *unit)
+{
+    if (tenths <= -100 || tenths >= 1000)
+    {
+        FMT_Int(buf, tenths / 10, 3, 0);
+        FMT_Char(buf, ' ');
+    }
+    else
+    {
+        FMT_Fixed(buf, tenths, 1, 4, FMT_ZERO);
+    }
+    FMT_String(buf, unit);
+}
+
+/* 2倍大小的温湿度数值，单位使用24x24字体绘制在右下方 */
+static void Home_DrawLargeTenths(const struct Home_Widget *widget, int16_t tenths, const char *unit)
+{
+    struct FMT_Buffer buf;
+
+    FMT_Init(&buf, String, sizeof(String));
+    Home_FormatTenths(&buf, tenths, "");
+    EPD_DrawAsciiX2(widget->x, widget->y_x8, widget->gap, String, EPD_FontAscii_12x24_B);
+    EPD_DrawUTF8(widget->x + buf.Length * (EPD_FontAscii_12x24_B[1] * 2 + widget->gap), widget->y_x8 + 3, 0, unit, NULL, EPD_FontUTF8_24x24_B);
+}
+
+/* 窗口上方2行为24小时最高/最低值，下方为逐小时趋势图 */
+static void Home_DrawHistory(const struct Home_Widget *widget, uint8_t type, const char *unit)
+{
+    struct HIST_Stats th_stats;
+    int16_t th_series[HIST_HOUR_COUNT];
+    struct FMT_Buffer buf;
+
+    if (HIST_GetStats(&Time, HIST_RANGE_24H, &th_stats) == 0)
+    {
+        FMT_Init(&buf, String, sizeof(String));
+        FMT_Char(&buf, 'H');
+        FMT_Fixed(&buf, FMT_Scale((type == HIST_TYPE_CEL) ? th_stats.CEL_Max : th_stats.RH_Max, 1), 1, 0, 0);
+        FMT_String(&buf, " L");
+        FMT_Fixed(&buf, FMT_Scale((type == HIST_TYPE_CEL) ? th_stats.CEL_Min : th_stats.RH_Min, 1), 1, 0, 0);
+        FMT_String(&buf, unit);
+        EPD_DrawUTF8(widget->x, widget->y_x8, 1, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16);
+    }
+    if (HIST_GetHourSeries(&Time, type, th_series) == 0)
+    {
+        EPD_DrawGraph(widget->x, widget->y_x8 + 2, widget->width, widget->height_x8 - 2, th_series, HIST_HOUR_COUNT, EPD_GRAPH_STYLE_LINE);
+    }
+}
+
+/**
+ * @brief  在窗口内绘制控件。
+ * @param  widget 控件。
+ * @param  data 当前数据。
+ * @param  clear 1：先清除窗口，用于单独重绘控件，0：显存已清空，直接绘制。
+ */
+static void Home_DrawWidget(const struct Home_Widget *widget, const struct Home_Data *data, uint8_t clear)
+{
+    struct FMT_Buffer buf;
+#if (HOME_INFO_STYLE == 1)
+    struct HIST_Stats th_stats;
+#elif (HOME_INFO_STYLE == 2)
+    int16_t th_series[HIST_HOUR_COUNT];
+#endif
+
+    if (clear != 0)
+    {
+        EPD_ClearArea(widget->x, widget->y_x8, widget->width, widget->height_x8, 0xFF);
+    }
+    FMT_Init(&buf, String, sizeof(String));
+    switch (widget->type)
+    {
+    case HOME_WIDGET_DATE:
+        FMT_Char(&buf, '2');
+        FMT_Uint(&buf, Time.Year, 3, FMT_ZERO);
+        FMT_Char(&buf, '/');
+        FMT_Uint(&buf, Time.Month, 2, FMT_ZERO);
+        FMT_Char(&buf, '/');
+        FMT_Uint(&buf, Time.Date, 2, FMT_ZERO);
+        FMT_String(&buf, " 星期");
+        FMT_String(&buf, Lunar_DayString[Time.Day]);
+        EPD_DrawUTF8(widget->x, widget->y_x8, widget->gap, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+        break;
+    case HOME_WIDGET_TIME:
+        FMT_Uint(&buf, Time.Hours, 2, FMT_ZERO);
+        FMT_Char(&buf, ':');
+        FMT_Uint(&buf, Time.Minutes, 2, FMT_ZERO);
+        EPD_DrawUTF8(widget->x, widget->y_x8, widget->gap, String, EPD_FontAscii_27x56, EPD_FontUTF8_24x24_B);
+        break;
+    case HOME_WIDGET_AMPM:
+        if (Time.PM != 0)
+        {
+            EPD_DrawUTF8(widget->x, widget->y_x8 + widget->height_x8 - 3, widget->gap, "PM", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+        }
+        else
+        {
+            EPD_DrawUTF8(widget->x, widget->y_x8, widget->gap, "AM", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+        }
+        break;
+    case HOME_WIDGET_TEMP:
+        Home_FormatTenths(&buf, data->cel_tenths, "℃");
+        EPD_DrawUTF8(widget->x, widget->y_x8, widget->gap, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+        break;
+    case HOME_WIDGET_RH:
+        Home_FormatTenths(&buf, data->rh_tenths, "％");
+        EPD_DrawUTF8(widget->x, widget->y_x8, widget->gap, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+        break;
+    case HOME_WIDGET_BATTERY: /* 根据放电曲线换算的电量绘制电池标志 */
+        EPD_DrawBattery(widget->x, widget->y_x8, BAT_GetPercent(data->battery_voltage), data->battery_voltage < Setting.battery_warn);
+        break;
+    case HOME_WIDGET_LUNAR:
+        FMT_String(&buf, data->lunar_title);
+        FMT_String(&buf, "：");
+        FMT_String(&buf, Lunar_MonthLeapString[Lunar.IsLeap]);
+        FMT_String(&buf, Lunar_MonthString[Lunar.Month]);
+        FMT_String(&buf, Lunar_DateString[Lunar.Date]);
+        EPD_DrawUTF8(widget->x, widget->y_x8, widget->gap, String, NULL, EPD_FontUTF8_16x16_B);
+        break;
+    case HOME_WIDGET_INFO:
+        if (HOME_INFO_STYLE == 3 || data->days_left < HOME_DAYS_LEFT_WARN) /* 电池快要用完时代替原有内容，字库没有“电池”等汉字，使用ASCII */
+        {
+            FMT_String(&buf, "BAT ");
+            if (data->days_left == BAT_DAYS_UNKNOWN)
+            {
+                FMT_String(&buf, "--");
+            }
+            else if (data->days_left > 999)
+            {
+                FMT_String(&buf, "999+");
+            }
+            else
+            {
+                FMT_Uint(&buf, data->days_left, 0, 0);
+            }
+            FMT_String(&buf, " DAYS");
+            EPD_DrawUTF8(widget->x, widget->y_x8, 1, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16_B); /* 最长13个字符，间距为1时不超出窗口 */
+            break;
+        }
+#if (HOME_INFO_STYLE == 1)
+        if (HIST_GetStats(&Time, HIST_RANGE_24H, &th_stats) == 0) /* 显示24小时内的温度最高/最低值 */
+        {
+            FMT_Char(&buf, 'H');
+            FMT_Fixed(&buf, FMT_Scale(th_stats.CEL_Max, 1), 1, 0, 0);
+            FMT_String(&buf, " L");
+            FMT_Fixed(&buf, FMT_Scale(th_stats.CEL_Min, 1), 1, 0, 0);
+            FMT_String(&buf, "℃");
+            EPD_DrawUTF8(widget->x, widget->y_x8, widget->gap, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16);
+        }
+#elif (HOME_INFO_STYLE == 2)
+        if (HIST_GetHourSeries(&Time, HIST_TYPE_CEL, th_series) == 0) /* 显示24小时内的温度趋势 */
+        {
+            EPD_DrawGraph(widget->x + 4, widget->y_x8, widget->width - 4, widget->height_x8, th_series, HIST_HOUR_COUNT, EPD_GRAPH_STYLE_LINE);
+        }
+#else
+        FMT_String(&buf, Lunar_StemStrig[LUNAR_GetStem(&Lunar)]);
+        FMT_String(&buf, Lunar_BranchStrig[LUNAR_GetBranch(&Lunar)]);
+        FMT_String(&buf, "年【");
+        FMT_String(&buf, Lunar_ZodiacString[LUNAR_GetZodiac(&Lunar)]);
+        FMT_String(&buf, "年】");
+        EPD_DrawUTF8(widget->x, widget->y_x8, widget->gap, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16_B);
+#endif
+        break;
+    case HOME_WIDGET_BIGTIME:
+        FMT_Uint(&buf, Time.Hours, 2, FMT_ZERO);
+        FMT_Char(&buf, ':');
+        FMT_Uint(&buf, Time.Minutes, 2, FMT_ZERO);
+        EPD_DrawAsciiX2(widget->x, widget->y_x8, widget->gap, String, EPD_FontAscii_27x56);
+        break;
+    case HOME_WIDGET_CLOCK:
+        FMT_Uint(&buf, Time.Month, 2, FMT_ZERO);
+        FMT_Char(&buf, '/');
+        FMT_Uint(&buf, Time.Date, 2, FMT_ZERO);
+        FMT_String(&buf, " 周");
+        FMT_String(&buf, Lunar_DayString[Time.Day]);
+        FMT_Char(&buf, ' ');
+        if (Time.Is_12hr != 0)
+        {
+            FMT_String(&buf, (Time.PM != 0) ? "PM " : "AM ");
+        }
+        FMT_Uint(&buf, Time.Hours, 2, FMT_ZERO);
+        FMT_Char(&buf, ':');
+        FMT_Uint(&buf, Time.Minutes, 2, FMT_ZERO);
+        EPD_DrawUTF8(widget->x, widget->y_x8, widget->gap, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+        break;
+    case HOME_WIDGET_TEMP_LARGE:
+        Home_DrawLargeTenths(widget, data->cel_tenths, "℃");
+        break;
+    case HOME_WIDGET_RH_LARGE:
+        Home_DrawLargeTenths(widget, data->rh_tenths, "％");
+        break;
+    case HOME_WIDGET_TEMP_HIST:
+        Home_DrawHistory(widget, HIST_TYPE_CEL, "℃");
+        break;
+    case HOME_WIDGET_RH_HIST:
+        Home_DrawHistory(widget, HIST_TYPE_RH, "％");
+        break;
+    }
+}
+
+/* 按布局表绘制主界面，partial为0时绘制全部内容，显存需要已清空；为1时只清除并重绘随时间变化的控件，其他内容保留在显存中 */
+static void Home_DrawLayout(const struct Home_Layout *layout, const struct Home_Data *data, uint8_t partial)
+{
+    uint8_t i;
+
+    for (i = 0; i < layout->line_count && partial == 0; i++)
+    {
+        if (layout->lines[i].vertical != 0)
+        {
+            EPD_DrawVLine(layout->lines[i].x, layout->lines[i].y, layout->lines[i].length, layout->lines[i].width);
+        }
+        else
+        {
+            EPD_DrawHLine(layout->lines[i].x, layout->lines[i].y, layout->lines[i].length, layout->lines[i].width);
+        }
+    }
+    for (i = 0; i < layout->widget_count; i++)
+    {
+        if (Home_IsVisible(&layout->widgets[i]) != 0 && (partial == 0 || Home_IsDaily(&layout->widgets[i]) == 0))
+        {
+            Home_DrawWidget(&layout->widgets[i], data, partial);
+        }
+    }
+}
+
 static void UpdateHomeDisplay(void) /* 更新主界面显示内容 */
 {
     uint32_t battery_stor;
-    float battery_voltage, cel_tmp, rh_tmp;
-    int8_t temp_value[2], rh_value[2];
+    float battery_voltage;
+    uint8_t i, term, festival, face_index, partial;
+    struct Home_Data data;
+    struct I2C_Stats i2c_stats;
+    const struct Home_Face *face;
 
     RTC_GetTime(&Time); /* 获取当前时间 */
+    face_index = (Setting.home_face < HOME_FACE_COUNT) ? Setting.home_face : 0;
+    face = &Home_Faces[face_index];
 
     RTC_ModifyAM2Mask(0x07); /* 设置闹钟2每分钟产生中断 */
     RTC_ModifyA2IE(1);       /* 打开闹钟2中断 */
-    RTC_ClearA2F();          /* 清除闹钟2中断标志 */
-    RTC_ModifyA1IE(0);       /* 关闭闹钟1中断 */
-    RTC_ClearA1F();          /* 清除闹钟1中断标志 */
+    RTC_ClearA2F();          /* 清除闹钟2中断标志，闹钟1用于钟声，见Alarm_Update() */
     RTC_ModifyINTCN(1);      /* 打开中断输出 */
 
-    TH_GetValue_SingleShotWithCS(TH_ACC_HIGH, &Sensor); /* 获取当前温度 */
-
-    EPD_Init(EPD_UPDATE_MODE_FAST); /* 电子纸快速全局刷新模式 */
-    EPD_ClearRAM();
+    if ((face->need & HOME_NEED_SENSOR) != 0) /* 不显示温湿度的表盘不启动转换，也不记录历史数据 */
+    {
+        if (TH_GetValue_SingleShotWithCS(TH_ACC_HIGH, &Sensor) == 0) /* 获取当前温度 */
+        {
+            HIST_AddSample(&Time, &Sensor); /* 加入历史记录 */
+        }
+        else
+        {
+            LOG_Add(&Time, LOG_EVENT_SENSOR_FAIL, 0);
+        }
+        data.cel_tenths = FMT_Scale(Sensor.CEL, 1);
+        data.rh_tenths = FMT_Scale(Sensor.RH, 1);
+    }
 
     battery_stor = BKPR_ReadDWORD(BKPR_ADDR_DWORD_ADCVAL); /* 读取上次屏幕刷新完成后的电量 */
     battery_voltage = *(float *)&battery_stor;             /* 存储的uint32_t转float */
-    if (battery_voltage < 0.1 || battery_voltage > 3.6)    /* 超出此范围则判断为备份寄存器数据失效，重新读取当前电池数据 */
+    if (battery_voltage < 0.1f || battery_voltage > 3.6f)  /* 超出此范围则判断为备份寄存器数据失效，重新读取当前电池数据 */
     {
         battery_voltage = ADC_GetChannel(ADC_CHANNEL_BATTERY);
     }
     if (battery_voltage < Setting.battery_stop) /* 电池已经低于最低工作电压，显示电量不足标志并停止更新 */
     {
-        if (RTC_ReadREG(RTC_REG_AL1_DDT) != 0xAA) /* 借用RTC未使用的寄存器，存储低电量画面已显示标志 */
+        if ((RTC_ReadREG(RTC_REG_LOWBAT) & RTC_LOWBAT_MASK) != RTC_LOWBAT_FLAG) /* 借用RTC闹钟2不使用的位，存储低电量画面已显示标志 */
         {
+            EPD_Init(EPD_UPDATE_MODE_FAST);
             EPD_DrawImage(0, 0, EPD_Image_BatteryLow_296x128);
             EPD_Show(0);
             LP_EnterStop(EPD_TIMEOUT_MS); /* 进入Stop模式，由电子纸BUSY引脚上升沿唤醒 */
             EPD_EnterDeepSleep();
-            RTC_WriteREG(RTC_REG_AL1_DDT, 0xAA); /* 借用RTC未使用的寄存器，存储低电量画面已显示标志 */
+            RTC_ModifyREG(RTC_REG_LOWBAT, RTC_LOWBAT_MASK, RTC_LOWBAT_FLAG); /* 借用RTC闹钟2不使用的位，存储低电量画面已显示标志 */
+            LOG_Add(&Time, LOG_EVENT_LOW_BATTERY, (uint16_t)(battery_voltage * 1000 + 0.5f));
         }
 
-        RTC_ModifyA2IE(0); /* 关闭闹钟2中断，防止中断引脚消耗电流 */
+        RTC_ModifyA2IE(0); /* 关闭闹钟中断，防止中断引脚消耗电流 */
         RTC_ClearA2F();    /* 清除闹钟2中断标志 */
+        RTC_ModifyA1IE(0); /* 钟声也不再响，换电池复位后重新设置 */
+        RTC_ClearA1F();
 
         Power_DisableGDEH029A1(); /* 尽可能关闭电源 */
         Power_DisableADC();
@@ -223,145 +676,395 @@ static void UpdateHomeDisplay(void) /* 更新主界面显示内容 */
             LP_DelayStop(5000);
         }
     }
-    RTC_WriteREG(RTC_REG_AL1_DDT, 0x00); /* 电量高于设定值，清除低电量画面已显示标志并正常执行 */
-
-    LUNAR_SolarToLunar(&Lunar, Time.Year + 2000, Time.Month, Time.Date); /* RTC读出的年份省去了2000，计算农历前要手动加上 */
+    RTC_ModifyREG(RTC_REG_LOWBAT, RTC_LOWBAT_MASK, 0x00); /* 电量高于设定值，清除低电量画面已显示标志并正常执行 */
 
-    /* 将浮点温度分为两个整数温度 */
-    if (Sensor.CEL > 0)
+    /* 本次唤醒中已显示过主界面且日期、表盘和时间格式都未改变时，只局部刷新随时间变化的控件，否则快速全局刷新 */
+    partial = Home_Shown.valid != 0 && Home_Shown.face == face_index && Home_Shown.is_12hr == Time.Is_12hr && Home_Shown.year == Time.Year && Home_Shown.month == Time.Month && Home_Shown.date == Time.Date;
+    if (partial != 0)
     {
-        cel_tmp = Sensor.CEL + 0.05;
+        EPD_SetUpdateMode(EPD_UPDATE_MODE_PART); /* 上次结束时只进入普通睡眠模式，RAM内仍是上次的画面 */
     }
     else
     {
-        cel_tmp = Sensor.CEL - 0.05;
+        EPD_Init(EPD_UPDATE_MODE_FAST); /* 电子纸快速全局刷新模式 */
+        EPD_ClearRAM();
     }
-    temp_value[0] = (int8_t)cel_tmp;
-    temp_value[1] = abs((int8_t)((cel_tmp - temp_value[0]) * 10));
-
-    /* 将浮点湿度分为两个整数 */
-    rh_tmp = Sensor.RH + 0.05;
-    rh_value[0] = (int8_t)rh_tmp;
-    rh_value[1] = (int8_t)((rh_tmp - rh_value[0]) * 10);
-
-    EPD_DrawHLine(0, 28, 296, 2);
-    EPD_DrawHLine(0, 104, 296, 2);
-    EPD_DrawHLine(213, 67, 76, 2);
-    EPD_DrawVLine(202, 39, 56, 2);
-    EPD_DrawBattery(258, 0, BAT_MAX_VOLTAGE, Setting.battery_warn, battery_voltage); /* 根据电量绘制电池标志 */
 
-    snprintf(String, sizeof(String), "2%03d/%02d/%02d 星期%s", Time.Year, Time.Month, Time.Date, Lunar_DayString[Time.Day]);
-    EPD_DrawUTF8(0, 0, 1, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-
-    if (Time.Is_12hr != 0)
+    data.battery_voltage = battery_voltage;
+    data.days_left = BAT_GetDaysLeft(&Time, BAT_GetPercent(battery_voltage)); /* 首次调用时在EEPROM记录参考点 */
+    if ((face->need & HOME_NEED_LUNAR) != 0 && partial == 0)
     {
-        if (Time.PM != 0)
+        LUNAR_SolarToLunarCached(&Lunar, Time.Year + 2000, Time.Month, Time.Date); /* RTC读出的年份省去了2000，计算农历前要手动加上 */
+        term = TERM_GetTerm(Time.Year + 2000, Time.Month, Time.Date);
+        festival = FEST_GetFestival(Time.Month, Time.Date, Time.Day, &Lunar, term);
+        if (festival != FEST_NONE) /* 节日或节气当天用名称代替“农历” */
+        {
+            data.lunar_title = FEST_GetName(festival);
+        }
+        else if (term != TERM_NONE)
         {
-            EPD_DrawUTF8(0, 9, 2, "PM", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+            data.lunar_title = Term_NameString[term];
         }
         else
         {
-            EPD_DrawUTF8(0, 5, 2, "AM", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+            data.lunar_title = "农历";
         }
     }
-    snprintf(String, sizeof(String), "%02d:%02d", Time.Hours, Time.Minutes);
-
-    if (Time.Is_12hr != 0)
-    {
-        EPD_DrawUTF8(34, 5, 6, String, EPD_FontAscii_27x56, EPD_FontUTF8_24x24_B);
-    }
-    else
-    {
-        EPD_DrawUTF8(22, 5, 6, String, EPD_FontAscii_27x56, EPD_FontUTF8_24x24_B);
-    }
+    Home_DrawLayout(face->layout, &data, partial);
 
-    if (cel_tmp <= -10.0)
-    {
-        snprintf(String, sizeof(String), "%02d ℃", temp_value[0]);
-    }
-    else if (cel_tmp < 0 && cel_tmp > -1.0)
-    {
-        snprintf(String, sizeof(String), "-%01d.%d℃", temp_value[0], temp_value[1]);
-    }
-    else if (cel_tmp >= 100.0)
-    {
-        snprintf(String, sizeof(String), "%03d ℃", temp_value[0]);
-    }
-    else
+    EPD_Show(0);
+    LP_EnterStop(EPD_TIMEOUT_MS);
+    if (EPD_GetBusy() != 0) /* 超时唤醒时电子纸仍在刷新 */
     {
-        snprintf(String, sizeof(String), "%02d.%d℃", temp_value[0], temp_value[1]);
+        if (EPD_TimeoutCount < 0xFF)
+        {
+            EPD_TimeoutCount += 1;
+        }
+        LOG_Add(&Time, LOG_EVENT_EPD_TIMEOUT, EPD_TimeoutCount);
     }
-    EPD_DrawUTF8(213, 5, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-
-    if (rh_tmp < 100)
+    if (I2C_GetResetCount() != 0) /* 本次唤醒中I2C出现过死锁 */
     {
-        snprintf(String, sizeof(String), "%02d.%d％", rh_value[0], rh_value[1]);
+        LOG_Add(&Time, LOG_EVENT_I2C_RECOVER, I2C_GetResetCount());
     }
-    else
+    for (i = 0; I2C_GetStats(i, &i2c_stats) == 0; i++) /* I2C统计在待机模式下不保持，失败的设备写入事件记录 */
     {
-        snprintf(String, sizeof(String), "%03d ％", rh_value[0]);
+        if (i2c_stats.Fail != 0)
+        {
+            LOG_Add(&Time, LOG_EVENT_I2C_FAIL, ((uint32_t)i2c_stats.Addr << 8) | i2c_stats.LastResult);
+        }
     }
-    EPD_DrawUTF8(213, 9, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-
-    snprintf(String, sizeof(String), "农历：%s%s%s", Lunar_MonthLeapString[Lunar.IsLeap], Lunar_MonthString[Lunar.Month], Lunar_DateString[Lunar.Date]);
-    EPD_DrawUTF8(0, 14, 2, String, NULL, EPD_FontUTF8_16x16_B);
-
-    snprintf(String, sizeof(String), "%s%s年【%s年】", Lunar_StemStrig[LUNAR_GetStem(&Lunar)], Lunar_BranchStrig[LUNAR_GetBranch(&Lunar)], Lunar_ZodiacString[LUNAR_GetZodiac(&Lunar)]);
-    EPD_DrawUTF8(172, 14, 2, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16_B);
-
-    EPD_Show(0);
-    LP_EnterStop(EPD_TIMEOUT_MS);
 
-    /* 读取电子纸刚刷新完成后的电池电压并存入备份寄存器，供下次唤醒后使用 */
-    battery_voltage = ADC_GetChannel(ADC_CHANNEL_BATTERY);
+    /* 读取电子纸刚刷新完成后的电池电压，与之前的读数滤波后存入备份寄存器，供下次唤醒后使用 */
+    battery_voltage = BAT_Filter(battery_voltage, ADC_GetChannel(ADC_CHANNEL_BATTERY));
     BKPR_WriteDWORD(BKPR_ADDR_DWORD_ADCVAL, *(uint32_t *)&battery_voltage);
 
-    EPD_EnterDeepSleep();
+    EPD_EnterSleep(); /* 保留RAM，本次唤醒中再次更新时可以局部刷新，进入Standby模式前电子纸断电 */
+    Home_Shown.valid = 1;
+    Home_Shown.face = face_index;
+    Home_Shown.is_12hr = Time.Is_12hr;
+    Home_Shown.year = Time.Year;
+    Home_Shown.month = Time.Month;
+    Home_Shown.date = Time.Date;
 }
 
-static void FullInit(void) /* 清除除硬件版本外的全部数据 */
+static void FullInit(void) /* 清除除硬件版本和事件记录外的全部数据 */
 {
-    BUZZER_SetFrqe(4000);
+    uint8_t error_count;
+
     BUZZER_SetVolume(DefaultSetting.buzzer_volume);
+    BUZZER_Play(Beep_FullInitNotes);
+    BUZZER_Wait(); /* 提示音结束后再开始清除 */
 
-    BUZZER_Beep(49);
-    LL_mDelay(49);
-    BUZZER_Beep(49);
-    LL_mDelay(49);
-    BUZZER_Beep(49);
-    LL_mDelay(999);
-    if (RTC_ResetAllRegToDefault() != 0)
-    {
-        BUZZER_SetFrqe(1000);
-        BUZZER_Beep(499);
-        LL_mDelay(499);
-    }
-    if (TH_SoftReset() != 0)
-    {
-        BUZZER_SetFrqe(1000);
-        BUZZER_Beep(499);
-        LL_mDelay(499);
-    }
-    if (BKPR_ResetAll() != 0)
+    error_count = 0;
+    error_count += RTC_ResetAllRegToDefault() != 0;
+    error_count += TH_SoftReset() != 0;
+    error_count += BKPR_ResetAll() != 0;
+    error_count += EEPROM_EraseRange(0, LOG_EEPROM_ADDR_DWORD - 1) != 0 || EEPROM_EraseRange(LOG_EEPROM_ADDR_DWORD + LOG_BLOCK_COUNT * LOG_BLOCK_DWORDS, EEPROM_ADDR_DWORD_HWVERSION - 1) != 0;
+    for (; error_count != 0; error_count--) /* 每个失败的步骤响一次长音 */
     {
-        BUZZER_SetFrqe(1000);
-        BUZZER_Beep(499);
-        LL_mDelay(499);
+        BUZZER_Play(Beep_ErrorNotes);
+        BUZZER_Wait();
     }
-    if (EEPROM_EraseRange(0, 510) != 0)
+    RTC_GetTime(&Time);
+    LOG_Add(&Time, LOG_EVENT_SETTING_RESET, 1);
+}
+
+/* 钟声响铃，“设置”键稍后提醒，“上”或“下”键停止，ALARM_RING_MS内无人处理时停止 */
+static void Alarm_Ring(void)
+{
+    struct BTN_Event event;
+    uint32_t ring_ms;
+    uint8_t result;
+
+    RTC_ClearA1F();
+    BTN_Flush();
+    result = 2;
+    ring_ms = 0;
+    while (ring_ms < ALARM_RING_MS && result == 2)
     {
-        BUZZER_SetFrqe(1000);
-        BUZZER_Beep(499);
-        LL_mDelay(499);
+        if (BTN_GetEvent(&event) == BTN_EVENT_PRESS)
+        {
+            result = (event.Key == BTN_KEY_SET) ? 1 : 0;
+        }
+        else
+        {
+            if (BUZZER_IsPlaying() == 0)
+            {
+                BUZZER_Play(Alarm_Notes);
+            }
+            ring_ms += BTN_Wait(ALARM_POLL_MS); /* 有按键事件时提前返回，只累计实际等待的时间 */
+        }
     }
+    BUZZER_Stop();
+    RTC_GetTime(&Time);
+    LOG_Add(&Time, LOG_EVENT_ALARM, result);
+    Alarm_Update((result == 1) ? ALARM_SNOOZE_MIN : 0);
 }
 
-/* ==================== 主菜单 ==================== */
+/**
+ * @brief  根据设置和当前时间写入下一个钟声。
+ * @param  snooze_min 稍后提醒的分钟数，0为不提醒。
+ * @note   修改时间、12/24小时制或钟声设置后都需要调用，未处理的稍后提醒会被取消。
+ */
+static void Alarm_Update(uint8_t snooze_min)
+{
+    RTC_GetTime(&Time);
+    ALARM_Schedule(Setting.alarms, ALARM_COUNT, &Time, snooze_min);
+}
+
+/* ==================== 菜单引擎 ==================== */
+
+/*
+ * 设置页面由const表描述：页面包含若干字段和静态文字，字段绑定到数据结构中的变量（偏移和类型），
+ * Menu_Run()统一处理按键、光标移动和保存/取消，只重绘数值发生变化的字段。
+ * 选择顺序为全部字段、保存、取消，“设置”键移动，“上”和“下”键修改字段，选中保存或取消时按“上”键退出。
+ */
+#define MENU_FIELD_DIGIT 0x00  /* 修改十进制数的一位，该位在min ~ max间循环，按住可连续修改 */
+#define MENU_FIELD_VALUE 0x01  /* 数值加减1，到达min或max后停止，按住可连续修改，连发时修改的位逐渐提高 */
+#define MENU_FIELD_SWITCH 0x02 /* “上”和“下”键在min ~ max间循环切换，显示text中对应的文字，按住不连续切换 */
+#define MENU_FIELD_CHECK 0x80  /* 离开此字段时调用页面的check()检查数据 */
+
+#define MENU_DATA_U8 0x00
+#define MENU_DATA_I8 0x01
+#define MENU_DATA_I16 0x02
+#define MENU_DATA_FLOAT 0x03 /* 编辑时为乘以100后的整数 */
+
+#define MENU_FORMAT_SIGN 0x10   /* 总是显示正负号，低4位为总宽度（包含符号和小数点），不足时补0 */
+#define MENU_FORMAT_FIXED2 0x20 /* 显示两位小数 */
+
+#define MENU_TEXT_SMALL 0x80 /* 使用16x16字体，低7位为字符间距 */
+
+#define MENU_CURSOR_LEFT 0 /* 字段右侧的“◀” */
+#define MENU_CURSOR_UP 1   /* 字段下方的箭头 */
+
+#define MENU_SCREEN_CONFIRM 0x01 /* 没有字段的确认页面，保存显示为“继续”，默认选中取消 */
+
+#define MENU_NO_DEPEND 0xFF  /* 字段总是有效 */
+#define MENU_PAGE_ITEMS 4    /* 主菜单每页项目数量 */
+#define MENU_REPEAT_DIGIT 8  /* MENU_FIELD_VALUE连发每8次，修改的位提高一位，最高到NUM_MaxStepPos() */
+#define MENU_STRINGIFY(x) MENU_STRINGIFY_(x)
+#define MENU_STRINGIFY_(x) #x
+
+struct Menu_Field
+{
+    uint16_t x; /* 数值显示位置，使用12x24和24x24字体 */
+    uint8_t y_x8;
+    uint8_t type;   /* MENU_FIELD_*，可或上MENU_FIELD_CHECK */
+    uint8_t data;   /* 绑定变量的类型，MENU_DATA_* */
+    uint8_t offset; /* 绑定变量在数据结构中的偏移 */
+    uint8_t format; /* MENU_FIELD_DIGIT：修改的位，0为个位；MENU_FIELD_VALUE：MENU_FORMAT_*和总宽度 */
+    uint8_t depend; /* 该偏移处的变量为0时跳过此字段并显示为空白，MENU_NO_DEPEND为总是有效 */
+    int16_t min;
+    int16_t max;
+    uint16_t cursor_x;
+    uint8_t cursor_y_x8;
+    const char *const *text; /* MENU_FIELD_SWITCH为min ~ max时显示的文字，宽度需相同 */
+};
+
+struct Menu_Text
+{
+    uint16_t x;
+    uint8_t y_x8;
+    uint8_t style; /* 字符间距，可或上MENU_TEXT_SMALL */
+    const char *str;
+};
+
+struct Menu_Screen
+{
+    const char *title;
+    uint8_t button_style; /* 用于Menu_DrawMenuFrame() */
+    uint8_t cursor;       /* MENU_CURSOR_* */
+    uint8_t flags;        /* MENU_SCREEN_* */
+    uint8_t field_count;
+    uint8_t text_count;
+    const struct Menu_Field *fields;
+    const struct Menu_Text *texts; /* 进入页面时绘制一次 */
+    void (*draw)(const void *data); /* 每次刷新时额外绘制的内容，可为NULL */
+    void (*check)(void *data);      /* 离开带MENU_FIELD_CHECK的字段时调用，之后重绘全部字段 */
+};
+
+struct Menu_Item
+{
+    const char *name;
+    void (*action)(void);             /* 为NULL时使用screen */
+    const struct Menu_Screen *screen; /* 修改Setting的设置页面，两者都为NULL时返回 */
+};
+
+static void Menu_DrawBatteryVoltage(const void *data);
+static void Menu_DrawVrefint(const void *data);
+static void Menu_CheckTime(void *data);
+static void Menu_CheckAlarm(void *data);
+
+const static char *const Menu_TextOnOff[2] = {"关闭", "开启"};
+const static char *const Menu_TextHourMode[2] = {"24", "12"};
+const static char *const Menu_TextAMPM[2] = {"上午", "下午"};
+const static char *const Menu_TextOffOn[2] = {"关", "开"};
+
+#define TIME_FIELD(x, y, member, digit, max, min, check) \
+    {x, y, MENU_FIELD_DIGIT | (check), MENU_DATA_U8, offsetof(struct RTC_Time, member), digit, MENU_NO_DEPEND, min, max, x, (y) + 3, NULL}
+
+const static struct Menu_Field Menu_TimeFields[] = {
+    TIME_FIELD(24, 4, Year, 2, 1, 0, 0),
+    TIME_FIELD(41, 4, Year, 1, 9, 0, 0),
+    TIME_FIELD(58, 4, Year, 0, 9, 0, MENU_FIELD_CHECK),
+    TIME_FIELD(104, 4, Month, 1, 1, 0, 0),
+    TIME_FIELD(121, 4, Month, 0, 9, 0, MENU_FIELD_CHECK),
+    TIME_FIELD(167, 4, Date, 1, 3, 0, 0),
+    TIME_FIELD(184, 4, Date, 0, 9, 0, MENU_FIELD_CHECK),
+    TIME_FIELD(276, 4, Day, 0, 7, 1, 0),
+    {125, 8, MENU_FIELD_SWITCH | MENU_FIELD_CHECK, MENU_DATA_U8, offsetof(struct RTC_Time, Is_12hr), 0, MENU_NO_DEPEND, 0, 1, 132, 11, Menu_TextHourMode},
+    {5, 12, MENU_FIELD_SWITCH, MENU_DATA_U8, offsetof(struct RTC_Time, PM), 0, offsetof(struct RTC_Time, Is_12hr), 0, 1, 23, 15, Menu_TextAMPM},
+    TIME_FIELD(58, 12, Hours, 1, 2, 0, MENU_FIELD_CHECK), /* 12小时制时十位超过1会在检查时限制为12 */
+    TIME_FIELD(75, 12, Hours, 0, 9, 0, MENU_FIELD_CHECK),
+    TIME_FIELD(109, 12, Minutes, 1, 5, 0, 0),
+    TIME_FIELD(126, 12, Minutes, 0, 9, 0, MENU_FIELD_CHECK),
+    TIME_FIELD(160, 12, Seconds, 1, 5, 0, 0),
+    TIME_FIELD(177, 12, Seconds, 0, 9, 0, MENU_FIELD_CHECK)};
+
+const static struct Menu_Text Menu_TimeTexts[] = {
+    {7, 4, 5, "2   年  月  日 周 "},
+    {5, 8, 0, "时间格式：  小时制"},
+    {58, 12, 5, "  :  :  "}};
+
+const static struct Menu_Screen Menu_TimeScreen = {
+    "时间设置", 0, MENU_CURSOR_UP, 0, sizeof(Menu_TimeFields) / sizeof(Menu_TimeFields[0]), sizeof(Menu_TimeTexts) / sizeof(Menu_TimeTexts[0]),
+    Menu_TimeFields, Menu_TimeTexts, NULL, Menu_CheckTime};
+
+const static struct Menu_Field Menu_BuzzerFields[] = {
+    {192, 4, MENU_FIELD_SWITCH, MENU_DATA_U8, offsetof(struct Func_Setting, buzzer_enable), 0, MENU_NO_DEPEND, 0, 1, 240, 4, Menu_TextOnOff},
+    {144, 8, MENU_FIELD_VALUE, MENU_DATA_U8, offsetof(struct Func_Setting, buzzer_volume), 2, MENU_NO_DEPEND, 1, BUZZER_MAX_VOL, 204, 8, NULL}};
+
+const static struct Menu_Text Menu_BuzzerTexts[] = {
+    {0, 4, 0, "蜂鸣器开启状态："},
+    {0, 8, 0, "蜂鸣器音量：  /" MENU_STRINGIFY(BUZZER_MAX_VOL)}};
+
+const static struct Menu_Screen Menu_BuzzerScreen = {
+    "铃声设置", 0, MENU_CURSOR_LEFT, 0, 2, 2, Menu_BuzzerFields, Menu_BuzzerTexts, NULL, NULL};
+
+const static struct Menu_Field Menu_BatteryFields[] = {
+    {120, 4, MENU_FIELD_VALUE, MENU_DATA_FLOAT, offsetof(struct Func_Setting, battery_warn), MENU_FORMAT_FIXED2 | 4, MENU_NO_DEPEND, BAT_MIN_VOLTAGE * 100, BAT_MAX_VOLTAGE * 100, 180, 4, NULL},
+    {120, 8, MENU_FIELD_VALUE, MENU_DATA_FLOAT, offsetof(struct Func_Setting, battery_stop), MENU_FORMAT_FIXED2 | 4, MENU_NO_DEPEND, BAT_MIN_VOLTAGE * 100, BAT_MAX_VOLTAGE * 100, 180, 8, NULL}};
+
+const static struct Menu_Text Menu_BatteryTexts[] = {
+    {0, 4, 0, "警告电压：    V"},
+    {0, 8, 0, "截止电压：    V"}};
+
+const static struct Menu_Screen Menu_BatteryScreen = {
+    "电池设置", 0, MENU_CURSOR_LEFT, 0, 2, 2, Menu_BatteryFields, Menu_BatteryTexts, Menu_DrawBatteryVoltage, NULL};
+
+const static struct Menu_Field Menu_SensorFields[] = {
+    {120, 4, MENU_FIELD_VALUE, MENU_DATA_FLOAT, offsetof(struct Func_Setting, sensor_temp_offset), MENU_FORMAT_FIXED2 | MENU_FORMAT_SIGN | 6, MENU_NO_DEPEND, -1000, 1000, 216, 4, NULL},
+    {120, 8, MENU_FIELD_VALUE, MENU_DATA_FLOAT, offsetof(struct Func_Setting, sensor_rh_offset), MENU_FORMAT_FIXED2 | MENU_FORMAT_SIGN | 6, MENU_NO_DEPEND, -1000, 1000, 216, 8, NULL}};
+
+const static struct Menu_Text Menu_SensorTexts[] = {
+    {0, 4, 0, "温度偏移：      ℃"},
+    {0, 8, 0, "湿度偏移：      ％"}};
+
+const static struct Menu_Screen Menu_SensorScreen = {
+    "传感器设置", 0, MENU_CURSOR_LEFT, 0, 2, 2, Menu_SensorFields, Menu_SensorTexts, NULL, NULL};
+
+const static struct Menu_Field Menu_VrefintFields[] = {
+    {120, 4, MENU_FIELD_VALUE, MENU_DATA_I16, offsetof(struct Func_Setting, vrefint_offset), MENU_FORMAT_SIGN | 4, MENU_NO_DEPEND, -127, 127, 168, 4, NULL}};
+
+const static struct Menu_Field Menu_AgingFields[] = {
+    {120, 4, MENU_FIELD_VALUE, MENU_DATA_I8, offsetof(struct Func_Setting, rtc_aging_offset), MENU_FORMAT_SIGN | 4, MENU_NO_DEPEND, -127, 127, 168, 4, NULL}};
+
+const static struct Menu_Text Menu_OffsetTexts[] = {
+    {0, 4, 0, "偏移数值："},
+    {0, 8, 1, "[每个偏移约为0.1ppm]"}};
+
+const static struct Menu_Screen Menu_VrefintScreen = {
+    "参考电压设置", 0, MENU_CURSOR_LEFT, 0, 1, 1, Menu_VrefintFields, Menu_OffsetTexts, Menu_DrawVrefint, NULL};
+
+const static struct Menu_Screen Menu_AgingScreen = {
+    "时钟老化设置", 0, MENU_CURSOR_LEFT, 0, 1, 2, Menu_AgingFields, Menu_OffsetTexts, NULL, NULL};
+
+const static struct Menu_Field Menu_FaceFields[] = {
+    {96, 4, MENU_FIELD_SWITCH, MENU_DATA_U8, offsetof(struct Func_Setting, home_face), 0, MENU_NO_DEPEND, 0, HOME_FACE_COUNT - 1, 156, 4, Home_FaceNames}};
+
+const static struct Menu_Text Menu_FaceTexts[] = {
+    {0, 4, 0, "主屏幕："}};
+
+const static struct Menu_Screen Menu_FaceScreen = {
+    "显示设置", 0, MENU_CURSOR_LEFT, 0, 1, 1, Menu_FaceFields, Menu_FaceTexts, NULL, NULL};
+
+/* 钟声设置页面编辑的数据，切换序号时保存当前钟声并读取另一个 */
+struct Menu_AlarmData
+{
+    uint8_t index; /* 1 ~ ALARM_COUNT */
+    uint8_t shown; /* hours等变量对应的序号 */
+    uint8_t hours;
+    uint8_t minutes;
+    uint8_t weekday[7]; /* 星期一 ~ 星期日，0为关闭 */
+    struct ALARM_Entry alarms[ALARM_COUNT];
+};
+
+#define ALARM_DAY_FIELD(day) \
+    {(day) * 28, 11, MENU_FIELD_SWITCH, MENU_DATA_U8, offsetof(struct Menu_AlarmData, weekday) + (day), 0, MENU_NO_DEPEND, 0, 1, (day) * 28 + 6, 14, Menu_TextOffOn}
+
+const static struct Menu_Field Menu_AlarmFields[] = {
+    {48, 4, MENU_FIELD_VALUE | MENU_FIELD_CHECK, MENU_DATA_U8, offsetof(struct Menu_AlarmData, index), 1, MENU_NO_DEPEND, 1, ALARM_COUNT, 48, 7, NULL},
+    {120, 4, MENU_FIELD_VALUE, MENU_DATA_U8, offsetof(struct Menu_AlarmData, hours), 2, MENU_NO_DEPEND, 0, 23, 126, 7, NULL},
+    {156, 4, MENU_FIELD_VALUE, MENU_DATA_U8, offsetof(struct Menu_AlarmData, minutes), 2, MENU_NO_DEPEND, 0, 59, 162, 7, NULL},
+    ALARM_DAY_FIELD(0),
+    ALARM_DAY_FIELD(1),
+    ALARM_DAY_FIELD(2),
+    ALARM_DAY_FIELD(3),
+    ALARM_DAY_FIELD(4),
+    ALARM_DAY_FIELD(5),
+    ALARM_DAY_FIELD(6)};
+
+const static struct Menu_Text Menu_AlarmTexts[] = {
+    {0, 4, 0, "钟声 /" MENU_STRINGIFY(ALARM_COUNT)},
+    {144, 4, 0, ":"},
+    {0, 8, 4, "一二三四五六日"}};
+
+const static struct Menu_Screen Menu_AlarmScreen = {
+    "钟声设置", 0, MENU_CURSOR_UP, 0, sizeof(Menu_AlarmFields) / sizeof(Menu_AlarmFields[0]), sizeof(Menu_AlarmTexts) / sizeof(Menu_AlarmTexts[0]),
+    Menu_AlarmFields, Menu_AlarmTexts, NULL, Menu_CheckAlarm};
+
+const static struct Menu_Field Menu_HWVerFields[] = {
+    {132, 4, MENU_FIELD_DIGIT, MENU_DATA_U8, 0, 0, MENU_NO_DEPEND, 0, 9, 132, 7, NULL},
+    {156, 4, MENU_FIELD_DIGIT, MENU_DATA_U8, 1, 0, MENU_NO_DEPEND, 0, 9, 156, 7, NULL}};
+
+const static struct Menu_Text Menu_HWVerTexts[] = {
+    {0, 4, 0, "硬件版本：V ."},
+    {0, 8, 0, "[注意：设置保存后不会再"},
+    {0, 12, 0, "显示此菜单]"}};
+
+const static struct Menu_Screen Menu_HWVerScreen = {
+    "硬件版本设置", 0, MENU_CURSOR_UP, 0, 2, 3, Menu_HWVerFields, Menu_HWVerTexts, NULL, NULL};
+
+const static struct Menu_Text Menu_ResetTexts[] = {
+    {0, 4, 0, "清除数据并恢复到初始设置"},
+    {0, 10, MENU_TEXT_SMALL, "*同时按住\"上\"和\"下\"键"},
+    {0, 12, MENU_TEXT_SMALL, " 并按\"复位\"键"},
+    {0, 14, MENU_TEXT_SMALL, " 可以强制擦除全部数据"}};
+
+const static struct Menu_Screen Menu_ResetScreen = {
+    "恢复设置", 1, MENU_CURSOR_LEFT, MENU_SCREEN_CONFIRM, 0, 4, NULL, Menu_ResetTexts, NULL, NULL};
+
+const static struct Menu_Item Menu_MainItems[] = {
+    {"返回", NULL, NULL},
+    {"时间设置", Menu_SetTime, NULL},
+    {"显示设置", NULL, &Menu_FaceScreen},
+    {"钟声设置", Menu_SetAlarm, NULL},
+    {"铃声设置", NULL, &Menu_BuzzerScreen},
+    {"电池设置", NULL, &Menu_BatteryScreen},
+    {"传感器设置", NULL, &Menu_SensorScreen},
+    {"参考电压设置", Menu_SetVrefint, NULL},
+    {"时钟老化设置", NULL, &Menu_AgingScreen},
+    {"系统信息", Menu_Info, NULL},
+    {"恢复默认设置", Menu_ResetAll, NULL},
+    {"清除屏幕", Menu_ClearScreen, NULL}};
+
+#define MENU_MAIN_COUNT ((uint8_t)(sizeof(Menu_MainItems) / sizeof(Menu_MainItems[0])))
 
 static void Menu_DrawMenuFrame(char *title, uint8_t button_style)
 {
     uint8_t i;
 
+    Home_Shown.valid = 0;
     EPD_Init(EPD_UPDATE_MODE_FAST);
     EPD_ClearRAM();
     for (i = 0; i < 2; i++)
@@ -438,1920 +1141,1923 @@ static void Menu_DrawSubmenuSaveSelect(uint8_t select)
     }
 }
 
-static void Menu_MainMenu(void)
+/* 字符串使用12x24和24x24字体时的宽度 */
+static uint16_t Menu_TextWidth(const char *str)
 {
-    uint8_t select, exit, full_update, wait_btn, update_display;
+    uint16_t width;
 
-    BEEP_OK();
-    exit = 0;
-    full_update = 1;
-    select = 0;
-    wait_btn = 0;
-    update_display = 0;
-    while (exit == 0)
+    width = 0;
+    while (*str != '\0')
     {
-        if (full_update == 0)
+        if ((*str & 0x80) == 0x00)
         {
-            if (BTN_ReadDOWN() == 0)
-            {
-                if (select < 9)
-                {
-                    select += 1;
-                }
-                else
-                {
-                    select = 0;
-                }
-                wait_btn = 1;
-            }
-            else if (BTN_ReadUP() == 0)
-            {
-                if (select > 0)
-                {
-                    select -= 1;
-                }
-                else
-                {
-                    select = 9;
-                }
-                wait_btn = 1;
-            }
-            else if (BTN_ReadSET() == 0)
-            {
-                BEEP_OK();
-                switch (select)
-                {
-                case 0:
-                    exit = 1;
-                    update_display = 0;
-                    wait_btn = 0;
-                    break;
-                case 1:
-                    Menu_SetTime();
-                    break;
-                case 2:
-                    Menu_SetBuzzer();
-                    break;
-                case 3:
-                    Menu_SetBattery();
-                    break;
-                case 4:
-                    Menu_SetSensor();
-                    break;
-                case 5:
-                    Menu_SetVrefint();
-                    break;
-                case 6:
-                    Menu_SetRTCAging();
-                    break;
-                case 7:
-                    Menu_Info();
-                    break;
-                case 8:
-                    Menu_ResetAll();
-                    break;
-                case 9:
-                    EPD_Init(EPD_UPDATE_MODE_FULL);
-                    EPD_ClearRAM();
-                    EPD_Show(0);
-                    LP_EnterStop(EPD_TIMEOUT_MS);
-                    LP_DelayStop(1000);
-                    EPD_ClearArea(0, 0, 296, 16, 0x00);
-                    EPD_Show(0);
-                    LP_EnterStop(EPD_TIMEOUT_MS);
-                    LP_DelayStop(1000);
-                    EPD_ClearRAM();
-                    EPD_Show(0);
-                    LP_EnterStop(EPD_TIMEOUT_MS);
-                    LP_DelayStop(1000);
-                    BEEP_OK();
-                    break;
-                case 10:
-                    /* code */
-                    break;
-                case 11:
-                    /* code */
-                    break;
-                }
-                full_update = 1;
-            }
-            if (wait_btn != 0)
-            {
-                update_display = 1;
-            }
-            if (update_display != 0)
-            {
-                if (EPD_GetBusy() == 0)
-                {
-                    update_display = 0;
-                    EPD_ClearArea(0, 4, 24, 12, 0xFF);
-                    snprintf(String, sizeof(String), "▶");
-                    EPD_DrawUTF8(0, 4 + ((select % 4) * 3), 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    snprintf(String, sizeof(String), "%d/%d页", (select / 4) + 1, (8 / 4) + 1);
-                    EPD_DrawUTF8(236, 13, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    if (select <= 3)
-                    {
-                        snprintf(String, sizeof(String), "1.返回        ");
-                        EPD_DrawUTF8(25, 4, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                        snprintf(String, sizeof(String), "2.时间设置    ");
-                        EPD_DrawUTF8(25, 7, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                        snprintf(String, sizeof(String), "3.铃声设置    ");
-                        EPD_DrawUTF8(25, 10, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                        snprintf(String, sizeof(String), "4.电池设置    ");
-                        EPD_DrawUTF8(25, 13, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    }
-                    else if (select >= 4 && select <= 7)
-                    {
-                        snprintf(String, sizeof(String), "5.传感器设置  ");
-                        EPD_DrawUTF8(25, 4, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                        snprintf(String, sizeof(String), "6.参考电压设置");
-                        EPD_DrawUTF8(25, 7, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                        snprintf(String, sizeof(String), "7.时钟老化设置");
-                        EPD_DrawUTF8(25, 10, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                        snprintf(String, sizeof(String), "8.系统信息    ");
-                        EPD_DrawUTF8(25, 13, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    }
-                    else if (select >= 8 && select <= 11)
-                    {
-                        snprintf(String, sizeof(String), "9.恢复默认设置");
-                        EPD_DrawUTF8(25, 4, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                        snprintf(String, sizeof(String), "10.清除屏幕   ");
-                        EPD_DrawUTF8(25, 7, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                        snprintf(String, sizeof(String), "              ");
-                        EPD_DrawUTF8(25, 10, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                        snprintf(String, sizeof(String), "              ");
-                        EPD_DrawUTF8(25, 13, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    }
-                    EPD_Show(0);
-                }
-            }
-            if (wait_btn != 0)
-            {
-                BEEP_Button();
-                BTN_WaitAll();
-                wait_btn = 0;
-            }
+            width += 12;
         }
-        else
+        else if ((*str & 0xC0) == 0xC0) /* UTF8首字节 */
         {
-            full_update = 0;
-            update_display = 1;
-            Menu_DrawMenuFrame("主菜单", 3);
-            BTN_WaitAll();
+            width += 24;
         }
+        str++;
     }
+    return width;
 }
 
-/* ==================== 子菜单 ==================== */
+static uint8_t Menu_FieldEnabled(const struct Menu_Field *field, const void *data)
+{
+    return field->depend == MENU_NO_DEPEND || ((const uint8_t *)data)[field->depend] != 0;
+}
 
-static void Menu_SetTime(void) /* 时间设置页面 */
+static int16_t Menu_GetValue(const struct Menu_Field *field, const void *data)
 {
-    struct RTC_Time new_time;
-    uint8_t select, save, update_display, wait_btn, time_check, arrow_y;
-    uint16_t arrow_x;
+    const uint8_t *ptr;
 
-    Menu_DrawMenuFrame("时间设置", 0);
-    BTN_WaitAll();
-    RTC_GetTime(&new_time);
-    if (RTC_GetOSF() != 0 || new_time.Month == 0)
+    ptr = (const uint8_t *)data + field->offset;
+    switch (field->data)
     {
-        memcpy(&new_time, &DefaultTime, sizeof(struct RTC_Time));
+    case MENU_DATA_I8:
+        return *(const int8_t *)ptr;
+    case MENU_DATA_I16:
+        return *(const int16_t *)ptr;
+    case MENU_DATA_FLOAT:
+        return FMT_Scale(*(const float *)ptr, 2);
+    default:
+        return *ptr;
     }
-    select = 0;
-    update_display = 1;
-    time_check = 0;
-    wait_btn = 0;
-    save = 0;
-    while (save == 0)
+}
+
+static void Menu_SetValue(const struct Menu_Field *field, void *data, int16_t value)
+{
+    uint8_t *ptr;
+
+    ptr = (uint8_t *)data + field->offset;
+    switch (field->data)
+    {
+    case MENU_DATA_I8:
+        *(int8_t *)ptr = value;
+        break;
+    case MENU_DATA_I16:
+        *(int16_t *)ptr = value;
+        break;
+    case MENU_DATA_FLOAT:
+        *(float *)ptr = (float)value / 100;
+        break;
+    default:
+        *ptr = value;
+        break;
+    }
+}
+
+/**
+ * @brief  按“上”或“下”键修改字段绑定的变量。
+ * @param  field 字段。
+ * @param  data 字段绑定的数据结构。
+ * @param  up 1：“上”键，0：“下”键。
+ * @param  repeat 连发次数，按下时为0。
+ */
+static void Menu_EditField(const struct Menu_Field *field, void *data, uint8_t up, uint8_t repeat)
+{
+    int16_t value;
+    uint8_t pos;
+
+    value = Menu_GetValue(field, data);
+    switch (field->type & ~MENU_FIELD_CHECK)
     {
-        if (BTN_ReadSET() == 0)
+    case MENU_FIELD_DIGIT:
+        value = NUM_CycleDigit(value, field->format, up, field->min, field->max);
+        break;
+    case MENU_FIELD_SWITCH:
+        value = NUM_Step(value, 0, up, field->min, field->max, NUM_WRAP);
+        break;
+    default:
+        pos = repeat / MENU_REPEAT_DIGIT;
+        if (pos > NUM_MaxStepPos(field->min, field->max))
         {
-            if (select < 17)
-            {
-                select += 1;
-            }
-            else
-            {
-                select = 0;
-            }
-            if (select == 9 && new_time.Is_12hr == 0)
-            {
-                select += 1;
-            }
-            if (time_check != 0)
-            {
-                RTC_CheckTimeRange(&new_time);
-                time_check = 0;
-            }
-            wait_btn = 1;
-        }
-        else
-        {
-            switch (select)
-            {
-            case 0:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Year, 2, 1, 0);
-                break;
-            case 1:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Year, 1, 9, 0);
-                break;
-            case 2:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Year, 0, 9, 0);
-                time_check = 1;
-                break;
-            case 3:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Month, 1, 1, 0);
-                break;
-            case 4:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Month, 0, 9, 0);
-                time_check = 1;
-                break;
-            case 5:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Date, 1, 3, 0);
-                break;
-            case 6:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Date, 0, 9, 0);
-                time_check = 1;
-                break;
-            case 7:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Day, 0, 7, 1);
-                break;
-            case 8:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Is_12hr, 0, 1, 0);
-                time_check = 1;
-                break;
-            case 9:
-                wait_btn = BTN_ModifySingleDigit(&new_time.PM, 0, 1, 0);
-                break;
-            case 10:
-                if (new_time.Is_12hr == 0)
-                {
-                    wait_btn = BTN_ModifySingleDigit(&new_time.Hours, 1, 2, 0);
-                }
-                else
-                {
-                    wait_btn = BTN_ModifySingleDigit(&new_time.Hours, 1, 1, 0);
-                }
-                break;
-            case 11:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Hours, 0, 9, 0);
-                time_check = 1;
-                break;
-            case 12:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Minutes, 1, 5, 0);
-                break;
-            case 13:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Minutes, 0, 9, 0);
-                time_check = 1;
-                break;
-            case 14:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Seconds, 1, 5, 0);
-                break;
-            case 15:
-                wait_btn = BTN_ModifySingleDigit(&new_time.Seconds, 0, 9, 0);
-                time_check = 1;
-                break;
-            case 16:
-                if (BTN_ReadUPFast() == 0)
-                {
-                    save = 2;
-                    wait_btn = 0;
-                    update_display = 0;
-                }
-                break;
-            case 17:
-                if (BTN_ReadUP() == 0)
-                {
-                    save = 1;
-                    wait_btn = 0;
-                    update_display = 0;
-                }
-                break;
-            }
-        }
-        if (wait_btn != 0)
-        {
-            update_display = 1;
-        }
-        if (update_display != 0)
-        {
-            if (EPD_GetBusy() == 0)
-            {
-                update_display = 0;
-                snprintf(String, sizeof(String), "2%03d年%02d月%02d日 周%d", new_time.Year, new_time.Month, new_time.Date, new_time.Day);
-                EPD_DrawUTF8(7, 4, 5, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                if (new_time.Is_12hr != 0)
-                {
-                    snprintf(String, sizeof(String), "时间格式：12小时制");
-                }
-                else
-                {
-                    snprintf(String, sizeof(String), "时间格式：24小时制");
-                }
-                EPD_DrawUTF8(5, 8, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                if (new_time.Is_12hr != 0)
-                {
-                    if (new_time.PM != 0)
-                    {
-                        snprintf(String, sizeof(String), "下午");
-                    }
-                    else
-                    {
-                        snprintf(String, sizeof(String), "上午");
-                    }
-                }
-                else
-                {
-                    snprintf(String, sizeof(String), "    ");
-                }
-                EPD_DrawUTF8(5, 12, 0, String, NULL, EPD_FontUTF8_24x24_B);
-                snprintf(String, sizeof(String), "%02d:%02d:%02d", new_time.Hours, new_time.Minutes, new_time.Seconds);
-                EPD_DrawUTF8(58, 12, 5, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                if (select <= 2)
-                {
-                    arrow_x = 24 + (select * 17);
-                    arrow_y = 7;
-                }
-                else if (select >= 3 && select <= 4)
-                {
-                    arrow_x = 104 + ((select - 3) * 17);
-                    arrow_y = 7;
-                }
-                else if (select >= 5 && select <= 6)
-                {
-                    arrow_x = 167 + ((select - 5) * 17);
-                    arrow_y = 7;
-                }
-                else if (select >= 7 && select <= 7)
-                {
-                    arrow_x = 276 + ((select - 7) * 17);
-                    arrow_y = 7;
-                }
-                else if (select >= 8 && select <= 8)
-                {
-                    arrow_x = 132;
-                    arrow_y = 11;
-                }
-                else if (select >= 9 && select <= 9)
-                {
-                    arrow_x = 23;
-                    arrow_y = 15;
-                }
-                else if (select >= 10 && select <= 11)
-                {
-                    arrow_x = 58 + ((select - 10) * 17);
-                    arrow_y = 15;
-                }
-                else if (select >= 12 && select <= 13)
-                {
-                    arrow_x = 109 + ((select - 12) * 17);
-                    arrow_y = 15;
-                }
-                else if (select >= 14 && select <= 15)
-                {
-                    arrow_x = 160 + ((select - 14) * 17);
-                    arrow_y = 15;
-                }
-                EPD_ClearArea(5, 7, 283, 1, 0xFF);
-                EPD_ClearArea(5, 11, 283, 1, 0xFF);
-                EPD_ClearArea(5, 15, 283, 1, 0xFF);
-
-                if (select == 16 || select == 17)
-                {
-                    Menu_DrawSubmenuSaveSelect(select - 16);
-                }
-                else
-                {
-                    EPD_DrawImage(arrow_x, arrow_y, EPD_Image_ArrowUp_12x8);
-                    Menu_DrawSubmenuSaveSelect(3);
-                }
-
-                EPD_Show(0);
-            }
-        }
-        if (save == 2)
-        {
-            RTC_SetTime(&new_time);
-        }
-        if (wait_btn != 0)
-        {
-            BEEP_Button();
-            BTN_WaitAll();
-            wait_btn = 0;
+            pos = NUM_MaxStepPos(field->min, field->max);
         }
+        value = NUM_Step(value, pos, up, field->min, field->max, 0);
+        break;
     }
-    BEEP_OK();
+    Menu_SetValue(field, data, value);
 }
 
-static void Menu_Guide(void) /* 首次使用时的引导 */
+static void Menu_DrawField(const struct Menu_Field *field, const void *data)
 {
-    Menu_DrawMenuFrame("欢迎使用", 2);
-    BTN_WaitAll();
-    EPD_DrawImage(0, 4, EPD_Image_Welcome_296x96);
-    EPD_Show(0);
-    LP_EnterStop(EPD_TIMEOUT_MS);
-    while (BTN_ReadSET() != 0)
+    const char *str;
+    int16_t value;
+    struct FMT_Buffer buf;
+
+    value = Menu_GetValue(field, data);
+    str = String;
+    FMT_Init(&buf, String, sizeof(String));
+    switch (field->type & ~MENU_FIELD_CHECK)
+    {
+    case MENU_FIELD_DIGIT:
+        FMT_Char(&buf, '0' + NUM_GetDigit(value, field->format));
+        break;
+    case MENU_FIELD_SWITCH:
+        str = field->text[value - field->min];
+        break;
+    default:
+        FMT_Fixed(&buf, value, (field->format & MENU_FORMAT_FIXED2) ? 2 : 0, field->format & 0x0F,
+                  FMT_ZERO | ((field->format & MENU_FORMAT_SIGN) ? FMT_SIGN : 0));
+        break;
+    }
+    if (Menu_FieldEnabled(field, data) != 0)
     {
-        LP_DelayStop(50);
+        EPD_DrawUTF8(field->x, field->y_x8, 0, str, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+    }
+    else
+    {
+        EPD_ClearArea(field->x, field->y_x8, Menu_TextWidth(str), 3, 0xFF);
     }
-    BEEP_OK();
 }
 
-static void Menu_SetBuzzer(void) /* 设置蜂鸣器状态 */
+static void Menu_DrawCursor(const struct Menu_Screen *screen, uint8_t select, uint8_t show)
 {
-    uint8_t select, save, update_display, wait_btn, volume, enable;
+    const struct Menu_Field *field;
 
-    Menu_DrawMenuFrame("铃声设置", 0);
-    BTN_WaitAll();
-    update_display = 1;
-    wait_btn = 0;
-    save = 0;
-    select = 0;
-    enable = Setting.buzzer_enable;
-    volume = Setting.buzzer_volume;
-    while (save == 0)
+    if (select >= screen->field_count) /* 保存和取消 */
     {
-        if (BTN_ReadSET() == 0)
+        if (show != 0)
         {
-            if (select < 3)
-            {
-                select += 1;
-            }
-            else
+            select -= screen->field_count;
+            if (select == 0 && (screen->flags & MENU_SCREEN_CONFIRM) != 0)
             {
-                select = 0;
+                select = 2;
             }
-            wait_btn = 1;
+            Menu_DrawSubmenuSaveSelect(select);
         }
         else
         {
-            switch (select)
-            {
-            case 0:
-                if (BTN_ReadUP() == 0 || BTN_ReadDOWN() == 0)
-                {
-                    if (Setting.buzzer_enable == 0)
-                    {
-                        Setting.buzzer_enable = 1;
-                    }
-                    else
-                    {
-                        Setting.buzzer_enable = 0;
-                    }
-                    wait_btn = 1;
-                }
-                break;
-            case 1:
-                if (BTN_ReadUP() == 0)
-                {
-                    if (Setting.buzzer_volume < BUZZER_MAX_VOL)
-                    {
-                        Setting.buzzer_volume += 1;
-                    }
-                    wait_btn = 1;
-                }
-                else if (BTN_ReadDOWN() == 0)
-                {
-                    if (Setting.buzzer_volume > 1)
-                    {
-                        Setting.buzzer_volume -= 1;
-                    }
-                    wait_btn = 1;
-                }
-                break;
-            case 2:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 2;
-                }
-                break;
-            case 3:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 1;
-                }
-                break;
-            }
-        }
-        if (wait_btn != 0)
-        {
-            update_display = 1;
-        }
-        if (update_display != 0)
-        {
-            if (EPD_GetBusy() == 0)
-            {
-                update_display = 0;
-                EPD_DrawUTF8(0, 4, 0, "蜂鸣器开启状态：", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                if (Setting.buzzer_enable != 0)
-                {
-                    EPD_DrawUTF8(192, 4, 0, "开启", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                }
-                else
-                {
-                    EPD_DrawUTF8(192, 4, 0, "关闭", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                }
-                snprintf(String, sizeof(String), "蜂鸣器音量：%02d/%02d", Setting.buzzer_volume, BUZZER_MAX_VOL);
-                EPD_DrawUTF8(0, 8, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                EPD_ClearArea(240, 4, 24, 3, 0xFF);
-                EPD_ClearArea(204, 8, 24, 3, 0xFF);
-                switch (select)
-                {
-                case 0:
-                    EPD_DrawUTF8(240, 4, 0, "◀", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    break;
-                case 1:
-                    EPD_DrawUTF8(204, 8, 0, "◀", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    break;
-                }
-                if (select == 2 || select == 3)
-                {
-                    Menu_DrawSubmenuSaveSelect(select - 2);
-                }
-                else
-                {
-                    Menu_DrawSubmenuSaveSelect(3);
-                }
-                EPD_Show(0);
-            }
-        }
-        if (save == 2)
-        {
-            SaveSetting(&Setting);
+            Menu_DrawSubmenuSaveSelect(3);
         }
-        else if (save == 1)
+        return;
+    }
+    field = &screen->fields[select];
+    if (screen->cursor == MENU_CURSOR_UP)
+    {
+        EPD_ClearArea(field->cursor_x, field->cursor_y_x8, 12, 1, 0xFF);
+        if (show != 0)
         {
-            Setting.buzzer_enable = enable;
-            Setting.buzzer_volume = volume;
+            EPD_DrawImage(field->cursor_x, field->cursor_y_x8, EPD_Image_ArrowUp_12x8);
         }
-        if (wait_btn != 0)
+    }
+    else
+    {
+        EPD_ClearArea(field->cursor_x, field->cursor_y_x8, 24, 3, 0xFF);
+        if (show != 0)
         {
-            wait_btn = 0;
-            BEEP_Button();
-            BTN_WaitAll();
+            EPD_DrawUTF8(field->cursor_x, field->cursor_y_x8, 0, "◀", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
         }
     }
-    BEEP_OK();
 }
 
-static void Menu_SetBattery(void) /* 设置电池信息 */
+/**
+ * @brief  运行设置页面。
+ * @param  screen 页面描述。
+ * @param  data 字段绑定的数据结构，直接在其中修改。
+ * @return 1：选择了保存（或继续），0：选择了取消。
+ * @note   选择取消时data中已修改的数据不会恢复，需要调用者处理。
+ * @note   按住“上”或“下”键时按BTN_EVENT_REPEAT连续修改，间隔逐渐缩短；长按“设置”键直接移到保存。
+ */
+static uint8_t Menu_Run(const struct Menu_Screen *screen, void *data)
 {
-    uint8_t select, save, update_display, wait_btn, long_press;
-    float bat_warn, bat_stop, tmp;
-
-    Menu_DrawMenuFrame("电池设置", 0);
-    BTN_WaitAll();
-    update_display = 1;
-    wait_btn = 0;
-    save = 0;
-    select = 0;
-    long_press = 0;
-    bat_warn = Setting.battery_warn;
-    bat_stop = Setting.battery_stop;
-    while (save == 0)
-    {
-        if (BTN_ReadSET() == 0)
-        {
-            if (select < 3)
+    struct BTN_Event event;
+    uint32_t dirty;
+    uint8_t i, select, last_select, count, result, update, type;
+
+    Menu_DrawMenuFrame((char *)screen->title, screen->button_style);
+    for (i = 0; i < screen->text_count; i++)
+    {
+        EPD_DrawUTF8(screen->texts[i].x, screen->texts[i].y_x8, screen->texts[i].style & ~MENU_TEXT_SMALL, screen->texts[i].str,
+                     (screen->texts[i].style & MENU_TEXT_SMALL) ? EPD_FontAscii_8x16 : EPD_FontAscii_12x24_B,
+                     (screen->texts[i].style & MENU_TEXT_SMALL) ? EPD_FontUTF8_16x16_B : EPD_FontUTF8_24x24_B);
+    }
+    BTN_Flush();
+    count = screen->field_count + 2;
+    select = ((screen->flags & MENU_SCREEN_CONFIRM) != 0) ? count - 1 : 0;
+    last_select = select;
+    dirty = 0xFFFFFFFF;
+    update = 1;
+    result = 0xFF;
+    while (result == 0xFF)
+    {
+        type = BTN_GetEvent(&event);
+        if ((type == BTN_EVENT_PRESS || (type == BTN_EVENT_LONG && select < screen->field_count)) && event.Key == BTN_KEY_SET)
+        {
+            if (select < screen->field_count && (screen->fields[select].type & MENU_FIELD_CHECK) != 0)
+            {
+                screen->check(data);
+                dirty = 0xFFFFFFFF;
+            }
+            if (type == BTN_EVENT_LONG)
             {
-                select += 1;
+                select = screen->field_count;
             }
             else
             {
-                select = 0;
+                do
+                {
+                    select = (select + 1 < count) ? select + 1 : 0;
+                } while (select < screen->field_count && Menu_FieldEnabled(&screen->fields[select], data) == 0);
             }
-            long_press = 255;
-            wait_btn = 1;
+            update = 1;
+            BEEP_Button();
         }
-        else
+        else if ((type == BTN_EVENT_PRESS || type == BTN_EVENT_REPEAT) && event.Key != BTN_KEY_SET && select < screen->field_count &&
+                 (type == BTN_EVENT_PRESS || (screen->fields[select].type & ~MENU_FIELD_CHECK) != MENU_FIELD_SWITCH))
         {
-            if (BTN_ReadSET() != 0 && BTN_ReadUP() != 0 && BTN_ReadDOWN() != 0)
-            {
-                long_press = 6;
-            }
-            switch (select)
+            Menu_EditField(&screen->fields[select], data, event.Key == BTN_KEY_UP, (type == BTN_EVENT_REPEAT) ? event.Count : 0);
+            dirty |= 1UL << select;
+            for (i = 0; i < screen->field_count; i++) /* 依赖此字段的字段也需要重绘 */
             {
-            case 0:
-                if (BTN_ReadUP() == 0)
-                {
-                    if ((bat_warn + 0.005) < BAT_MAX_VOLTAGE)
-                    {
-                        bat_warn += 0.01;
-                    }
-                    wait_btn = 1;
-                }
-                else if (BTN_ReadDOWN() == 0)
-                {
-                    if ((bat_warn - 0.005) > BAT_MIN_VOLTAGE)
-                    {
-                        bat_warn -= 0.01;
-                    }
-                    wait_btn = 1;
-                }
-                break;
-            case 1:
-                if (BTN_ReadUP() == 0)
-                {
-                    if ((bat_stop + 0.005) < BAT_MAX_VOLTAGE)
-                    {
-                        bat_stop += 0.01;
-                    }
-                    wait_btn = 1;
-                }
-                else if (BTN_ReadDOWN() == 0)
-                {
-                    if ((bat_stop - 0.005) > BAT_MIN_VOLTAGE)
-                    {
-                        bat_stop -= 0.01;
-                    }
-                    wait_btn = 1;
-                }
-                break;
-            case 2:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 2;
-                }
-                break;
-            case 3:
-                if (BTN_ReadUP() == 0)
+                if (screen->fields[i].depend == screen->fields[select].offset)
                 {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 1;
+                    dirty |= 1UL << i;
                 }
-                break;
+            }
+            update = 1;
+            if (type == BTN_EVENT_PRESS)
+            {
+                BEEP_Button();
+            }
+            else
+            {
+                BEEP_Fast();
             }
         }
-        if (wait_btn != 0)
+        else if (type == BTN_EVENT_PRESS && event.Key == BTN_KEY_UP && select >= screen->field_count)
         {
-            update_display = 1;
+            result = (select == screen->field_count) ? 1 : 0;
         }
-        if (update_display != 0)
+        else if (type == BTN_EVENT_NONE && update == 0) /* 没有按键，也没有可以刷新的内容，在Stop模式中等待按键中断 */
         {
-            if (EPD_GetBusy() == 0)
-            {
-                update_display = 0;
-                tmp = bat_warn + 0.005;
-                snprintf(String, sizeof(String), "警告电压：%d.%02dV", (int8_t)tmp, (uint16_t)((tmp - (int8_t)tmp) * 100));
-                EPD_DrawUTF8(0, 4, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                tmp = bat_stop + 0.005;
-                snprintf(String, sizeof(String), "截止电压：%d.%02dV", (int8_t)(tmp), (uint16_t)(((tmp) - (int8_t)(tmp)) * 100));
-                EPD_DrawUTF8(0, 8, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                tmp = ADC_GetChannel(ADC_CHANNEL_BATTERY) + 0.005;
-                snprintf(String, sizeof(String), "[实时电压：%d.%02dV]", (int8_t)(tmp), (uint16_t)(((tmp) - (int8_t)(tmp)) * 100));
-                EPD_DrawUTF8(0, 12, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                EPD_ClearArea(180, 4, 24, 3, 0xFF);
-                EPD_ClearArea(180, 8, 24, 3, 0xFF);
-                switch (select)
-                {
-                case 0:
-                    EPD_DrawUTF8(180, 4, 0, "◀", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    break;
-                case 1:
-                    EPD_DrawUTF8(180, 8, 0, "◀", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    break;
-                }
-
-                if (select == 2 || select == 3)
-                {
-                    Menu_DrawSubmenuSaveSelect(select - 2);
-                }
-                else
-                {
-                    Menu_DrawSubmenuSaveSelect(3);
-                }
-                EPD_Show(0);
-            }
+            BTN_Wait(BTN_IDLE_WAIT_MS);
         }
-        if (save == 2)
+        else if (type == BTN_EVENT_NONE && EPD_GetBusy() != 0) /* 有内容等待刷新，轮询电子纸刷新完成 */
         {
-            Setting.battery_warn = bat_warn;
-            Setting.battery_stop = bat_stop;
-            SaveSetting(&Setting);
+            BTN_Wait(MENU_IDLE_MS);
         }
-        if (wait_btn != 0)
+        if (update != 0 && result == 0xFF && EPD_GetBusy() == 0) /* 连续修改时只显示刷新时的最新数值 */
         {
-            wait_btn = 0;
-            if (long_press != 0)
+            update = 0;
+            for (i = 0; i < screen->field_count; i++)
             {
-                BEEP_Button();
+                if ((dirty & (1UL << i)) != 0)
+                {
+                    Menu_DrawField(&screen->fields[i], data);
+                }
             }
-            else
+            dirty = 0;
+            if (last_select != select)
             {
-                BEEP_Fast();
+                Menu_DrawCursor(screen, last_select, 0);
             }
-            while (long_press != 0 && (BTN_ReadDOWN() == 0 || BTN_ReadUP() == 0 || BTN_ReadSET() == 0))
+            Menu_DrawCursor(screen, select, 1);
+            last_select = select;
+            if (screen->draw != NULL)
             {
-                LL_mDelay(0);
-                if (long_press != 255)
-                {
-                    long_press -= 1;
-                }
+                screen->draw(data);
             }
+            EPD_Show(0);
         }
     }
     BEEP_OK();
+    return result;
+}
+
+/* 直接修改Setting，保存时应用并写入EEPROM，取消时恢复 */
+static void Menu_RunSetting(const struct Menu_Screen *screen)
+{
+    struct Func_Setting backup;
+
+    memcpy(&backup, &Setting, sizeof(struct Func_Setting));
+    if (Menu_Run(screen, &Setting) != 0)
+    {
+        ApplySetting(&Setting);
+        SaveSetting(&Setting);
+    }
+    else
+    {
+        memcpy(&Setting, &backup, sizeof(struct Func_Setting));
+    }
+}
+
+static void Menu_DrawBatteryVoltage(const void *data)
+{
+    struct FMT_Buffer buf;
+
+    ((void)data);
+    FMT_Init(&buf, String, sizeof(String));
+    FMT_String(&buf, "[实时电压：");
+    FMT_Fixed(&buf, FMT_Scale(ADC_GetChannel(ADC_CHANNEL_BATTERY), 2), 2, 0, 0);
+    FMT_String(&buf, "V]");
+    EPD_DrawUTF8(0, 12, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+}
+
+static void Menu_DrawVrefint(const void *data)
+{
+    float vrefint_factory;
+    struct FMT_Buffer buf;
+
+    vrefint_factory = ADC_GetVrefintFactory() + (ADC_GetVrefintStep() * ((const struct Func_Setting *)data)->vrefint_offset);
+    FMT_Init(&buf, String, sizeof(String));
+    FMT_String(&buf, "[实际电压：");
+    FMT_Fixed(&buf, FMT_Scale(vrefint_factory, 3), 3, 8, FMT_ZERO);
+    FMT_String(&buf, "mV]");
+    EPD_DrawUTF8(0, 8, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+}
+
+static void Menu_CheckTime(void *data)
+{
+    RTC_CheckTimeRange((struct RTC_Time *)data);
+}
+
+/* 读取index对应的钟声到编辑的变量 */
+static void Menu_LoadAlarm(struct Menu_AlarmData *alarm_data)
+{
+    const struct ALARM_Entry *entry;
+    uint8_t day;
+
+    entry = &alarm_data->alarms[alarm_data->index - 1];
+    alarm_data->shown = alarm_data->index;
+    alarm_data->hours = entry->Hours;
+    alarm_data->minutes = entry->Minutes;
+    for (day = 0; day < 7; day++)
+    {
+        alarm_data->weekday[day] = (entry->Weekdays >> day) & 0x01;
+    }
+}
+
+/* 将编辑的变量写回shown对应的钟声 */
+static void Menu_StoreAlarm(struct Menu_AlarmData *alarm_data)
+{
+    struct ALARM_Entry *entry;
+    uint8_t day;
+
+    entry = &alarm_data->alarms[alarm_data->shown - 1];
+    entry->Hours = alarm_data->hours;
+    entry->Minutes = alarm_data->minutes;
+    entry->Weekdays = 0;
+    for (day = 0; day < 7; day++)
+    {
+        if (alarm_data->weekday[day] != 0)
+        {
+            entry->Weekdays |= 0x01 << day;
+        }
+    }
+}
+
+/* 离开序号字段时保存正在编辑的钟声，并读取新序号的钟声 */
+static void Menu_CheckAlarm(void *data)
+{
+    Menu_StoreAlarm((struct Menu_AlarmData *)data);
+    Menu_LoadAlarm((struct Menu_AlarmData *)data);
 }
 
-static void Menu_SetSensor(void) /* 设置传感器信息 */
+/* ==================== 主菜单 ==================== */
+
+static void Menu_DrawMainMenu(uint8_t select, uint8_t last_select)
+{
+    uint8_t i, page;
+    struct FMT_Buffer buf;
+
+    page = select / MENU_PAGE_ITEMS;
+    if (last_select / MENU_PAGE_ITEMS != page) /* 换页时重绘项目和页码 */
+    {
+        EPD_ClearArea(25, 4, 211, 12, 0xFF);
+        for (i = page * MENU_PAGE_ITEMS; i < (page + 1) * MENU_PAGE_ITEMS && i < MENU_MAIN_COUNT; i++)
+        {
+            FMT_Init(&buf, String, sizeof(String));
+            FMT_Uint(&buf, i + 1, 0, 0);
+            FMT_Char(&buf, '.');
+            FMT_String(&buf, Menu_MainItems[i].name);
+            EPD_DrawUTF8(25, 4 + ((i % MENU_PAGE_ITEMS) * 3), 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+        }
+        FMT_Init(&buf, String, sizeof(String));
+        FMT_Uint(&buf, page + 1, 0, 0);
+        FMT_Char(&buf, '/');
+        FMT_Uint(&buf, (MENU_MAIN_COUNT + MENU_PAGE_ITEMS - 1) / MENU_PAGE_ITEMS, 0, 0);
+        FMT_String(&buf, "页");
+        EPD_DrawUTF8(236, 13, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+    }
+    EPD_ClearArea(0, 4, 24, 12, 0xFF);
+    EPD_DrawUTF8(0, 4 + ((select % MENU_PAGE_ITEMS) * 3), 0, "▶", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+}
+
+static void Menu_MainMenu(void)
 {
-    uint8_t select, save, update_display, wait_btn, long_press;
-    float temp_offset, rh_offset, tmp;
+    struct BTN_Event event;
+    uint8_t select, last_select, exit, full_update, update_display, type;
 
-    Menu_DrawMenuFrame("传感器设置", 0);
-    BTN_WaitAll();
-    update_display = 1;
-    wait_btn = 0;
-    save = 0;
+    BEEP_OK();
+    exit = 0;
+    full_update = 1;
     select = 0;
-    long_press = 0;
-    temp_offset = Setting.sensor_temp_offset;
-    rh_offset = Setting.sensor_rh_offset;
-    while (save == 0)
+    last_select = 0;
+    update_display = 0;
+    while (exit == 0)
     {
-        if (BTN_ReadSET() == 0)
+        if (full_update != 0)
+        {
+            full_update = 0;
+            update_display = 1;
+            last_select = 0xFF; /* 重绘全部项目 */
+            Menu_DrawMenuFrame("主菜单", 3);
+            BTN_Flush();
+        }
+        type = BTN_GetEvent(&event);
+        if ((type == BTN_EVENT_PRESS || type == BTN_EVENT_REPEAT) && event.Key != BTN_KEY_SET) /* 按住“上”或“下”键连续移动 */
         {
-            if (select < 3)
+            if (event.Key == BTN_KEY_DOWN)
             {
-                select += 1;
+                select = (select < MENU_MAIN_COUNT - 1) ? select + 1 : 0;
             }
             else
             {
-                select = 0;
+                select = (select > 0) ? select - 1 : MENU_MAIN_COUNT - 1;
+            }
+            update_display = 1;
+            if (type == BTN_EVENT_PRESS)
+            {
+                BEEP_Button();
+            }
+            else
+            {
+                BEEP_Fast();
             }
-            wait_btn = 1;
-            long_press = 255;
         }
-        else
+        else if (type == BTN_EVENT_PRESS && event.Key == BTN_KEY_SET)
         {
-            if (BTN_ReadSET() != 0 && BTN_ReadUP() != 0 && BTN_ReadDOWN() != 0)
+            BEEP_OK();
+            if (Menu_MainItems[select].action != NULL)
             {
-                long_press = 6;
+                Menu_MainItems[select].action();
             }
-            switch (select)
+            else if (Menu_MainItems[select].screen != NULL)
             {
-            case 0:
-                if (BTN_ReadUP() == 0)
-                {
-                    if ((temp_offset + 0.005) < 10.00)
-                    {
-                        temp_offset += 0.01;
-                    }
-                    wait_btn = 1;
-                }
-                else if (BTN_ReadDOWN() == 0)
-                {
-                    if ((temp_offset - 0.005) > -10.00)
-                    {
-                        temp_offset -= 0.01;
-                    }
-                    wait_btn = 1;
-                }
-                break;
-            case 1:
-                if (BTN_ReadUP() == 0)
-                {
-                    if ((rh_offset + 0.005) < 10.00)
-                    {
-                        rh_offset += 0.01;
-                    }
-                    wait_btn = 1;
-                }
-                else if (BTN_ReadDOWN() == 0)
-                {
-                    if ((rh_offset - 0.005) > -10.00)
-                    {
-                        rh_offset -= 0.01;
-                    }
-                    wait_btn = 1;
-                }
-                break;
-            case 2:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 2;
-                }
-                break;
-            case 3:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 1;
-                }
-                break;
+                Menu_RunSetting(Menu_MainItems[select].screen);
+            }
+            else
+            {
+                exit = 1;
             }
+            full_update = 1;
         }
-        if (wait_btn != 0)
+        else if (type == BTN_EVENT_NONE && update_display == 0) /* 没有按键，也没有可以刷新的内容，在Stop模式中等待按键中断 */
         {
-            update_display = 1;
+            BTN_Wait(BTN_IDLE_WAIT_MS);
         }
-        if (update_display != 0)
+        else if (type == BTN_EVENT_NONE && EPD_GetBusy() != 0) /* 有内容等待刷新，轮询电子纸刷新完成 */
         {
-            if (EPD_GetBusy() == 0)
-            {
-                update_display = 0;
-
-                if (temp_offset > 0)
-                {
-                    tmp = temp_offset + 0.005;
-                }
-                else
-                {
-                    tmp = temp_offset - 0.005;
-                }
-                if (tmp > -1.0 && tmp <= -0.01)
-                {
-                    snprintf(String, sizeof(String), "温度偏移：-%02d.%02d℃", (int8_t)tmp, abs((int16_t)((tmp - (int8_t)tmp) * 100)));
-                }
-                else
-                {
-                    snprintf(String, sizeof(String), "温度偏移：%+03d.%02d℃", (int8_t)tmp, abs((int16_t)((tmp - (int8_t)tmp) * 100)));
-                }
-                EPD_DrawUTF8(0, 4, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-
-                if (rh_offset > 0)
-                {
-                    tmp = rh_offset + 0.005;
-                }
-                else
-                {
-                    tmp = rh_offset - 0.005;
-                }
-                if (tmp >= -1.0 && tmp <= -0.01)
-                {
-                    snprintf(String, sizeof(String), "湿度偏移：-%02d.%02d％", (int8_t)tmp, abs((int16_t)((tmp - (int8_t)tmp) * 100)));
-                }
-                else
-                {
-                    snprintf(String, sizeof(String), "湿度偏移：%+03d.%02d％", (int8_t)tmp, abs((int16_t)((tmp - (int8_t)tmp) * 100)));
-                }
-                EPD_DrawUTF8(0, 8, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                EPD_ClearArea(216, 4, 24, 3, 0xFF);
-                EPD_ClearArea(216, 8, 24, 3, 0xFF);
-                switch (select)
-                {
-                case 0:
-                    EPD_DrawUTF8(216, 4, 0, "◀", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    break;
-                case 1:
-                    EPD_DrawUTF8(216, 8, 0, "◀", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    break;
-                }
-
-                if (select == 2 || select == 3)
-                {
-                    Menu_DrawSubmenuSaveSelect(select - 2);
-                }
-                else
-                {
-                    Menu_DrawSubmenuSaveSelect(3);
-                }
-
-                EPD_Show(0);
-            }
-        }
-        if (save == 2)
-        {
-            Setting.sensor_temp_offset = temp_offset;
-            Setting.sensor_rh_offset = rh_offset;
-            TH_SetTemperatureOffset(temp_offset);
-            TH_SetHumidityOffset(rh_offset);
-            SaveSetting(&Setting);
+            BTN_Wait(MENU_IDLE_MS);
         }
-        if (wait_btn != 0)
+        if (update_display != 0 && exit == 0 && full_update == 0 && EPD_GetBusy() == 0)
         {
-            wait_btn = 0;
-            if (long_press != 0)
-            {
-                BEEP_Button();
-            }
-            else
-            {
-                BEEP_Fast();
-            }
-            while (long_press != 0 && (BTN_ReadDOWN() == 0 || BTN_ReadUP() == 0 || BTN_ReadSET() == 0))
-            {
-                LL_mDelay(0);
-                if (long_press != 255)
-                {
-                    long_press -= 1;
-                }
-            }
+            update_display = 0;
+            Menu_DrawMainMenu(select, last_select);
+            last_select = select;
+            EPD_Show(0);
         }
     }
-    BEEP_OK();
 }
 
-static void Menu_SetVrefint(void) /* 设置参考电压偏移 */
+/* ==================== 子菜单 ==================== */
+
+static void Menu_SetTime(void) /* 时间设置页面 */
 {
-    uint8_t select, save, update_display, wait_btn;
-    int16_t offset;
-    float vrefint_factory;
+    struct RTC_Time new_time;
 
-    Menu_DrawMenuFrame("参考电压设置", 0);
-    BTN_WaitAll();
-    update_display = 1;
-    wait_btn = 0;
-    save = 0;
-    select = 0;
-    offset = Setting.vrefint_offset;
-    ADC_EnableVrefintOutput();
-    while (save == 0)
+    RTC_GetTime(&new_time);
+    if (RTC_GetOSF() != 0 || new_time.Month == 0)
     {
-        if (BTN_ReadSET() == 0)
-        {
-            if (select < 2)
-            {
-                select += 1;
-            }
-            else
-            {
-                select = 0;
-            }
-            wait_btn = 1;
-        }
-        else
-        {
-            switch (select)
-            {
-            case 0:
-                if (BTN_ReadUP() == 0)
-                {
-                    if (offset < 127)
-                    {
-                        offset += 1;
-                    }
-                    wait_btn = 1;
-                }
-                else if (BTN_ReadDOWN() == 0)
-                {
-                    if (offset > -127)
-                    {
-                        offset -= 1;
-                    }
-                    wait_btn = 1;
-                }
-                break;
-            case 1:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 2;
-                }
-                break;
-            case 2:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 1;
-                }
-                break;
-            }
-        }
-        if (wait_btn != 0)
-        {
-            update_display = 1;
-        }
-        if (update_display != 0)
-        {
-            if (EPD_GetBusy() == 0)
-            {
-                update_display = 0;
-                snprintf(String, sizeof(String), "偏移数值：%+04d", offset);
-                EPD_DrawUTF8(0, 4, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                vrefint_factory = ADC_GetVrefintFactory() + (ADC_GetVrefintStep() * offset) + 0.0005;
-                snprintf(String, sizeof(String), "[实际电压：%04d.%03dmV]", (int16_t)vrefint_factory, (int16_t)((vrefint_factory - (int16_t)vrefint_factory) * 1000));
-                EPD_DrawUTF8(0, 8, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                EPD_ClearArea(168, 4, 24, 3, 0xFF);
-                switch (select)
-                {
-                case 0:
-                    EPD_DrawUTF8(168, 4, 0, "◀", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    break;
-                }
+        memcpy(&new_time, &DefaultTime, sizeof(struct RTC_Time));
+    }
+    if (Menu_Run(&Menu_TimeScreen, &new_time) != 0)
+    {
+        RTC_CheckTimeRange(&new_time);
+        RTC_SetTime(&new_time);
+        LUNAR_InvalidateCache(); /* 时间已修改，下次重新计算农历 */
+        Alarm_Update(0);         /* 钟声按新的时间和12/24小时制重新设置 */
+    }
+}
 
-                if (select == 1 || select == 2)
-                {
-                    Menu_DrawSubmenuSaveSelect(select - 1);
-                }
-                else
-                {
-                    Menu_DrawSubmenuSaveSelect(3);
-                }
+static void Menu_SetAlarm(void) /* 钟声设置页面 */
+{
+    struct Menu_AlarmData alarm_data;
 
-                EPD_Show(0);
-            }
-        }
-        if (save == 2)
-        {
-            Setting.vrefint_offset = offset;
-            ADC_SetVrefintOffset(offset);
-            SaveSetting(&Setting);
-        }
-        if (wait_btn != 0)
-        {
-            wait_btn = 0;
-            BEEP_Button();
-            BTN_WaitAll();
-        }
+    memcpy(alarm_data.alarms, Setting.alarms, sizeof(alarm_data.alarms));
+    alarm_data.index = 1;
+    Menu_LoadAlarm(&alarm_data);
+    if (Menu_Run(&Menu_AlarmScreen, &alarm_data) != 0)
+    {
+        Menu_StoreAlarm(&alarm_data); /* 保存正在编辑的钟声 */
+        memcpy(Setting.alarms, alarm_data.alarms, sizeof(Setting.alarms));
+        SaveSetting(&Setting);
+        Alarm_Update(0);
     }
-    ADC_DisableVrefintOutput();
+}
+
+static void Menu_Guide(void) /* 首次使用时的引导 */
+{
+    Menu_DrawMenuFrame("欢迎使用", 2);
+    BTN_Flush();
+    EPD_DrawImage(0, 4, EPD_Image_Welcome_296x96);
+    EPD_Show(0);
+    LP_EnterStop(EPD_TIMEOUT_MS);
+    BTN_WaitPress(BTN_KEY_SET);
     BEEP_OK();
 }
 
+static void Menu_SetVrefint(void) /* 设置参考电压偏移，设置时输出内部参考电压以便测量 */
+{
+    ADC_EnableVrefintOutput();
+    Menu_RunSetting(&Menu_VrefintScreen);
+    ADC_DisableVrefintOutput();
+}
+
 static void Menu_Info(void) /* 系统信息 */
 {
     uint32_t eeprom_tmp;
-    float mcu_temp, rtc_temp;
+    int32_t mcu_temp, rtc_temp, sht_temp, sht_rh;
     struct TH_Value th_value;
-    char date_tmp[sizeof(__DATE__)], sig[2];
-    uint8_t i, btn_cnt;
+    struct FMT_Buffer buf;
+    char date_tmp[sizeof(__DATE__)];
+    struct BTN_Event event;
+    uint8_t i, btn_cnt, type;
 
     Menu_DrawMenuFrame("系统信息", 2);
-    BTN_WaitAll();
-    mcu_temp = ADC_GetTemp();
+    BTN_Flush();
+    mcu_temp = FMT_Scale(ADC_GetTemp(), 2);
     eeprom_tmp = EEPROM_ReadDWORD(EEPROM_ADDR_DWORD_HWVERSION) & 0x00FFFFFF;
     TH_GetValue_SingleShotWithCS(TH_ACC_HIGH, &th_value);
-    rtc_temp = RTC_GetTemp();
+    sht_temp = FMT_Scale(th_value.CEL, 2);
+    sht_rh = FMT_Scale(th_value.RH, 2);
+    rtc_temp = FMT_Scale(RTC_GetTemp(), 2);
+    memcpy(date_tmp, __DATE__, sizeof(date_tmp));
+    if (date_tmp[4] == ' ')
+    {
+        date_tmp[4] = '0';
+    }
     for (i = 0; i < 2; i++)
     {
-        snprintf(String, sizeof(String), "软件版本  : %s", SOFT_VERSION);
+        FMT_Init(&buf, String, sizeof(String));
+        FMT_String(&buf, "软件版本  : " SOFT_VERSION);
         EPD_DrawUTF8(0, 4, 0, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16);
-        memcpy(date_tmp, __DATE__, sizeof(date_tmp));
-        if (date_tmp[4] == ' ')
-        {
-            date_tmp[4] = '0';
-        }
-        snprintf(String, sizeof(String), "编译时间  : %s %s", date_tmp, __TIME__);
+
+        FMT_Init(&buf, String, sizeof(String));
+        FMT_String(&buf, "编译时间  : ");
+        FMT_String(&buf, date_tmp);
+        FMT_String(&buf, " " __TIME__);
         EPD_DrawUTF8(0, 6, 0, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16);
-        snprintf(String, sizeof(String), "硬件版本  : %s", (char *)&eeprom_tmp);
+
+        FMT_Init(&buf, String, sizeof(String));
+        FMT_String(&buf, "硬件版本  : ");
+        FMT_String(&buf, (char *)&eeprom_tmp);
         EPD_DrawUTF8(0, 8, 0, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16);
-        if (mcu_temp > 0)
-        {
-            mcu_temp += 0.005;
-        }
-        else
-        {
-            mcu_temp -= 0.005;
-        }
-        if (mcu_temp < 0 && mcu_temp > -1.0)
-        {
-            sig[0] = '-';
-            sig[1] = '\0';
-        }
-        else
-        {
-            sig[0] = '\0';
-        }
-        snprintf(String, sizeof(String), "MCU信息   : 0x%03X 0x%04X %s%02d.%02d℃",
-                 LL_DBGMCU_GetDeviceID(), LL_DBGMCU_GetRevisionID(), sig, (int8_t)mcu_temp, abs((int16_t)((mcu_temp - (int8_t)mcu_temp) * 100)));
+
+        FMT_Init(&buf, String, sizeof(String));
+        FMT_String(&buf, "MCU信息   : 0x");
+        FMT_Hex(&buf, LL_DBGMCU_GetDeviceID(), 3);
+        FMT_String(&buf, " 0x");
+        FMT_Hex(&buf, LL_DBGMCU_GetRevisionID(), 4);
+        FMT_Char(&buf, ' ');
+        FMT_Fixed(&buf, mcu_temp, 2, 5, FMT_ZERO);
+        FMT_String(&buf, "℃");
         EPD_DrawUTF8(0, 10, 0, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16);
-        if (th_value.CEL > 0)
-        {
-            th_value.CEL += 0.005;
-        }
-        else
+
+        FMT_Init(&buf, String, sizeof(String));
+        FMT_String(&buf, "SHT30状态 : 0x");
+        FMT_Hex(&buf, TH_GetStatus(), 2);
+        FMT_Char(&buf, ' ');
+        FMT_Fixed(&buf, sht_temp, 2, 5, FMT_ZERO);
+        FMT_String(&buf, "℃ ");
+        FMT_Fixed(&buf, sht_rh, 2, 5, FMT_ZERO);
+        FMT_String(&buf, "％");
+        EPD_DrawUTF8(0, 12, 0, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16);
+
+        FMT_Init(&buf, String, sizeof(String));
+        FMT_String(&buf, "DS3231状态: 0x");
+        FMT_Hex(&buf, RTC_ReadREG(RTC_REG_CTL), 2);
+        FMT_String(&buf, " 0x");
+        FMT_Hex(&buf, RTC_ReadREG(RTC_REG_STA), 2);
+        FMT_String(&buf, " 0x");
+        FMT_Hex(&buf, RTC_ReadREG(RTC_REG_AGI), 2);
+        FMT_Char(&buf, ' ');
+        FMT_Fixed(&buf, rtc_temp, 2, 5, FMT_ZERO);
+        FMT_String(&buf, "℃");
+        EPD_DrawUTF8(0, 14, 0, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16);
+
+        if (i == 0)
         {
-            th_value.CEL -= 0.005;
+            EPD_Show(0);
+            LP_EnterStop(EPD_TIMEOUT_MS);
         }
-        if (th_value.CEL < 0 && th_value.CEL > -1.0)
+    }
+    btn_cnt = 0;
+    while (1) /* “设置”键返回，按8次“下”键显示隐藏信息 */
+    {
+        type = BTN_GetEvent(&event);
+        if (type == BTN_EVENT_PRESS && event.Key == BTN_KEY_SET)
         {
-            sig[0] = '-';
-            sig[1] = '\0';
+            break;
         }
-        else
+        if (type == BTN_EVENT_PRESS && event.Key == BTN_KEY_DOWN && ++btn_cnt >= 8)
         {
-            sig[0] = '\0';
+            EPD_DrawImage(207, 0, EPD_Image_Info_89x128);
+            EPD_Show(0);
+            LP_EnterStop(EPD_TIMEOUT_MS);
+            BTN_WaitPress(BTN_KEY_SET);
+            break;
         }
-        snprintf(String, sizeof(String), "SHT30状态 : 0x%02X %s%02d.%02d℃ %02d.%02d％",
-                 TH_GetStatus(), sig, (int8_t)th_value.CEL, abs((int16_t)((th_value.CEL - (int8_t)th_value.CEL) * 100)), (int8_t)th_value.RH, (int16_t)((th_value.RH - (int8_t)th_value.RH) * 100));
-        EPD_DrawUTF8(0, 12, 0, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16);
-        if (rtc_temp > 0)
+        if (type == BTN_EVENT_NONE)
         {
-            rtc_temp += 0.005;
+            BTN_Wait(BTN_IDLE_WAIT_MS);
         }
-        else
+    }
+    BEEP_OK();
+}
+
+static void Menu_ResetAll(void) /* 恢复初始设置 */
+{
+    if (Menu_Run(&Menu_ResetScreen, NULL) == 0)
+    {
+        return;
+    }
+    memcpy(&Setting, &DefaultSetting, sizeof(struct Func_Setting));
+    Setting.available = SETTING_AVALIABLE_FLAG;
+    SaveSetting(&Setting);
+    ApplySetting(&Setting);
+    Alarm_Update(0);
+    EPD_WaitBusy();
+    EPD_ClearArea(0, 4, 296, 12, 0xFF);
+    EPD_DrawUTF8(0, 4, 0, "恢复完成", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+    EPD_DrawUTF8(0, 8, 0, "三秒后返回主菜单", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
+    EPD_Show(0);
+    if (Setting.buzzer_enable != 0)
+    {
+        BUZZER_SetVolume(Setting.buzzer_volume);
+        BUZZER_Play(Beep_LongNotes);
+    }
+    LP_EnterStop(EPD_TIMEOUT_MS);
+    LP_DelayStop(3000);
+}
+
+static void Menu_SetHWVer(void) /* 设置硬件版本 */
+{
+    uint8_t hwver[2];
+    uint32_t hwver_stor;
+
+    hwver[0] = 0;
+    hwver[1] = 0;
+    if (Menu_Run(&Menu_HWVerScreen, hwver) != 0)
+    {
+        hwver_stor = 0x00002E00;
+        hwver_stor |= (hwver[1] + 48) << 16;
+        hwver_stor |= (hwver[0] + 48);
+        EEPROM_WriteDWORD(EEPROM_ADDR_DWORD_HWVERSION, hwver_stor);
+    }
+}
+
+static void Menu_ClearScreen(void) /* 反复刷新全屏以清除残影 */
+{
+    Home_Shown.valid = 0;
+    EPD_Init(EPD_UPDATE_MODE_FULL);
+    EPD_ClearRAM();
+    EPD_Show(0);
+    LP_EnterStop(EPD_TIMEOUT_MS);
+    LP_DelayStop(1000);
+    EPD_ClearArea(0, 0, 296, 16, 0x00);
+    EPD_Show(0);
+    LP_EnterStop(EPD_TIMEOUT_MS);
+    LP_DelayStop(1000);
+    EPD_ClearRAM();
+    EPD_Show(0);
+    LP_EnterStop(EPD_TIMEOUT_MS);
+    LP_DelayStop(1000);
+    BEEP_OK();
+}
+
+/* ==================== 电池图标绘制 ==================== */
+
+static void EPD_DrawBattery(uint16_t x, uint8_t y_x8, uint8_t percent, uint8_t warn)
+{
+    uint8_t dis_ram[sizeof(EPD_Image_BattWarn)];
+    uint8_t i, bar_size, bar_size_max, bar_end_pos;
+
+    if (warn != 0)
+    {
+        EPD_DrawImage(x, y_x8, EPD_Image_BattWarn);
+        return;
+    }
+    memcpy(dis_ram, EPD_Image_BattWarn, sizeof(dis_ram));
+    bar_end_pos = (dis_ram[2] / 8) * (dis_ram[0] - 5) + 3;
+    bar_size_max = dis_ram[0] - 12;
+    bar_size = (percent * bar_size_max + 50) / 100;
+    if (bar_size == 0)
+    {
+        bar_size = 1;
+    }
+    else if (bar_size > bar_size_max)
+    {
+        bar_size = bar_size_max;
+    }
+    for (i = 0; i < bar_size_max; i++) /* 清空电池图标内部 */
+    {
+        dis_ram[bar_end_pos - (i * 3) + 0] |= 0x07;
+        dis_ram[bar_end_pos - (i * 3) + 1] |= 0xFF;
+        dis_ram[bar_end_pos - (i * 3) + 2] |= 0xE0;
+    }
+    for (i = 0; i < bar_size; i++) /* 绘制填充 */
+    {
+        dis_ram[bar_end_pos - (i * 3) + 0] &= 0xF8;
+        dis_ram[bar_end_pos - (i * 3) + 1] &= 0x00;
+        dis_ram[bar_end_pos - (i * 3) + 2] &= 0x1F;
+    }
+    EPD_DrawImage(x, y_x8, dis_ram);
+}
+
+/* ==================== 设置存储 ==================== */
+
+static void SaveSetting(const struct Func_Setting *setting)
+{
+    STORE_Save(setting, sizeof(struct Func_Setting), SETTING_VERSION);
+}
+
+static void ReadSetting(struct Func_Setting *setting)
+{
+    uint16_t i;
+    uint8_t *setting_ptr;
+
+    if (STORE_Load(setting, sizeof(struct Func_Setting), SETTING_VERSION) == 0 && setting->available == SETTING_AVALIABLE_FLAG)
+    {
+        return;
+    }
+    memcpy(setting, &DefaultSetting, sizeof(struct Func_Setting)); /* 旧版本没有的设置使用默认值 */
+    setting_ptr = (uint8_t *)setting;
+    if (STORE_Load(setting, offsetof(struct Func_Setting, alarms), SETTING_VERSION_V2) != 0) /* 新增的alarms在结构体末尾 */
+    {
+        if (STORE_Load(setting, offsetof(struct Func_Setting, alarms), SETTING_VERSION_V1) != 0)
         {
-            rtc_temp -= 0.005;
+            for (i = 0; i < offsetof(struct Func_Setting, alarms); i++) /* 没有有效记录，尝试读取旧版本固定地址保存的设置 */
+            {
+                setting_ptr[i] = EEPROM_ReadByte(EEPROM_ADDR_BYTE_SETTING + i);
+            }
         }
-        if (rtc_temp < 0 && rtc_temp > -1.0)
+        setting->home_face = DefaultSetting.home_face; /* 新增的home_face在原来的填充字节中 */
+    }
+    if (setting->available != SETTING_AVALIABLE_FLAG)
+    {
+        BUZZER_SetVolume(DefaultSetting.buzzer_volume);
+        BUZZER_Play(Beep_LongNotes);
+        memcpy(setting, &DefaultSetting, sizeof(struct Func_Setting));
+        RTC_GetTime(&Time);
+        LOG_Add(&Time, LOG_EVENT_SETTING_RESET, 0);
+    }
+}
+
+/* 设置电池和传感器偏移量 */
+static void ApplySetting(const struct Func_Setting *setting)
+{
+    TH_SetTemperatureOffset(setting->sensor_temp_offset);
+    TH_SetHumidityOffset(setting->sensor_rh_offset);
+    ADC_SetVrefintOffset(setting->vrefint_offset);
+    if (RTC_GetAging() != setting->rtc_aging_offset)
+    {
+        RTC_ModifyAging(setting->rtc_aging_offset);
+    }
+}
+
+/* ==================== 按键读取 ==================== */
+
+static uint8_t BTN_ReadUP(void)
+{
+    if (LL_GPIO_IsInputPinSet(BTN_UP_GPIO_Port, BTN_UP_Pin) == 0)
+    {
+        LL_mDelay(BTN_DEBOUNCE_MS);
+        if (LL_GPIO_IsInputPinSet(BTN_UP_GPIO_Port, BTN_UP_Pin) == 0)
         {
-            sig[0] = '-';
-            sig[1] = '\0';
+            return 0;
         }
-        else
+    }
+    return 1;
+}
+
+static uint8_t BTN_ReadDOWN(void)
+{
+    if (LL_GPIO_IsInputPinSet(BTN_DOWN_GPIO_Port, BTN_DOWN_Pin) == 0)
+    {
+        LL_mDelay(BTN_DEBOUNCE_MS);
+        if (LL_GPIO_IsInputPinSet(BTN_DOWN_GPIO_Port, BTN_DOWN_Pin) == 0)
         {
-            sig[0] = '\0';
+            return 0;
         }
-        snprintf(String, sizeof(String), "DS3231状态: 0x%02X 0x%02X 0x%02X %s%02d.%02d℃",
-                 RTC_ReadREG(RTC_REG_CTL), RTC_ReadREG(RTC_REG_STA), RTC_ReadREG(RTC_REG_AGI), sig, (int8_t)rtc_temp, abs((int16_t)((rtc_temp - (int8_t)rtc_temp) * 100)));
-        EPD_DrawUTF8(0, 14, 0, String, EPD_FontAscii_8x16, EPD_FontUTF8_16x16);
+    }
+    return 1;
+}
 
-        if (i == 0)
+static void BTN_WaitSET(void)
+{
+    while (1)
+    {
+        if (LL_GPIO_IsInputPinSet(BTN_SET_GPIO_Port, BTN_SET_Pin) != 0)
         {
-            EPD_Show(0);
-            LP_EnterStop(EPD_TIMEOUT_MS);
+            LL_mDelay(BTN_DEBOUNCE_MS);
+            if (LL_GPIO_IsInputPinSet(BTN_SET_GPIO_Port, BTN_SET_Pin) != 0)
+            {
+                return;
+            }
         }
     }
-    btn_cnt = 0;
-    while (BTN_ReadSET() != 0)
+}
+
+/* 等待按键按下，忽略其他按键和事件 */
+static void BTN_WaitPress(uint8_t key)
+{
+    struct BTN_Event event;
+
+    while (BTN_GetEvent(&event) != BTN_EVENT_PRESS || event.Key != key)
+    {
+        BTN_Wait(BTN_IDLE_WAIT_MS);
+    }
+}
+
+/* ==================== 蜂鸣器 ==================== */
+
+/* 提示音都在后台播放，函数立即返回 */
+static void BEEP_Fast(void)
+{
+    if (Setting.buzzer_enable != 0)
+    {
+        BUZZER_SetVolume(Setting.buzzer_volume);
+        BUZZER_Play(Beep_FastNotes);
+    }
+}
+
+static void BEEP_Button(void)
+{
+    if (Setting.buzzer_enable != 0)
+    {
+        BUZZER_SetVolume(Setting.buzzer_volume);
+        BUZZER_Play(Beep_ButtonNotes);
+    }
+}
+
+static void BEEP_OK(void)
+{
+    if (Setting.buzzer_enable != 0)
+    {
+        BUZZER_SetVolume(Setting.buzzer_volume);
+        BUZZER_Play(Beep_OKNotes);
+    }
+}
+
+/* ==================== 电源控制 ==================== */
+
+static void Power_EnableGDEH029A1(void)
+{
+    LL_GPIO_ResetOutputPin(EPD_POWER_GPIO_Port, EPD_POWER_Pin);
+    LL_GPIO_SetOutputPin(EPD_CS_PORT, EPD_CS_PIN);
+    LL_GPIO_SetOutputPin(EPD_DC_PORT, EPD_DC_PIN);
+    LL_GPIO_SetOutputPin(EPD_RST_PORT, EPD_RST_PIN);
+    Delay_100ns(100); /* 10us，未要求，短暂延时 */
+    if (LL_SPI_IsEnabled(SPI1) == 0)
+    {
+        LL_SPI_Enable(SPI1);
+    }
+}
+
+static void Power_Enable_SHT30_I2C(void)
+{
+    LL_GPIO_ResetOutputPin(SHT30_POWER_GPIO_Port, SHT30_POWER_Pin); /* 打开SHT30电源 */
+    LL_GPIO_SetOutputPin(I2C1_PULLUP_GPIO_Port, I2C1_PULLUP_Pin);   /* 打开I2C上拉电阻 */
+    LL_GPIO_SetOutputPin(SHT30_RST_GPIO_Port, SHT30_RST_Pin);       /* 释放SHT30复位引脚 */
+    Delay_100ns(20);                                                /* 最少1us宽度，设置为2us */
+    LL_GPIO_ResetOutputPin(SHT30_RST_GPIO_Port, SHT30_RST_Pin);     /* SHT30硬复位 */
+    Delay_100ns(20);                                                /* 最少1us宽度，设置为2us */
+    LL_GPIO_SetOutputPin(SHT30_RST_GPIO_Port, SHT30_RST_Pin);       /* SHT30硬复位 */
+    LL_mDelay(1);                                                   /* SHT30复位后需要最少1ms启动时间，设置为2ms */
+    if (LL_I2C_IsEnabled(I2C1) == 0)                                /* 打开I2C */
+    {
+        LL_I2C_Enable(I2C1);
+    }
+}
+
+static uint8_t Power_EnableADC(void)
+{
+    ADC_Disable();
+    ADC_StartCal();
+    return ADC_Enable();
+}
+
+static void Power_EnableBUZZER(void)
+{
+    BUZZER_Enable();
+}
+
+static void Power_EnableUSART(void) /* 恢复串口引脚并打开接收 */
+{
+    LL_GPIO_SetPinPull(SERIAL_RX_PORT, SERIAL_RX_PIN, LL_GPIO_PULL_UP); /* 断开适配器后RX保持空闲电平 */
+    LL_GPIO_SetPinMode(SERIAL_TX_PORT, SERIAL_TX_PIN, LL_GPIO_MODE_ALTERNATE);
+    LL_GPIO_SetPinMode(SERIAL_RX_PORT, SERIAL_RX_PIN, LL_GPIO_MODE_ALTERNATE);
+    SERIAL_EnableRX();
+}
+
+static void Power_DisableGDEH029A1(void)
+{
+    Home_Shown.valid = 0; /* 断电后电子纸RAM丢失 */
+    if (LL_SPI_IsEnabled(SPI1) != 0)
+    {
+        LL_SPI_Disable(SPI1);
+    }
+    LL_GPIO_ResetOutputPin(EPD_RST_PORT, EPD_RST_PIN);
+    LL_GPIO_ResetOutputPin(EPD_DC_PORT, EPD_DC_PIN);
+    LL_GPIO_ResetOutputPin(EPD_CS_PORT, EPD_CS_PIN);
+    LL_GPIO_SetOutputPin(EPD_POWER_GPIO_Port, EPD_POWER_Pin);
+}
+
+static void Power_Disable_I2C_SHT30(void)
+{
+    if (LL_I2C_IsEnabled(I2C1) != 0) /* 关闭I2C */
     {
-        if (BTN_ReadDOWN() == 0)
-        {
-            btn_cnt += 1;
-            BTN_WaitAll();
-        }
-        else
-        {
-            LP_DelayStop(50);
-        }
-        if (btn_cnt >= 8)
-        {
-            EPD_DrawImage(207, 0, EPD_Image_Info_89x128);
-            EPD_Show(0);
-            LP_EnterStop(EPD_TIMEOUT_MS);
-            while (BTN_ReadSET() != 0)
-            {
-                LP_DelayStop(50);
-            }
-            break;
-        }
+        LL_I2C_Disable(I2C1);
     }
-    BEEP_OK();
+    LL_GPIO_ResetOutputPin(I2C1_PULLUP_GPIO_Port, I2C1_PULLUP_Pin); /* 关闭I2C上拉电阻 */
+    LL_GPIO_ResetOutputPin(SHT30_RST_GPIO_Port, SHT30_RST_Pin);     /* 拉低SHT30复位引脚 */
+    LL_GPIO_SetOutputPin(SHT30_POWER_GPIO_Port, SHT30_POWER_Pin);   /* 关闭SHT30电源 */
 }
 
-static void Menu_SetRTCAging(void) /* 设置实时时钟老化偏移 */
+static uint8_t Power_DisableADC(void)
 {
-    uint8_t select, save, update_display, wait_btn;
-    int8_t offset;
+    return ADC_Disable();
+}
 
-    Menu_DrawMenuFrame("时钟老化设置", 0);
-    BTN_WaitAll();
-    update_display = 1;
-    wait_btn = 0;
-    save = 0;
-    select = 0;
-    offset = Setting.rtc_aging_offset;
-    while (save == 0)
+static void Power_DisableBUZZER(void)
+{
+    BUZZER_Wait(); /* 等待提示音播放完成 */
+    BUZZER_Disable();
+}
+
+static void Power_DisableUSART(void) /* 关闭串口，下次使用需要重新初始化 */
+{
+    LL_USART_Disable(SERIAL_NUM);
+    LL_GPIO_SetPinMode(SERIAL_TX_PORT, SERIAL_TX_PIN, LL_GPIO_MODE_ANALOG);
+    LL_GPIO_SetPinMode(SERIAL_RX_PORT, SERIAL_RX_PIN, LL_GPIO_MODE_ANALOG);
+    LL_GPIO_SetPinPull(SERIAL_TX_PORT, SERIAL_TX_PIN, LL_GPIO_PULL_NO);
+    LL_GPIO_SetPinPull(SERIAL_RX_PORT, SERIAL_RX_PIN, LL_GPIO_PULL_NO);
+}
+
+/* ==================== 辅助功能 ==================== */
+
+static void DumpRTCReg(void)
+{
+    uint8_t i, j, reg_tmp;
+    char byte_str[9];
+    struct FMT_Buffer buf;
+
+    SERIAL_SendStringRN("");
+    SERIAL_SendStringRN("DS3231 REG DUMP:");
+    for (i = 0; i < RTC_REG_COUNT; i++)
     {
-        if (BTN_ReadSET() == 0)
+        reg_tmp = RTC_ReadREG(RTC_REG_SEC + i);
+        for (j = 0; j < 8; j++)
         {
-            if (select < 2)
+            if ((reg_tmp & (0x80 >> j)) != 0)
             {
-                select += 1;
+                byte_str[j] = '1';
             }
             else
             {
-                select = 0;
-            }
-            wait_btn = 1;
-        }
-        else
-        {
-            switch (select)
-            {
-            case 0:
-                if (BTN_ReadUP() == 0)
-                {
-                    if (offset < 127)
-                    {
-                        offset += 1;
-                    }
-                    wait_btn = 1;
-                }
-                else if (BTN_ReadDOWN() == 0)
-                {
-                    if (offset > -127)
-                    {
-                        offset -= 1;
-                    }
-                    wait_btn = 1;
-                }
-                break;
-            case 1:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 2;
-                }
-                break;
-            case 2:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 1;
-                }
-                break;
+                byte_str[j] = '0';
             }
         }
-        if (wait_btn != 0)
-        {
-            update_display = 1;
-        }
-        if (update_display != 0)
-        {
-            if (EPD_GetBusy() == 0)
-            {
-                update_display = 0;
-                snprintf(String, sizeof(String), "偏移数值：%+04d", offset);
-                EPD_DrawUTF8(0, 4, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                EPD_DrawUTF8(0, 8, 1, "[每个偏移约为0.1ppm]", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                EPD_ClearArea(168, 4, 24, 3, 0xFF);
-                switch (select)
-                {
-                case 0:
-                    EPD_DrawUTF8(168, 4, 0, "◀", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                    break;
-                }
+        byte_str[8] = '\0';
+        SERIAL_SendString(byte_str);
+        SERIAL_SendString(" 0x");
+        FMT_Init(&buf, byte_str, sizeof(byte_str));
+        FMT_Hex(&buf, reg_tmp, 2);
+        SERIAL_SendStringRN(byte_str);
+    }
+    SERIAL_SendStringRN("DS3231 REG DUMP END");
+    SERIAL_SendStringRN("");
+}
 
-                if (select == 1 || select == 2)
-                {
-                    Menu_DrawSubmenuSaveSelect(select - 1);
-                }
-                else
-                {
-                    Menu_DrawSubmenuSaveSelect(3);
-                }
+/* 输出一行十六进制数据，行首为地址，整行一次发送 */
+static void DumpHexRow(uint16_t addr, const uint8_t *data, uint8_t count)
+{
+    uint8_t i;
+    char str_buffer[96];
+    struct FMT_Buffer buf;
 
-                EPD_Show(0);
-            }
-        }
-        if (save == 2)
+    FMT_Init(&buf, str_buffer, sizeof(str_buffer));
+    FMT_String(&buf, "0x");
+    FMT_Hex(&buf, addr, 4);
+    FMT_String(&buf, "    ");
+    for (i = 0; i < count; i++)
+    {
+        FMT_String(&buf, "0x");
+        FMT_Hex(&buf, data[i], 2);
+        FMT_Char(&buf, ' ');
+    }
+    SERIAL_SendStringRN("");
+    SERIAL_SendString(str_buffer);
+}
+
+static void DumpEEPROM(void)
+{
+    uint16_t i;
+    uint8_t j, row[16];
+
+    SERIAL_SendStringRN("");
+    SERIAL_SendStringRN("EEPROM DUMP:");
+    SERIAL_SendStringRN("INDEX:    00   01   02   03   04   05   06   07   08   09   0A   0B   0C   0D   0E   0F");
+    for (i = 0; i < EEPROM_SIZE; i += 16)
+    {
+        for (j = 0; j < 16; j++)
         {
-            Setting.rtc_aging_offset = offset;
-            RTC_ModifyAging(offset);
-            SaveSetting(&Setting);
+            row[j] = EEPROM_ReadByte(i + j);
         }
-        if (wait_btn != 0)
+        DumpHexRow(i, row, 16);
+    }
+    SERIAL_SendStringRN("");
+    SERIAL_SendStringRN("EEPROM DUMP END");
+    SERIAL_SendStringRN("");
+}
+
+static void DumpBKPR(void)
+{
+    uint8_t i, j, row[16];
+
+    SERIAL_SendStringRN("");
+    SERIAL_SendStringRN("BKPR DUMP:");
+    SERIAL_SendStringRN("INDEX:    00   01   02   03   04   05   06   07   08   09   0A   0B   0C   0D   0E   0F");
+    for (i = 0; i < BKPR_SIZE; i += 16)
+    {
+        for (j = 0; j < 16 && i + j < BKPR_SIZE; j++)
         {
-            wait_btn = 0;
-            BEEP_Button();
-            BTN_WaitAll();
+            row[j] = BKPR_ReadByte(i + j);
         }
+        DumpHexRow(i, row, j);
     }
-    BEEP_OK();
+    SERIAL_SendStringRN("");
+    SERIAL_SendStringRN("BKPR DUMP END");
+    SERIAL_SendStringRN("");
 }
 
-static void Menu_ResetAll(void) /* 恢复初始设置 */
+/* 追加温湿度最小、最大和平均值，数值为实际值的10倍，除最后一列外左对齐为6列宽 */
+static void DumpHistoryValues(struct FMT_Buffer *buf, const int32_t *values)
+{
+    uint8_t i;
+
+    for (i = 0; i < 6; i++)
+    {
+        FMT_Char(buf, ' ');
+        FMT_Fixed(buf, values[i], 1, (i < 5) ? 6 : 0, FMT_LEFT);
+    }
+}
+
+static void DumpHistory(void)
 {
-    uint8_t select, save, update_display, wait_btn;
+    uint8_t i, range;
+    char str_buffer[64];
+    int32_t values[6];
+    struct HIST_Record record;
+    struct HIST_Stats stats;
+    struct FMT_Buffer buf;
 
-    Menu_DrawMenuFrame("恢复设置", 1);
-    BTN_WaitAll();
-    update_display = 1;
-    wait_btn = 0;
-    save = 0;
-    select = 1;
-    while (save == 0)
+    SERIAL_SendStringRN("");
+    SERIAL_SendStringRN("HISTORY DUMP:");
+    SERIAL_SendStringRN("SLOT  STAMP  T_MIN  T_MAX  T_AVG  RH_MIN RH_MAX RH_AVG");
+    for (i = 0; i < HIST_HOUR_COUNT + HIST_DAY_COUNT; i++)
     {
-        if (BTN_ReadSET() == 0)
+        if (i == 0)
         {
-            if (select < 1)
-            {
-                select += 1;
-            }
-            else
-            {
-                select = 0;
-            }
-            wait_btn = 1;
+            SERIAL_SendStringRN("HOUR:");
         }
-        else
+        else if (i == HIST_HOUR_COUNT)
         {
-            switch (select)
-            {
-            case 0:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 2;
-                }
-                break;
-            case 1:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 1;
-                }
-                break;
-            }
+            SERIAL_SendStringRN("DAY:");
         }
-        if (wait_btn != 0)
+        if (i < HIST_HOUR_COUNT)
         {
-            update_display = 1;
+            HIST_ReadHour(i, &record);
         }
-        if (update_display != 0)
+        else
         {
-            if (EPD_GetBusy() == 0)
-            {
-                update_display = 0;
-                Menu_DrawSubmenuSaveSelect(2 - select);
-                EPD_DrawUTF8(0, 4, 0, "清除数据并恢复到初始设置", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                EPD_DrawUTF8(0, 10, 0, "*同时按住\"上\"和\"下\"键", EPD_FontAscii_8x16, EPD_FontUTF8_16x16_B);
-                EPD_DrawUTF8(0, 12, 0, " 并按\"复位\"键", EPD_FontAscii_8x16, EPD_FontUTF8_16x16_B);
-                EPD_DrawUTF8(0, 14, 0, " 可以强制擦除全部数据", EPD_FontAscii_8x16, EPD_FontUTF8_16x16_B);
-                EPD_Show(0);
-            }
+            HIST_ReadDay(i - HIST_HOUR_COUNT, &record);
         }
-        if (save == 2)
+        if (record.Stamp == 0)
         {
-            BEEP_OK();
-            memcpy(&Setting, &DefaultSetting, sizeof(struct Func_Setting));
-            Setting.available = SETTING_AVALIABLE_FLAG;
-            SaveSetting(&Setting);
-            /* 设置电池和传感器偏移量 */
-            TH_SetTemperatureOffset(Setting.sensor_temp_offset);
-            TH_SetHumidityOffset(Setting.sensor_rh_offset);
-            ADC_SetVrefintOffset(Setting.vrefint_offset);
-            if (RTC_GetAging() != Setting.rtc_aging_offset)
-            {
-                RTC_ModifyAging(Setting.rtc_aging_offset);
-            }
-            EPD_WaitBusy();
-            EPD_ClearArea(0, 4, 296, 12, 0xFF);
-            EPD_DrawUTF8(0, 4, 0, "恢复完成", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-            EPD_DrawUTF8(0, 8, 0, "三秒后返回主菜单", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-            EPD_Show(0);
-            if (Setting.buzzer_enable != 0)
-            {
-                BUZZER_SetFrqe(4000);
-                BUZZER_SetVolume(Setting.buzzer_volume);
-                BUZZER_Beep(499);
-            }
-            LP_EnterStop(EPD_TIMEOUT_MS);
-            LP_DelayStop(3000);
-            return;
+            continue;
         }
-        if (wait_btn != 0)
+        values[0] = record.CEL_Min * 5; /* 记录单位为0.5，换算为0.1 */
+        values[1] = record.CEL_Max * 5;
+        values[2] = record.CEL_Avg * 5;
+        values[3] = record.RH_Min * 5;
+        values[4] = record.RH_Max * 5;
+        values[5] = record.RH_Avg * 5;
+        FMT_Init(&buf, str_buffer, sizeof(str_buffer));
+        FMT_Uint(&buf, i, 2, FMT_ZERO);
+        FMT_String(&buf, "    ");
+        FMT_Uint(&buf, record.Stamp, 6, FMT_LEFT);
+        DumpHistoryValues(&buf, values);
+        SERIAL_SendStringRN(str_buffer);
+    }
+    for (range = HIST_RANGE_24H; range <= HIST_RANGE_7D; range++)
+    {
+        if (HIST_GetStats(&Time, range, &stats) != 0)
         {
-            wait_btn = 0;
-            BEEP_Button();
-            BTN_WaitAll();
+            continue;
         }
+        values[0] = FMT_Scale(stats.CEL_Min, 1);
+        values[1] = FMT_Scale(stats.CEL_Max, 1);
+        values[2] = FMT_Scale(stats.CEL_Avg, 1);
+        values[3] = FMT_Scale(stats.RH_Min, 1);
+        values[4] = FMT_Scale(stats.RH_Max, 1);
+        values[5] = FMT_Scale(stats.RH_Avg, 1);
+        FMT_Init(&buf, str_buffer, sizeof(str_buffer));
+        FMT_String(&buf, range == HIST_RANGE_24H ? "24H   " : "7D    ");
+        FMT_Uint(&buf, stats.Count, 6, FMT_LEFT);
+        DumpHistoryValues(&buf, values);
+        SERIAL_SendStringRN(str_buffer);
     }
-    BEEP_OK();
+    SERIAL_SendStringRN("HISTORY DUMP END");
+    SERIAL_SendStringRN("");
 }
 
-static void Menu_SetHWVer(void) /* 设置硬件版本 */
+static void DumpBattery(void)
 {
-    uint8_t select, save, update_display, wait_btn, hwver_1, hwver_2;
-    uint32_t hwver_stor;
+    uint32_t battery_stor;
+    uint16_t days_left;
+    uint8_t percent;
+    float battery_voltage;
+    char str_buffer[48];
+    struct FMT_Buffer buf;
 
-    Menu_DrawMenuFrame("硬件版本设置", 0);
-    BTN_WaitAll();
-    update_display = 1;
-    wait_btn = 0;
-    save = 0;
-    select = 0;
-    hwver_1 = 0;
-    hwver_2 = 0;
-    while (save == 0)
+    battery_stor = BKPR_ReadDWORD(BKPR_ADDR_DWORD_ADCVAL);
+    battery_voltage = *(float *)&battery_stor;
+    percent = BAT_GetPercent(battery_voltage);
+    days_left = BAT_GetDaysLeft(&Time, percent);
+
+    SERIAL_SendStringRN("");
+    SERIAL_SendStringRN("BATTERY DUMP:");
+    FMT_Init(&buf, str_buffer, sizeof(str_buffer));
+    FMT_String(&buf, "VOLTAGE: ");
+    FMT_Int(&buf, FMT_Scale(battery_voltage, 3), 0, 0);
+    FMT_String(&buf, "mV");
+    SERIAL_SendStringRN(str_buffer);
+    FMT_Init(&buf, str_buffer, sizeof(str_buffer));
+    FMT_String(&buf, "PERCENT: ");
+    FMT_Uint(&buf, percent, 0, 0);
+    FMT_Char(&buf, '%');
+    SERIAL_SendStringRN(str_buffer);
+    if (days_left == BAT_DAYS_UNKNOWN)
+    {
+        SERIAL_SendStringRN("DAYS LEFT: UNKNOWN");
+    }
+    else
     {
-        if (BTN_ReadSET() == 0)
+        FMT_Init(&buf, str_buffer, sizeof(str_buffer));
+        FMT_String(&buf, "DAYS LEFT: ");
+        FMT_Uint(&buf, days_left, 0, 0);
+        SERIAL_SendStringRN(str_buffer);
+    }
+    SERIAL_SendStringRN("BATTERY DUMP END");
+    SERIAL_SendStringRN("");
+}
+
+static void DumpEventLog(void)
+{
+    static const char *const event_name[] = {"", "RESET", "SETTING_RESET", "LOW_BATTERY", "I2C_RECOVER", "EPD_TIMEOUT", "SENSOR_FAIL", "ALARM", "I2C_FAIL"};
+    uint16_t cursor;
+    struct LOG_Entry entry;
+    struct RTC_Time time;
+    char str_buffer[64];
+    struct FMT_Buffer buf;
+
+    SERIAL_SendStringRN("");
+    SERIAL_SendStringRN("EVENT LOG DUMP:");
+    SERIAL_SendStringRN("TIME              EVENT          ARG");
+    cursor = 0;
+    while (LOG_ReadNext(&cursor, &entry) == 0)
+    {
+        LOG_MinutesToTime(entry.Minutes, &time);
+        FMT_Init(&buf, str_buffer, sizeof(str_buffer));
+        if (time.Month == 0)
         {
-            if (select < 3)
-            {
-                select += 1;
-            }
-            else
-            {
-                select = 0;
-            }
-            wait_btn = 1;
+            FMT_String(&buf, "----/--/-- --:--");
         }
         else
         {
-            switch (select)
-            {
-            case 0:
-                if (BTN_ReadUP() == 0)
-                {
-                    if (hwver_1 < 9)
-                    {
-                        hwver_1 += 1;
-                    }
-                    wait_btn = 1;
-                }
-                else if (BTN_ReadDOWN() == 0)
-                {
-                    if (hwver_1 > 0)
-                    {
-                        hwver_1 -= 1;
-                    }
-                    wait_btn = 1;
-                }
-                break;
-            case 1:
-                if (BTN_ReadUP() == 0)
-                {
-                    if (hwver_2 < 9)
-                    {
-                        hwver_2 += 1;
-                    }
-                    wait_btn = 1;
-                }
-                else if (BTN_ReadDOWN() == 0)
-                {
-                    if (hwver_2 > 0)
-                    {
-                        hwver_2 -= 1;
-                    }
-                    wait_btn = 1;
-                }
-                break;
-            case 2:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 2;
-                }
-                break;
-            case 3:
-                if (BTN_ReadUP() == 0)
-                {
-                    wait_btn = 0;
-                    update_display = 0;
-                    save = 1;
-                }
-                break;
-            }
-        }
-        if (wait_btn != 0)
-        {
-            update_display = 1;
+            FMT_Uint(&buf, time.Year + 2000, 4, FMT_ZERO);
+            FMT_Char(&buf, '/');
+            FMT_Uint(&buf, time.Month, 2, FMT_ZERO);
+            FMT_Char(&buf, '/');
+            FMT_Uint(&buf, time.Date, 2, FMT_ZERO);
+            FMT_Char(&buf, ' ');
+            FMT_Uint(&buf, time.Hours, 2, FMT_ZERO);
+            FMT_Char(&buf, ':');
+            FMT_Uint(&buf, time.Minutes, 2, FMT_ZERO);
         }
-        if (update_display != 0)
+        FMT_String(&buf, "  ");
+        if (entry.Event < sizeof(event_name) / sizeof(event_name[0]))
         {
-            if (EPD_GetBusy() == 0)
-            {
-                update_display = 0;
-                snprintf(String, sizeof(String), "硬件版本：V%d.%d", hwver_1, hwver_2);
-                EPD_DrawUTF8(0, 4, 0, String, EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                EPD_DrawUTF8(0, 8, 0, "[注意：设置保存后不会再", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                EPD_DrawUTF8(0, 12, 0, "显示此菜单]", EPD_FontAscii_12x24_B, EPD_FontUTF8_24x24_B);
-                EPD_ClearArea(132, 7, 36, 1, 0xFF);
-                switch (select)
-                {
-                case 0:
-                    EPD_DrawImage(132, 7, EPD_Image_ArrowUp_12x8);
-                    break;
-                case 1:
-                    EPD_DrawImage(156, 7, EPD_Image_ArrowUp_12x8);
-                    break;
-                }
-                if (select == 2 || select == 3)
-                {
-                    Menu_DrawSubmenuSaveSelect(select - 2);
-                }
-                else
-                {
-                    Menu_DrawSubmenuSaveSelect(6);
-                }
-
-                EPD_Show(0);
-            }
+            FMT_String(&buf, event_name[entry.Event]);
         }
-        if (save == 2)
+        else
         {
-            hwver_stor = 0x00002E00;
-            hwver_stor |= (hwver_2 + 48) << 16;
-            hwver_stor |= (hwver_1 + 48);
-            EEPROM_WriteDWORD(EEPROM_ADDR_DWORD_HWVERSION, hwver_stor);
+            FMT_String(&buf, "0x");
+            FMT_Hex(&buf, entry.Event, 2);
         }
-        if (wait_btn != 0)
+        FMT_Pad(&buf, 18 + 15); /* 事件名称列宽14，之后一个空格 */
+        FMT_String(&buf, "0x");
+        FMT_Hex(&buf, entry.Arg, 8);
+        SERIAL_SendStringRN(str_buffer);
+    }
+    SERIAL_SendStringRN("EVENT LOG DUMP END");
+    SERIAL_SendStringRN("");
+}
+
+static void DumpI2C(void)
+{
+    uint8_t i, bin;
+    struct I2C_Stats stats;
+    char str_buffer[80];
+    struct FMT_Buffer buf;
+
+    SERIAL_SendStringRN("");
+    SERIAL_SendStringRN("I2C DUMP:");
+    FMT_Init(&buf, str_buffer, sizeof(str_buffer));
+    FMT_String(&buf, "BUS RECOVER: ");
+    FMT_Uint(&buf, I2C_GetResetCount(), 0, 0);
+    SERIAL_SendStringRN(str_buffer);
+    SERIAL_SendStringRN("ADDR  OK     NACK   TMO    BERR   RCVR   RFAIL  SKIP   STREAK LAST MAX_US");
+    for (i = 0; I2C_GetStats(i, &stats) == 0; i++)
+    {
+        FMT_Init(&buf, str_buffer, sizeof(str_buffer));
+        FMT_String(&buf, "0x");
+        FMT_Hex(&buf, stats.Addr, 2);
+        FMT_String(&buf, "  ");
+        FMT_Uint(&buf, stats.Count, 6, FMT_LEFT);
+        FMT_Char(&buf, ' ');
+        FMT_Uint(&buf, stats.NACK, 6, FMT_LEFT);
+        FMT_Char(&buf, ' ');
+        FMT_Uint(&buf, stats.Timeout, 6, FMT_LEFT);
+        FMT_Char(&buf, ' ');
+        FMT_Uint(&buf, stats.BusError, 6, FMT_LEFT);
+        FMT_Char(&buf, ' ');
+        FMT_Uint(&buf, stats.Recover, 6, FMT_LEFT);
+        FMT_Char(&buf, ' ');
+        FMT_Uint(&buf, stats.RecoverFail, 6, FMT_LEFT);
+        FMT_Char(&buf, ' ');
+        FMT_Uint(&buf, stats.Skip, 6, FMT_LEFT);
+        FMT_Char(&buf, ' ');
+        FMT_Uint(&buf, stats.FailStreak, 6, FMT_LEFT);
+        FMT_Char(&buf, ' ');
+        FMT_Uint(&buf, stats.LastResult, 4, FMT_LEFT);
+        FMT_Char(&buf, ' ');
+        FMT_Uint(&buf, stats.LatencyMax, 0, 0);
+        SERIAL_SendStringRN(str_buffer);
+    }
+    SERIAL_SendStringRN("ADDR  <128us <256us <512us <1ms   <2ms   <4ms   <8ms   >=8ms");
+    for (i = 0; I2C_GetStats(i, &stats) == 0; i++)
+    {
+        FMT_Init(&buf, str_buffer, sizeof(str_buffer));
+        FMT_String(&buf, "0x");
+        FMT_Hex(&buf, stats.Addr, 2);
+        FMT_Char(&buf, ' ');
+        for (bin = 0; bin < I2C_LATENCY_BINS; bin++)
+        {
+            FMT_Char(&buf, ' ');
+            FMT_Uint(&buf, stats.Latency[bin], 6, FMT_LEFT);
+        }
+        SERIAL_SendStringRN(str_buffer);
+    }
+    SERIAL_SendStringRN("I2C DUMP END");
+    SERIAL_SendStringRN("");
+}
+
+/* ==================== 串口命令 ==================== */
+
+/* 可以通过串口读写的设置，数值范围和小数位数与设置页面的字段相同 */
+struct Console_Setting
+{
+    const char *name;
+    const struct Menu_Field *field;
+};
+
+const static struct Console_Setting Console_Settings[] = {
+    {"buzzer_enable", &Menu_BuzzerFields[0]},
+    {"buzzer_volume", &Menu_BuzzerFields[1]},
+    {"battery_warn", &Menu_BatteryFields[0]},
+    {"battery_stop", &Menu_BatteryFields[1]},
+    {"sensor_temp_offset", &Menu_SensorFields[0]},
+    {"sensor_rh_offset", &Menu_SensorFields[1]},
+    {"vrefint_offset", &Menu_VrefintFields[0]},
+    {"rtc_aging_offset", &Menu_AgingFields[0]},
+    {"home_face", &Menu_FaceFields[0]}};
+
+struct Console_Dump
+{
+    const char *name;
+    void (*dump)(void);
+};
+
+const static struct Console_Dump Console_Dumps[] = {
+    {"rtc", DumpRTCReg},
+    {"eeprom", DumpEEPROM},
+    {"bkpr", DumpBKPR},
+    {"history", DumpHistory},
+    {"battery", DumpBattery},
+    {"log", DumpEventLog},
+    {"i2c", DumpI2C}};
+
+static uint8_t Console_FieldDecimals(const struct Menu_Field *field)
+{
+    return ((field->type & ~MENU_FIELD_CHECK) == MENU_FIELD_VALUE && (field->format & MENU_FORMAT_FIXED2) != 0) ? 2 : 0;
+}
+
+static void Console_PrintSetting(const struct Console_Setting *setting)
+{
+    struct FMT_Buffer buf;
+
+    FMT_Init(&buf, String, sizeof(String));
+    FMT_String(&buf, setting->name);
+    FMT_Char(&buf, '=');
+    FMT_Fixed(&buf, Menu_GetValue(setting->field, &Setting), Console_FieldDecimals(setting->field), 0, 0);
+    SERIAL_SendStringRN(String);
+}
+
+/* get [名称]：读取一个或全部设置 */
+static uint8_t Console_Get(uint8_t argc, char *argv[])
+{
+    uint8_t i, found;
+
+    found = 0;
+    for (i = 0; i < sizeof(Console_Settings) / sizeof(Console_Settings[0]); i++)
+    {
+        if (argc == 1 || CON_IsEqual(argv[1], Console_Settings[i].name) != 0)
         {
-            wait_btn = 0;
-            BEEP_Button();
-            BTN_WaitAll();
+            Console_PrintSetting(&Console_Settings[i]);
+            found = 1;
         }
     }
-    BEEP_OK();
+    return (argc <= 2 && found != 0) ? CON_RESULT_OK : CON_RESULT_ERROR;
 }
 
-/* ==================== 电池图标绘制 ==================== */
-
-static void EPD_DrawBattery(uint16_t x, uint8_t y_x8, float max_voltage, float min_voltage, float voltage)
+/* set 名称 数值：修改设置，应用并保存 */
+static uint8_t Console_Set(uint8_t argc, char *argv[])
 {
-    uint8_t dis_ram[sizeof(EPD_Image_BattWarn)];
-    uint8_t i, bar_size, bar_size_max, bar_end_pos;
+    const struct Menu_Field *field;
+    int32_t value;
+    uint8_t i;
 
-    if ((voltage < min_voltage) || ((max_voltage - min_voltage) < 0.001))
+    if (argc != 3)
     {
-        EPD_DrawImage(x, y_x8, EPD_Image_BattWarn);
-        return;
+        return CON_RESULT_ERROR;
     }
-    memcpy(dis_ram, EPD_Image_BattWarn, sizeof(dis_ram));
-    bar_end_pos = (dis_ram[2] / 8) * (dis_ram[0] - 5) + 3;
-    bar_size_max = dis_ram[0] - 12;
-    if (voltage < max_voltage)
+    for (i = 0; i < sizeof(Console_Settings) / sizeof(Console_Settings[0]); i++)
     {
-        voltage -= min_voltage;
-        bar_size = (voltage / ((max_voltage - min_voltage) / bar_size_max)) + 0.5;
+        if (CON_IsEqual(argv[1], Console_Settings[i].name) != 0)
+        {
+            break;
+        }
     }
-    else
+    if (i == sizeof(Console_Settings) / sizeof(Console_Settings[0]))
     {
-        bar_size = bar_size_max;
+        return CON_RESULT_ERROR;
     }
-    if (bar_size == 0)
+    field = Console_Settings[i].field;
+    if (CON_ParseFixed(argv[2], Console_FieldDecimals(field), &value) != 0 || value < field->min || value > field->max)
     {
-        bar_size = 1;
+        return CON_RESULT_ERROR;
     }
-    else if (bar_size > bar_size_max)
+    Menu_SetValue(field, &Setting, value);
+    ApplySetting(&Setting);
+    SaveSetting(&Setting);
+    Console_PrintSetting(&Console_Settings[i]);
+    return CON_RESULT_OK;
+}
+
+/* time [YYYY-MM-DD HH:MM:SS]：读取或设置时间，使用24小时制，星期由日期计算 */
+static uint8_t Console_Time(uint8_t argc, char *argv[])
+{
+    int32_t date[3], clock[3];
+    uint8_t month_days;
+    struct FMT_Buffer buf;
+
+    if (argc == 3)
+    {
+        if (CON_ParseFields(argv[1], '-', date, 3) != 0 || CON_ParseFields(argv[2], ':', clock, 3) != 0 ||
+            date[0] < 2000 || date[0] > 2199 || date[1] < 1 || date[1] > 12 || clock[0] > 23 || clock[1] > 59 || clock[2] > 59)
+        {
+            return CON_RESULT_ERROR;
+        }
+        month_days = (date[1] == 12) ? 31 : CAL_GetDays2000(date[0], date[1] + 1, 1) - CAL_GetDays2000(date[0], date[1], 1);
+        if (date[2] < 1 || date[2] > month_days)
+        {
+            return CON_RESULT_ERROR;
+        }
+        RTC_GetTime(&Time); /* 保持12/24小时制 */
+        Time.Year = date[0] - 2000;
+        Time.Month = date[1];
+        Time.Date = date[2];
+        Time.Day = (CAL_GetDays2000(date[0], date[1], date[2]) + 5) % 7 + 1; /* 2000年1月1日为星期六 */
+        Time.Minutes = clock[1];
+        Time.Seconds = clock[2];
+        Time.PM = (Time.Is_12hr != 0 && clock[0] >= 12) ? 1 : 0;
+        Time.Hours = (Time.Is_12hr != 0) ? ((clock[0] % 12 == 0) ? 12 : clock[0] % 12) : clock[0];
+        RTC_SetTime(&Time);
+        LUNAR_InvalidateCache(); /* 时间已修改，下次重新计算农历 */
+        Alarm_Update(0);         /* 钟声按新的时间重新设置 */
+    }
+    else if (argc != 1)
+    {
+        return CON_RESULT_ERROR;
+    }
+    RTC_GetTime(&Time);
+    FMT_Init(&buf, String, sizeof(String));
+    FMT_String(&buf, "time=");
+    FMT_Uint(&buf, Time.Year + 2000, 4, FMT_ZERO);
+    FMT_Char(&buf, '-');
+    FMT_Uint(&buf, Time.Month, 2, FMT_ZERO);
+    FMT_Char(&buf, '-');
+    FMT_Uint(&buf, Time.Date, 2, FMT_ZERO);
+    FMT_Char(&buf, ' ');
+    FMT_Uint(&buf, (Time.Is_12hr != 0) ? (Time.Hours % 12) + Time.PM * 12 : Time.Hours, 2, FMT_ZERO);
+    FMT_Char(&buf, ':');
+    FMT_Uint(&buf, Time.Minutes, 2, FMT_ZERO);
+    FMT_Char(&buf, ':');
+    FMT_Uint(&buf, Time.Seconds, 2, FMT_ZERO);
+    FMT_String(&buf, " day=");
+    FMT_Uint(&buf, Time.Day, 0, 0);
+    SERIAL_SendStringRN(String);
+    return CON_RESULT_OK;
+}
+
+/* alarm [序号 HH:MM 星期]：读取全部或设置一个钟声，星期为7位0/1，从星期一开始 */
+static uint8_t Console_Alarm(uint8_t argc, char *argv[])
+{
+    int32_t index, clock[2];
+    uint8_t i, day, weekdays;
+    struct FMT_Buffer buf;
+
+    if (argc == 4)
     {
-        bar_size = bar_size_max;
+        if (CON_ParseFixed(argv[1], 0, &index) != 0 || index < 1 || index > ALARM_COUNT ||
+            CON_ParseFields(argv[2], ':', clock, 2) != 0 || clock[0] > 23 || clock[1] > 59)
+        {
+            return CON_RESULT_ERROR;
+        }
+        weekdays = 0;
+        for (day = 0; day < 7; day++)
+        {
+            if (argv[3][day] != '0' && argv[3][day] != '1')
+            {
+                return CON_RESULT_ERROR;
+            }
+            weekdays |= (argv[3][day] - '0') << day;
+        }
+        if (argv[3][7] != '\0')
+        {
+            return CON_RESULT_ERROR;
+        }
+        Setting.alarms[index - 1].Hours = clock[0];
+        Setting.alarms[index - 1].Minutes = clock[1];
+        Setting.alarms[index - 1].Weekdays = weekdays;
+        SaveSetting(&Setting);
+        Alarm_Update(0);
     }
-    for (i = 0; i < bar_size_max; i++) /* 清空电池图标内部 */
+    else if (argc != 1)
     {
-        dis_ram[bar_end_pos - (i * 3) + 0] |= 0x07;
-        dis_ram[bar_end_pos - (i * 3) + 1] |= 0xFF;
-        dis_ram[bar_end_pos - (i * 3) + 2] |= 0xE0;
+        return CON_RESULT_ERROR;
     }
-    for (i = 0; i < bar_size; i++) /* 绘制填充 */
+    for (i = 0; i < ALARM_COUNT; i++)
     {
-        dis_ram[bar_end_pos - (i * 3) + 0] &= 0xF8;
-        dis_ram[bar_end_pos - (i * 3) + 1] &= 0x00;
-        dis_ram[bar_end_pos - (i * 3) + 2] &= 0x1F;
+        FMT_Init(&buf, String, sizeof(String));
+        FMT_String(&buf, "alarm");
+        FMT_Uint(&buf, i + 1, 0, 0);
+        FMT_Char(&buf, '=');
+        FMT_Uint(&buf, Setting.alarms[i].Hours, 2, FMT_ZERO);
+        FMT_Char(&buf, ':');
+        FMT_Uint(&buf, Setting.alarms[i].Minutes, 2, FMT_ZERO);
+        FMT_Char(&buf, ' ');
+        for (day = 0; day < 7; day++)
+        {
+            FMT_Char(&buf, '0' + ((Setting.alarms[i].Weekdays >> day) & 0x01));
+        }
+        SERIAL_SendStringRN(String);
     }
-    EPD_DrawImage(x, y_x8, dis_ram);
+    return CON_RESULT_OK;
 }
 
-/* ==================== 设置存储 ==================== */
-
-static void SaveSetting(const struct Func_Setting *setting)
+/* dump 名称：输出调试信息 */
+static uint8_t Console_Dump(uint8_t argc, char *argv[])
 {
-    uint16_t i;
-    uint8_t *setting_ptr;
+    uint8_t i;
 
-    setting_ptr = (uint8_t *)setting;
-    for (i = 0; i < sizeof(struct Func_Setting); i++)
+    if (argc != 2)
+    {
+        return CON_RESULT_ERROR;
+    }
+    for (i = 0; i < sizeof(Console_Dumps) / sizeof(Console_Dumps[0]); i++)
     {
-        if (EEPROM_ReadByte(EEPROM_ADDR_BYTE_SETTING + i) != setting_ptr[i])
+        if (CON_IsEqual(argv[1], Console_Dumps[i].name) != 0)
         {
-            EEPROM_WriteByte(EEPROM_ADDR_BYTE_SETTING + i, setting_ptr[i]);
+            Console_Dumps[i].dump();
+            return CON_RESULT_OK;
         }
     }
+    return CON_RESULT_ERROR;
 }
 
-static void ReadSetting(struct Func_Setting *setting)
+/* refresh [full]：立即刷新主界面，full时先全屏刷新清除残影 */
+static uint8_t Console_Refresh(uint8_t argc, char *argv[])
 {
-    uint16_t i;
-    uint8_t *setting_ptr;
-
-    setting_ptr = (uint8_t *)setting;
-    for (i = 0; i < sizeof(struct Func_Setting); i++)
+    if (argc > 2 || (argc == 2 && CON_IsEqual(argv[1], "full") == 0))
     {
-        setting_ptr[i] = EEPROM_ReadByte(EEPROM_ADDR_BYTE_SETTING + i);
+        return CON_RESULT_ERROR;
     }
-    if (setting->available != SETTING_AVALIABLE_FLAG)
+    if (argc == 2)
     {
-        BUZZER_SetFrqe(4000);
-        BUZZER_SetVolume(DefaultSetting.buzzer_volume);
-        BUZZER_Beep(499);
-        memcpy(setting, &DefaultSetting, sizeof(struct Func_Setting));
+        Menu_ClearScreen();
     }
+    UpdateHomeDisplay(); /* 串口命令期间电子纸保持供电，日期未改变时局部刷新 */
+    return CON_RESULT_OK;
 }
 
-/* ==================== 按键读取 ==================== */
+/* ==================== 二进制数据交换 ==================== */
+
+/*
+ * 串口命令binary进入二进制模式，之后按frame.c的帧格式交换数据，地址和数量都以字节为单位。
+ * 请求和回复的数据（地址为小端序）：
+ * FRAME_TYPE_PING：无 -> 软件版本字符串
+ * FRAME_TYPE_READ_EEPROM：地址(2) 数量(1) -> 地址(2) 数据
+ * FRAME_TYPE_WRITE_EEPROM：地址(2) 数据 -> 地址(2)，不能写入Frame_ProtectedEEPROM中的区域
+ * FRAME_TYPE_READ_BKPR/READ_RTC：地址(1) 数量(1) -> 地址(1) 数据
+ * FRAME_TYPE_WRITE_BKPR/WRITE_RTC：地址(1) 数据 -> 地址(1)
+ * FRAME_TYPE_READ_HISTORY：范围(1，HIST_RANGE_*) 位置(1) 数量(1) -> 范围(1) 位置(1) 每条记录8字节（struct HIST_Record）
+ * FRAME_TYPE_READ_LOG：游标(2，首次为0) -> 下次的游标(2) 每条记录9字节（分钟数+1(4) 事件(1) 参数(4)），没有记录时读取结束
+ */
+#define FRAME_TYPE_PING 0x01
+#define FRAME_TYPE_READ_EEPROM 0x02
+#define FRAME_TYPE_WRITE_EEPROM 0x03
+#define FRAME_TYPE_READ_BKPR 0x04
+#define FRAME_TYPE_WRITE_BKPR 0x05
+#define FRAME_TYPE_READ_RTC 0x06
+#define FRAME_TYPE_WRITE_RTC 0x07
+#define FRAME_TYPE_READ_HISTORY 0x08
+#define FRAME_TYPE_READ_LOG 0x09
+
+#define FRAME_HIST_RECORD_SIZE 8
+#define FRAME_LOG_RECORD_SIZE 9
+
+/* 不能通过FRAME_TYPE_WRITE_EEPROM写入的EEPROM区域（四字节地址），写入后设置记录或硬件版本会被破坏 */
+struct Frame_Region
+{
+    uint16_t start_dword;
+    uint16_t dword_count;
+};
 
-static uint8_t BTN_ReadUP(void)
+const static struct Frame_Region Frame_ProtectedEEPROM[] = {
+    {STORE_EEPROM_ADDR_DWORD, STORE_SLOT_COUNT * STORE_SLOT_DWORDS}, /* store.c管理的设置记录槽 */
+    {EEPROM_ADDR_DWORD_HWVERSION, 1}};
+
+static void Frame_PutDWORD(uint8_t *data, uint32_t value)
 {
-    if (LL_GPIO_IsInputPinSet(BTN_UP_GPIO_Port, BTN_UP_Pin) == 0)
-    {
-        LL_mDelay(BTN_DEBOUNCE_MS);
-        if (LL_GPIO_IsInputPinSet(BTN_UP_GPIO_Port, BTN_UP_Pin) == 0)
-        {
-            return 0;
-        }
-    }
-    return 1;
+    data[0] = value & 0xFF;
+    data[1] = (value >> 8) & 0xFF;
+    data[2] = (value >> 16) & 0xFF;
+    data[3] = value >> 24;
 }
 
-static uint8_t BTN_ReadUPFast(void)
+static uint8_t Frame_Ping(uint8_t *data, uint8_t *length)
 {
-    if (LL_GPIO_IsInputPinSet(BTN_UP_GPIO_Port, BTN_UP_Pin) == 0)
-    {
-        return 0;
-    }
-    return 1;
+    *length = sizeof(SOFT_VERSION) - 1;
+    memcpy(data, SOFT_VERSION, *length);
+    return FRAME_OK;
 }
 
-static uint8_t BTN_ReadDOWN(void)
+static uint8_t Frame_ReadEEPROM(uint8_t *data, uint8_t *length)
 {
-    if (LL_GPIO_IsInputPinSet(BTN_DOWN_GPIO_Port, BTN_DOWN_Pin) == 0)
+    uint16_t addr;
+    uint8_t i, count;
+
+    if (*length != 3)
     {
-        LL_mDelay(BTN_DEBOUNCE_MS);
-        if (LL_GPIO_IsInputPinSet(BTN_DOWN_GPIO_Port, BTN_DOWN_Pin) == 0)
-        {
-            return 0;
-        }
+        return FRAME_ERROR_LENGTH;
     }
-    return 1;
-}
-
-static uint8_t BTN_ReadSET(void)
-{
-    if (LL_GPIO_IsInputPinSet(BTN_SET_GPIO_Port, BTN_SET_Pin) == 0)
+    addr = data[0] | (data[1] << 8);
+    count = data[2];
+    if (count == 0 || count > FRAME_PAYLOAD_MAX - 2 || addr + count > EEPROM_SIZE)
     {
-        LL_mDelay(BTN_DEBOUNCE_MS);
-        if (LL_GPIO_IsInputPinSet(BTN_SET_GPIO_Port, BTN_SET_Pin) == 0)
-        {
-            return 0;
-        }
+        return FRAME_ERROR_RANGE;
     }
-    return 1;
+    for (i = 0; i < count; i++)
+    {
+        data[2 + i] = EEPROM_ReadByte(addr + i);
+    }
+    *length = 2 + count;
+    return FRAME_OK;
 }
 
-static void BTN_WaitSET(void)
+static uint8_t Frame_WriteEEPROM(uint8_t *data, uint8_t *length)
 {
-    while (1)
+    uint16_t addr, end;
+    uint8_t i;
+
+    if (*length < 3)
     {
-        if (LL_GPIO_IsInputPinSet(BTN_SET_GPIO_Port, BTN_SET_Pin) != 0)
+        return FRAME_ERROR_LENGTH;
+    }
+    addr = data[0] | (data[1] << 8);
+    end = addr + (*length - 2);
+    if (addr >= EEPROM_SIZE || end > EEPROM_SIZE)
+    {
+        return FRAME_ERROR_RANGE;
+    }
+    for (i = 0; i < sizeof(Frame_ProtectedEEPROM) / sizeof(struct Frame_Region); i++) /* 与受保护区域有重叠 */
+    {
+        if (addr < (Frame_ProtectedEEPROM[i].start_dword + Frame_ProtectedEEPROM[i].dword_count) * 4 && end > Frame_ProtectedEEPROM[i].start_dword * 4)
         {
-            LL_mDelay(BTN_DEBOUNCE_MS);
-            if (LL_GPIO_IsInputPinSet(BTN_SET_GPIO_Port, BTN_SET_Pin) != 0)
-            {
-                return;
-            }
+            return FRAME_ERROR_RANGE;
         }
     }
+    if (EEPROM_WriteBuffer(addr, data + 2, *length - 2) != 0)
+    {
+        return FRAME_ERROR_IO;
+    }
+    *length = 2;
+    return FRAME_OK;
 }
 
-static void BTN_WaitAll(void)
+static uint8_t Frame_ReadBKPR(uint8_t *data, uint8_t *length)
 {
-    while (1)
+    uint8_t i;
+
+    if (*length != 2)
     {
-        if (LL_GPIO_IsInputPinSet(BTN_SET_GPIO_Port, BTN_SET_Pin) != 0 &&
-            LL_GPIO_IsInputPinSet(BTN_UP_GPIO_Port, BTN_UP_Pin) != 0 &&
-            LL_GPIO_IsInputPinSet(BTN_DOWN_GPIO_Port, BTN_DOWN_Pin) != 0)
-        {
-            LL_mDelay(BTN_DEBOUNCE_MS);
-            if (LL_GPIO_IsInputPinSet(BTN_SET_GPIO_Port, BTN_SET_Pin) != 0 &&
-                LL_GPIO_IsInputPinSet(BTN_UP_GPIO_Port, BTN_UP_Pin) != 0 &&
-                LL_GPIO_IsInputPinSet(BTN_DOWN_GPIO_Port, BTN_DOWN_Pin) != 0)
-            {
-                return;
-            }
-        }
+        return FRAME_ERROR_LENGTH;
+    }
+    if (data[1] == 0 || data[0] + data[1] > BKPR_SIZE)
+    {
+        return FRAME_ERROR_RANGE;
+    }
+    *length = 1 + data[1];
+    for (i = 1; i < *length; i++)
+    {
+        data[i] = BKPR_ReadByte(data[0] + i - 1);
     }
+    return FRAME_OK;
 }
 
-static uint8_t BTN_ModifySingleDigit(uint8_t *number, uint8_t modify_digit, uint8_t max_val, uint8_t min_val)
+static uint8_t Frame_WriteBKPR(uint8_t *data, uint8_t *length)
 {
-    double pow_tmp;
-    uint8_t digit_value;
+    uint8_t i;
 
-    if (BTN_ReadUP() == 0)
+    if (*length < 2)
     {
-        pow_tmp = pow(10, modify_digit);
-        digit_value = (uint32_t)(*number / pow_tmp) % 10;
-        if (digit_value < max_val)
-        {
-            *number += (uint32_t)pow_tmp;
-        }
-        else
-        {
-            *number -= (uint32_t)pow_tmp * digit_value;
-            *number += (uint32_t)pow_tmp * min_val;
-        }
-        return 1;
+        return FRAME_ERROR_LENGTH;
     }
-    else if (BTN_ReadDOWN() == 0)
+    if (data[0] + (*length - 1) > BKPR_SIZE)
     {
-        pow_tmp = pow(10, modify_digit);
-        digit_value = (uint32_t)(*number / pow_tmp) % 10;
-        if (digit_value > min_val)
-        {
-            *number -= (uint32_t)pow_tmp;
-        }
-        else
+        return FRAME_ERROR_RANGE;
+    }
+    for (i = 1; i < *length; i++)
+    {
+        if (BKPR_WriteByte(data[0] + i - 1, data[i]) != 0)
         {
-            *number -= (uint32_t)pow_tmp * digit_value;
-            *number += (uint32_t)pow_tmp * max_val;
+            return FRAME_ERROR_IO;
         }
-        return 1;
     }
-    return 0;
+    *length = 1;
+    return FRAME_OK;
 }
 
-/* ==================== 蜂鸣器 ==================== */
-
-static void BEEP_Fast(void)
+static uint8_t Frame_ReadRTC(uint8_t *data, uint8_t *length)
 {
-    if (Setting.buzzer_enable != 0)
+    if (*length != 2)
     {
-        BUZZER_SetFrqe(4000);
-        BUZZER_SetVolume(Setting.buzzer_volume);
-        BUZZER_Beep(4);
+        return FRAME_ERROR_LENGTH;
     }
-}
-
-static void BEEP_Button(void)
-{
-    if (Setting.buzzer_enable != 0)
+    if (data[1] == 0 || data[0] + data[1] > RTC_REG_COUNT)
     {
-        BUZZER_SetFrqe(4000);
-        BUZZER_SetVolume(Setting.buzzer_volume);
-        BUZZER_Beep(19);
+        return FRAME_ERROR_RANGE;
     }
-}
-
-static void BEEP_OK(void)
-{
-    if (Setting.buzzer_enable != 0)
+    *length = 1 + data[1];
+    if (RTC_ReadREG_Multi(data[0], data[1], data + 1) != 0)
     {
-        BUZZER_SetFrqe(4000);
-        BUZZER_SetVolume(Setting.buzzer_volume);
-        BUZZER_SetFrqe(1000);
-        BUZZER_Beep(39);
-        BUZZER_SetFrqe(4000);
-        BUZZER_Beep(39);
+        return FRAME_ERROR_IO;
     }
+    return FRAME_OK;
 }
 
-/* ==================== 电源控制 ==================== */
-
-static void Power_EnableGDEH029A1(void)
+static uint8_t Frame_WriteRTC(uint8_t *data, uint8_t *length)
 {
-    LL_GPIO_ResetOutputPin(EPD_POWER_GPIO_Port, EPD_POWER_Pin);
-    LL_GPIO_SetOutputPin(EPD_CS_PORT, EPD_CS_PIN);
-    LL_GPIO_SetOutputPin(EPD_DC_PORT, EPD_DC_PIN);
-    LL_GPIO_SetOutputPin(EPD_RST_PORT, EPD_RST_PIN);
-    Delay_100ns(100); /* 10us，未要求，短暂延时 */
-    if (LL_SPI_IsEnabled(SPI1) == 0)
+    if (*length < 2)
     {
-        LL_SPI_Enable(SPI1);
+        return FRAME_ERROR_LENGTH;
     }
-}
-
-static void Power_Enable_SHT30_I2C(void)
-{
-    LL_GPIO_ResetOutputPin(SHT30_POWER_GPIO_Port, SHT30_POWER_Pin); /* 打开SHT30电源 */
-    LL_GPIO_SetOutputPin(I2C1_PULLUP_GPIO_Port, I2C1_PULLUP_Pin);   /* 打开I2C上拉电阻 */
-    LL_GPIO_SetOutputPin(SHT30_RST_GPIO_Port, SHT30_RST_Pin);       /* 释放SHT30复位引脚 */
-    Delay_100ns(20);                                                /* 最少1us宽度，设置为2us */
-    LL_GPIO_ResetOutputPin(SHT30_RST_GPIO_Port, SHT30_RST_Pin);     /* SHT30硬复位 */
-    Delay_100ns(20);                                                /* 最少1us宽度，设置为2us */
-    LL_GPIO_SetOutputPin(SHT30_RST_GPIO_Port, SHT30_RST_Pin);       /* SHT30硬复位 */
-    LL_mDelay(1);                                                   /* SHT30复位后需要最少1ms启动时间，设置为2ms */
-    if (LL_I2C_IsEnabled(I2C1) == 0)                                /* 打开I2C */
+    if (data[0] + (*length - 1) > RTC_REG_COUNT)
     {
-        LL_I2C_Enable(I2C1);
+        return FRAME_ERROR_RANGE;
+    }
+    if (RTC_WriteREG_Multi(data[0], *length - 1, data + 1) != 0)
+    {
+        return FRAME_ERROR_IO;
+    }
+    if (data[0] <= RTC_REG_YER) /* 时间已修改，下次重新计算农历，钟声按新的时间重新设置 */
+    {
+        LUNAR_InvalidateCache();
+        Alarm_Update(0);
     }
+    *length = 1;
+    return FRAME_OK;
 }
 
-static uint8_t Power_EnableADC(void)
+static uint8_t Frame_ReadHistory(uint8_t *data, uint8_t *length)
 {
-    ADC_Disable();
-    ADC_StartCal();
-    return ADC_Enable();
-}
+    struct HIST_Record record;
+    uint8_t i, count, *ptr;
 
-static void Power_EnableBUZZER(void)
-{
-    BUZZER_Enable();
+    if (*length != 3)
+    {
+        return FRAME_ERROR_LENGTH;
+    }
+    count = data[2];
+    if (data[0] > HIST_RANGE_7D || count == 0 || count > (FRAME_PAYLOAD_MAX - 2) / FRAME_HIST_RECORD_SIZE)
+    {
+        return FRAME_ERROR_RANGE;
+    }
+    if ((uint16_t)data[1] + count > ((data[0] == HIST_RANGE_24H) ? HIST_HOUR_COUNT : HIST_DAY_COUNT)) /* 不能超出记录数量，也避免位置加上序号后回绕 */
+    {
+        return FRAME_ERROR_RANGE;
+    }
+    ptr = data + 2;
+    for (i = 0; i < count; i++)
+    {
+        if (((data[0] == HIST_RANGE_24H) ? HIST_ReadHour(data[1] + i, &record) : HIST_ReadDay(data[1] + i, &record)) != 0)
+        {
+            return FRAME_ERROR_RANGE;
+        }
+        ptr[0] = record.Stamp & 0xFF;
+        ptr[1] = record.Stamp >> 8;
+        ptr[2] = record.CEL_Min;
+        ptr[3] = record.CEL_Max;
+        ptr[4] = record.CEL_Avg;
+        ptr[5] = record.RH_Min;
+        ptr[6] = record.RH_Max;
+        ptr[7] = record.RH_Avg;
+        ptr += FRAME_HIST_RECORD_SIZE;
+    }
+    *length = ptr - data;
+    return FRAME_OK;
 }
 
-static void Power_DisableGDEH029A1(void)
+static uint8_t Frame_ReadLog(uint8_t *data, uint8_t *length)
 {
-    if (LL_SPI_IsEnabled(SPI1) != 0)
+    struct LOG_Entry entry;
+    uint16_t cursor;
+    uint8_t *ptr;
+
+    if (*length != 2)
     {
-        LL_SPI_Disable(SPI1);
+        return FRAME_ERROR_LENGTH;
     }
-    LL_GPIO_ResetOutputPin(EPD_RST_PORT, EPD_RST_PIN);
-    LL_GPIO_ResetOutputPin(EPD_DC_PORT, EPD_DC_PIN);
-    LL_GPIO_ResetOutputPin(EPD_CS_PORT, EPD_CS_PIN);
-    LL_GPIO_SetOutputPin(EPD_POWER_GPIO_Port, EPD_POWER_Pin);
+    cursor = data[0] | (data[1] << 8);
+    ptr = data + 2;
+    while (ptr + FRAME_LOG_RECORD_SIZE <= data + FRAME_PAYLOAD_MAX && LOG_ReadNext(&cursor, &entry) == 0)
+    {
+        Frame_PutDWORD(ptr, entry.Minutes);
+        ptr[4] = entry.Event;
+        Frame_PutDWORD(ptr + 5, entry.Arg);
+        ptr += FRAME_LOG_RECORD_SIZE;
+    }
+    data[0] = cursor & 0xFF;
+    data[1] = cursor >> 8;
+    *length = ptr - data;
+    return FRAME_OK;
 }
 
-static void Power_Disable_I2C_SHT30(void)
+const static struct FRAME_Command Frame_Commands[] = {
+    {FRAME_TYPE_PING, Frame_Ping},
+    {FRAME_TYPE_READ_EEPROM, Frame_ReadEEPROM},
+    {FRAME_TYPE_WRITE_EEPROM, Frame_WriteEEPROM},
+    {FRAME_TYPE_READ_BKPR, Frame_ReadBKPR},
+    {FRAME_TYPE_WRITE_BKPR, Frame_WriteBKPR},
+    {FRAME_TYPE_READ_RTC, Frame_ReadRTC},
+    {FRAME_TYPE_WRITE_RTC, Frame_WriteRTC},
+    {FRAME_TYPE_READ_HISTORY, Frame_ReadHistory},
+    {FRAME_TYPE_READ_LOG, Frame_ReadLog}};
+
+/* binary：进入二进制模式，回复"BINARY"后按帧交换数据，收到FRAME_TYPE_EXIT后回到命令行 */
+static uint8_t Console_Binary(uint8_t argc, char *argv[])
 {
-    if (LL_I2C_IsEnabled(I2C1) != 0) /* 关闭I2C */
+    ((void)argv);
+    if (argc != 1)
     {
-        LL_I2C_Disable(I2C1);
+        return CON_RESULT_ERROR;
     }
-    LL_GPIO_ResetOutputPin(I2C1_PULLUP_GPIO_Port, I2C1_PULLUP_Pin); /* 关闭I2C上拉电阻 */
-    LL_GPIO_ResetOutputPin(SHT30_RST_GPIO_Port, SHT30_RST_Pin);     /* 拉低SHT30复位引脚 */
-    LL_GPIO_SetOutputPin(SHT30_POWER_GPIO_Port, SHT30_POWER_Pin);   /* 关闭SHT30电源 */
+    FRAME_Init(Frame_Commands, sizeof(Frame_Commands) / sizeof(Frame_Commands[0]));
+    SERIAL_SendStringRN("BINARY");
+    Console_Session(FRAME_Poll, FRAME_Resync);
+    return CON_RESULT_OK;
 }
 
-static uint8_t Power_DisableADC(void)
+static uint8_t Console_Help(uint8_t argc, char *argv[])
 {
-    return ADC_Disable();
+    ((void)argc);
+    ((void)argv);
+    CON_PrintHelp();
+    return CON_RESULT_OK;
 }
 
-static void Power_DisableBUZZER(void)
+static uint8_t Console_Exit(uint8_t argc, char *argv[])
 {
-    BUZZER_Disable();
+    ((void)argc);
+    ((void)argv);
+    return CON_RESULT_EXIT;
 }
 
-static void Power_DisableUSART(void) /* 关闭串口，下次使用需要重新初始化 */
+const static struct CON_Command Console_Commands[] = {
+    {"help", "", Console_Help},
+    {"get", "[name]", Console_Get},
+    {"set", "name value", Console_Set},
+    {"time", "[YYYY-MM-DD HH:MM:SS]", Console_Time},
+    {"alarm", "[index HH:MM 1111100]", Console_Alarm},
+    {"dump", "rtc|eeprom|bkpr|history|battery|log|i2c", Console_Dump},
+    {"refresh", "[full]", Console_Refresh},
+    {"binary", "", Console_Binary},
+    {"exit", "", Console_Exit}};
+
+/* 串口适配器的TX空闲时为高电平，RX引脚下拉后仍为高电平说明连接了适配器 */
+static uint8_t Console_Detect(void)
 {
-    LL_USART_Disable(SERIAL_NUM);
-    LL_GPIO_SetPinMode(GPIOA, LL_GPIO_PIN_9, LL_GPIO_MODE_ANALOG);
-    LL_GPIO_SetPinMode(GPIOA, LL_GPIO_PIN_10, LL_GPIO_MODE_ANALOG);
-    LL_GPIO_SetPinPull(GPIOA, LL_GPIO_PIN_9, LL_GPIO_PULL_NO);
-    LL_GPIO_SetPinPull(GPIOA, LL_GPIO_PIN_10, LL_GPIO_PULL_NO);
+    uint8_t connected;
+
+    LL_GPIO_SetPinPull(SERIAL_RX_PORT, SERIAL_RX_PIN, LL_GPIO_PULL_DOWN);
+    LL_GPIO_SetPinMode(SERIAL_RX_PORT, SERIAL_RX_PIN, LL_GPIO_MODE_INPUT);
+    Delay_100ns(100); /* 10us，等待下拉电阻生效 */
+    connected = LL_GPIO_IsInputPinSet(SERIAL_RX_PORT, SERIAL_RX_PIN);
+    LL_GPIO_SetPinMode(SERIAL_RX_PORT, SERIAL_RX_PIN, LL_GPIO_MODE_ANALOG);
+    LL_GPIO_SetPinPull(SERIAL_RX_PORT, SERIAL_RX_PIN, LL_GPIO_PULL_NO);
+    return connected;
 }
 
-/* ==================== 辅助功能 ==================== */
-
-static void DumpRTCReg(void)
+/**
+ * @brief  等待并处理串口数据，直到poll返回退出、按下“设置”键或CONSOLE_IDLE_MS内没有收到数据。
+ * @param  poll CON_Poll()或FRAME_Poll()，两者返回值的含义相同。
+ * @param  resync 等待了一次仍没有数据时调用，用于丢弃不完整的帧，可为NULL。
+ * @note   最近收到过数据时在Sleep模式中等待，连续接收时不会因为从Stop模式唤醒较慢而溢出，
+ *         长时间空闲后在Stop模式中等待，由串口接收唤醒，唤醒期间收到的数据可能丢失。
+ */
+static void Console_Session(uint8_t (*poll)(void), void (*resync)(void))
 {
-    uint8_t i, j, reg_tmp;
-    char byte_str[9];
+    struct BTN_Event event;
+    uint16_t idle_ms;
+    uint8_t status;
 
-    SERIAL_SendStringRN("");
-    SERIAL_SendStringRN("DS3231 REG DUMP:");
-    for (i = 0; i < 19; i++)
+    BTN_Flush();
+    idle_ms = 0;
+    while (idle_ms < CONSOLE_IDLE_MS)
     {
-        reg_tmp = RTC_ReadREG(RTC_REG_SEC + i);
-        for (j = 0; j < 8; j++)
+        status = poll();
+        if (status == CON_POLL_EXIT)
         {
-            if ((reg_tmp & (0x80 >> j)) != 0)
-            {
-                byte_str[j] = '1';
-            }
-            else
-            {
-                byte_str[j] = '0';
-            }
+            break;
         }
-        byte_str[8] = '\0';
-        SERIAL_SendString(byte_str);
-        snprintf(byte_str, sizeof(byte_str), " 0x%02X", reg_tmp);
-        SERIAL_SendStringRN(byte_str);
-    }
-    SERIAL_SendStringRN("DS3231 REG DUMP END");
-    SERIAL_SendStringRN("");
-}
-
-static void DumpEEPROM(void)
-{
-    uint16_t i;
-    char str_buffer[10];
-
-    SERIAL_SendStringRN("");
-    SERIAL_SendStringRN("EEPROM DUMP:");
-    SERIAL_SendStringRN("INDEX:    00   01   02   03   04   05   06   07   08   09   0A   0B   0C   0D   0E   0F");
-    for (i = 0; i < 2048; i++)
-    {
-        if (i % 16 == 0)
+        if (status == CON_POLL_ACTIVE)
         {
-            SERIAL_SendStringRN("");
+            idle_ms = 0;
+            continue;
         }
-        if (i % 16 == 0)
+        if (idle_ms != 0 && resync != NULL)
         {
-            snprintf(str_buffer, sizeof(str_buffer), "0x%04X    ", i);
-            SERIAL_SendString(str_buffer);
+            resync();
         }
-        snprintf(str_buffer, sizeof(str_buffer), "0x%02X ", EEPROM_ReadByte(i));
-        SERIAL_SendString(str_buffer);
-    }
-    SERIAL_SendStringRN("");
-    SERIAL_SendStringRN("EEPROM DUMP END");
-    SERIAL_SendStringRN("");
-}
-
-static void DumpBKPR(void)
-{
-    uint16_t i;
-    char str_buffer[10];
-
-    SERIAL_SendStringRN("");
-    SERIAL_SendStringRN("BKPR DUMP:");
-    SERIAL_SendStringRN("INDEX:    00   01   02   03   04   05   06   07   08   09   0A   0B   0C   0D   0E   0F");
-    for (i = 0; i < 20; i++)
-    {
-        if (i % 16 == 0)
+        if (BTN_GetEvent(&event) == BTN_EVENT_PRESS && event.Key == BTN_KEY_SET)
+        {
+            break;
+        }
+        if (idle_ms < CONSOLE_ACTIVE_MS) /* 收到数据或按键时提前唤醒，只累计实际经过的时间 */
         {
-            SERIAL_SendStringRN("");
+            idle_ms += LP_EnterSleep(CONSOLE_POLL_MS);
         }
-        if (i % 16 == 0)
+        else
         {
-            snprintf(str_buffer, sizeof(str_buffer), "0x%04X    ", i);
-            SERIAL_SendString(str_buffer);
+            idle_ms += BTN_Wait(CONSOLE_POLL_MS);
         }
-        snprintf(str_buffer, sizeof(str_buffer), "0x%02X ", BKPR_ReadByte(i));
-        SERIAL_SendString(str_buffer);
     }
+}
+
+/**
+ * @brief  处理串口命令，直到执行exit、按下“设置”键或CONSOLE_IDLE_MS内没有收到数据。
+ * @note   调用前需要先调用Power_EnableUSART()，已经收到的数据按命令处理。
+ */
+static void Console_Run(void)
+{
+    CON_Init(Console_Commands, sizeof(Console_Commands) / sizeof(Console_Commands[0]));
     SERIAL_SendStringRN("");
-    SERIAL_SendStringRN("BKPR DUMP END");
-    SERIAL_SendStringRN("");
+    SERIAL_SendStringRN(SOFT_VERSION);
+    Console_Session(CON_Poll, NULL);
 }
@@ -14,22 +14,50 @@
 #include "gdeh029A1.h"
 #include "buzzer.h"
 #include "lunar.h"
+#include "solarterm.h"
+#include "festival.h"
+#include "history.h"
+#include "battery.h"
+#include "store.h"
+#include "eventlog.h"
+#include "fmt.h"
+#include "alarm.h"
+#include "button.h"
+#include "numedit.h"
+#include "console.h"
+#include "frame.h"
 
 /* 可修改 */
 #define SOFT_VERSION "L051_1.06_MELANTHA"
-#define BTN_DEBOUNCE_MS 24
+#define MENU_IDLE_MS 20 /* 菜单中有内容等待电子纸刷新完成时的轮询间隔 */
+#define BTN_IDLE_WAIT_MS 1000 /* 等待按键时进入Stop模式的时间，按键中断会提前唤醒 */
 #define BAT_MIN_VOLTAGE 0.80
 #define BAT_MAX_VOLTAGE 3.00
+#define ALARM_RING_MS 60000UL /* 钟声无人处理时的响铃时间 */
+#define ALARM_POLL_MS 20 /* 响铃时检查按键的间隔 */
+#define ALARM_VOLUME BUZZER_MAX_VOL
+#define CONSOLE_IDLE_MS 30000 /* 串口命令没有收到数据时退出的时间 */
+#define CONSOLE_POLL_MS 1000  /* 等待串口数据时检查按键和计时的间隔 */
+#define CONSOLE_ACTIVE_MS 3000 /* 收到数据后在Sleep模式中等待的时间，之后进入Stop模式 */
+#define HOME_INFO_STYLE 0 /* 主界面右下角显示内容，0：干支纪年，1：24小时温度最高/最低值，2：24小时温度趋势图，3：电池剩余天数 */
+#define HOME_DAYS_LEFT_WARN 30 /* 电池剩余天数少于此值时主界面右下角改为显示剩余天数，0为只在HOME_INFO_STYLE为3时显示 */
 /* 结束 */
 
-#define BKPR_ADDR_DWORD_ADCVAL 0x00
-#define BKPR_ADDR_BYTE_REQINIT 0x04
+#define BKPR_ADDR_DWORD_ADCVAL 0x00 /* 滤波后的电池电压 */
+#define BKPR_ADDR_BYTE_REQINIT 0x04 /* 字节地址0x05 ~ 0x07由lunar.c使用，四字节地址0x02 ~ 0x04由history.c使用 */
 
-#define EEPROM_ADDR_BYTE_SETTING 0x00
-#define EEPROM_ADDR_DWORD_HWVERSION 0x01FF
+#define RTC_REG_LOWBAT RTC_REG_AL2_DDT /* 闹钟2每分钟触发，不比较日期，借用日期的低6位存储低电量画面已显示标志 */
+#define RTC_LOWBAT_MASK 0x3F
+#define RTC_LOWBAT_FLAG 0x2A
+
+#define EEPROM_ADDR_BYTE_SETTING 0x00 /* 旧版本的设置存储地址，现由store.c管理四字节地址0x00 ~ 0x7F */
+#define EEPROM_ADDR_DWORD_HWVERSION 0x01FF /* 四字节地址0xFE ~ 0xFF由battery.c使用，0x100 ~ 0x13D由history.c使用，0x140 ~ 0x1EF由eventlog.c使用 */
 
 #define REQUEST_RESET_ALL_FLAG 0x55
 #define SETTING_AVALIABLE_FLAG 0xAA
+#define SETTING_VERSION 0x03 /* 修改struct Func_Setting后需要修改此版本号 */
+#define SETTING_VERSION_V2 0x02 /* 没有alarms的版本，读取后补充默认值 */
+#define SETTING_VERSION_V1 0x01 /* 没有home_face和alarms的版本 */
 
 struct Func_Setting
 {
@@ -42,6 +70,8 @@ struct Func_Setting
     float sensor_rh_offset;
     int16_t vrefint_offset;
     int8_t rtc_aging_offset;
+    uint8_t home_face; /* 主界面表盘，Home_Faces中的序号 */
+    struct ALARM_Entry alarms[ALARM_COUNT];
 };
 
 void Init(void);
@@ -1,5 +1,8 @@
 #include "gdeh029a1.h"
 
+/* 曲线图绘制缓冲区 */
+static uint8_t graph_buffer[EPD_GRAPH_BUFFER_SIZE];
+
 /* 全屏刷新LUT */
 static const uint8_t LUT_Full[30] = {
     0x00, 0x00, 0xA6, 0x65, 0x66,
@@ -30,6 +33,11 @@ static const uint8_t LUT_Fast[30] = {
     0x00, 0x00, 0x00, 0x00, 0x77,
     0x17, 0x77, 0x77, 0x77, 0x77};
 
+/* 4位像素放大为8位，每个像素重复一次，用于2倍字体 */
+static const uint8_t Double_Nibble[16] = {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+    0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF};
+
 /**
  * @brief  延时100ns的倍数（不准确，只是大概）。
  * @param  nsX100 延时时间。
@@ -352,6 +360,16 @@ void EPD_Init(uint8_t update_mode)
     epd_send_cmd(0x3C);
     epd_send_data(0x33);
 
+    EPD_SetUpdateMode(update_mode);
+}
+
+/**
+ * @brief  切换显示更新模式，不复位控制器，显示RAM内数据保持不变。
+ * @param  update_mode 显示更新模式，可设置为：EPD_UPDATE_MODE_FULL、EPD_UPDATE_MODE_PART、EPD_UPDATE_MODE_FAST。
+ * @note   用于EPD_EnterSleep()之后在已有画面上局部刷新，DeepSleep之后需要调用EPD_Init()。
+ */
+void EPD_SetUpdateMode(uint8_t update_mode)
+{
     switch (update_mode)
     {
     case EPD_UPDATE_MODE_FULL:
@@ -483,6 +501,52 @@ void EPD_DrawUTF8(uint16_t x, uint8_t y_x8, uint8_t gap, const char *str, const
     }
 }
 
+/**
+ * @brief  以2倍大小绘制ASCII字符串，每个像素放大为2x2。
+ * @param  x 绘制起始X位置。
+ * @param  y_x8 绘制起始Y位置，设置1等于8像素。
+ * @param  gap 字符间额外间距。
+ * @param  str 要绘制的字符串指针，字模中没有的字符留空。
+ * @param  ascii_font ASCII字符字模指针，字体高度不超过64像素。
+ * @note   逐列放大后发送，不需要额外的显存缓冲区。
+ */
+void EPD_DrawAsciiX2(uint16_t x, uint8_t y_x8, uint8_t gap, const char *str, const uint8_t *ascii_font)
+{
+    uint8_t i, j, height_x8;
+    uint8_t column[16];
+    uint16_t x_count, font_size;
+    const uint8_t *glyph;
+
+    height_x8 = ascii_font[2] / 8;
+    if (height_x8 > sizeof(column) / 2)
+    {
+        return;
+    }
+    font_size = ascii_font[1] * height_x8;
+    x_count = 0;
+    while (*str != '\0')
+    {
+        if ((uint8_t)*str >= ascii_font[0] && (uint8_t)*str < ascii_font[0] + ascii_font[3]) /* 限制数组范围 */
+        {
+            glyph = ascii_font + ((uint8_t)*str - ascii_font[0]) * font_size + 4;
+            EPD_SetWindow(x + x_count, y_x8, ascii_font[1] * 2, height_x8 * 2);
+            for (i = 0; i < ascii_font[1]; i++)
+            {
+                for (j = 0; j < height_x8; j++) /* 高4位在上方 */
+                {
+                    column[j * 2] = Double_Nibble[glyph[j] >> 4];
+                    column[j * 2 + 1] = Double_Nibble[glyph[j] & 0x0F];
+                }
+                EPD_SendRAM(column, height_x8 * 2); /* 每列发送两次 */
+                EPD_SendRAM(column, height_x8 * 2);
+                glyph += height_x8;
+            }
+        }
+        x_count += ascii_font[1] * 2 + gap;
+        str += 1;
+    }
+}
+
 /**
  * @brief  绘制图像。
  * @param  x 绘制起始X位置。
@@ -573,3 +637,186 @@ void EPD_DrawVLine(uint16_t x, uint8_t y, uint8_t y_size, uint16_t width)
         }
     }
 }
+
+/**
+ * @brief  在曲线图缓冲区的一列中填充黑色像素。
+ * @param  column 列数据指针。
+ * @param  top 填充起始行，0为最上方。
+ * @param  bottom 填充结束行（包含）。
+ */
+static void graph_fill_column(uint8_t *column, uint8_t top, uint8_t bottom)
+{
+    uint8_t mask;
+
+    column += top >> 3;
+    mask = 0xFF >> (top & 0x07);
+    while ((top & 0xF8) != (bottom & 0xF8)) /* 填充到当前字节结束 */
+    {
+        *column &= ~mask;
+        column += 1;
+        top = (top | 0x07) + 1;
+        mask = 0xFF;
+    }
+    mask &= 0xFF << (7 - (bottom & 0x07));
+    *column &= ~mask;
+}
+
+/**
+ * @brief  数值转换为曲线图中的行位置。
+ * @param  value 数值。
+ * @param  min_val 曲线图最小值。
+ * @param  scale 缩放系数，16位小数。
+ * @param  height 曲线图高度。
+ * @return 行位置，0为最上方。
+ */
+static uint8_t graph_value_to_row(int16_t value, int16_t min_val, uint32_t scale, uint8_t height)
+{
+    return height - 1 - (uint8_t)(((uint32_t)(value - min_val) * scale) >> 16);
+}
+
+/**
+ * @brief  绘制曲线图或柱状图，数据自动缩放至窗口高度。
+ * @param  x 绘制起始X位置。
+ * @param  y_x8 绘制起始Y位置，设置1等于8像素。
+ * @param  x_size 绘制宽度。
+ * @param  y_size_x8 绘制高度，设置1等于8像素。
+ * @param  data 数据指针，值为EPD_GRAPH_NO_DATA的数据不绘制。
+ * @param  data_count 数据数量，多于x_size时每列显示多个数据的范围，少于x_size时数据会被拉宽。
+ * @param  style 绘制样式，可设置为：EPD_GRAPH_STYLE_LINE、EPD_GRAPH_STYLE_BAR。
+ * @return 1：窗口超出缓冲区大小或没有有效数据，0：绘制完成。
+ * @note   在RAM中生成全部列数据后只设置一次窗口并一次发送，不使用除法逐列计算数据范围。
+ */
+uint8_t EPD_DrawGraph(uint16_t x, uint8_t y_x8, uint16_t x_size, uint8_t y_size_x8, const int16_t *data, uint16_t data_count, uint8_t style)
+{
+    uint16_t i, column, sample, sample_end, data_end, remainder, buffer_size;
+    int16_t min_val, max_val, col_min, col_max, col_last;
+    int32_t col_sum;
+    uint32_t scale;
+    uint16_t col_count;
+    uint8_t height, top, bottom, prev_row, has_prev;
+
+    buffer_size = x_size * y_size_x8;
+    if (x_size == 0 || y_size_x8 == 0 || y_size_x8 > 16 || buffer_size > EPD_GRAPH_BUFFER_SIZE)
+    {
+        return 1;
+    }
+
+    /* 查找数据范围 */
+    min_val = 32767;
+    max_val = -32767;
+    for (i = 0; i < data_count; i++)
+    {
+        if (data[i] == EPD_GRAPH_NO_DATA)
+        {
+            continue;
+        }
+        if (data[i] < min_val)
+        {
+            min_val = data[i];
+        }
+        if (data[i] > max_val)
+        {
+            max_val = data[i];
+        }
+    }
+    if (min_val > max_val)
+    {
+        return 1;
+    }
+
+    height = y_size_x8 * 8;
+    if (max_val == min_val) /* 数据没有变化，显示在中间 */
+    {
+        min_val -= 1;
+        max_val += 1;
+    }
+    scale = (((uint32_t)(height - 1) << 16) + (uint16_t)(max_val - min_val) - 1) / (uint16_t)(max_val - min_val); /* 向上取整，最大值落在最上方一行 */
+
+    for (i = 0; i < buffer_size; i++)
+    {
+        graph_buffer[i] = 0xFF;
+    }
+
+    data_end = 0;
+    remainder = 0;
+    has_prev = 0;
+    prev_row = 0;
+    for (column = 0; column < x_size; column++)
+    {
+        /* 计算当前列对应的数据范围，等价于 data_end = (column + 1) * data_count / x_size */
+        sample = data_end;
+        remainder += data_count;
+        while (remainder >= x_size)
+        {
+            remainder -= x_size;
+            data_end += 1;
+        }
+        sample_end = data_end;
+        if (sample_end == sample) /* 数据少于列数，重复使用当前数据 */
+        {
+            if (sample >= data_count)
+            {
+                sample = data_count - 1;
+            }
+            sample_end = sample + 1;
+        }
+
+        col_count = 0;
+        col_sum = 0;
+        col_min = 0;
+        col_max = 0;
+        col_last = 0;
+        for (; sample < sample_end; sample++)
+        {
+            if (data[sample] == EPD_GRAPH_NO_DATA)
+            {
+                continue;
+            }
+            if (col_count == 0 || data[sample] < col_min)
+            {
+                col_min = data[sample];
+            }
+            if (col_count == 0 || data[sample] > col_max)
+            {
+                col_max = data[sample];
+            }
+            col_last = data[sample];
+            col_sum += data[sample];
+            col_count += 1;
+        }
+        if (col_count == 0) /* 没有数据的列留空，曲线在此断开 */
+        {
+            has_prev = 0;
+            continue;
+        }
+
+        if (style == EPD_GRAPH_STYLE_BAR)
+        {
+            top = graph_value_to_row(col_sum / col_count, min_val, scale, height);
+            bottom = height - 1;
+        }
+        else
+        {
+            top = graph_value_to_row(col_max, min_val, scale, height);
+            bottom = graph_value_to_row(col_min, min_val, scale, height);
+            if (has_prev != 0) /* 与上一列连接 */
+            {
+                if (prev_row < top)
+                {
+                    top = prev_row;
+                }
+                if (prev_row > bottom)
+                {
+                    bottom = prev_row;
+                }
+            }
+            prev_row = graph_value_to_row(col_last, min_val, scale, height);
+            has_prev = 1;
+        }
+        graph_fill_column(graph_buffer + column * y_size_x8, top, bottom);
+    }
+
+    EPD_SetWindow(x, y_x8, x_size, y_size_x8);
+    EPD_SendRAM(graph_buffer, buffer_size);
+    return 0;
+}
@@ -13,6 +13,7 @@
 #define EPD_DC_PIN EPD_DC_Pin
 #define EPD_CS_PORT EPD_CS_GPIO_Port
 #define EPD_CS_PIN EPD_CS_Pin
+#define EPD_GRAPH_BUFFER_SIZE 512 /* 曲线图绘制缓冲区大小，需要大于等于 x_size * y_size_x8 */
 /* 结束 */
 
 #define SPI_TIMEOUT_MS 100
@@ -22,11 +23,16 @@
 #define EPD_UPDATE_MODE_PART 0x01
 #define EPD_UPDATE_MODE_FAST 0x02
 
+#define EPD_GRAPH_STYLE_LINE 0x00
+#define EPD_GRAPH_STYLE_BAR 0x01
+#define EPD_GRAPH_NO_DATA (-32768)
+
 #ifndef NULL
 #define NULL 0
 #endif
 
 void EPD_Init(uint8_t update_mode);
+void EPD_SetUpdateMode(uint8_t update_mode);
 void EPD_ClearRAM(void);
 void EPD_ClearArea(uint16_t x, uint8_t y_x8, uint16_t x_size, uint8_t y_size_x8, uint8_t color);
 void EPD_SetWindow(uint16_t x, uint8_t y_x8, uint16_t x_size, uint8_t y_size_x8);
@@ -37,9 +43,11 @@ uint8_t EPD_WaitBusy(void);
 uint8_t EPD_GetBusy(void);
 
 void EPD_DrawUTF8(uint16_t x, uint8_t y_x8, uint8_t gap, const char *str, const uint8_t *ascii_font, const uint8_t *utf8_font);
+void EPD_DrawAsciiX2(uint16_t x, uint8_t y_x8, uint8_t gap, const char *str, const uint8_t *ascii_font);
 void EPD_DrawImage(uint16_t x, uint8_t y_x8, const uint8_t *image);
 void EPD_DrawHLine(uint16_t x, uint8_t y, uint16_t x_size, uint8_t width);
 void EPD_DrawVLine(uint16_t x, uint8_t y, uint8_t y_size, uint16_t width);
+uint8_t EPD_DrawGraph(uint16_t x, uint8_t y_x8, uint16_t x_size, uint8_t y_size_x8, const int16_t *data, uint16_t data_count, uint8_t style);
 
 void EPD_EnterSleep(void);
 void EPD_EnterDeepSleep(void);
@@ -1027,7 +1035,7 @@ static const uint8_t EPD_FontAscii_12x24_B[] = {
 };
 
 static const uint8_t EPD_FontUTF8_16x16_B[] = {
-    0, 16, 16, 97,    /* 起始字符，字体宽度，字体高度，字体个数 */
+    0, 16, 16, 144,    /* 起始字符，字体宽度，字体高度，字体个数 */
     0x00, 0x51, 0x9C, /* UNICODE索引 - 农 */
     0xFB, 0xF7, 0xE3, 0xE7, 0xE7, 0xCF, 0xEF, 0x9F, 0xEF, 0x00, 0xEC, 0x00, 0xE0, 0xF9, 0x00, 0xFB,
     0x0C, 0x3F, 0xEF, 0x1F, 0xEF, 0x8F, 0xEF, 0x27, 0xEA, 0x73, 0xE2, 0xF9, 0xE7, 0xFD, 0xFF, 0xFD,
@@ -1318,7 +1326,148 @@ static const uint8_t EPD_FontUTF8_16x16_B[] = {
     0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x83, 0xC1, 0x8F, 0xF1, 0x9F, 0xF9, 0xBF, 0xFD, 0xFF, 0xFF,
     0x00, 0x30, 0x11, /* UNICODE索引 - 】 */
     0xFF, 0xFF, 0xFF, 0xFF, 0xBF, 0xFD, 0x9F, 0xF9, 0x8F, 0xF1, 0x83, 0xC1, 0x80, 0x01, 0x80, 0x01,
-    0x80, 0x01, 0x80, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    0x80, 0x01, 0x80, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x5C, 0x0F, /* UNICODE索引 - 小 */
+    0xFF, 0xDF, 0xFF, 0x1F, 0xFC, 0x3F, 0xF0, 0xFF, 0xF3, 0xFD, 0xFF, 0xFC, 0xFF, 0xFC, 0x00, 0x00,
+    0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xF7, 0xFF, 0xF1, 0xFF, 0xF8, 0x7F, 0xFE, 0x1F, 0xFF, 0x9F,
+    0x00, 0x5B, 0xD2, /* UNICODE索引 - 寒 */
+    0xFF, 0x7D, 0x9F, 0x79, 0x97, 0x7B, 0xB5, 0x73, 0xB5, 0x67, 0xA0, 0x4F, 0xA0, 0x1D, 0x15, 0x2C,
+    0x15, 0x66, 0xA0, 0x37, 0xA0, 0x1F, 0xB5, 0x4F, 0xB5, 0x67, 0x97, 0x73, 0x9F, 0x79, 0xFF, 0x79,
+    0x00, 0x59, 0x27, /* UNICODE索引 - 大 */
+    0xF7, 0xFE, 0xF7, 0xFC, 0xF7, 0xF9, 0xF7, 0xF3, 0xF7, 0xC7, 0xF7, 0x8F, 0xF6, 0x3F, 0x00, 0x7F,
+    0x00, 0x7F, 0xF6, 0x3F, 0xF7, 0x8F, 0xF7, 0xC7, 0xF7, 0xF3, 0xF7, 0xF9, 0xF7, 0xFC, 0xF7, 0xFC,
+    0x00, 0x7A, 0xCB, /* UNICODE索引 - 立 */
+    0xFF, 0xFD, 0xEF, 0xFD, 0xEF, 0xFD, 0xEB, 0xFD, 0xE8, 0xFD, 0xEC, 0x3D, 0xEF, 0x0D, 0x6F, 0xCD,
+    0x2F, 0xFD, 0xAF, 0xE5, 0xEF, 0x85, 0xEE, 0x1D, 0xE8, 0x7D, 0xE9, 0xFD, 0xEF, 0xFD, 0xFF, 0xFD,
+    0x00, 0x66, 0x25, /* UNICODE索引 - 春 */
+    0xFB, 0xDF, 0xFB, 0x9F, 0xBB, 0xBF, 0xAB, 0x00, 0xAA, 0x00, 0xA8, 0x6D, 0xA1, 0x6D, 0x03, 0x6D,
+    0x0B, 0x6D, 0xA9, 0x6D, 0xA8, 0x00, 0xAA, 0x00, 0xAB, 0xBF, 0xFB, 0x9F, 0xFB, 0xDF, 0xFB, 0xDF,
+    0x00, 0x96, 0xE8, /* UNICODE索引 - 雨 */
+    0x7F, 0xFF, 0x60, 0x00, 0x60, 0x00, 0x6F, 0xFF, 0x6D, 0xBF, 0x6C, 0x9F, 0x6F, 0xFF, 0x00, 0x00,
+    0x00, 0x00, 0x6F, 0xFF, 0x6D, 0xBF, 0x6C, 0x9D, 0x6F, 0xFC, 0x60, 0x00, 0x60, 0x01, 0x7F, 0xFF,
+    0x00, 0x6C, 0x34, /* UNICODE索引 - 水 */
+    0xF7, 0xFB, 0xF7, 0xF3, 0xF7, 0xE7, 0xF7, 0x8F, 0xF6, 0x1F, 0xF0, 0x7F, 0xF1, 0xFD, 0x0F, 0xFC,
+    0x00, 0x00, 0xF0, 0x01, 0xFC, 0x7F, 0xF9, 0x3F, 0xF3, 0x9F, 0xE7, 0xCF, 0xCF, 0xE7, 0xFF, 0xF3,
+    0x00, 0x60, 0xCA, /* UNICODE索引 - 惊 */
+    0xE1, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xF7, 0xFB, 0xC7, 0xF3, 0xDF, 0xE7, 0xD0, 0xCF,
+    0xD0, 0xDF, 0xD6, 0xFD, 0x56, 0xFC, 0x16, 0x00, 0x96, 0x01, 0xD0, 0xFF, 0xD0, 0xDF, 0xDF, 0xCF,
+    0x00, 0x86, 0xF0, /* UNICODE索引 - 蛰 */
+    0xFD, 0xFD, 0xB5, 0xFD, 0xB5, 0x0D, 0x01, 0x0D, 0x03, 0x6D, 0xAF, 0x6D, 0x9D, 0x6D, 0xD4, 0x01,
+    0xDA, 0x01, 0x01, 0x6D, 0x03, 0x6D, 0xDF, 0x6D, 0xC3, 0x05, 0xE1, 0x09, 0xF9, 0xF8, 0xFB, 0xFD,
+    0x00, 0x52, 0x06, /* UNICODE索引 - 分 */
+    0xFD, 0xFE, 0xF9, 0xFC, 0xF3, 0xFD, 0xC5, 0xF9, 0x0D, 0xF3, 0x3D, 0xC7, 0xFC, 0x0F, 0xFC, 0x3F,
+    0xFD, 0xFF, 0xFD, 0xFD, 0x7D, 0xFC, 0x1D, 0xFC, 0x8C, 0x00, 0xE4, 0x01, 0xF3, 0xFF, 0xF9, 0xFF,
+    0x00, 0x6E, 0x05, /* UNICODE索引 - 清 */
+    0xF7, 0xF9, 0x73, 0xF1, 0x39, 0xE7, 0x9F, 0x8F, 0xFF, 0x3F, 0xBB, 0xFF, 0xA8, 0x01, 0xA8, 0x01,
+    0xA9, 0x5F, 0xA9, 0x5F, 0x01, 0x5B, 0x01, 0x59, 0xA8, 0x01, 0xA8, 0x03, 0xAB, 0xFF, 0xBB, 0xFF,
+    0x00, 0x66, 0x0E, /* UNICODE索引 - 明 */
+    0xC0, 0x0F, 0xC0, 0x0F, 0xDD, 0xDF, 0xDD, 0xDF, 0xC0, 0x1E, 0xC0, 0x1C, 0xFF, 0xF9, 0xFF, 0xE3,
+    0x00, 0x07, 0x00, 0x1F, 0x77, 0x7F, 0x77, 0x7D, 0x77, 0x7C, 0x00, 0x00, 0x00, 0x01, 0xFF, 0xFF,
+    0x00, 0x8C, 0x37, /* UNICODE索引 - 谷 */
+    0xF7, 0x7F, 0xE7, 0x7F, 0xCE, 0x7F, 0x9C, 0x01, 0x39, 0x81, 0x73, 0xBB, 0xE7, 0xBB, 0xCF, 0xBB,
+    0xCF, 0xBB, 0xE7, 0xBB, 0x73, 0xBB, 0x39, 0x81, 0x9C, 0x01, 0xCE, 0x7F, 0xE7, 0x7F, 0xF7, 0x7F,
+    0x00, 0x59, 0x0F, /* UNICODE索引 - 夏 */
+    0x7F, 0xFE, 0x7F, 0xF6, 0x7F, 0xF6, 0x40, 0x6E, 0x40, 0x4D, 0x55, 0x05, 0x15, 0x11, 0x15, 0x59,
+    0x55, 0x5B, 0x55, 0x59, 0x55, 0x51, 0x40, 0x44, 0x40, 0x4C, 0x7F, 0xFE, 0x7F, 0xFE, 0x7F, 0xFE,
+    0x00, 0x6E, 0xE1, /* UNICODE索引 - 满 */
+    0xF7, 0xFC, 0x73, 0xF8, 0x39, 0xE3, 0x9F, 0x87, 0xB7, 0x3F, 0xB4, 0x00, 0x14, 0x00, 0x15, 0xEF,
+    0xB4, 0x17, 0xB5, 0xCF, 0xB1, 0xE7, 0xB0, 0x0F, 0x15, 0xD5, 0x15, 0xFC, 0xB4, 0x00, 0xB4, 0x01,
+    0x00, 0x82, 0x92, /* UNICODE索引 - 芒 */
+    0xBB, 0xFF, 0xBB, 0xFF, 0xBB, 0xFF, 0xB8, 0x01, 0x18, 0x01, 0x1B, 0xFD, 0xBB, 0xFD, 0xAB, 0xFD,
+    0xA3, 0xFD, 0xB3, 0xFD, 0x1B, 0xFD, 0x1B, 0xFD, 0xBB, 0xFD, 0xBB, 0xFD, 0xBB, 0xF9, 0xBB, 0xF1,
+    0x00, 0x79, 0xCD, /* UNICODE索引 - 种 */
+    0xB7, 0x3F, 0xB6, 0x7F, 0xB4, 0xFF, 0x80, 0x00, 0x40, 0x00, 0x74, 0xFF, 0x76, 0x7F, 0xFF, 0x7F,
+    0xC0, 0xFF, 0xC0, 0xFF, 0xDE, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xDE, 0xFF, 0xC0, 0xFF, 0xC0, 0xFF,
+    0x00, 0x81, 0xF3, /* UNICODE索引 - 至 */
+    0xBD, 0xFD, 0xBD, 0xFD, 0xBB, 0xBD, 0xBB, 0xBD, 0xB3, 0xBD, 0xA3, 0xBD, 0x8B, 0xBD, 0x9A, 0x01,
+    0xBA, 0x01, 0xBB, 0xBD, 0xAB, 0xBD, 0xA3, 0xBD, 0xB1, 0xBD, 0xBD, 0xBD, 0xBF, 0xFD, 0xBF, 0xFD,
+    0x00, 0x66, 0x91, /* UNICODE索引 - 暑 */
+    0xFF, 0x7F, 0xFF, 0x7F, 0xFD, 0x6F, 0x05, 0x6F, 0x05, 0x4F, 0x55, 0x5F, 0x55, 0x00, 0x50, 0x00,
+    0x50, 0x15, 0x55, 0x55, 0x54, 0x55, 0x04, 0x55, 0x03, 0x40, 0xFB, 0x40, 0xFF, 0x7F, 0xFF, 0x7F,
+    0x00, 0x79, 0xCB, /* UNICODE索引 - 秋 */
+    0xB7, 0x3F, 0xB6, 0x7F, 0xB4, 0xFF, 0x80, 0x00, 0x40, 0x00, 0x74, 0xFF, 0x76, 0x7B, 0xFF, 0x73,
+    0xE7, 0xE7, 0xCF, 0x8F, 0xFE, 0x1F, 0x00, 0xFF, 0x00, 0xFF, 0xFE, 0x3F, 0xCF, 0x8F, 0xDF, 0xC7,
+    0x00, 0x59, 0x04, /* UNICODE索引 - 处 */
+    0xFD, 0xF7, 0xF1, 0xE7, 0xC3, 0xCF, 0x09, 0x9F, 0x1C, 0x3F, 0xDC, 0x7F, 0xD1, 0x3F, 0xC3, 0x9F,
+    0xCF, 0xCF, 0xFF, 0xE7, 0xFF, 0xE7, 0x00, 0x17, 0x00, 0x13, 0xEF, 0xF3, 0xF7, 0xFB, 0xF3, 0xFB,
+    0x00, 0x76, 0x7D, /* UNICODE索引 - 白 */
+    0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0x01, 0xC0, 0x01, 0xDE, 0xFB, 0x9E, 0xFB, 0x1E, 0xFB, 0x5E, 0xFB,
+    0xDE, 0xFB, 0xDE, 0xFB, 0xDE, 0xFB, 0xDE, 0xFB, 0xC0, 0x01, 0xC0, 0x01, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x97, 0x32, /* UNICODE索引 - 露 */
+    0xFE, 0x1E, 0xC2, 0x1E, 0x42, 0xC0, 0x5E, 0x00, 0x4A, 0x16, 0x4B, 0xF5, 0x5F, 0xBF, 0x03, 0x20,
+    0x02, 0x60, 0x5E, 0x96, 0x4A, 0x96, 0x4A, 0x46, 0x5E, 0x60, 0xC3, 0xE0, 0xC3, 0xFF, 0xFF, 0xFF,
+    0x00, 0x97, 0x1C, /* UNICODE索引 - 霜 */
+    0xFF, 0x77, 0xC3, 0x67, 0x43, 0x4F, 0x5C, 0x01, 0x48, 0x01, 0x4B, 0x4F, 0x5F, 0x67, 0x03, 0xFF,
+    0x02, 0x01, 0x5E, 0x01, 0x4A, 0xAB, 0x4A, 0xAB, 0x5E, 0xAB, 0xC2, 0x01, 0xC2, 0x01, 0xFF, 0xFF,
+    0x00, 0x96, 0x4D, /* UNICODE索引 - 降 */
+    0x00, 0x00, 0x00, 0x00, 0x6F, 0x7F, 0x16, 0x5F, 0x30, 0xDF, 0xEB, 0xDF, 0xCD, 0x5F, 0x9D, 0x5F,
+    0x19, 0x5F, 0x2B, 0x5F, 0xB3, 0x00, 0xA7, 0x00, 0x83, 0x5F, 0x9B, 0x5F, 0xF9, 0xDF, 0xFD, 0xDF,
+    0x00, 0x96, 0xEA, /* UNICODE索引 - 雪 */
+    0xFF, 0xFF, 0xC1, 0xFF, 0x41, 0x7D, 0x5F, 0x6D, 0x55, 0x6D, 0x55, 0x6D, 0x5F, 0x6D, 0x01, 0x6D,
+    0x01, 0x6D, 0x5F, 0x6D, 0x55, 0x6D, 0x55, 0x6D, 0x5F, 0x00, 0xC1, 0x00, 0xC1, 0xFF, 0xFF, 0xFF,
+    0x00, 0x51, 0x43, /* UNICODE索引 - 元 */
+    0xF7, 0xFD, 0xF7, 0xF9, 0xB7, 0xF3, 0xB7, 0xE7, 0xB7, 0x8F, 0xB0, 0x1F, 0xB0, 0x7F, 0xB7, 0xFF,
+    0xB7, 0xFF, 0xB0, 0x03, 0xB0, 0x01, 0xB7, 0xFD, 0xB7, 0xFD, 0xB7, 0xFD, 0xF7, 0xF9, 0xF7, 0xE1,
+    0x00, 0x65, 0xE6, /* UNICODE索引 - 旦 */
+    0xFF, 0xFB, 0xFF, 0xFB, 0xFF, 0xFB, 0x80, 0x1B, 0x80, 0x1B, 0xBB, 0xBB, 0xBB, 0xBB, 0xBB, 0xBB,
+    0xBB, 0xBB, 0xBB, 0xBB, 0xBB, 0xBB, 0x80, 0x1B, 0x80, 0x1B, 0xFF, 0xFB, 0xFF, 0xFB, 0xFF, 0xFB,
+    0x00, 0x82, 0x82, /* UNICODE索引 - 节 */
+    0xBF, 0xFF, 0xB7, 0xFF, 0xB7, 0xFF, 0xB7, 0xFF, 0x17, 0xFF, 0x17, 0xFF, 0xB0, 0x00, 0xB0, 0x00,
+    0xB7, 0xFF, 0xB7, 0xFF, 0x17, 0xDF, 0x17, 0xCF, 0xB0, 0x0F, 0xB0, 0x1F, 0xBF, 0xFF, 0xBF, 0xFF,
+    0x00, 0x52, 0xB3, /* UNICODE索引 - 劳 */
+    0xBF, 0xFE, 0xB3, 0xFC, 0xB2, 0xFD, 0xB6, 0xFB, 0x16, 0xF3, 0x16, 0xE7, 0xB6, 0xCF, 0xB0, 0x1F,
+    0xB0, 0x3F, 0xB6, 0xFD, 0x16, 0xFC, 0x16, 0xFC, 0xB6, 0x00, 0xB2, 0x01, 0xB3, 0xFF, 0xBF, 0xFF,
+    0x00, 0x51, 0x3F, /* UNICODE索引 - 儿 */
+    0xFF, 0xFE, 0xFF, 0xFC, 0xFF, 0xF9, 0xFF, 0xF3, 0xFF, 0xC7, 0xFF, 0x0F, 0x00, 0x3F, 0x00, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x01, 0x00, 0x01, 0xFF, 0xFD, 0xFF, 0xFD, 0xFF, 0xF9, 0xFF, 0xC1,
+    0x00, 0x7A, 0xE5, /* UNICODE索引 - 童 */
+    0xF7, 0xFD, 0xB7, 0xFD, 0xB0, 0x2D, 0x90, 0x2D, 0x82, 0xAD, 0xA2, 0xAD, 0xB2, 0xAD, 0x30, 0x01,
+    0x30, 0x01, 0xB2, 0xAD, 0xB2, 0xAD, 0xA2, 0xAD, 0x80, 0x2D, 0x90, 0x2D, 0xB7, 0xFD, 0xF7, 0xFD,
+    0x00, 0x65, 0x59, /* UNICODE索引 - 教 */
+    0xFB, 0xEF, 0xDB, 0xEF, 0xDB, 0x6D, 0x02, 0x6C, 0x00, 0x60, 0xD9, 0x01, 0xD3, 0x0F, 0xE2, 0x6B,
+    0xFC, 0xF3, 0xF0, 0xC7, 0xE2, 0x0F, 0xCF, 0x3F, 0x0E, 0x1F, 0x20, 0xCF, 0xE1, 0xE7, 0xEF, 0xF3,
+    0x00, 0x5E, 0x08, /* UNICODE索引 - 师 */
+    0xC0, 0x3E, 0xC0, 0x3C, 0xFF, 0xF1, 0x00, 0x03, 0x00, 0x0F, 0xFF, 0xFF, 0xB0, 0x07, 0xB0, 0x07,
+    0xB7, 0xFF, 0xB7, 0xFF, 0x80, 0x00, 0x80, 0x00, 0xB7, 0xFF, 0xB7, 0xEF, 0xB0, 0x07, 0xB8, 0x0F,
+    0x00, 0x56, 0xFD, /* UNICODE索引 - 国 */
+    0xFF, 0xFF, 0x00, 0x01, 0x00, 0x01, 0x7F, 0xFB, 0x6F, 0xDB, 0x6D, 0xDB, 0x6D, 0xDB, 0x60, 0x1B,
+    0x60, 0x1B, 0x6D, 0xDB, 0x6D, 0x5B, 0x6F, 0x1B, 0x7F, 0xFB, 0x00, 0x01, 0x00, 0x01, 0xFF, 0xFF,
+    0x00, 0x5E, 0x86, /* UNICODE索引 - 庆 */
+    0xFF, 0xFC, 0xFF, 0xE1, 0xC0, 0x03, 0xC0, 0x1F, 0xDF, 0xFD, 0xDE, 0xFD, 0xDE, 0xFB, 0x1E, 0xF3,
+    0x1E, 0xE7, 0xDE, 0xCF, 0xD0, 0x1F, 0xD0, 0x1F, 0xDE, 0xCF, 0xDE, 0xE7, 0xDE, 0xF3, 0xDF, 0xF9,
+    0x00, 0x5B, 0xB5, /* UNICODE索引 - 宵 */
+    0xFF, 0xFF, 0x9F, 0xFF, 0x9F, 0xFD, 0xAF, 0xF9, 0xA4, 0x03, 0xB4, 0x07, 0xBD, 0x5F, 0x01, 0x5F,
+    0x01, 0x5D, 0xBD, 0x5D, 0xB4, 0x01, 0xA4, 0x01, 0xAF, 0xFF, 0x9F, 0xFF, 0x9F, 0xFF, 0xFF, 0xFF,
+    0x00, 0x62, 0xAC, /* UNICODE索引 - 抬 */
+    0xDD, 0xFD, 0xDD, 0xFC, 0x00, 0x00, 0x00, 0x01, 0xDB, 0xFF, 0xD3, 0xFF, 0xE7, 0xFF, 0xC6, 0x07,
+    0x96, 0x07, 0x36, 0xEF, 0x76, 0xEF, 0xF6, 0xEF, 0xD6, 0xEF, 0xC2, 0x07, 0xE2, 0x07, 0xFF, 0xFF,
+    0x00, 0x59, 0x34, /* UNICODE索引 - 头 */
+    0xFF, 0xBE, 0xFB, 0xBC, 0xB9, 0xBD, 0x9C, 0xBB, 0xCE, 0xB3, 0xEF, 0xA7, 0x7F, 0x8F, 0x00, 0x1F,
+    0x80, 0x3F, 0xFF, 0x9F, 0xFF, 0x8F, 0xFF, 0xA7, 0xFF, 0xB3, 0xFF, 0xB9, 0xFF, 0xBC, 0xFF, 0xBE,
+    0x00, 0x7A, 0xEF, /* UNICODE索引 - 端 */
+    0xD1, 0xF7, 0xDC, 0x37, 0x5F, 0xF7, 0x1F, 0x17, 0x90, 0x77, 0xDF, 0xF7, 0xFF, 0xFF, 0x8A, 0x00,
+    0x8A, 0x00, 0xEA, 0xFF, 0x08, 0x03, 0x08, 0xFF, 0xEA, 0x03, 0x8A, 0xFD, 0x8A, 0x00, 0xFA, 0x01,
+    0x00, 0x59, 0x15, /* UNICODE索引 - 夕 */
+    0xFD, 0xFD, 0xF9, 0xFD, 0xF3, 0xF9, 0xE7, 0xFB, 0xCF, 0xF3, 0x89, 0xF7, 0xAC, 0xE7, 0xEE, 0x4F,
+    0xEF, 0x0F, 0xEF, 0x9F, 0xEC, 0x3F, 0xE0, 0x7F, 0xE3, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x4E, 0x2D, /* UNICODE索引 - 中 */
+    0xFF, 0xFF, 0xE0, 0x7F, 0xE0, 0x7F, 0xEF, 0x7F, 0xEF, 0x7F, 0xEF, 0x7F, 0xEF, 0x7F, 0x00, 0x00,
+    0x00, 0x00, 0xEF, 0x7F, 0xEF, 0x7F, 0xEF, 0x7F, 0xEF, 0x7F, 0xE0, 0x7F, 0xE0, 0x7F, 0xFF, 0xFF,
+    0x00, 0x91, 0xCD, /* UNICODE索引 - 重 */
+    0xEF, 0xFD, 0xEF, 0xFD, 0xA8, 0x2D, 0xA8, 0x2D, 0xAA, 0xAD, 0xAA, 0xAD, 0xAA, 0xAD, 0x80, 0x01,
+    0x80, 0x01, 0xAA, 0xAD, 0x6A, 0xAD, 0x6A, 0xAD, 0x68, 0x2D, 0xE8, 0x2D, 0xEF, 0xFD, 0xEF, 0xFD,
+    0x00, 0x96, 0x33, /* UNICODE索引 - 阳 */
+    0x00, 0x00, 0x00, 0x00, 0x6F, 0x7F, 0x16, 0x7F, 0x30, 0xFF, 0xF9, 0xFF, 0xFF, 0xFF, 0x80, 0x01,
+    0x80, 0x01, 0xBE, 0xFB, 0xBE, 0xFB, 0xBE, 0xFB, 0xBE, 0xFB, 0x80, 0x01, 0x80, 0x01, 0xFF, 0xFF,
+    0x00, 0x6B, 0xCD, /* UNICODE索引 - 母 */
+    0xFD, 0xFF, 0xFD, 0xC7, 0xFC, 0x07, 0xE0, 0x37, 0x01, 0xF7, 0x1D, 0xF7, 0xBD, 0xF7, 0xBD, 0xF7,
+    0xAD, 0x77, 0xB5, 0xB7, 0xB1, 0x95, 0xBD, 0xF4, 0x80, 0x00, 0x80, 0x01, 0xFD, 0xFF, 0xFD, 0xFF,
+    0x00, 0x4E, 0xB2, /* UNICODE索引 - 亲 */
+    0xFB, 0xFB, 0xDA, 0xFB, 0xDA, 0xF7, 0xCA, 0xF7, 0xC2, 0xEF, 0xD2, 0xCF, 0xDA, 0x9D, 0x58, 0x3C,
+    0x18, 0x00, 0x9A, 0x81, 0xD2, 0xFF, 0xC2, 0xDF, 0xCA, 0xCF, 0xDA, 0xE7, 0xDA, 0xF3, 0xFB, 0xFB,
+    0x00, 0x72, 0x36, /* UNICODE索引 - 父 */
+    0xF7, 0xFD, 0xE7, 0xF9, 0xCF, 0xF3, 0x9F, 0xE7, 0x3F, 0xCF, 0x73, 0x9F, 0xF9, 0x3F, 0xFC, 0x7F,
+    0xFC, 0x7F, 0xF9, 0x3F, 0x73, 0x9F, 0x3F, 0xCF, 0x9F, 0xE7, 0xCF, 0xF3, 0xE7, 0xF9, 0xF7, 0xFD};
 
 static const uint8_t EPD_FontUTF8_16x16[] = {
     0, 16, 16, 18,    /* 起始字符，字体宽度，字体高度，字体个数 */
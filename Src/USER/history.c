@@ -0,0 +1,557 @@
+#include "history.h"
+
+#define HIST_DAY_ADDR_DWORD (HIST_EEPROM_ADDR_DWORD + HIST_HOUR_COUNT * 2)
+
+/* 当前小时的累加数据，保存在备份寄存器中，Standby模式下不会丢失 */
+struct hist_acc
+{
+    uint32_t stamp; /* 完整的小时时间戳，备份寄存器中保存低24位 */
+    int8_t cel_min;
+    int8_t cel_max;
+    uint8_t rh_min;
+    uint8_t rh_max;
+    uint8_t count;
+    int16_t cel_sum;
+    uint16_t rh_sum;
+};
+
+/* 统计时使用的中间数据 */
+struct hist_sum
+{
+    int8_t cel_min;
+    int8_t cel_max;
+    uint8_t rh_min;
+    uint8_t rh_max;
+    int32_t cel_sum;
+    uint32_t rh_sum;
+    uint16_t weight;
+    uint8_t count;
+};
+
+/**
+ * @brief  计算从2000年1月1日开始的天数。
+ * @param  year 年份，范围为：0 ~ 199，对应2000年 ~ 2199年。
+ * @param  month 月份。
+ * @param  date 日期。
+ * @return 天数。
+ */
+static uint32_t days_from_2000(uint8_t year, uint8_t month, uint8_t date)
+{
+    static const uint16_t month_days_sum[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+    uint32_t days;
+
+    days = year * 365UL + (year + 3) / 4 + month_days_sum[(month - 1) % 12] + date - 1;
+    if (year > 100) /* 2100年不是闰年 */
+    {
+        days -= 1;
+    }
+    if ((year % 4) == 0 && year != 100 && month > 2)
+    {
+        days += 1;
+    }
+    return days;
+}
+
+/**
+ * @brief  将完整时间戳转换为记录中保存的时间戳。
+ * @param  stamp 完整时间戳，不能为0。
+ * @return 对HIST_STAMP_PERIOD取模后+1的时间戳，范围为：1 ~ HIST_STAMP_PERIOD。
+ */
+static uint16_t stamp_wrap(uint32_t stamp)
+{
+    return (stamp - 1) % HIST_STAMP_PERIOD + 1;
+}
+
+/**
+ * @brief  计算记录距当前时间的间隔。
+ * @param  now 当前完整时间戳。
+ * @param  stamp 记录中保存的时间戳，不能为0。
+ * @return 间隔，记录时间在当前时间之后时按取模周期回绕，结果很大。
+ */
+static uint16_t stamp_age(uint32_t now, uint16_t stamp)
+{
+    uint16_t now_wrap;
+
+    now_wrap = stamp_wrap(now);
+    if (now_wrap >= stamp)
+    {
+        return now_wrap - stamp;
+    }
+    return now_wrap + (HIST_STAMP_PERIOD - stamp);
+}
+
+/**
+ * @brief  温度量化为0.5度单位。
+ * @param  cel 温度。
+ * @return 量化后的温度。
+ */
+static int8_t quant_cel(float cel)
+{
+    cel = cel * 2;
+    if (cel >= 127)
+    {
+        return 127;
+    }
+    else if (cel <= -128)
+    {
+        return -128;
+    }
+    if (cel > 0)
+    {
+        return (int8_t)(cel + 0.5f);
+    }
+    return (int8_t)(cel - 0.5f);
+}
+
+/**
+ * @brief  湿度量化为0.5％单位。
+ * @param  rh 湿度。
+ * @return 量化后的湿度。
+ */
+static uint8_t quant_rh(float rh)
+{
+    rh = rh * 2;
+    if (rh >= 200)
+    {
+        return 200;
+    }
+    else if (rh <= 0)
+    {
+        return 0;
+    }
+    return (uint8_t)(rh + 0.5f);
+}
+
+/**
+ * @brief  从EEPROM读取一条记录。
+ * @param  addr_dword 记录的EEPROM地址（四字节地址）。
+ * @param  record 记录存储结构体。
+ */
+static void record_read(uint16_t addr_dword, struct HIST_Record *record)
+{
+    uint32_t dword_tmp;
+
+    dword_tmp = EEPROM_ReadDWORD(addr_dword);
+    record->CEL_Avg = (int8_t)(dword_tmp >> 24);
+    record->RH_Min = dword_tmp >> 16;
+    record->RH_Max = dword_tmp >> 8;
+    record->RH_Avg = dword_tmp;
+    dword_tmp = EEPROM_ReadDWORD(addr_dword + 1);
+    record->Stamp = dword_tmp >> 16;
+    record->CEL_Min = (int8_t)(dword_tmp >> 8);
+    record->CEL_Max = (int8_t)dword_tmp;
+}
+
+/**
+ * @brief  向EEPROM写入一条记录。
+ * @param  addr_dword 记录的EEPROM地址（四字节地址）。
+ * @param  record 记录存储结构体。
+ * @return 1：写入失败，0：写入成功。
+ * @note   时间戳位于第二个四字节，按地址顺序写入时最后写入，写入中断电时留下的旧时间戳会使记录按过期处理。
+ */
+static uint8_t record_write(uint16_t addr_dword, const struct HIST_Record *record)
+{
+    uint32_t dword_tmp[2];
+
+    dword_tmp[0] = ((uint32_t)(uint8_t)record->CEL_Avg << 24) | ((uint32_t)record->RH_Min << 16) | ((uint32_t)record->RH_Max << 8) | record->RH_Avg;
+    dword_tmp[1] = ((uint32_t)record->Stamp << 16) | ((uint32_t)(uint8_t)record->CEL_Min << 8) | (uint8_t)record->CEL_Max;
+    return EEPROM_WriteBuffer(addr_dword * 4, dword_tmp, sizeof(dword_tmp));
+}
+
+/**
+ * @brief  从备份寄存器读取当前小时的累加数据。
+ * @param  acc 累加数据存储结构体。
+ */
+static void acc_read(struct hist_acc *acc)
+{
+    uint32_t dword_tmp;
+
+    dword_tmp = BKPR_ReadDWORD(HIST_BKPR_ADDR_DWORD);
+    acc->stamp = dword_tmp >> 8;
+    acc->count = dword_tmp;
+    dword_tmp = BKPR_ReadDWORD(HIST_BKPR_ADDR_DWORD + 1);
+    acc->cel_min = (int8_t)(dword_tmp >> 24);
+    acc->cel_max = (int8_t)(dword_tmp >> 16);
+    acc->rh_min = dword_tmp >> 8;
+    acc->rh_max = dword_tmp;
+    dword_tmp = BKPR_ReadDWORD(HIST_BKPR_ADDR_DWORD + 2);
+    acc->cel_sum = (int16_t)(dword_tmp >> 16);
+    acc->rh_sum = dword_tmp;
+}
+
+/**
+ * @brief  将当前小时的累加数据写入备份寄存器。
+ * @param  acc 累加数据存储结构体。
+ */
+static void acc_write(const struct hist_acc *acc)
+{
+    BKPR_WriteDWORD(HIST_BKPR_ADDR_DWORD, (acc->stamp << 8) | acc->count);
+    BKPR_WriteDWORD(HIST_BKPR_ADDR_DWORD + 1, ((uint32_t)(uint8_t)acc->cel_min << 24) | ((uint32_t)(uint8_t)acc->cel_max << 16) | ((uint32_t)acc->rh_min << 8) | acc->rh_max);
+    BKPR_WriteDWORD(HIST_BKPR_ADDR_DWORD + 2, ((uint32_t)(uint16_t)acc->cel_sum << 16) | acc->rh_sum);
+}
+
+/**
+ * @brief  将累加数据转换为记录。
+ * @param  acc 累加数据。
+ * @param  record 记录存储结构体。
+ */
+static void acc_to_record(const struct hist_acc *acc, struct HIST_Record *record)
+{
+    record->Stamp = stamp_wrap(acc->stamp);
+    record->CEL_Min = acc->cel_min;
+    record->CEL_Max = acc->cel_max;
+    record->CEL_Avg = acc->cel_sum / acc->count;
+    record->RH_Min = acc->rh_min;
+    record->RH_Max = acc->rh_max;
+    record->RH_Avg = acc->rh_sum / acc->count;
+}
+
+/**
+ * @brief  将一条记录加入统计。
+ * @param  sum 统计中间数据。
+ * @param  record 要加入的记录。
+ * @param  weight 记录的平均值权重，小时记录为1，日记录为24。
+ */
+static void sum_add(struct hist_sum *sum, const struct HIST_Record *record, uint8_t weight)
+{
+    if (sum->count == 0 || record->CEL_Min < sum->cel_min)
+    {
+        sum->cel_min = record->CEL_Min;
+    }
+    if (sum->count == 0 || record->CEL_Max > sum->cel_max)
+    {
+        sum->cel_max = record->CEL_Max;
+    }
+    if (sum->count == 0 || record->RH_Min < sum->rh_min)
+    {
+        sum->rh_min = record->RH_Min;
+    }
+    if (sum->count == 0 || record->RH_Max > sum->rh_max)
+    {
+        sum->rh_max = record->RH_Max;
+    }
+    sum->cel_sum += (int32_t)record->CEL_Avg * weight;
+    sum->rh_sum += (uint32_t)record->RH_Avg * weight;
+    sum->weight += weight;
+    sum->count += 1;
+}
+
+/**
+ * @brief  统计指定日期内的小时记录并写入日记录。
+ * @param  now 当前小时时间戳。
+ * @param  day 要统计的日期（2000年起的天数）。
+ */
+static void day_summarize(uint32_t now, uint32_t day)
+{
+    uint8_t i;
+    uint16_t age;
+    struct HIST_Record record;
+    struct hist_sum sum;
+
+    sum.count = 0;
+    sum.weight = 0;
+    sum.cel_sum = 0;
+    sum.rh_sum = 0;
+    for (i = 0; i < HIST_HOUR_COUNT; i++)
+    {
+        record_read(HIST_EEPROM_ADDR_DWORD + i * 2, &record);
+        if (record.Stamp == 0)
+        {
+            continue;
+        }
+        age = stamp_age(now, record.Stamp);
+        if (age != 0 && age <= HIST_HOUR_COUNT && (now - age - 1) / 24 == day)
+        {
+            sum_add(&sum, &record, 1);
+        }
+    }
+    if (sum.count == 0)
+    {
+        return;
+    }
+    record.Stamp = stamp_wrap(day + 1);
+    record.CEL_Min = sum.cel_min;
+    record.CEL_Max = sum.cel_max;
+    record.CEL_Avg = sum.cel_sum / sum.weight;
+    record.RH_Min = sum.rh_min;
+    record.RH_Max = sum.rh_max;
+    record.RH_Avg = sum.rh_sum / sum.weight;
+    record_write(HIST_DAY_ADDR_DWORD + ((day + 1) % HIST_DAY_COUNT) * 2, &record);
+}
+
+/**
+ * @brief  获取小时时间戳。
+ * @param  time 时间存储结构体。
+ * @return 2000年1月1日0时起的小时数+1，0为时间无效。
+ */
+uint32_t HIST_GetHourStamp(const struct RTC_Time *time)
+{
+    uint8_t hours;
+
+    if (time->Month < 1 || time->Month > 12 || time->Date < 1 || time->Date > 31)
+    {
+        return 0;
+    }
+    hours = time->Hours;
+    if (time->Is_12hr != 0)
+    {
+        hours = hours % 12;
+        if (time->PM != 0)
+        {
+            hours += 12;
+        }
+    }
+    return days_from_2000(time->Year, time->Month, time->Date) * 24 + hours + 1;
+}
+
+/**
+ * @brief  加入一次温湿度采样。
+ * @param  time 当前时间。
+ * @param  value 当前温湿度。
+ * @return 1：时间无效，0：加入成功。
+ * @note   采样先累加在备份寄存器中，每小时只在第一次采样时将上一小时的记录写入EEPROM，跨天时再额外写入一条日记录。
+ */
+uint8_t HIST_AddSample(const struct RTC_Time *time, const struct TH_Value *value)
+{
+    uint32_t now, age;
+    int8_t cel;
+    uint8_t rh;
+    struct hist_acc acc;
+    struct HIST_Record record;
+
+    now = HIST_GetHourStamp(time);
+    if (now == 0)
+    {
+        return 1;
+    }
+    cel = quant_cel(value->CEL);
+    rh = quant_rh(value->RH);
+    acc_read(&acc);
+    if (acc.stamp == now && acc.count != 0)
+    {
+        if (cel < acc.cel_min)
+        {
+            acc.cel_min = cel;
+        }
+        if (cel > acc.cel_max)
+        {
+            acc.cel_max = cel;
+        }
+        if (rh < acc.rh_min)
+        {
+            acc.rh_min = rh;
+        }
+        if (rh > acc.rh_max)
+        {
+            acc.rh_max = rh;
+        }
+        if (acc.count < 255)
+        {
+            acc.cel_sum += cel;
+            acc.rh_sum += rh;
+            acc.count += 1;
+        }
+    }
+    else
+    {
+        age = now - acc.stamp;
+        if (acc.stamp != 0 && acc.count != 0 && age < HIST_HOUR_COUNT) /* 上一小时的数据仍在统计范围内，写入小时记录，时间被调回时age回绕后很大，不写入 */
+        {
+            acc_to_record(&acc, &record);
+            record_write(HIST_EEPROM_ADDR_DWORD + (acc.stamp % HIST_HOUR_COUNT) * 2, &record);
+            if ((now - age - 1) / 24 != (now - 1) / 24) /* 跨天，统计上一天的数据 */
+            {
+                day_summarize(now, (now - age - 1) / 24);
+            }
+        }
+        acc.stamp = now;
+        acc.cel_min = cel;
+        acc.cel_max = cel;
+        acc.rh_min = rh;
+        acc.rh_max = rh;
+        acc.cel_sum = cel;
+        acc.rh_sum = rh;
+        acc.count = 1;
+    }
+    acc_write(&acc);
+    return 0;
+}
+
+/**
+ * @brief  获取最近一段时间内的温湿度统计数据。
+ * @param  time 当前时间。
+ * @param  range 统计范围，可设置为：HIST_RANGE_24H、HIST_RANGE_7D。
+ * @param  stats 统计数据存储结构体。
+ * @return 1：没有数据，0：获取成功。
+ * @note   24小时统计最多读取24条小时记录，7天统计最多读取24条小时记录和7条日记录，耗时固定，与历史长度无关。
+ */
+uint8_t HIST_GetStats(const struct RTC_Time *time, uint8_t range, struct HIST_Stats *stats)
+{
+    uint8_t i;
+    uint16_t age;
+    uint32_t now, day_now;
+    struct hist_acc acc;
+    struct HIST_Record record;
+    struct hist_sum sum;
+
+    stats->Count = 0;
+    now = HIST_GetHourStamp(time);
+    if (now == 0)
+    {
+        return 1;
+    }
+    sum.count = 0;
+    sum.weight = 0;
+    sum.cel_sum = 0;
+    sum.rh_sum = 0;
+    acc_read(&acc);
+    if (acc.stamp != 0 && acc.count != 0 && now - acc.stamp < HIST_HOUR_COUNT && (range == HIST_RANGE_24H || (acc.stamp - 1) / 24 == (now - 1) / 24)) /* 尚未写入EEPROM的累加数据 */
+    {
+        acc_to_record(&acc, &record);
+        sum_add(&sum, &record, 1);
+    }
+    for (i = 0; i < HIST_HOUR_COUNT; i++)
+    {
+        record_read(HIST_EEPROM_ADDR_DWORD + i * 2, &record);
+        if (record.Stamp == 0)
+        {
+            continue;
+        }
+        age = stamp_age(now, record.Stamp);
+        if (age == 0 || age >= HIST_HOUR_COUNT)
+        {
+            continue;
+        }
+        if (range == HIST_RANGE_24H || (now - age - 1) / 24 == (now - 1) / 24) /* 7天统计只使用今天的小时记录 */
+        {
+            sum_add(&sum, &record, 1);
+        }
+    }
+    if (range == HIST_RANGE_7D)
+    {
+        day_now = (now - 1) / 24 + 1;
+        for (i = 0; i < HIST_DAY_COUNT; i++)
+        {
+            record_read(HIST_DAY_ADDR_DWORD + i * 2, &record);
+            if (record.Stamp == 0)
+            {
+                continue;
+            }
+            age = stamp_age(day_now, record.Stamp);
+            if (age != 0 && age < HIST_DAY_COUNT)
+            {
+                sum_add(&sum, &record, 24);
+            }
+        }
+    }
+    if (sum.count == 0)
+    {
+        return 1;
+    }
+    stats->CEL_Min = sum.cel_min / 2.0f;
+    stats->CEL_Max = sum.cel_max / 2.0f;
+    stats->CEL_Avg = (float)sum.cel_sum / sum.weight / 2.0f;
+    stats->RH_Min = sum.rh_min / 2.0f;
+    stats->RH_Max = sum.rh_max / 2.0f;
+    stats->RH_Avg = (float)sum.rh_sum / sum.weight / 2.0f;
+    stats->Count = sum.count;
+    return 0;
+}
+
+/**
+ * @brief  获取最近24小时每小时的平均值序列。
+ * @param  time 当前时间。
+ * @param  type 数据类型，可设置为：HIST_TYPE_CEL、HIST_TYPE_RH。
+ * @param  series 序列存储数组，大小为HIST_HOUR_COUNT，按时间从早到晚排列，单位为0.5度或0.5％，没有数据的小时为HIST_NO_DATA。
+ * @return 1：没有数据，0：获取成功。
+ */
+uint8_t HIST_GetHourSeries(const struct RTC_Time *time, uint8_t type, int16_t *series)
+{
+    uint8_t i, count;
+    uint16_t age;
+    uint32_t now;
+    struct hist_acc acc;
+    struct HIST_Record record;
+
+    for (i = 0; i < HIST_HOUR_COUNT; i++)
+    {
+        series[i] = HIST_NO_DATA;
+    }
+    now = HIST_GetHourStamp(time);
+    if (now == 0)
+    {
+        return 1;
+    }
+    count = 0;
+    for (i = 0; i <= HIST_HOUR_COUNT; i++)
+    {
+        if (i < HIST_HOUR_COUNT)
+        {
+            record_read(HIST_EEPROM_ADDR_DWORD + i * 2, &record);
+        }
+        else /* 尚未写入EEPROM的累加数据 */
+        {
+            acc_read(&acc);
+            if (acc.count == 0)
+            {
+                continue;
+            }
+            acc_to_record(&acc, &record);
+        }
+        if (record.Stamp == 0)
+        {
+            continue;
+        }
+        age = stamp_age(now, record.Stamp);
+        if (age >= HIST_HOUR_COUNT)
+        {
+            continue;
+        }
+        if (type == HIST_TYPE_RH)
+        {
+            series[HIST_HOUR_COUNT - 1 - age] = record.RH_Avg;
+        }
+        else
+        {
+            series[HIST_HOUR_COUNT - 1 - age] = record.CEL_Avg;
+        }
+        count += 1;
+    }
+    if (count == 0)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief  读取一条小时记录。
+ * @param  slot 记录位置，范围为：0 ~ HIST_HOUR_COUNT-1。
+ * @param  record 记录存储结构体。
+ * @return 1：位置无效，0：读取成功。
+ */
+uint8_t HIST_ReadHour(uint8_t slot, struct HIST_Record *record)
+{
+    if (slot >= HIST_HOUR_COUNT)
+    {
+        return 1;
+    }
+    record_read(HIST_EEPROM_ADDR_DWORD + slot * 2, record);
+    return 0;
+}
+
+/**
+ * @brief  读取一条日记录。
+ * @param  slot 记录位置，范围为：0 ~ HIST_DAY_COUNT-1。
+ * @param  record 记录存储结构体。
+ * @return 1：位置无效，0：读取成功。
+ */
+uint8_t HIST_ReadDay(uint8_t slot, struct HIST_Record *record)
+{
+    if (slot >= HIST_DAY_COUNT)
+    {
+        return 1;
+    }
+    record_read(HIST_DAY_ADDR_DWORD + slot * 2, record);
+    return 0;
+}
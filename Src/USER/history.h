@@ -0,0 +1,56 @@
+#ifndef _HISTORY_H_
+#define _HISTORY_H_
+
+#include "main.h"
+#include "eeprom.h"
+#include "bkpr.h"
+#include "ds3231.h"
+#include "sht30.h"
+
+/* 可修改 */
+#define HIST_EEPROM_ADDR_DWORD 0x100 /* 历史数据在EEPROM中的起始地址（四字节地址），占用 (HIST_HOUR_COUNT + HIST_DAY_COUNT) * 2 个四字节 */
+#define HIST_BKPR_ADDR_DWORD 0x02    /* 当前小时累加数据在备份寄存器中的起始地址（四字节地址），占用3个四字节 */
+#define HIST_HOUR_COUNT 24           /* 小时记录数量 */
+#define HIST_DAY_COUNT 7             /* 日记录数量 */
+/* 结束 */
+
+#define HIST_RANGE_24H 0
+#define HIST_RANGE_7D 1
+
+#define HIST_TYPE_CEL 0
+#define HIST_TYPE_RH 1
+
+#define HIST_NO_DATA (-32768) /* 与EPD_GRAPH_NO_DATA相同，数据可直接用于绘制曲线图 */
+
+#define HIST_STAMP_PERIOD 65520 /* 记录时间戳的取模周期，为24和7的公倍数，取模后记录位置不变 */
+
+struct HIST_Record
+{
+    uint16_t Stamp; /* 时间戳，小时记录为2000年起的小时数，日记录为2000年起的天数，对HIST_STAMP_PERIOD取模后+1，0为空记录 */
+    int8_t CEL_Min; /* 温度，单位为0.5度 */
+    int8_t CEL_Max;
+    int8_t CEL_Avg;
+    uint8_t RH_Min; /* 湿度，单位为0.5％ */
+    uint8_t RH_Max;
+    uint8_t RH_Avg;
+};
+
+struct HIST_Stats
+{
+    float CEL_Min;
+    float CEL_Max;
+    float CEL_Avg;
+    float RH_Min;
+    float RH_Max;
+    float RH_Avg;
+    uint8_t Count; /* 参与统计的记录数量，0为没有数据 */
+};
+
+uint8_t HIST_AddSample(const struct RTC_Time *time, const struct TH_Value *value);
+uint8_t HIST_GetStats(const struct RTC_Time *time, uint8_t range, struct HIST_Stats *stats);
+uint8_t HIST_GetHourSeries(const struct RTC_Time *time, uint8_t type, int16_t *series);
+uint8_t HIST_ReadHour(uint8_t slot, struct HIST_Record *record);
+uint8_t HIST_ReadDay(uint8_t slot, struct HIST_Record *record);
+uint32_t HIST_GetHourStamp(const struct RTC_Time *time);
+
+#endif
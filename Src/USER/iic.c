@@ -1,27 +1,41 @@
 #include "iic.h"
 
-#define WAIT_TIMEOUT(val)                                       \
-    timeout = I2C_TIMEOUT_MS;                                   \
-    systick_tmp = SysTick->CTRL;                                \
-    ((void)systick_tmp);                                        \
-    while (timeout != 0 && val)                                 \
-    {                                                           \
-        if ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0U) \
-        {                                                       \
-            timeout -= 1;                                       \
-        }                                                       \
-    }                                                           \
-    if (timeout == 0)                                           \
-    {                                                           \
-        if (i2c_reset() == 0)                                   \
-        {                                                       \
-            return 1;                                           \
-        }                                                       \
-        else                                                    \
-        {                                                       \
-            return 2;                                           \
-        }                                                       \
-    }
+#define I2C_STATE_WRITE 0   /* 发送当前描述符的数据 */
+#define I2C_STATE_READ 1    /* 接收当前描述符的数据 */
+#define I2C_STATE_STOP 2    /* 等待停止标志发送完成 */
+#define I2C_STATE_RECOVER 3 /* 超时或总线错误，清除死锁 */
+#define I2C_STATE_DONE 4    /* 全部描述符已处理或出错结束 */
+
+#define I2C_FAULT_NONE 0
+#define I2C_FAULT_TIMEOUT 1 /* 描述符超时 */
+#define I2C_FAULT_BUS 2     /* 总线错误或仲裁丢失 */
+
+struct i2c_engine
+{
+    const struct I2C_Xfer *xfer; /* 描述符队列 */
+    uint8_t count;               /* 描述符数量 */
+    uint8_t index;               /* 当前描述符 */
+    uint8_t pos;                 /* 当前方向已传输的数据大小 */
+    uint8_t state;
+    uint8_t result;
+    uint8_t fault;               /* 进入清除死锁状态的原因 */
+    uint16_t timeout;            /* 当前描述符剩余时间，单位为毫秒 */
+    uint16_t ticks;              /* 开始传输以来的SysTick计数次数，即毫秒数 */
+    uint16_t start_tick;         /* 当前描述符开始时的ticks */
+    uint32_t start_val;          /* 当前描述符开始时的SysTick->VAL */
+    uint32_t load;               /* 计算us_scale时的SysTick->LOAD */
+    uint32_t us_scale;           /* SysTick时钟周期数转换为微秒的倍数，左移16位 */
+};
+
+struct i2c_device
+{
+    struct I2C_Stats stats;
+    uint8_t skip; /* 退避剩余跳过次数 */
+};
+
+static struct i2c_engine engine;
+static struct i2c_device devices[I2C_STATS_DEVICE_COUNT]; /* RAM在待机模式下不保持，退避只在本次唤醒内有效，失败记录由调用者在唤醒结束前写入事件记录 */
+static uint8_t reset_count = 0; /* 死锁恢复次数，RAM在待机模式下不保持，即为本次唤醒的次数 */
 
 /**
  * @brief  延时100ns的倍数（不准确，只是大概）。
@@ -46,6 +60,10 @@ static uint8_t i2c_reset(void)
     volatile uint32_t systick_tmp;
     uint32_t i2c_old_state;
 
+    if (reset_count < 0xFF)
+    {
+        reset_count += 1;
+    }
     i2c_old_state = LL_I2C_IsEnabled(I2C_NUM); /* 保存I2C复位前的启用状态 */
     LL_I2C_Disable(I2C_NUM);                   /* 软复位 */
     for (timeout = 0; timeout < 10; timeout++)  /* 等待软复位 */
@@ -74,7 +92,7 @@ static uint8_t i2c_reset(void)
 
     if (LL_GPIO_IsInputPinSet(I2C_SDA_PORT, I2C_SDA_PIN) == 0) /* 检测I2C是否已释放，如未释放则代表I2C未恢复，继续处理 */
     {
-        timeout = I2C_TIMEOUT_MS;
+        timeout = I2C_RECOVER_TIMEOUT_MS;
         systick_tmp = SysTick->CTRL;
         ((void)systick_tmp);
         while (timeout != 0) /* 在时钟线上发送脉冲，用来跳过现有数据 */
@@ -116,217 +134,406 @@ static uint8_t i2c_reset(void)
 }
 
 /**
- * @brief  产生启动或重新启动标志，开始数据传输。
+ * @brief  查找设备的统计数据，没有则分配一个。
  * @param  addr I2C设备地址。
- * @param  is_read 本次传输是读取数据，不是写入数据。
- * @param  data_size 要传输的数据大小。
- * @return 3：发送开始传输信号后收到了NACK，2：I2C从机未响应或发生死锁，未恢复，1：I2C从机未响应或发生死锁，已恢复，可以重新执行，0：传输已启动。
+ * @return 设备统计数据指针，统计表已满时返回NULL。
  */
-uint8_t I2C_Start(uint8_t addr, uint8_t is_read, uint8_t data_size)
+static struct i2c_device *device_find(uint8_t addr)
 {
-    uint32_t timeout;
-    volatile uint32_t systick_tmp;
+    uint8_t i;
 
-    if (LL_I2C_IsActiveFlag_BUSY(I2C_NUM) != 0)
+    for (i = 0; i < I2C_STATS_DEVICE_COUNT; i++)
     {
-        timeout = I2C_TIMEOUT_MS;
-        systick_tmp = SysTick->CTRL;
-        ((void)systick_tmp);
-        while (timeout != 0 && LL_I2C_IsActiveFlag_TXE(I2C_NUM) == 0)
+        if (devices[i].stats.Addr == addr)
         {
-            if ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0U)
-            {
-                timeout -= 1;
-            }
+            return &devices[i];
         }
-        if (timeout == 0)
+        if (devices[i].stats.Addr == 0)
         {
-            if (i2c_reset() == 0)
-            {
-                return 1;
-            }
-            else
-            {
-                return 2;
-            }
+            devices[i].stats.Addr = addr;
+            return &devices[i];
         }
     }
-    /* DocID025942 Rev 8 - Page 604 */
-    LL_I2C_SetMasterAddressingMode(I2C_NUM, LL_I2C_ADDRESSING_MODE_7BIT);
-    LL_I2C_SetSlaveAddr(I2C_NUM, addr);
-    if (is_read == 0)
+    return NULL;
+}
+
+/**
+ * @brief  检查SysTick计数标志，累计毫秒数和当前描述符的剩余时间。
+ */
+static void tick_update(void)
+{
+    if ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0U)
     {
-        LL_I2C_SetTransferRequest(I2C_NUM, LL_I2C_REQUEST_WRITE);
+        engine.ticks += 1;
+        if (engine.timeout != 0)
+        {
+            engine.timeout -= 1;
+        }
     }
-    else
+}
+
+/**
+ * @brief  获取当前描述符开始后经过的时间。
+ * @return 经过的时间，单位为微秒，最大65535。
+ */
+static uint16_t elapsed_us(void)
+{
+    uint32_t val, cycles;
+    uint16_t ticks;
+
+    val = SysTick->VAL;
+    tick_update();
+    if (SysTick->VAL > val) /* 读取val后计数器重装，重装已计入ticks */
     {
-        LL_I2C_SetTransferRequest(I2C_NUM, LL_I2C_REQUEST_READ);
+        val += SysTick->LOAD + 1;
     }
-    LL_I2C_DisableReloadMode(I2C_NUM);
-    LL_I2C_SetTransferSize(I2C_NUM, data_size);
-    /* DocID025942 Rev 8 - Page 606 */
-    LL_I2C_DisableAutoEndMode(I2C_NUM);
-    LL_I2C_GenerateStartCondition(I2C_NUM);
-    timeout = I2C_TIMEOUT_MS;
-    systick_tmp = SysTick->CTRL;
-    ((void)systick_tmp);
-    if (is_read == 0)
+    ticks = engine.ticks - engine.start_tick;
+    if (ticks >= 64) /* 超过65535us，同时保证下面的乘法不溢出 */
     {
-        while (timeout != 0 && LL_I2C_IsActiveFlag_TXE(I2C_NUM) == 0)
-        {
-            if ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0U)
-            {
-                timeout -= 1;
-            }
-            if (LL_I2C_IsActiveFlag_NACK(I2C_NUM) != 0)
-            {
-                LL_I2C_ClearFlag_NACK(I2C_NUM);
-                return 3;
-            }
-        }
+        return 0xFFFF;
+    }
+    cycles = (uint32_t)ticks * (SysTick->LOAD + 1) + engine.start_val - val;
+    cycles = (cycles * engine.us_scale) >> 16;
+    if (cycles > 0xFFFF)
+    {
+        return 0xFFFF;
+    }
+    return cycles;
+}
+
+/**
+ * @brief  增加16位计数，到最大值后不再增加。
+ * @param  counter 计数指针。
+ */
+static void counter_inc(uint16_t *counter)
+{
+    if (*counter < 0xFFFF)
+    {
+        *counter += 1;
+    }
+}
+
+/**
+ * @brief  当前描述符传输成功，记录耗时并清除连续失败次数。
+ */
+static void xfer_done(void)
+{
+    struct i2c_device *device;
+    uint16_t us;
+    uint8_t bin;
+
+    device = device_find(engine.xfer[engine.index].Addr);
+    if (device == NULL)
+    {
+        return;
+    }
+    us = elapsed_us();
+    counter_inc(&device->stats.Count);
+    if (us > device->stats.LatencyMax)
+    {
+        device->stats.LatencyMax = us;
+    }
+    us >>= 7;
+    for (bin = 0; us != 0 && bin < I2C_LATENCY_BINS - 1; bin++) /* 按2的幂分档，不使用除法 */
+    {
+        us >>= 1;
+    }
+    counter_inc(&device->stats.Latency[bin]);
+    device->stats.FailStreak = 0;
+}
+
+/**
+ * @brief  传输失败，记录失败原因，连续失败时设置退避次数。
+ * @param  addr 失败的设备地址。
+ */
+static void xfer_failed(uint8_t addr)
+{
+    struct i2c_device *device;
+
+    device = device_find(addr);
+    if (device == NULL)
+    {
+        return;
+    }
+    if (device->stats.Fail < 0xFF)
+    {
+        device->stats.Fail += 1;
+    }
+    device->stats.LastResult = engine.result;
+    if (engine.result == I2C_RESULT_NACK)
+    {
+        counter_inc(&device->stats.NACK);
+    }
+    else if (engine.fault == I2C_FAULT_TIMEOUT)
+    {
+        counter_inc(&device->stats.Timeout);
     }
     else
     {
-        while (timeout != 0 && LL_I2C_IsActiveFlag_RXNE(I2C_NUM) == 0)
-        {
-            if ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0U)
-            {
-                timeout -= 1;
-            }
-            if (LL_I2C_IsActiveFlag_NACK(I2C_NUM) != 0)
-            {
-                LL_I2C_ClearFlag_NACK(I2C_NUM);
-                return 3;
-            }
-        }
+        counter_inc(&device->stats.BusError);
     }
-    if (timeout == 0)
+    if (engine.result == I2C_RESULT_RECOVERED)
     {
-        if (i2c_reset() == 0)
-        {
-            return 1;
-        }
-        else
+        counter_inc(&device->stats.Recover);
+    }
+    else if (engine.result == I2C_RESULT_BUS_ERROR)
+    {
+        counter_inc(&device->stats.RecoverFail);
+    }
+    if (device->stats.FailStreak < 0xFF)
+    {
+        device->stats.FailStreak += 1;
+    }
+    if (device->stats.FailStreak >= I2C_BACKOFF_THRESHOLD) /* 跳过次数按失败次数加倍 */
+    {
+        device->skip = I2C_BACKOFF_MAX_SKIP;
+        if (device->stats.FailStreak - I2C_BACKOFF_THRESHOLD < 7 && (1U << (device->stats.FailStreak - I2C_BACKOFF_THRESHOLD)) < I2C_BACKOFF_MAX_SKIP)
         {
-            return 2;
+            device->skip = 1U << (device->stats.FailStreak - I2C_BACKOFF_THRESHOLD); /* 1, 2, 4 ... */
         }
     }
-    return 0;
 }
 
 /**
- * @brief  产生停止标志。
- * @return 2：I2C从机未响应或发生死锁，未恢复，1：I2C从机未响应或发生死锁，已恢复，可以重新执行，0：传输已停止。
+ * @brief  开始传输当前描述符，产生启动标志。
  */
-uint8_t I2C_Stop(void)
+static void xfer_start(void)
 {
-    uint32_t timeout;
-    volatile uint32_t systick_tmp;
+    const struct I2C_Xfer *xfer;
 
-    timeout = I2C_TIMEOUT_MS;
-    systick_tmp = SysTick->CTRL;
-    ((void)systick_tmp);
-    while (timeout != 0 && LL_I2C_IsActiveFlag_TXE(I2C_NUM) == 0)
+    xfer = &engine.xfer[engine.index];
+    engine.pos = 0;
+    engine.timeout = (xfer->Timeout != 0) ? xfer->Timeout : I2C_TIMEOUT_MS;
+    engine.start_tick = engine.ticks;
+    engine.start_val = SysTick->VAL;
+    /* DocID025942 Rev 8 - Page 604，不使用自动结束模式，由TC标志决定重新启动或停止 */
+    if (xfer->TxSize != 0 || xfer->RxSize == 0) /* 两者都为0时只发送地址，用于检测设备是否存在 */
     {
-        if ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0U)
-        {
-            timeout -= 1;
-        }
+        engine.state = I2C_STATE_WRITE;
+        LL_I2C_HandleTransfer(I2C_NUM, xfer->Addr, LL_I2C_ADDRSLAVE_7BIT, xfer->TxSize, LL_I2C_MODE_SOFTEND, LL_I2C_GENERATE_START_WRITE);
     }
-    if (timeout == 0)
+    else
     {
-        if (i2c_reset() == 0)
+        engine.state = I2C_STATE_READ;
+        LL_I2C_HandleTransfer(I2C_NUM, xfer->Addr, LL_I2C_ADDRSLAVE_7BIT, xfer->RxSize, LL_I2C_MODE_SOFTEND, LL_I2C_GENERATE_START_READ);
+    }
+}
+
+/**
+ * @brief  根据I2C状态标志推进传输状态机，每次I2C或SysTick中断唤醒后调用。
+ */
+static void engine_step(void)
+{
+    const struct I2C_Xfer *xfer;
+
+    if (LL_I2C_IsActiveFlag_BERR(I2C_NUM) != 0 || LL_I2C_IsActiveFlag_ARLO(I2C_NUM) != 0) /* 总线错误或仲裁丢失 */
+    {
+        LL_I2C_ClearFlag_BERR(I2C_NUM);
+        LL_I2C_ClearFlag_ARLO(I2C_NUM);
+        engine.fault = I2C_FAULT_BUS;
+        engine.state = I2C_STATE_RECOVER;
+    }
+    xfer = &engine.xfer[engine.index];
+    switch (engine.state)
+    {
+    case I2C_STATE_WRITE:
+    case I2C_STATE_READ:
+        if (LL_I2C_IsActiveFlag_NACK(I2C_NUM) != 0) /* 主机模式下收到NACK后硬件自动产生停止标志 */
         {
-            return 1;
+            LL_I2C_ClearFlag_NACK(I2C_NUM);
+            LL_I2C_ClearFlag_TXE(I2C_NUM); /* 清空未发送的数据 */
+            engine.result = I2C_RESULT_NACK;
+            engine.state = I2C_STATE_STOP;
+            break;
+        }
+        if (engine.state == I2C_STATE_WRITE && LL_I2C_IsActiveFlag_TXIS(I2C_NUM) != 0)
+        {
+            LL_I2C_TransmitData8(I2C_NUM, xfer->TxData[engine.pos]);
+            engine.pos += 1;
+        }
+        else if (engine.state == I2C_STATE_READ && LL_I2C_IsActiveFlag_RXNE(I2C_NUM) != 0)
+        {
+            xfer->RxData[engine.pos] = LL_I2C_ReceiveData8(I2C_NUM);
+            engine.pos += 1;
+        }
+        if (LL_I2C_IsActiveFlag_TC(I2C_NUM) == 0) /* 当前方向的数据还未传输完成 */
+        {
+            break;
+        }
+        if (engine.state == I2C_STATE_WRITE && xfer->RxSize != 0) /* 发送完成后以重新启动标志开始接收 */
+        {
+            engine.pos = 0;
+            engine.state = I2C_STATE_READ;
+            LL_I2C_HandleTransfer(I2C_NUM, xfer->Addr, LL_I2C_ADDRSLAVE_7BIT, xfer->RxSize, LL_I2C_MODE_SOFTEND, LL_I2C_GENERATE_RESTART_7BIT_READ);
         }
         else
         {
-            return 2;
+            xfer_done();
+            engine.index += 1;
+            engine.state = I2C_STATE_STOP;
+            LL_I2C_GenerateStopCondition(I2C_NUM);
         }
-    }
-    LL_I2C_GenerateStopCondition(I2C_NUM);
-    timeout = I2C_TIMEOUT_MS;
-    systick_tmp = SysTick->CTRL;
-    ((void)systick_tmp);
-    while (timeout != 0 && LL_I2C_IsActiveFlag_BUSY(I2C_NUM) != 0)
-    {
-        if ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0U)
+        break;
+    case I2C_STATE_STOP:
+        if (LL_I2C_IsActiveFlag_STOP(I2C_NUM) != 0)
         {
-            timeout -= 1;
+            LL_I2C_ClearFlag_STOP(I2C_NUM);
+            if (engine.result != I2C_RESULT_OK || engine.index >= engine.count)
+            {
+                engine.state = I2C_STATE_DONE;
+            }
+            else
+            {
+                xfer_start();
+            }
         }
-    }
-    if (timeout == 0)
-    {
-        if (i2c_reset() != 0)
+        break;
+    case I2C_STATE_RECOVER:
+        if (i2c_reset() == 0)
         {
-            return 2;
+            engine.result = I2C_RESULT_RECOVERED;
         }
         else
         {
-            return 1;
+            engine.result = I2C_RESULT_BUS_ERROR;
         }
+        engine.state = I2C_STATE_DONE;
+        break;
+    default:
+        engine.state = I2C_STATE_DONE;
+        break;
     }
-    return 0;
 }
 
 /**
- * @brief  发送一字节。
- * @param  byte 要传输的数据。
- * @return 2：I2C从机未响应或发生死锁，未恢复，1：I2C从机未响应或发生死锁，需要重新执行，0：数据已发送。
+ * @brief  按顺序执行一组传输描述符，等待期间CPU进入Sleep模式，由I2C中断唤醒。
+ * @param  xfer 描述符数组。
+ * @param  xfer_count 描述符数量。
+ * @return I2C_RESULT_OK：全部传输完成，I2C_RESULT_NACK：收到了NACK，I2C_RESULT_RECOVERED：从机未响应或发生死锁，已恢复，可以重新执行，I2C_RESULT_BUS_ERROR：从机未响应或发生死锁，未恢复，I2C_RESULT_SKIPPED：设备处于退避期间，未执行。
+ * @note   出错后停止执行剩余的描述符。
+ * @note   同一设备连续失败 I2C_BACKOFF_THRESHOLD 次后，之后对该设备的传输请求直接跳过，跳过次数随连续失败次数加倍，最多 I2C_BACKOFF_MAX_SKIP 次。
+ * @note   与lowpower.c相同，等待期间暂停响应所有中断，I2C中断和SysTick中断只用于唤醒，不进入中断服务函数。
  */
-uint8_t I2C_WriteByte(uint8_t byte)
+uint8_t I2C_Transfer(const struct I2C_Xfer *xfer, uint8_t xfer_count)
 {
-    uint32_t timeout;
-    volatile uint32_t systick_tmp;
+    uint32_t tickint;
+    uint8_t i;
+    struct i2c_device *device;
 
-    timeout = I2C_TIMEOUT_MS;
-    systick_tmp = SysTick->CTRL;
-    ((void)systick_tmp);
-    while (timeout != 0 && LL_I2C_IsActiveFlag_TXE(I2C_NUM) == 0)
+    if (xfer_count == 0)
     {
-        if ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0U)
+        return I2C_RESULT_OK;
+    }
+    for (i = 0; i < xfer_count; i++) /* 任一设备处于退避期间则跳过整组传输 */
+    {
+        device = device_find(xfer[i].Addr);
+        if (device != NULL && device->skip != 0)
         {
-            timeout -= 1;
+            device->skip -= 1;
+            counter_inc(&device->stats.Skip);
+            return I2C_RESULT_SKIPPED;
         }
     }
-    if (timeout == 0)
+    if (LL_I2C_IsActiveFlag_BUSY(I2C_NUM) != 0) /* 上次传输未正常结束 */
     {
         if (i2c_reset() != 0)
         {
-            return 2;
+            return I2C_RESULT_BUS_ERROR;
         }
-        else
+    }
+    engine.xfer = xfer;
+    engine.count = xfer_count;
+    engine.index = 0;
+    engine.result = I2C_RESULT_OK;
+    engine.fault = I2C_FAULT_NONE;
+    engine.ticks = 0;
+    if (SysTick->LOAD != engine.load) /* 系统时钟改变后重新计算，避免每次传输都做除法 */
+    {
+        engine.load = SysTick->LOAD;
+        engine.us_scale = (1000UL << 16) / (engine.load + 1); /* SysTick每毫秒重装一次 */
+    }
+
+    __disable_irq(); /* 暂停响应所有中断 */
+
+    tickint = SysTick->CTRL & SysTick_CTRL_TICKINT_Msk; /* 同时清除COUNTFLAG */
+    SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;          /* 每毫秒唤醒一次，用于超时计时 */
+    LL_I2C_EnableIT_TX(I2C_NUM);
+    LL_I2C_EnableIT_RX(I2C_NUM);
+    LL_I2C_EnableIT_TC(I2C_NUM);
+    LL_I2C_EnableIT_NACK(I2C_NUM);
+    LL_I2C_EnableIT_STOP(I2C_NUM);
+    LL_I2C_EnableIT_ERR(I2C_NUM);
+    NVIC_ClearPendingIRQ(I2C_IRQ);
+    NVIC_EnableIRQ(I2C_IRQ);
+    LL_LPM_EnableSleep(); /* 等待时进入Sleep模式，Stop模式下I2C时钟会停止 */
+
+    xfer_start();
+    while (1)
+    {
+        NVIC_ClearPendingIRQ(I2C_IRQ); /* 标志未清除时中断会重新挂起 */
+        engine_step();
+        if (engine.state == I2C_STATE_DONE)
         {
-            return 1;
+            break;
+        }
+        if (engine.state != I2C_STATE_RECOVER)
+        {
+            __WFI(); /* 进入Sleep模式，等待I2C标志或SysTick唤醒 */
+        }
+        SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+        tick_update();
+        if (engine.timeout == 0 && engine.state != I2C_STATE_RECOVER)
+        {
+            engine.fault = I2C_FAULT_TIMEOUT;
+            engine.state = I2C_STATE_RECOVER;
         }
     }
-    LL_I2C_TransmitData8(I2C_NUM, byte);
-    return 0;
+
+    LL_I2C_DisableIT_TX(I2C_NUM);
+    LL_I2C_DisableIT_RX(I2C_NUM);
+    LL_I2C_DisableIT_TC(I2C_NUM);
+    LL_I2C_DisableIT_NACK(I2C_NUM);
+    LL_I2C_DisableIT_STOP(I2C_NUM);
+    LL_I2C_DisableIT_ERR(I2C_NUM);
+    NVIC_DisableIRQ(I2C_IRQ);
+    NVIC_ClearPendingIRQ(I2C_IRQ);
+    if (tickint == 0)
+    {
+        SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+    }
+    SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+
+    __enable_irq(); /* 重新响应所有中断 */
+
+    if (engine.result != I2C_RESULT_OK)
+    {
+        xfer_failed(xfer[(engine.index < xfer_count) ? engine.index : xfer_count - 1].Addr);
+    }
+    return engine.result;
 }
 
 /**
- * @brief  接收一字节。
- * @return 接收到的数据。
+ * @brief  获取I2C死锁恢复次数。
+ * @return 上电或唤醒以来的恢复次数。
  */
-uint8_t I2C_ReadByte(void)
+uint8_t I2C_GetResetCount(void)
 {
-    uint32_t timeout;
-    volatile uint32_t systick_tmp;
+    return reset_count;
+}
 
-    timeout = I2C_TIMEOUT_MS;
-    systick_tmp = SysTick->CTRL;
-    ((void)systick_tmp);
-    while (timeout != 0 && LL_I2C_IsActiveFlag_RXNE(I2C_NUM) == 0)
-    {
-        if ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0U)
-        {
-            timeout -= 1;
-        }
-    }
-    if (timeout == 0)
+/**
+ * @brief  获取设备的传输统计数据。
+ * @param  index 统计表序号，范围为：0 ~ I2C_STATS_DEVICE_COUNT - 1。
+ * @param  stats 统计数据存储结构体。
+ * @return 1：序号超出范围或未使用，0：获取成功。
+ * @note   RAM在待机模式下不保持，统计数据只包含本次唤醒，需要保留时在唤醒结束前写入事件记录。
+ */
+uint8_t I2C_GetStats(uint8_t index, struct I2C_Stats *stats)
+{
+    if (index >= I2C_STATS_DEVICE_COUNT || devices[index].stats.Addr == 0)
     {
-        i2c_reset();
-        return 0x00;
+        return 1;
     }
-    return LL_I2C_ReceiveData8(I2C_NUM);
+    *stats = devices[index].stats;
+    return 0;
 }
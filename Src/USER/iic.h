@@ -3,6 +3,7 @@
 
 #include "main.h"
 #include "i2c.h"
+#include <stddef.h>
 
 /* 可修改 */
 #define I2C_NUM I2C1
@@ -13,13 +14,52 @@
 #define I2C_SDA_PORT GPIOB
 #define I2C_SDA_PIN LL_GPIO_PIN_7
 #define I2C_INIT_FUNC MX_I2C1_Init
+#define I2C_IRQ I2C1_IRQn
+
+#define I2C_STATS_DEVICE_COUNT 4 /* 单独统计的设备数量，超出的设备不统计也不退避 */
+#define I2C_BACKOFF_THRESHOLD 3  /* 同一设备连续失败此次数后开始退避 */
+#define I2C_BACKOFF_MAX_SKIP 64  /* 退避时最多连续跳过的传输次数 */
 /* 结束 */
 
-#define I2C_TIMEOUT_MS 1000
+#define I2C_TIMEOUT_MS 10           /* 描述符未指定超时时间时使用，足够以100kHz传输100字节以上 */
+#define I2C_RECOVER_TIMEOUT_MS 1000 /* 清除死锁时在时钟线上发送脉冲的最长时间 */
+#define I2C_LATENCY_BINS 8          /* 耗时分布档数，第0档小于128us，之后每档上限加倍，最后一档为8192us以上 */
+
+#define I2C_RESULT_OK 0
+#define I2C_RESULT_RECOVERED 1 /* 从机未响应或发生死锁，已恢复，可以重新执行 */
+#define I2C_RESULT_BUS_ERROR 2 /* 从机未响应或发生死锁，未恢复 */
+#define I2C_RESULT_NACK 3      /* 地址或数据收到了NACK */
+#define I2C_RESULT_SKIPPED 4   /* 设备连续失败，退避期间未执行 */
+
+struct I2C_Xfer
+{
+    uint8_t Addr;          /* I2C设备地址（已左移一位） */
+    uint8_t TxSize;        /* 要发送的数据大小，为0时只读取 */
+    uint8_t RxSize;        /* 要接收的数据大小，为0时只发送；两者都不为0时发送完成后以重新启动标志开始接收 */
+    const uint8_t *TxData; /* 要发送的数据 */
+    uint8_t *RxData;       /* 接收数据存放位置 */
+    uint16_t Timeout;      /* 超时时间，单位为毫秒，从机时钟延展时需包含转换时间，0为I2C_TIMEOUT_MS */
+};
+
+struct I2C_Stats
+{
+    uint8_t Addr;         /* 设备地址，0为未使用 */
+    uint8_t FailStreak;   /* 连续失败次数 */
+    uint8_t Fail;         /* 失败次数，即NACK、Timeout与BusError之和，最大255 */
+    uint8_t LastResult;   /* 最后一次失败的结果，I2C_RESULT_... */
+    uint16_t Count;       /* 成功次数 */
+    uint16_t NACK;        /* 收到NACK次数 */
+    uint16_t Timeout;     /* 超时次数 */
+    uint16_t BusError;    /* 总线错误或仲裁丢失次数 */
+    uint16_t Recover;     /* 超时或总线错误后成功清除死锁的次数 */
+    uint16_t RecoverFail; /* 超时或总线错误后未能清除死锁的次数 */
+    uint16_t Skip;        /* 退避期间跳过的传输次数 */
+    uint16_t LatencyMax;  /* 成功传输的最长耗时，单位为微秒 */
+    uint16_t Latency[I2C_LATENCY_BINS];
+};
 
-uint8_t I2C_Start(uint8_t addr, uint8_t is_read, uint8_t data_size);
-uint8_t I2C_Stop(void);
-uint8_t I2C_WriteByte(uint8_t byte);
-uint8_t I2C_ReadByte(void);
+uint8_t I2C_Transfer(const struct I2C_Xfer *xfer, uint8_t xfer_count);
+uint8_t I2C_GetResetCount(void);
+uint8_t I2C_GetStats(uint8_t index, struct I2C_Stats *stats);
 
 #endif
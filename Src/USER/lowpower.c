@@ -1,5 +1,7 @@
 #include "lowpower.h"
 
+static uint8_t reset_flags = 0; /* LP_GetResetInfo()清除前保存的复位标志 */
+
 /**
  * @brief  开启唤醒外部中断。
  */
@@ -34,12 +36,34 @@ static void lptim_init(uint16_t ms)
     {
         LL_LPTIM_Enable(LP_LPTIM_NUM);
     }
-    LL_LPTIM_SetAutoReload(LP_LPTIM_NUM, (ms / (1000 / LP_LPTIM_FINAL_CLK)) + 0.5); /* 设置重载数值 */
-    LL_LPTIM_EnableIT_ARRM(LP_LPTIM_NUM);                                           /* 打开重载数值匹配中断 */
-    LL_EXTI_EnableIT_0_31(LP_LPTIM_EXTI);                                           /* 打开外部中断 */
-    NVIC_EnableIRQ(LP_LPTIM_WKUP_IRQ);                                              /* 打开中断请求 */
-    NVIC_SetPriority(LP_LPTIM_WKUP_IRQ, 0);                                         /* 设置中断请求优先级 */
-    LL_LPTIM_StartCounter(LP_LPTIM_NUM, LL_LPTIM_OPERATING_MODE_ONESHOT);           /* 开始计数 */
+    LL_LPTIM_SetAutoReload(LP_LPTIM_NUM, ((uint32_t)ms * LP_LPTIM_FINAL_CLK_X2 + 1000) / 2000); /* 设置重载数值，四舍五入 */
+    LL_LPTIM_EnableIT_ARRM(LP_LPTIM_NUM);                                                       /* 打开重载数值匹配中断 */
+    LL_EXTI_EnableIT_0_31(LP_LPTIM_EXTI);                                                       /* 打开外部中断 */
+    NVIC_EnableIRQ(LP_LPTIM_WKUP_IRQ);                                                          /* 打开中断请求 */
+    NVIC_SetPriority(LP_LPTIM_WKUP_IRQ, 0);                                                     /* 设置中断请求优先级 */
+    LL_LPTIM_StartCounter(LP_LPTIM_NUM, LL_LPTIM_OPERATING_MODE_ONESHOT);                       /* 开始计数 */
+}
+
+/**
+ * @brief  获取低功耗定时器开始后经过的时间。
+ * @param  ms 定时时间，已超时时返回此值。
+ * @return 经过的时间，单位为毫秒。
+ * @note   计数器使用异步时钟，需要连续读取两次相同的数值。
+ */
+static uint16_t lptim_elapsed(uint16_t ms)
+{
+    uint32_t count;
+
+    if (LL_LPTIM_IsActiveFlag_ARRM(LP_LPTIM_NUM) != 0) /* 单次模式超时后计数器归零 */
+    {
+        return ms;
+    }
+    do
+    {
+        count = LL_LPTIM_GetCounter(LP_LPTIM_NUM);
+    } while (count != LL_LPTIM_GetCounter(LP_LPTIM_NUM));
+    count = (count * 2000 + LP_LPTIM_FINAL_CLK_X2 / 2) / LP_LPTIM_FINAL_CLK_X2; /* 与lptim_init()相反，四舍五入 */
+    return (count < ms) ? count : ms;
 }
 
 /**
@@ -55,6 +79,98 @@ static void lptim_deinit(void)
     LL_LPTIM_Disable(LP_LPTIM_NUM);          /* 关闭低功耗定时器 */
 }
 
+/**
+ * @brief  LP_STOP_BLOCKED()不为0时，在Sleep模式中等待到允许进入Stop模式或唤醒源产生中断。
+ * @param  wkup 1：唤醒引脚为唤醒源，0：不使用唤醒引脚。
+ * @param  ms 低功耗定时器的定时时间，0为不使用低功耗定时器。
+ * @param  any_irq 1：LP_STOP_BLOCKED_IRQ以外的中断处理后也返回，0：只等待唤醒源。
+ * @return 1：any_irq为1且已处理了其他中断，调用者不应再进入Stop模式，0：可以进入Stop模式。
+ * @note   调用前唤醒源已设置好并暂停响应所有中断。等待期间只响应其他外设的中断，唤醒源的中断标志保留，
+ *         之后进入Stop模式时会立即唤醒，结果与直接进入Stop模式相同。
+ */
+static uint8_t wait_stop_allowed(uint8_t wkup, uint16_t ms, uint8_t any_irq)
+{
+    uint32_t pending;
+    uint8_t woken = 0;
+
+    if (LP_STOP_BLOCKED() == 0)
+    {
+        return 0;
+    }
+    if (wkup != 0)
+    {
+        NVIC_DisableIRQ(LP_WKUP_IRQ); /* 唤醒源只置位标志，不进入中断 */
+    }
+    if (ms != 0)
+    {
+        NVIC_DisableIRQ(LP_LPTIM_WKUP_IRQ);
+    }
+    LL_LPM_EnableSleep();
+    while (LP_STOP_BLOCKED() != 0)
+    {
+        if ((wkup != 0 && LL_EXTI_IsActiveFlag_0_31(LP_WKUP_EXTI) != 0) || (ms != 0 && LL_LPTIM_IsActiveFlag_ARRM(LP_LPTIM_NUM) != 0))
+        {
+            break;
+        }
+        __WFI();                                                                 /* 由其他外设的中断唤醒，例如蜂鸣器定时器每个周期唤醒一次 */
+        pending = NVIC->ISPR[0] & NVIC->ISER[0] & ~(1UL << LP_STOP_BLOCKED_IRQ); /* 暂停响应中断时挂起的中断同样唤醒，处理前记录来源 */
+        __enable_irq();
+        __ISB();
+        __disable_irq();
+        if (any_irq != 0 && pending != 0) /* 例如按键中断，之后的Stop模式只能由超时唤醒 */
+        {
+            woken = 1;
+            break;
+        }
+    }
+    if (wkup != 0)
+    {
+        NVIC_EnableIRQ(LP_WKUP_IRQ);
+    }
+    if (ms != 0)
+    {
+        NVIC_EnableIRQ(LP_LPTIM_WKUP_IRQ);
+    }
+    return woken;
+}
+
+/**
+ * @brief  执行WFI直到唤醒源产生中断，其他外设的中断（例如按键）唤醒时先处理该中断，再继续等待。
+ * @param  wkup 1：唤醒引脚为唤醒源，0：不使用唤醒引脚。
+ * @param  ms 低功耗定时器的定时时间，0为不使用低功耗定时器。
+ * @note   调用前低功耗模式已设置好并暂停响应所有中断。
+ */
+static void wait_wakeup(uint8_t wkup, uint16_t ms)
+{
+    while (1)
+    {
+        __WFI();
+        if ((wkup == 0 && ms == 0) || (wkup != 0 && LL_EXTI_IsActiveFlag_0_31(LP_WKUP_EXTI) != 0) || (ms != 0 && LL_LPTIM_IsActiveFlag_ARRM(LP_LPTIM_NUM) != 0))
+        {
+            return;
+        }
+        if (wkup != 0)
+        {
+            NVIC_DisableIRQ(LP_WKUP_IRQ); /* 唤醒源没有中断函数，只处理其他中断 */
+        }
+        if (ms != 0)
+        {
+            NVIC_DisableIRQ(LP_LPTIM_WKUP_IRQ);
+        }
+        __enable_irq();
+        __ISB();
+        __disable_irq();
+        if (wkup != 0)
+        {
+            NVIC_EnableIRQ(LP_WKUP_IRQ);
+        }
+        if (ms != 0)
+        {
+            NVIC_EnableIRQ(LP_LPTIM_WKUP_IRQ);
+        }
+    }
+}
+
 /**
  * @brief  手动禁用调试，防止Keil下载完成后不进行断电重启的话会造成电流异常消耗（使用STM32 ST-LINK Utility下载无此问题）。
  */
@@ -78,6 +194,7 @@ uint8_t LP_GetResetInfo(void)
 {
     uint8_t ret;
 
+    reset_flags = RCC->CSR >> 24;
     if (LL_RCC_IsActiveFlag_PORRST() != 0) /* 上电复位 */
     {
         ret = LP_RESET_POWERON;
@@ -99,14 +216,24 @@ uint8_t LP_GetResetInfo(void)
     return ret;
 }
 
+/**
+ * @brief  获取上次调用LP_GetResetInfo()时保存的复位标志。
+ * @return RCC->CSR的高8位，可区分看门狗复位、软件复位、nRST引脚复位、上电复位等。
+ */
+uint8_t LP_GetResetFlags(void)
+{
+    return reset_flags;
+}
+
 /**
  * @brief  进入Sleep模式，等待中断唤醒。
  * @param  ms 超时时间，0为永不超时，每增加1超时时间大约增加1毫秒。
+ * @return 实际等待的时间，单位为毫秒，提前唤醒时小于ms，ms为0时返回0。
  * @note   进入后所有IO状态保持不变。
  * @note   唤醒最快，电力消耗较多。
  * @note   唤醒后程序从停止位置继续执行。
  */
-void LP_EnterSleep(uint16_t ms)
+uint16_t LP_EnterSleep(uint16_t ms)
 {
     uint32_t voltage_scale;
 
@@ -128,10 +255,12 @@ void LP_EnterSleep(uint16_t ms)
     wkup_exti_deinit();
     if (ms != 0)
     {
-        lptim_deinit(); /* 关闭低功耗定时器 */
+        ms = lptim_elapsed(ms); /* 关闭前读取计数值 */
+        lptim_deinit();         /* 关闭低功耗定时器 */
     }
 
     __enable_irq(); /* 重新响应所有中断 */
+    return ms;
 }
 
 /**
@@ -154,6 +283,7 @@ void LP_EnterStop(uint16_t ms)
     {
         lptim_init(ms); /* 初始化低功耗定时器 */
     }
+    wait_stop_allowed(1, ms, 0);
 
     voltage_scale = LL_PWR_GetRegulVoltageScaling();
     LL_PWR_SetRegulVoltageScaling(LL_PWR_REGU_VOLTAGE_SCALE2);   /* 设置Vcore电压等级到二级，CPU最高允许8Mhz */
@@ -163,7 +293,7 @@ void LP_EnterStop(uint16_t ms)
     LL_PWR_SetRegulModeLP(LL_PWR_REGU_LPMODES_LOW_POWER);        /* 设置进入低功耗模式后，稳压器为低功耗模式 */
     LL_PWR_SetPowerMode(LL_PWR_MODE_STOP);                       /* 设置DeepSleep为Stop模式 */
     LL_LPM_EnableDeepSleep();                                    /* 准备进入Stop模式 */
-    __WFI();                                                     /* 进入Stop模式，等待中断唤醒 */
+    wait_wakeup(1, ms);                                          /* 进入Stop模式，等待中断唤醒 */
     LL_PWR_SetRegulVoltageScaling(voltage_scale);                /* 恢复Vcore电压等级 */
 
     wkup_exti_deinit();
@@ -202,19 +332,18 @@ void LP_EnterStandby(void)
 }
 
 /**
- * @brief  进入Sleep模式并等待一段时间后退出。
- * @param  ms 延时时间，每增加1时间增加LP_LPTIM_AUTORELOAD_MS。
- * @note   进入后所有IO状态保持不变。
- * @note   唤醒最快，电力消耗较多。
- * @note   唤醒后程序从停止位置继续执行。
+ * @brief  进入Stop模式，由低功耗定时器或其他中断唤醒。
+ * @param  ms 延时时间。
+ * @param  any_irq 1：任意中断唤醒后返回，0：其他中断处理后继续等待到超时。
+ * @return 实际等待的时间，单位为毫秒。
  */
-void LP_DelayStop(uint16_t ms)
+static uint16_t delay_stop(uint16_t ms, uint8_t any_irq)
 {
     uint32_t voltage_scale;
 
     if (ms == 0)
     {
-        return;
+        return 0;
     }
     __disable_irq(); /* 暂停响应所有中断 */
 
@@ -223,19 +352,54 @@ void LP_DelayStop(uint16_t ms)
     wkup_exti_deinit();
     lptim_init(ms); /* 初始化低功耗定时器 */
 
-    voltage_scale = LL_PWR_GetRegulVoltageScaling();             /* 保存当前电压等级 */
-    LL_PWR_SetRegulVoltageScaling(LL_PWR_REGU_VOLTAGE_SCALE2);   /* 设置Vcore电压等级到二级，CPU最高允许8Mhz */
-    LL_PWR_EnableUltraLowPower();                                /* 进入低功耗模式后，关闭VREFINT */
-    LL_PWR_DisableFastWakeUp();                                  /* 唤醒后等待VREFINT恢复 */
-    LL_RCC_SetClkAfterWakeFromStop(LL_RCC_STOP_WAKEUPCLOCK_HSI); /* 设置唤醒后的系统时钟源为HSI16，默认唤醒后为MSI */
-    LL_PWR_SetRegulModeLP(LL_PWR_REGU_LPMODES_LOW_POWER);        /* 设置进入低功耗模式后，稳压器为低功耗模式 */
-    LL_PWR_SetPowerMode(LL_PWR_MODE_STOP);                       /* 设置DeepSleep为Stop模式 */
-    LL_LPM_EnableDeepSleep();                                    /* 准备进入Stop模式 */
-    __WFI();                                                     /* 进入Stop模式，等待中断唤醒 */
-    LL_PWR_SetRegulVoltageScaling(voltage_scale);                /* 恢复Vcore电压等级 */
+    if (wait_stop_allowed(0, ms, any_irq) == 0) /* 蜂鸣器播放期间已被其他中断唤醒时不再进入Stop模式 */
+    {
+        voltage_scale = LL_PWR_GetRegulVoltageScaling();             /* 保存当前电压等级 */
+        LL_PWR_SetRegulVoltageScaling(LL_PWR_REGU_VOLTAGE_SCALE2);   /* 设置Vcore电压等级到二级，CPU最高允许8Mhz */
+        LL_PWR_EnableUltraLowPower();                                /* 进入低功耗模式后，关闭VREFINT */
+        LL_PWR_DisableFastWakeUp();                                  /* 唤醒后等待VREFINT恢复 */
+        LL_RCC_SetClkAfterWakeFromStop(LL_RCC_STOP_WAKEUPCLOCK_HSI); /* 设置唤醒后的系统时钟源为HSI16，默认唤醒后为MSI */
+        LL_PWR_SetRegulModeLP(LL_PWR_REGU_LPMODES_LOW_POWER);        /* 设置进入低功耗模式后，稳压器为低功耗模式 */
+        LL_PWR_SetPowerMode(LL_PWR_MODE_STOP);                       /* 设置DeepSleep为Stop模式 */
+        LL_LPM_EnableDeepSleep();                                    /* 准备进入Stop模式 */
+        if (any_irq != 0)
+        {
+            __WFI(); /* 进入Stop模式，任意中断唤醒 */
+        }
+        else
+        {
+            wait_wakeup(0, ms); /* 进入Stop模式，等待低功耗定时器唤醒 */
+        }
+        LL_PWR_SetRegulVoltageScaling(voltage_scale); /* 恢复Vcore电压等级 */
+        LL_PWR_DisableUltraLowPower();                /* 恢复电源配置 */
+    }
 
-    LL_PWR_DisableUltraLowPower(); /* 恢复电源配置 */
+    ms = lptim_elapsed(ms); /* 关闭前读取计数值 */
     lptim_deinit();                /* 关闭低功耗定时器 */
 
     __enable_irq(); /* 重新响应所有中断 */
+    return ms;
+}
+
+/**
+ * @brief  进入Stop模式并等待一段时间后退出。
+ * @param  ms 延时时间，单位为毫秒。
+ * @note   进入后所有IO状态保持不变。
+ * @note   期间产生的其他中断（例如按键）处理后继续等待，延时时间不变。
+ * @note   唤醒后程序从停止位置继续执行。
+ */
+void LP_DelayStop(uint16_t ms)
+{
+    delay_stop(ms, 0);
+}
+
+/**
+ * @brief  进入Stop模式，超时或产生任意中断后退出，用于等待按键等事件。
+ * @param  ms 超时时间，单位为毫秒。
+ * @return 实际等待的时间，单位为毫秒，提前唤醒时小于ms。
+ * @note   LP_STOP_BLOCKED()期间在Sleep模式中等待，LP_STOP_BLOCKED_IRQ以外的中断同样使其返回。
+ */
+uint16_t LP_WaitStop(uint16_t ms)
+{
+    return delay_stop(ms, 1);
 }
@@ -2,6 +2,7 @@
 #define _LOWPOWER_H_
 
 #include "main.h"
+#include "buzzer.h"
 
 /* 可修改 */
 #define LP_STANDBY_WKUP_PIN LL_PWR_WAKEUP_PIN1
@@ -11,7 +12,9 @@
 #define LP_LPTIM_NUM LPTIM1
 #define LP_LPTIM_EXTI LL_EXTI_LINE_29
 #define LP_LPTIM_WKUP_IRQ LPTIM1_IRQn
-#define LP_LPTIM_FINAL_CLK 2312.5 /* 此频率下最大延时12秒 */
+#define LP_LPTIM_FINAL_CLK_X2 4625 /* 计数频率（2312.5Hz）的2倍，使用整数计算，此频率下最大延时12秒 */
+#define LP_STOP_BLOCKED() BUZZER_IsPlaying() /* 不为0时暂不进入Stop模式，先在Sleep模式中等待（Stop模式下蜂鸣器定时器停止） */
+#define LP_STOP_BLOCKED_IRQ BUZZER_IRQ       /* LP_STOP_BLOCKED()期间周期唤醒的中断，LP_WaitStop()不因此中断返回 */
 /* 结束 */
 
 #define LP_RESET_NONE 0
@@ -21,10 +24,12 @@
 
 void LP_DisableDebug(void);
 uint8_t LP_GetResetInfo(void);
+uint8_t LP_GetResetFlags(void);
 
-void LP_EnterSleep(uint16_t ms);
+uint16_t LP_EnterSleep(uint16_t ms);
 void LP_EnterStop(uint16_t ms);
 void LP_EnterStandby(void);
 void LP_DelayStop(uint16_t ms);
+uint16_t LP_WaitStop(uint16_t ms);
 
 #endif
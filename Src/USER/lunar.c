@@ -1,81 +1,51 @@
 #include "lunar.h"
+#include "lunar_table.h"
 #include <string.h>
 
-/* 2000 ~ 2199  */
-const static uint32_t lunar_month_days[] = {
-    1997,
-    0x0000B26D, 0x0000125C, 0x0000192C, 0x00009A95, 0x00001A94, 0x00001B4A, 0x00004B55, 0x00000AD4, 0x0000F55B,
-    0x000004BA, 0x0000125A, 0x0000B92B, 0x0000152A, 0x00001694, 0x000096AA, 0x000015AA, 0x00012AB5, 0x00000974,
-    0x000014B6, 0x0000CA57, 0x00000A56, 0x00001526, 0x00008E95, 0x00000D54, 0x000015AA, 0x000049B5, 0x0000096C,
-    0x0000D4AE, 0x0000149C, 0x00001A4C, 0x0000BD26, 0x00001AA6, 0x00000B54, 0x00006D6A, 0x000012DA, 0x0001695D,
-    0x0000095A, 0x0000149A, 0x0000DA4B, 0x00001A4A, 0x00001AA4, 0x0000BB54, 0x000016B4, 0x00000ADA, 0x0000495B,
-    0x00000936, 0x0000F497, 0x00001496, 0x0000154A, 0x0000B6A5, 0x00000DA4, 0x000015B4, 0x00006AB6, 0x0000126E,
-    0x0001092F, 0x0000092E, 0x00000C96, 0x0000CD4A, 0x00001D4A, 0x00000D64, 0x0000956C, 0x0000155C, 0x0000125C,
-    0x0000792E, 0x0000192C, 0x0000FA95, 0x00001A94, 0x00001B4A, 0x0000AB55, 0x00000AD4, 0x000014DA, 0x00008A5D,
-    0x00000A5A, 0x0001152B, 0x0000152A, 0x00001694, 0x0000D6AA, 0x000015AA, 0x00000AB4, 0x000094BA, 0x000014B6,
-    0x00000A56, 0x00007527, 0x00000D26, 0x0000EE53, 0x00000D54, 0x000015AA, 0x0000A9B5, 0x0000096C, 0x000014AE,
-    0x00008A4E, 0x00001A4C, 0x00011D26, 0x00001AA4, 0x00001B54, 0x0000CD6A, 0x00000ADA, 0x0000095C, 0x0000949D,
-    0x0000149A, 0x00001A2A, 0x00005B25, 0x00001AA4, 0x0000FB52, 0x000016B4, 0x00000ABA, 0x0000A95B, 0x00000936,
-    0x00001496, 0x00009A4B, 0x0000154A, 0x000136A5, 0x00000DA4, 0x000015AC, 0x0000CAB6, 0x0000126E, 0x0000092E,
-    0x00008C97, 0x00000A96, 0x00000D4A, 0x00006DA5, 0x00000D54, 0x0000F56A, 0x0000155A, 0x00000A5C, 0x0000B92E,
-    0x0000152C, 0x00001A94, 0x00009D4A, 0x00001B2A, 0x00016B55, 0x00000AD4, 0x000014DA, 0x0000CA5D, 0x00000A5A,
-    0x0000151A, 0x0000BA95, 0x00001654, 0x000016AA, 0x00004AD5, 0x00000AB4, 0x0000F4BA, 0x000014B6, 0x00000A56,
-    0x0000B517, 0x00000D16, 0x00000E52, 0x000096AA, 0x00000D6A, 0x000165B5, 0x0000096C, 0x000014AE, 0x0000CA2E,
-    0x00001A2C, 0x00001D16, 0x0000AD52, 0x00001B52, 0x00000B6A, 0x0000656D, 0x0000055C, 0x0000F45D, 0x0000145A,
-    0x00001A2A, 0x0000DA95, 0x000016A4, 0x00001AD2, 0x00008B5A, 0x00000AB6, 0x0001455B, 0x000008B6, 0x00001456,
-    0x0000D52B, 0x0000152A, 0x00001694, 0x0000B6AA, 0x000015AA, 0x00000AB6, 0x000064B7, 0x000008AE, 0x0000EC57,
-    0x00000A56, 0x00000D2A, 0x0000CD95, 0x00000B54, 0x0000156A, 0x00008A6D, 0x0000095C, 0x000014AE, 0x00004A56,
-    0x00001A54, 0x0000DD2A, 0x00001AAA, 0x00000B54, 0x0000B56A, 0x000014DA, 0x0000095C, 0x000074AB, 0x0000149A,
-    0x0000FA4B, 0x00001652, 0x000016AA, 0x0000CAD5, 0x000005B4};
-
-/* 2000 ~ 2199  */
-const static uint32_t solar_1_1[] = {
-    1997,
-    0x000F9C3C, 0x000F9E50, 0x000FA045, 0x000FA238, 0x000FA44C, 0x000FA641, 0x000FA836, 0x000FAA49, 0x000FAC3D,
-    0x000FAE52, 0x000FB047, 0x000FB23A, 0x000FB44E, 0x000FB643, 0x000FB837, 0x000FBA4A, 0x000FBC3F, 0x000FBE53,
-    0x000FC048, 0x000FC23C, 0x000FC450, 0x000FC645, 0x000FC839, 0x000FCA4C, 0x000FCC41, 0x000FCE36, 0x000FD04A,
-    0x000FD23D, 0x000FD451, 0x000FD646, 0x000FD83A, 0x000FDA4D, 0x000FDC43, 0x000FDE37, 0x000FE04B, 0x000FE23F,
-    0x000FE453, 0x000FE648, 0x000FE83C, 0x000FEA4F, 0x000FEC44, 0x000FEE38, 0x000FF04C, 0x000FF241, 0x000FF436,
-    0x000FF64A, 0x000FF83E, 0x000FFA51, 0x000FFC46, 0x000FFE3A, 0x0010004E, 0x00100242, 0x00100437, 0x0010064B,
-    0x00100841, 0x00100A53, 0x00100C48, 0x00100E3C, 0x0010104F, 0x00101244, 0x00101438, 0x0010164C, 0x00101842,
-    0x00101A35, 0x00101C49, 0x00101E3D, 0x00102051, 0x00102245, 0x0010243A, 0x0010264E, 0x00102843, 0x00102A37,
-    0x00102C4B, 0x00102E3F, 0x00103053, 0x00103247, 0x0010343B, 0x0010364F, 0x00103845, 0x00103A38, 0x00103C4C,
-    0x00103E42, 0x00104036, 0x00104249, 0x0010443D, 0x00104651, 0x00104846, 0x00104A3A, 0x00104C4E, 0x00104E43,
-    0x00105038, 0x0010524A, 0x0010543E, 0x00105652, 0x00105847, 0x00105A3B, 0x00105C4F, 0x00105E45, 0x00106039,
-    0x0010624C, 0x00106441, 0x00106635, 0x00106849, 0x00106A3D, 0x00106C51, 0x00106E47, 0x0010703C, 0x0010724F,
-    0x00107444, 0x00107638, 0x0010784C, 0x00107A3F, 0x00107C53, 0x00107E48, 0x0010803D, 0x00108250, 0x00108446,
-    0x0010863A, 0x0010884E, 0x00108A42, 0x00108C36, 0x00108E4A, 0x0010903E, 0x00109251, 0x00109447, 0x0010963B,
-    0x0010984F, 0x00109A43, 0x00109C37, 0x00109E4B, 0x0010A041, 0x0010A253, 0x0010A448, 0x0010A63D, 0x0010A851,
-    0x0010AA45, 0x0010AC39, 0x0010AE4D, 0x0010B042, 0x0010B236, 0x0010B44A, 0x0010B63E, 0x0010B852, 0x0010BA47,
-    0x0010BC3B, 0x0010BE4F, 0x0010C044, 0x0010C237, 0x0010C44B, 0x0010C641, 0x0010C854, 0x0010CA48, 0x0010CC3D,
-    0x0010CE50, 0x0010D045, 0x0010D239, 0x0010D44C, 0x0010D642, 0x0010D837, 0x0010DA4A, 0x0010DC3E, 0x0010DE52,
-    0x0010E047, 0x0010E23A, 0x0010E44E, 0x0010E643, 0x0010E838, 0x0010EA4B, 0x0010EC41, 0x0010EE54, 0x0010F049,
-    0x0010F23C, 0x0010F450, 0x0010F645, 0x0010F839, 0x0010FA4C, 0x0010FC42, 0x0010FE37, 0x0011004B, 0x0011023E,
-    0x00110452, 0x00110647, 0x0011083B, 0x00110A4E, 0x00110C43, 0x00110E38, 0x0011104C, 0x0011123F, 0x00111435,
-    0x00111648, 0x0011183C, 0x00111A4F, 0x00111C45, 0x00111E39, 0x0011204D, 0x00112242, 0x00112436, 0x0011264A,
-    0x0011283E, 0x00112A51, 0x00112C46, 0x00112E3B, 0x0011304F};
+/*
+ * 农历缓存格式（24位）：
+ * 位23 ~ 9：公历日期的键，2000年1月1日起的天数取低15位（约89年重复一次，2000年之前的负数取低15位后仍然连续）
+ * 位8 ~ 5：农历年内的月序号（1 ~ 13，闰月也占一个序号），0为缓存无效
+ * 位4 ~ 0：农历日期
+ * 农历年份不需要保存：公历1、2月时月序号大于等于6则为上一农历年，其他月份与公历年份相同。
+ * 设置时间后需要调用LUNAR_InvalidateCache()，之后每分钟唤醒一次，键不会出现重复。
+ */
+#define LUNAR_CACHE_KEY_MASK 0x7FFF
+
+/*
+ * 农历年数据（24位，lunar_year_data中每年3字节，高字节在前）：
+ * 位22 ~ 17：正月初一在公历年内的天数，1月1日为0
+ * 位16 ~ 13：闰月，0为没有闰月
+ * 位12 ~ 0：各月大小，位12为正月，1为大月，有闰月时闰月紧跟在该月之后
+ */
 
 static uint32_t GetBitInt(uint32_t data, uint8_t length, uint8_t shift)
 {
     return (data & (((1 << length) - 1) << shift)) >> shift;
 }
 
-//WARNING: Dates before Oct. 1582 are inaccurate
-static uint64_t SolarToInt(uint16_t y, uint8_t m, uint8_t d)
+/* 读取农历年数据，year_index为农历年份减LUNAR_TABLE_YEAR */
+static uint32_t GetYearData(uint16_t year_index)
+{
+    const uint8_t *data = &lunar_year_data[year_index * 3];
+
+    return ((uint32_t)data[0] << 16) | ((uint32_t)data[1] << 8) | data[2];
+}
+
+/* 年内第month_index个月（1 ~ 13，闰月也占一个序号）的天数，29或30 */
+static uint8_t GetMonthDays(uint32_t data, uint8_t month_index)
 {
-    m = (m + 9) % 12;
-    y = y - m / 10;
-    return 365 * y + y / 4 - y / 100 + y / 400 + (m * 306 + 5) / 10 + (d - 1);
+    return 29 + GetBitInt(data, 1, 13 - month_index);
 }
 
 void LUNAR_SolarToLunar(struct Lunar_Date *lunar, uint16_t solar_year, uint8_t solar_month, uint8_t solar_date)
 {
-    uint8_t i, lunarM, m, d, leap, dm;
-    uint16_t year_index, lunarY, y, offset;
-    uint32_t solar_data, solar11, days;
+    uint8_t lunarM, leap, dm;
+    uint16_t year_index, offset;
+    uint32_t data, day_number, new_year;
 
     if (solar_month < 1 || solar_month > 12 || solar_date < 1 || solar_date > 31 ||
-        (solar_year - solar_1_1[0] < 3) || ((solar_year - solar_1_1[0]) > (sizeof(solar_1_1) / sizeof(uint32_t) - 2)))
+        solar_year < LUNAR_YEAR_MIN || solar_year > LUNAR_YEAR_MAX)
     {
         lunar->Year = 0;
         lunar->Month = 0;
@@ -84,43 +54,27 @@ void LUNAR_SolarToLunar(struct Lunar_Date *lunar, uint16_t solar_year, uint8_t s
         return;
     }
 
-    year_index = solar_year - solar_1_1[0];
-    solar_data = (solar_year << 9) | (solar_month << 5) | (solar_date);
-    if (solar_1_1[year_index] > solar_data)
+    year_index = solar_year - LUNAR_TABLE_YEAR;
+    data = GetYearData(year_index);
+    day_number = CAL_GetDayNumber(solar_year, solar_month, solar_date);
+    new_year = CAL_GetDayNumber(solar_year, 1, 1) + GetBitInt(data, 6, 17);
+    if (day_number < new_year) /* 正月初一之前属于上一农历年 */
     {
         year_index -= 1;
+        data = GetYearData(year_index);
+        new_year = CAL_GetDayNumber(solar_year - 1, 1, 1) + GetBitInt(data, 6, 17);
     }
-    solar11 = solar_1_1[year_index];
-    y = GetBitInt(solar11, 12, 9);
-    m = GetBitInt(solar11, 4, 5);
-    d = GetBitInt(solar11, 5, 0);
-    offset = SolarToInt(solar_year, solar_month, solar_date) - SolarToInt(y, m, d);
-
-    days = lunar_month_days[year_index];
-    leap = GetBitInt(days, 4, 13);
-
-    lunarY = year_index + solar_1_1[0];
-    lunarM = 1;
-    offset += 1;
-    for (i = 0; i < 13; i++)
+    offset = day_number - new_year + 1;
+    leap = GetBitInt(data, 4, 13);
+
+    for (lunarM = 1; lunarM < 13; lunarM++)
     {
-        if (GetBitInt(days, 1, 12 - i) == 1)
-        {
-            dm = 30;
-        }
-        else
-        {
-            dm = 29;
-        }
-        if (offset > dm)
-        {
-            lunarM += 1;
-            offset -= dm;
-        }
-        else
+        dm = GetMonthDays(data, lunarM);
+        if (offset <= dm)
         {
             break;
         }
+        offset -= dm;
     }
     lunar->IsLeap = 0;
     if (leap != 0 && lunarM > leap)
@@ -133,20 +87,155 @@ void LUNAR_SolarToLunar(struct Lunar_Date *lunar, uint16_t solar_year, uint8_t s
     }
     lunar->Month = lunarM;
     lunar->Date = offset;
-    lunar->Year = lunarY;
+    lunar->Year = year_index + LUNAR_TABLE_YEAR;
 }
 
 uint8_t LUNAR_GetZodiac(const struct Lunar_Date *lunar)
 {
-    return lunar->Year % 12;
+    return CAL_GetBranch(CAL_GetYearCycle(lunar->Year));
 }
 
 uint8_t LUNAR_GetStem(const struct Lunar_Date *lunar)
 {
-    return lunar->Year % 10;
+    return CAL_GetStem(CAL_GetYearCycle(lunar->Year));
 }
 
 uint8_t LUNAR_GetBranch(const struct Lunar_Date *lunar)
 {
-    return lunar->Year % 12;
+    return CAL_GetBranch(CAL_GetYearCycle(lunar->Year));
+}
+
+/* 农历月的天数（29或30），农历日期无效时返回0 */
+uint8_t LUNAR_GetMonthDays(const struct Lunar_Date *lunar)
+{
+    uint8_t leap, month_index;
+    uint32_t data;
+
+    if (lunar->Month == 0)
+    {
+        return 0;
+    }
+    data = GetYearData(lunar->Year - LUNAR_TABLE_YEAR);
+    leap = GetBitInt(data, 4, 13);
+    month_index = lunar->Month;
+    if (leap != 0 && (month_index > leap || lunar->IsLeap != 0)) /* 闰月及之后的月份序号加1 */
+    {
+        month_index += 1;
+    }
+    return GetMonthDays(data, month_index);
+}
+
+/* 将年内的月序号转换为农历月份和闰月标志 */
+static void MonthIndexToLunar(struct Lunar_Date *lunar, uint16_t year_index, uint8_t month_index, uint8_t date)
+{
+    uint8_t leap;
+
+    leap = GetBitInt(GetYearData(year_index), 4, 13);
+    lunar->IsLeap = 0;
+    if (leap != 0 && month_index > leap)
+    {
+        if (month_index == leap + 1)
+        {
+            lunar->IsLeap = 1;
+        }
+        month_index -= 1;
+    }
+    lunar->Month = month_index;
+    lunar->Date = date;
+    lunar->Year = year_index + LUNAR_TABLE_YEAR;
+}
+
+static uint32_t CacheRead(void)
+{
+    return ((uint32_t)BKPR_ReadByte(LUNAR_BKPR_ADDR_BYTE) << 16) | ((uint32_t)BKPR_ReadByte(LUNAR_BKPR_ADDR_BYTE + 1) << 8) | BKPR_ReadByte(LUNAR_BKPR_ADDR_BYTE + 2);
+}
+
+static void CacheWrite(uint32_t cache)
+{
+    BKPR_WriteByte(LUNAR_BKPR_ADDR_BYTE, cache >> 16);
+    BKPR_WriteByte(LUNAR_BKPR_ADDR_BYTE + 1, cache >> 8);
+    BKPR_WriteByte(LUNAR_BKPR_ADDR_BYTE + 2, cache);
+}
+
+/* 根据公历年月和农历月序号得到农历年在表中的序号 */
+static uint16_t CacheYearIndex(uint16_t solar_year, uint8_t solar_month, uint8_t month_index)
+{
+    if (solar_month <= 2 && month_index >= 6)
+    {
+        solar_year -= 1;
+    }
+    return solar_year - LUNAR_TABLE_YEAR;
+}
+
+/* 与LUNAR_SolarToLunar()结果相同，同一天直接使用缓存，跨天时在缓存基础上加一天，其他情况完整计算 */
+void LUNAR_SolarToLunarCached(struct Lunar_Date *lunar, uint16_t solar_year, uint8_t solar_month, uint8_t solar_date)
+{
+    uint8_t month_index, date, month_count, dm, leap;
+    uint16_t key, cache_key, year_index;
+    uint32_t cache, data;
+
+    if (solar_month < 1 || solar_month > 12 || solar_date < 1 || solar_date > 31 ||
+        solar_year < LUNAR_YEAR_MIN || solar_year > LUNAR_YEAR_MAX)
+    {
+        LUNAR_SolarToLunar(lunar, solar_year, solar_month, solar_date);
+        return;
+    }
+
+    key = CAL_GetDays2000(solar_year, solar_month, solar_date) & LUNAR_CACHE_KEY_MASK;
+    cache = CacheRead();
+    cache_key = GetBitInt(cache, 15, 9);
+    month_index = GetBitInt(cache, 4, 5);
+    date = GetBitInt(cache, 5, 0);
+    if (month_index != 0 && cache_key == key) /* 同一天 */
+    {
+        MonthIndexToLunar(lunar, CacheYearIndex(solar_year, solar_month, month_index), month_index, date);
+        return;
+    }
+    if (month_index != 0 && cache_key == ((key - 1) & LUNAR_CACHE_KEY_MASK)) /* 缓存为前一天，加一天 */
+    {
+        if (solar_date != 1) /* 前一天的公历年月 */
+        {
+            year_index = CacheYearIndex(solar_year, solar_month, month_index);
+        }
+        else if (solar_month != 1)
+        {
+            year_index = CacheYearIndex(solar_year, solar_month - 1, month_index);
+        }
+        else
+        {
+            year_index = CacheYearIndex(solar_year - 1, 12, month_index);
+        }
+        data = GetYearData(year_index);
+        dm = GetMonthDays(data, month_index);
+        month_count = (GetBitInt(data, 4, 13) != 0) ? 13 : 12;
+        date += 1;
+        if (date > dm)
+        {
+            date = 1;
+            month_index += 1;
+            if (month_index > month_count)
+            {
+                month_index = 1;
+                year_index += 1;
+            }
+        }
+        MonthIndexToLunar(lunar, year_index, month_index, date);
+    }
+    else /* 缓存无效或时间跳变，完整计算 */
+    {
+        LUNAR_SolarToLunar(lunar, solar_year, solar_month, solar_date);
+        leap = GetBitInt(GetYearData(lunar->Year - LUNAR_TABLE_YEAR), 4, 13);
+        month_index = lunar->Month;
+        if (lunar->IsLeap != 0 || (leap != 0 && lunar->Month > leap)) /* 闰月及之后的月份序号比月份大1 */
+        {
+            month_index += 1;
+        }
+        date = lunar->Date;
+    }
+    CacheWrite(((uint32_t)key << 9) | ((uint32_t)month_index << 5) | date);
+}
+
+void LUNAR_InvalidateCache(void)
+{
+    CacheWrite(0);
 }
@@ -2,6 +2,15 @@
 #define _LUNAR_H_
 
 #include "main.h"
+#include "bkpr.h"
+#include "calendar.h"
+
+/* 可修改 */
+#define LUNAR_BKPR_ADDR_BYTE 0x05 /* 农历缓存在备份寄存器中的地址（字节地址），占用3个字节 */
+/* 结束 */
+
+#define LUNAR_YEAR_MIN 1900
+#define LUNAR_YEAR_MAX 2299
 
 struct Lunar_Date
 {
@@ -40,8 +49,11 @@ const static char Lunar_BranchStrig[12][4] = {
     "申", "酉", "戌", "亥", "子", "丑", "寅", "卯", "辰", "巳", "午", "未"};
 
 void LUNAR_SolarToLunar(struct Lunar_Date *lunar, uint16_t solar_year, uint8_t solar_month, uint8_t solar_date);
+void LUNAR_SolarToLunarCached(struct Lunar_Date *lunar, uint16_t solar_year, uint8_t solar_month, uint8_t solar_date);
+void LUNAR_InvalidateCache(void);
 uint8_t LUNAR_GetZodiac(const struct Lunar_Date *lunar);
 uint8_t LUNAR_GetStem(const struct Lunar_Date *lunar);
 uint8_t LUNAR_GetBranch(const struct Lunar_Date *lunar);
+uint8_t LUNAR_GetMonthDays(const struct Lunar_Date *lunar);
 
 #endif
@@ -0,0 +1,61 @@
+/* 此文件由 资源/农历数据生成/农历数据压缩.js 根据 农历数据表生成.htm 生成，不要手动修改 */
+#ifndef _LUNAR_TABLE_H_
+#define _LUNAR_TABLE_H_
+
+#define LUNAR_TABLE_YEAR 1899 /* 表中第一年 */
+
+/* 1899 ~ 2299，每年3字节 */
+const static uint8_t lunar_year_data[] = {
+    0x50, 0x15, 0x6A, 0x3D, 0x09, 0x6D, 0x62, 0x09, 0x5C, 0x4C, 0x14, 0xAE, 0x38, 0xAA, 0x4D, 0x5C, 0x1A, 0x4C, 0x44, 0x1B, 0x2A, 0x30, 0x8D, 0x55,
+    0x56, 0x0A, 0xD4, 0x40, 0x13, 0x5A, 0x2A, 0x49, 0x5D, 0x50, 0x09, 0x5C, 0x3A, 0xD4, 0x9B, 0x60, 0x14, 0x9A, 0x48, 0x1A, 0x4A, 0x32, 0xBA, 0xA5,
+    0x58, 0x16, 0xA8, 0x42, 0x1A, 0xD4, 0x2C, 0x52, 0xDA, 0x52, 0x12, 0xB6, 0x3E, 0xE9, 0x37, 0x64, 0x09, 0x2E, 0x4C, 0x14, 0x96, 0x36, 0xB6, 0x4B,
+    0x5C, 0x0D, 0x4A, 0x46, 0x0D, 0xA8, 0x2E, 0x95, 0xB5, 0x56, 0x05, 0x6C, 0x40, 0x12, 0xAE, 0x2C, 0x49, 0x2F, 0x50, 0x09, 0x2E, 0x3A, 0xCC, 0x96,
+    0x5E, 0x1A, 0x94, 0x48, 0x1D, 0x4A, 0x32, 0xAD, 0xA9, 0x58, 0x0B, 0x5A, 0x44, 0x05, 0x6C, 0x2E, 0x72, 0x6E, 0x52, 0x12, 0x5C, 0x3C, 0xF9, 0x2D,
+    0x62, 0x19, 0x2A, 0x4C, 0x1A, 0x94, 0x34, 0xDB, 0x4A, 0x5A, 0x16, 0xAA, 0x46, 0x0A, 0xD4, 0x30, 0x95, 0x5B, 0x56, 0x04, 0xBA, 0x40, 0x12, 0x5A,
+    0x2A, 0x59, 0x2B, 0x50, 0x15, 0x2A, 0x38, 0xF6, 0x95, 0x5E, 0x0D, 0x94, 0x48, 0x16, 0xAA, 0x34, 0xAA, 0xB5, 0x58, 0x09, 0xB4, 0x42, 0x14, 0xB6,
+    0x2E, 0x6A, 0x57, 0x54, 0x0A, 0x56, 0x3D, 0x15, 0x2A, 0x60, 0x1D, 0x2A, 0x4C, 0x0D, 0x54, 0x36, 0xD5, 0xAA, 0x5A, 0x15, 0x6A, 0x46, 0x09, 0x6C,
+    0x30, 0x94, 0xAE, 0x56, 0x14, 0xAE, 0x40, 0x0A, 0x4C, 0x28, 0x7D, 0x26, 0x4E, 0x1B, 0x2A, 0x3A, 0xEB, 0x55, 0x5E, 0x0A, 0xD4, 0x48, 0x12, 0xDA,
+    0x34, 0xA9, 0x5D, 0x5A, 0x09, 0x5A, 0x42, 0x14, 0x9A, 0x2C, 0x9A, 0x4D, 0x52, 0x1A, 0x4A, 0x3D, 0x1A, 0xA5, 0x60, 0x16, 0xA8, 0x4A, 0x16, 0xD4,
+    0x36, 0xD2, 0xDA, 0x5C, 0x12, 0xB6, 0x46, 0x09, 0x36, 0x30, 0x94, 0x97, 0x56, 0x14, 0x96, 0x41, 0x56, 0x4B, 0x64, 0x0D, 0x4A, 0x4E, 0x0D, 0xA8,
+    0x38, 0xD5, 0xB4, 0x5E, 0x15, 0x6C, 0x48, 0x12, 0xAE, 0x34, 0xA9, 0x2F, 0x5A, 0x09, 0x2E, 0x44, 0x0C, 0x96, 0x2C, 0x6D, 0x4A, 0x50, 0x1D, 0x4A,
+    0x3D, 0x0D, 0x65, 0x62, 0x0B, 0x58, 0x4A, 0x15, 0x6C, 0x36, 0xB2, 0x6D, 0x5C, 0x12, 0x5C, 0x46, 0x19, 0x2C, 0x2E, 0x9A, 0x95, 0x54, 0x1A, 0x94,
+    0x3E, 0x1B, 0x4A, 0x2A, 0x4B, 0x55, 0x4E, 0x0A, 0xD4, 0x38, 0xF5, 0x5B, 0x60, 0x04, 0xBA, 0x4A, 0x12, 0x5A, 0x32, 0xB9, 0x2B, 0x58, 0x15, 0x2A,
+    0x42, 0x16, 0x94, 0x2C, 0x96, 0xAA, 0x50, 0x15, 0xAA, 0x3D, 0x2A, 0xB5, 0x62, 0x09, 0x74, 0x4C, 0x14, 0xB6, 0x36, 0xCA, 0x57, 0x5C, 0x0A, 0x56,
+    0x46, 0x15, 0x26, 0x30, 0x8E, 0x95, 0x54, 0x0D, 0x54, 0x3E, 0x15, 0xAA, 0x2A, 0x49, 0xB5, 0x50, 0x09, 0x6C, 0x38, 0xD4, 0xAE, 0x5E, 0x14, 0x9C,
+    0x48, 0x1A, 0x4C, 0x32, 0xBD, 0x26, 0x56, 0x1A, 0xA6, 0x42, 0x0B, 0x54, 0x2C, 0x6D, 0x6A, 0x52, 0x12, 0xDA, 0x3D, 0x69, 0x5D, 0x62, 0x09, 0x5A,
+    0x4C, 0x14, 0x9A, 0x36, 0xDA, 0x4B, 0x5A, 0x1A, 0x4A, 0x44, 0x1A, 0xA4, 0x2E, 0xBB, 0x54, 0x54, 0x16, 0xB4, 0x3E, 0x0A, 0xDA, 0x2A, 0x49, 0x5B,
+    0x50, 0x09, 0x36, 0x3A, 0xF4, 0x97, 0x5E, 0x14, 0x96, 0x48, 0x15, 0x4A, 0x32, 0xB6, 0xA5, 0x58, 0x0D, 0xA4, 0x40, 0x15, 0xB4, 0x2C, 0x6A, 0xB6,
+    0x52, 0x12, 0x6E, 0x3F, 0x09, 0x2F, 0x62, 0x09, 0x2E, 0x4C, 0x0C, 0x96, 0x36, 0xCD, 0x4A, 0x5A, 0x1D, 0x4A, 0x44, 0x0D, 0x64, 0x2E, 0x95, 0x6C,
+    0x54, 0x15, 0x5C, 0x40, 0x12, 0x5C, 0x28, 0x79, 0x2E, 0x4E, 0x19, 0x2C, 0x38, 0xFA, 0x95, 0x5E, 0x1A, 0x94, 0x46, 0x1B, 0x4A, 0x32, 0xAB, 0x55,
+    0x58, 0x0A, 0xD4, 0x42, 0x14, 0xDA, 0x2C, 0x8A, 0x5D, 0x52, 0x0A, 0x5A, 0x3D, 0x15, 0x2B, 0x62, 0x15, 0x2A, 0x4A, 0x16, 0x94, 0x34, 0xD6, 0xAA,
+    0x5A, 0x15, 0xAA, 0x46, 0x0A, 0xB4, 0x2E, 0x94, 0xBA, 0x54, 0x14, 0xB6, 0x40, 0x0A, 0x56, 0x2A, 0x75, 0x27, 0x4E, 0x0D, 0x26, 0x38, 0xEE, 0x53,
+    0x5E, 0x0D, 0x54, 0x48, 0x15, 0xAA, 0x32, 0xA9, 0xB5, 0x58, 0x09, 0x6C, 0x42, 0x14, 0xAE, 0x2E, 0x8A, 0x4E, 0x50, 0x1A, 0x4C, 0x3B, 0x1D, 0x26,
+    0x60, 0x1A, 0xA4, 0x4A, 0x1B, 0x54, 0x34, 0xCD, 0x6A, 0x5A, 0x0A, 0xDA, 0x46, 0x09, 0x5C, 0x30, 0x94, 0x9D, 0x54, 0x14, 0x9A, 0x3E, 0x1A, 0x2A,
+    0x28, 0x5B, 0x25, 0x4E, 0x1A, 0xA4, 0x38, 0xFB, 0x52, 0x5E, 0x16, 0xB4, 0x4A, 0x0A, 0xBA, 0x36, 0xA9, 0x5B, 0x5A, 0x09, 0x36, 0x44, 0x14, 0x96,
+    0x2E, 0x9A, 0x4B, 0x54, 0x15, 0x4A, 0x3D, 0x36, 0xA5, 0x62, 0x0D, 0xA4, 0x4C, 0x15, 0xAC, 0x38, 0xCA, 0xB6, 0x5C, 0x12, 0x6E, 0x48, 0x09, 0x2E,
+    0x32, 0x8C, 0x97, 0x58, 0x0A, 0x96, 0x40, 0x0D, 0x4A, 0x2A, 0x6D, 0xA5, 0x50, 0x0D, 0x54, 0x3A, 0xF5, 0x6A, 0x5E, 0x15, 0x5A, 0x4A, 0x0A, 0x5C,
+    0x34, 0xB9, 0x2E, 0x5A, 0x15, 0x2C, 0x42, 0x1A, 0x94, 0x2C, 0x9D, 0x4A, 0x52, 0x1B, 0x2A, 0x3F, 0x6B, 0x55, 0x62, 0x0A, 0xD4, 0x4C, 0x14, 0xDA,
+    0x38, 0xCA, 0x5D, 0x5E, 0x0A, 0x5A, 0x46, 0x15, 0x1A, 0x30, 0xBA, 0x95, 0x56, 0x16, 0x54, 0x40, 0x16, 0xAA, 0x2A, 0x4A, 0xD5, 0x50, 0x0A, 0xB4,
+    0x3A, 0xF4, 0xBA, 0x60, 0x14, 0xB6, 0x4A, 0x0A, 0x56, 0x34, 0xB5, 0x17, 0x5A, 0x0D, 0x16, 0x44, 0x0E, 0x52, 0x2C, 0x96, 0xAA, 0x52, 0x0D, 0x6A,
+    0x3F, 0x65, 0xB5, 0x64, 0x09, 0x6C, 0x4C, 0x14, 0xAE, 0x38, 0xCA, 0x2E, 0x5C, 0x1A, 0x2C, 0x46, 0x1D, 0x16, 0x30, 0xAD, 0x52, 0x54, 0x1B, 0x52,
+    0x40, 0x0B, 0x6A, 0x2C, 0x65, 0x6D, 0x50, 0x05, 0x5C, 0x3A, 0xF4, 0x5D, 0x60, 0x14, 0x5A, 0x4A, 0x1A, 0x2A, 0x32, 0xDA, 0x95, 0x58, 0x16, 0xA4,
+    0x42, 0x1A, 0xD2, 0x2E, 0x8B, 0x5A, 0x52, 0x0A, 0xB6, 0x3F, 0x45, 0x5B, 0x64, 0x08, 0xB6, 0x4E, 0x14, 0x56, 0x36, 0xD5, 0x2B, 0x5C, 0x15, 0x2A,
+    0x46, 0x16, 0x94, 0x30, 0xB6, 0xAA, 0x54, 0x15, 0xAA, 0x40, 0x0A, 0xB6, 0x2C, 0x64, 0xB7, 0x52, 0x08, 0xAE, 0x3A, 0xEC, 0x57, 0x60, 0x0A, 0x56,
+    0x4A, 0x0D, 0x2A, 0x34, 0xCD, 0x95, 0x58, 0x0B, 0x54, 0x42, 0x15, 0x6A, 0x2E, 0x8A, 0x6D, 0x54, 0x09, 0x5C, 0x3C, 0x14, 0xAE, 0x28, 0x4A, 0x56,
+    0x4C, 0x1A, 0x54, 0x36, 0xDD, 0x2A, 0x5A, 0x1A, 0xAA, 0x46, 0x0B, 0x54, 0x30, 0xB5, 0x6A, 0x56, 0x14, 0xDA, 0x40, 0x09, 0x5C, 0x2A, 0x74, 0xAB,
+    0x50, 0x14, 0x9A, 0x3A, 0xFA, 0x4B, 0x5E, 0x16, 0x52, 0x48, 0x16, 0xAA, 0x34, 0xCA, 0xD5, 0x5A, 0x05, 0xB4, 0x44, 0x12, 0xBA, 0x30, 0x89, 0x5B,
+    0x56, 0x09, 0x36, 0x41, 0x34, 0x97, 0x64, 0x0C, 0x96, 0x4E, 0x0D, 0x52, 0x38, 0xD6, 0xA9, 0x5E, 0x0D, 0x6A, 0x48, 0x05, 0x6C, 0x32, 0x92, 0xB6,
+    0x58, 0x12, 0x6E, 0x44, 0x09, 0x2E, 0x2C, 0x6C, 0x96, 0x50, 0x1C, 0x94, 0x3A, 0xFD, 0x4A, 0x60, 0x1B, 0x52, 0x4A, 0x0B, 0x6A, 0x36, 0xA5, 0x6D,
+    0x5C, 0x05, 0x5C, 0x46, 0x12, 0x5C, 0x2E, 0x99, 0x2D, 0x54, 0x19, 0x2A, 0x3F, 0x3A, 0x95, 0x64, 0x16, 0x94, 0x4C, 0x16, 0xD2, 0x38, 0xEA, 0xDA,
+    0x5E, 0x0A, 0xB6, 0x4A, 0x04, 0xBA, 0x32, 0xB2, 0x5B, 0x58, 0x12, 0x56, 0x42, 0x15, 0x2A, 0x2C, 0x7A, 0x95, 0x50, 0x16, 0x94, 0x3B, 0x16, 0xAA,
+    0x60, 0x15, 0xAA, 0x4C, 0x0A, 0xB6, 0x36, 0xA4, 0xB7, 0x5C, 0x04, 0xAE, 0x46, 0x0A, 0x56, 0x30, 0x95, 0x2B, 0x54, 0x0D, 0x2A, 0x3F, 0x6D, 0x95,
+    0x64, 0x0B, 0x54, 0x4E, 0x15, 0x6A, 0x38, 0xC9, 0x6D, 0x5E, 0x09, 0x5C, 0x48, 0x14, 0xAE, 0x34, 0xAA, 0x4D, 0x56, 0x1A, 0x4C, 0x40, 0x1D, 0x2A,
+    0x2C, 0x6D, 0x55, 0x52, 0x0B, 0x54, 0x3A, 0xF5, 0x5A, 0x60, 0x12, 0xBA, 0x4C, 0x09, 0x5C, 0x36, 0xD4, 0x9B, 0x5A, 0x14, 0x9A, 0x44, 0x1A, 0x4A,
+    0x2E, 0xBB, 0x25, 0x54, 0x16, 0xA8, 0x3C, 0x1A, 0xD4, 0x28, 0x32, 0xDA, 0x4E, 0x12, 0xB6, 0x3A, 0xE9, 0x57, 0x5E, 0x09, 0x36, 0x48, 0x14, 0x96,
+    0x32, 0xB6, 0x4B, 0x58, 0x0D, 0x4A, 0x40, 0x15, 0xA8, 0x2A, 0x76, 0xB5, 0x52, 0x05, 0x6C, 0x3D, 0x12, 0xB6, 0x60, 0x12, 0x6E, 0x4C, 0x09, 0x2E,
+    0x36, 0xCC, 0x96, 0x5A, 0x1C, 0x94, 0x42, 0x1D, 0x4A, 0x2E, 0x8D, 0xA9, 0x54, 0x0B, 0x5A, 0x40, 0x05, 0x6C, 0x28, 0x52, 0xAE, 0x4E, 0x12, 0x5C,
+    0x38, 0xD9, 0x2D, 0x5E, 0x19, 0x2A, 0x46, 0x1A, 0x94, 0x30, 0xBB, 0x4A, 0x56, 0x16, 0xCA, 0x42, 0x0A, 0xD4, 0x2A, 0x75, 0x5B, 0x52, 0x04, 0xBA,
+    0x3C, 0xF2, 0x5B, 0x62, 0x12, 0x56, 0x4A, 0x15, 0x2A, 0x34, 0xD6, 0x95, 0x5A, 0x0E, 0x94, 0x44, 0x16, 0xAA, 0x2E, 0x8A, 0xD5, 0x54, 0x09, 0xB4,
+    0x3E, 0x14, 0xB6};
+
+#endif
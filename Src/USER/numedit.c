@@ -0,0 +1,152 @@
+#include "numedit.h"
+
+/*
+ * 设置页面的数值编辑，数值为整数，定点小数由调用者放大10^decimals倍，有符号数的各位为绝对值的各位。
+ * 每一位的权值查表得到，取某一位用减去10的幂代替除法和取余，不使用浮点数和pow()。
+ */
+const static uint32_t num_pow10[NUM_DIGITS_MAX] = {
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL};
+
+static uint32_t AbsValue(int32_t value)
+{
+    return (value < 0) ? 0 - (uint32_t)value : (uint32_t)value;
+}
+
+/**
+ * @brief  获取10的pos次幂。
+ * @param  pos 0 ~ NUM_DIGITS_MAX - 1，0为个位。
+ * @return 该位的权值。
+ */
+uint32_t NUM_Pow10(uint8_t pos)
+{
+    return num_pow10[pos];
+}
+
+/**
+ * @brief  读取十进制数的一位。
+ * @param  value 数值，负数时读取绝对值的一位。
+ * @param  pos 位置，0为个位。
+ * @return 该位的数字，0 ~ 9。
+ */
+uint8_t NUM_GetDigit(int32_t value, uint8_t pos)
+{
+    uint32_t abs_value;
+    uint8_t i, digit;
+
+    abs_value = AbsValue(value);
+    for (i = NUM_DIGITS_MAX - 1; i > pos; i--) /* 去掉高位，每一位最多减9次 */
+    {
+        while (abs_value >= num_pow10[i])
+        {
+            abs_value -= num_pow10[i];
+        }
+    }
+    digit = 0;
+    while (abs_value >= num_pow10[pos])
+    {
+        abs_value -= num_pow10[pos];
+        digit++;
+    }
+    return digit;
+}
+
+/**
+ * @brief  修改十进制数的一位，其他位和符号不变。
+ * @param  value 数值。
+ * @param  pos 位置，0为个位。
+ * @param  digit 新的数字，0 ~ 9。
+ * @return 修改后的数值。
+ */
+int32_t NUM_SetDigit(int32_t value, uint8_t pos, uint8_t digit)
+{
+    uint32_t abs_value;
+
+    abs_value = AbsValue(value);
+    abs_value -= num_pow10[pos] * NUM_GetDigit(value, pos);
+    abs_value += num_pow10[pos] * digit;
+    return (value < 0) ? -(int32_t)abs_value : (int32_t)abs_value;
+}
+
+/**
+ * @brief  将十进制数的一位加减1，该位在min_digit ~ max_digit间循环，不进位。
+ * @param  value 数值。
+ * @param  pos 位置，0为个位。
+ * @param  up 1：加1，0：减1。
+ * @param  min_digit 该位的最小值。
+ * @param  max_digit 该位的最大值，不超过9。
+ * @return 修改后的数值。
+ */
+int32_t NUM_CycleDigit(int32_t value, uint8_t pos, uint8_t up, uint8_t min_digit, uint8_t max_digit)
+{
+    uint8_t digit;
+
+    digit = NUM_GetDigit(value, pos);
+    if (up != 0)
+    {
+        digit = (digit < max_digit) ? digit + 1 : min_digit;
+    }
+    else
+    {
+        digit = (digit > min_digit) ? digit - 1 : max_digit;
+    }
+    return NUM_SetDigit(value, pos, digit);
+}
+
+/**
+ * @brief  将数值加减10的pos次幂，结果限制在min ~ max内。
+ * @param  value 数值，超出范围时先限制到范围内。
+ * @param  pos 修改的位，0为个位。
+ * @param  up 1：增加，0：减少。
+ * @param  min 最小值。
+ * @param  max 最大值。
+ * @param  flags NUM_WRAP：已在边界时回绕到另一端，否则停在边界。
+ * @return 修改后的数值。
+ * @note   步长超过到边界的距离时先停在边界，下一次才回绕。
+ */
+int32_t NUM_Step(int32_t value, uint8_t pos, uint8_t up, int32_t min, int32_t max, uint8_t flags)
+{
+    int32_t step;
+
+    step = num_pow10[pos];
+    if (value < min)
+    {
+        value = min;
+    }
+    else if (value > max)
+    {
+        value = max;
+    }
+    if (up != 0)
+    {
+        if (value == max)
+        {
+            return ((flags & NUM_WRAP) != 0) ? min : max;
+        }
+        return (max - value > step) ? value + step : max;
+    }
+    if (value == min)
+    {
+        return ((flags & NUM_WRAP) != 0) ? max : min;
+    }
+    return (value - min > step) ? value - step : min;
+}
+
+/**
+ * @brief  获取范围内适合快速修改的最高位，该位的10倍不超过范围的大小。
+ * @param  min 最小值。
+ * @param  max 最大值。
+ * @return 位置，0为个位。
+ */
+uint8_t NUM_MaxStepPos(int32_t min, int32_t max)
+{
+    uint32_t range;
+    uint8_t pos;
+
+    range = (uint32_t)max - (uint32_t)min;
+    pos = 0;
+    while (pos < NUM_DIGITS_MAX - 2 && num_pow10[pos + 2] <= range)
+    {
+        pos++;
+    }
+    return pos;
+}
@@ -0,0 +1,18 @@
+#ifndef _NUMEDIT_H_
+#define _NUMEDIT_H_
+
+#include "main.h"
+
+/* 数值编辑标志 */
+#define NUM_WRAP 0x01 /* 超出范围时回绕到另一端，否则停在边界 */
+
+#define NUM_DIGITS_MAX 10 /* int32_t绝对值最多10位十进制数 */
+
+uint32_t NUM_Pow10(uint8_t pos);
+uint8_t NUM_GetDigit(int32_t value, uint8_t pos);
+int32_t NUM_SetDigit(int32_t value, uint8_t pos, uint8_t digit);
+int32_t NUM_CycleDigit(int32_t value, uint8_t pos, uint8_t up, uint8_t min_digit, uint8_t max_digit);
+int32_t NUM_Step(int32_t value, uint8_t pos, uint8_t up, int32_t min, int32_t max, uint8_t flags);
+uint8_t NUM_MaxStepPos(int32_t min, int32_t max);
+
+#endif
@@ -1,5 +1,11 @@
 #include "serial.h"
-#include <stdio.h>
+#include "fmt.h"
+
+/* 接收缓冲区，中断只写入头、读取者只写入尾 */
+static volatile uint8_t rx_buffer[SERIAL_RX_BUFFER_SIZE];
+static volatile uint8_t rx_head = 0;
+static volatile uint8_t rx_tail = 0;
+static volatile uint8_t rx_overflow = 0;
 
 #define WAIT_TIMEOUT(val)                                       \
     timeout = SERIAL_TIMEOUT_MS;                                \
@@ -67,6 +73,111 @@ void SERIAL_SendStringRN(const char *tx_char)
     SERIAL_SendData((uint8_t *)"\r\n", 2);
 }
 
+/**
+ * @brief  打开串口接收中断，Stop模式下收到数据时唤醒
+ * @note   串口时钟切换为HSI16，Stop模式下由串口请求时钟接收数据
+ */
+void SERIAL_EnableRX(void)
+{
+    LL_USART_Disable(SERIAL_NUM);
+    LL_RCC_SetUSARTClockSource(SERIAL_RX_CLKSOURCE);
+    LL_USART_SetBaudRate(SERIAL_NUM, HSI_VALUE, LL_USART_OVERSAMPLING_16, SERIAL_BAUDRATE);
+    LL_USART_SetWKUPType(SERIAL_NUM, LL_USART_WAKEUP_ON_RXNE);
+    LL_USART_EnableInStopMode(SERIAL_NUM);
+    LL_USART_Enable(SERIAL_NUM);
+
+    rx_tail = rx_head;
+    rx_overflow = 0;
+    LL_USART_ClearFlag_ORE(SERIAL_NUM);
+    LL_USART_EnableIT_RXNE(SERIAL_NUM);
+    LL_EXTI_EnableIT_0_31(SERIAL_WKUP_EXTI);
+    NVIC_ClearPendingIRQ(SERIAL_IRQ);
+    NVIC_SetPriority(SERIAL_IRQ, 1);
+    NVIC_EnableIRQ(SERIAL_IRQ);
+}
+
+/**
+ * @brief  关闭串口接收中断和Stop模式唤醒
+ */
+void SERIAL_DisableRX(void)
+{
+    NVIC_DisableIRQ(SERIAL_IRQ);
+    LL_USART_DisableIT_RXNE(SERIAL_NUM);
+    LL_USART_DisableInStopMode(SERIAL_NUM);
+    LL_EXTI_DisableIT_0_31(SERIAL_WKUP_EXTI);
+}
+
+/**
+ * @brief  从接收缓冲区读取一个字节，不等待
+ * @param  rx_data  读取到的数据
+ * @return 1：没有数据，0：读取成功
+ */
+uint8_t SERIAL_ReadByte(uint8_t *rx_data)
+{
+    if (rx_tail == rx_head)
+    {
+        return 1;
+    }
+    *rx_data = rx_buffer[rx_tail];
+    rx_tail = (rx_tail + 1) & (SERIAL_RX_BUFFER_SIZE - 1);
+    return 0;
+}
+
+/**
+ * @brief  获取接收缓冲区中未读取的数据大小
+ * @return 未读取的字节数
+ */
+uint8_t SERIAL_GetRXCount(void)
+{
+    return (rx_head - rx_tail) & (SERIAL_RX_BUFFER_SIZE - 1);
+}
+
+/**
+ * @brief  读取并清除接收溢出标志
+ * @return 1：上次读取后有数据因缓冲区已满或串口溢出而丢失，0：没有丢失
+ */
+uint8_t SERIAL_GetOverflow(void)
+{
+    if (rx_overflow == 0)
+    {
+        return 0;
+    }
+    rx_overflow = 0;
+    return 1;
+}
+
+/**
+ * @brief  串口中断处理，在串口的中断函数中调用
+ */
+void SERIAL_IRQHandler(void)
+{
+    uint8_t head, rx_data;
+
+    if (LL_USART_IsActiveFlag_ORE(SERIAL_NUM) != 0)
+    {
+        LL_USART_ClearFlag_ORE(SERIAL_NUM);
+        rx_overflow = 1;
+    }
+    if (LL_USART_IsActiveFlag_FE(SERIAL_NUM) != 0 || LL_USART_IsActiveFlag_NE(SERIAL_NUM) != 0) /* 错误的数据仍然读取，由上层协议丢弃 */
+    {
+        LL_USART_ClearFlag_FE(SERIAL_NUM);
+        LL_USART_ClearFlag_NE(SERIAL_NUM);
+    }
+    LL_USART_ClearFlag_WKUP(SERIAL_NUM);
+    if (LL_USART_IsActiveFlag_RXNE(SERIAL_NUM) != 0)
+    {
+        rx_data = LL_USART_ReceiveData8(SERIAL_NUM);
+        head = (rx_head + 1) & (SERIAL_RX_BUFFER_SIZE - 1);
+        if (head == rx_tail)
+        {
+            rx_overflow = 1;
+            return;
+        }
+        rx_buffer[rx_head] = rx_data;
+        rx_head = head;
+    }
+}
+
 /**
  * @brief  从串口发送调试打印信息
  * @param  file_name  当前程序文件路径字符串指针
@@ -77,13 +188,16 @@ void SERIAL_SendStringRN(const char *tx_char)
 void _SERIAL_DebugPrint(const char *file_name, const char *func_name, uint32_t func_line, const char *info_str)
 {
     char text[11];
+    struct FMT_Buffer buf;
+
     SERIAL_SendString("\r\n**DEBUG PRINT");
     SERIAL_SendString("\r\nFILE  : ");
     SERIAL_SendString(file_name);
     SERIAL_SendString("\r\nFUNC  : ");
     SERIAL_SendString(func_name);
     SERIAL_SendString("\r\nLINE  : ");
-    snprintf(text, sizeof(text), "%d", func_line);
+    FMT_Init(&buf, text, sizeof(text));
+    FMT_Uint(&buf, func_line, 0, 0);
     SERIAL_SendString(text);
     SERIAL_SendString("\r\nINFO  : ");
     SERIAL_SendString(info_str);
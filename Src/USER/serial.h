@@ -5,9 +5,18 @@
 
 /* 可修改 */
 #define SERIAL_NUM USART1
+#define SERIAL_IRQ USART1_IRQn
+#define SERIAL_TX_PORT GPIOA
+#define SERIAL_TX_PIN LL_GPIO_PIN_9
+#define SERIAL_RX_PORT GPIOA
+#define SERIAL_RX_PIN LL_GPIO_PIN_10
+#define SERIAL_WKUP_EXTI LL_EXTI_LINE_25 /* USART1从Stop模式唤醒的内部EXTI线 */
+#define SERIAL_RX_CLKSOURCE LL_RCC_USART1_CLKSOURCE_HSI /* 接收时使用HSI16，Stop模式下收到数据可以唤醒 */
+#define SERIAL_BAUDRATE 115200
 /* 结束 */
 
 #define SERIAL_TIMEOUT_MS 1000
+#define SERIAL_RX_BUFFER_SIZE 64 /* 2的幂 */
 
 #ifdef ENABLE_DEBUG_PRINT
 #define SERIAL_DebugPrint(info_str) _SERIAL_DebugPrint(__FILE__, __FUNCTION__, __LINE__, info_str)
@@ -18,6 +27,12 @@
 void SERIAL_SendData(const uint8_t *tx_data, uint32_t data_size);
 void SERIAL_SendString(const char *tx_char);
 void SERIAL_SendStringRN(const char *tx_char);
+void SERIAL_EnableRX(void);
+void SERIAL_DisableRX(void);
+uint8_t SERIAL_ReadByte(uint8_t *rx_data);
+uint8_t SERIAL_GetRXCount(void);
+uint8_t SERIAL_GetOverflow(void);
+void SERIAL_IRQHandler(void);
 void _SERIAL_DebugPrint(const char *file_name, const char *func_name, uint32_t func_line, const char *info_str);
 
 #endif
@@ -1,8 +1,38 @@
 #include "sht30.h"
 
+/* 时钟延展模式下传感器在转换完成前保持SCL为低，I2C超时时间需加上最长转换时间 */
+#define TH_CONV_TIME_HIGH_MS 16
+#define TH_CONV_TIME_MID_MS 7
+#define TH_CONV_TIME_LOW_MS 5
+
 static float TemperatureOffset = 0;
 static float HumidityOffset = 0;
 
+/* CRC-8（多项式0x31）查表，256项时每字节查表一次，16项时每字节查表两次（每次处理4位） */
+static const uint8_t crc8_table[TH_CRC8_TABLE_SIZE] = {
+#if TH_CRC8_TABLE_SIZE == 256
+    0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
+    0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4, 0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F, 0x5C, 0x6D,
+    0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11, 0x3F, 0x0E, 0x5D, 0x6C, 0xFB, 0xCA, 0x99, 0xA8,
+    0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52, 0x7C, 0x4D, 0x1E, 0x2F, 0xB8, 0x89, 0xDA, 0xEB,
+    0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA, 0x84, 0xB5, 0xE6, 0xD7, 0x40, 0x71, 0x22, 0x13,
+    0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9, 0xC7, 0xF6, 0xA5, 0x94, 0x03, 0x32, 0x61, 0x50,
+    0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C, 0x02, 0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95,
+    0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F, 0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6,
+    0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC, 0xED, 0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54,
+    0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC, 0x9F, 0xAE, 0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17,
+    0xFC, 0xCD, 0x9E, 0xAF, 0x38, 0x09, 0x5A, 0x6B, 0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2,
+    0xBF, 0x8E, 0xDD, 0xEC, 0x7B, 0x4A, 0x19, 0x28, 0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91,
+    0x47, 0x76, 0x25, 0x14, 0x83, 0xB2, 0xE1, 0xD0, 0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69,
+    0x04, 0x35, 0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93, 0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A,
+    0xC1, 0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56, 0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
+    0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15, 0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D, 0xAC};
+#elif TH_CRC8_TABLE_SIZE == 16
+    0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E};
+#else
+#error "TH_CRC8_TABLE_SIZE must be 256 or 16"
+#endif
+
 /**
  * @brief  计算CRC-8校验值。
  * @param  data 要计算的数据。
@@ -11,28 +41,38 @@ static float HumidityOffset = 0;
  */
 static uint8_t crc8(const uint8_t *data, uint8_t data_size)
 {
-    uint8_t i, j, crc, polynomial;
+    uint8_t crc;
 
-    polynomial = 0x31;
     crc = 0xFF;
-    for (i = 0; i < data_size; i++)
-    {
-        crc ^= *data++;
-        for (j = 0; j < 8; j++)
-        {
-            if ((crc & 0x80) != 0)
-            {
-                crc = (crc << 1) ^ polynomial;
-            }
-            else
-            {
-                crc = crc << 1;
-            }
-        }
+    while (data_size != 0)
+    {
+#if TH_CRC8_TABLE_SIZE == 256
+        crc = crc8_table[crc ^ *data];
+#else
+        crc ^= *data;
+        crc = (uint8_t)(crc << 4) ^ crc8_table[crc >> 4];
+        crc = (uint8_t)(crc << 4) ^ crc8_table[crc >> 4];
+#endif
+        data += 1;
+        data_size -= 1;
     }
     return crc;
 }
 
+/**
+ * @brief  校验一帧完整的测量数据（温度2字节+CRC，湿度2字节+CRC）。
+ * @param  frame 6字节测量数据。
+ * @return 1：校验错误，0：校验正确。
+ */
+static uint8_t crc8_check_frame(const uint8_t *frame)
+{
+    if (crc8(frame, 2) != frame[2] || crc8(frame + 3, 2) != frame[5])
+    {
+        return 1;
+    }
+    return 0;
+}
+
 /**
  * @brief  传感器原始数据转为实际数据。
  * @param  raw_data 原始数据。
@@ -42,9 +82,9 @@ static void readout_data_conv(const uint8_t *raw_data, struct TH_Value *value)
 {
     float conv_tmp;
 
-    conv_tmp = -45 + 175 * (((raw_data[0] << 8) | raw_data[1]) / 65535.0);
+    conv_tmp = -45 + 175 * (((raw_data[0] << 8) | raw_data[1]) / 65535.0f);
     value->CEL = conv_tmp + TemperatureOffset;
-    conv_tmp = 100 * (((raw_data[3] << 8) | raw_data[4]) / 65535.0);
+    conv_tmp = 100 * (((raw_data[3] << 8) | raw_data[4]) / 65535.0f);
     value->RH = conv_tmp + HumidityOffset;
     if (value->RH > 100)
     {
@@ -53,19 +93,36 @@ static void readout_data_conv(const uint8_t *raw_data, struct TH_Value *value)
 }
 
 /**
- * @brief  向传感器发送命令。
+ * @brief  向传感器发送命令后读取数据，可指定超时时间。
  * @param  cmd 要发送的命令。
- * @return 1：发送失败，0：发送成功。
+ * @param  data 数据指针。
+ * @param  data_size 数据大小。
+ * @param  timeout 超时时间，单位为毫秒，0为I2C_TIMEOUT_MS。
+ * @return 1：读取或命令执行失败，0：读取或命令执行成功。
  */
-uint8_t TH_WriteCmd(uint16_t cmd)
+static uint8_t read_cmd_timeout(uint16_t cmd, uint8_t *data, uint8_t data_size, uint16_t timeout)
 {
-    if (I2C_Start(TH_I2C_ADDR, 0, 2) != 0 ||
-        I2C_WriteByte(cmd >> 8) != 0 ||
-        I2C_WriteByte(cmd & 0x00FF) != 0)
+    uint8_t cmd_temp[2] = {cmd >> 8, cmd & 0x00FF};
+    struct I2C_Xfer xfer = {TH_I2C_ADDR, sizeof(cmd_temp), data_size, cmd_temp, data, timeout};
+
+    if (I2C_Transfer(&xfer, 1) != 0)
     {
         return 1;
     }
-    if (I2C_Stop() != 0)
+    return 0;
+}
+
+/**
+ * @brief  向传感器发送命令。
+ * @param  cmd 要发送的命令。
+ * @return 1：发送失败，0：发送成功。
+ */
+uint8_t TH_WriteCmd(uint16_t cmd)
+{
+    uint8_t cmd_temp[2] = {cmd >> 8, cmd & 0x00FF};
+    struct I2C_Xfer xfer = {TH_I2C_ADDR, sizeof(cmd_temp), 0, cmd_temp, NULL, I2C_TIMEOUT_MS};
+
+    if (I2C_Transfer(&xfer, 1) != 0)
     {
         return 1;
     }
@@ -80,17 +137,9 @@ uint8_t TH_WriteCmd(uint16_t cmd)
  */
 uint8_t TH_ReadData(uint8_t *data, uint8_t data_size)
 {
-    uint8_t i;
+    struct I2C_Xfer xfer = {TH_I2C_ADDR, 0, data_size, NULL, data, I2C_TIMEOUT_MS};
 
-    if (I2C_Start(TH_I2C_ADDR, 1, data_size) != 0)
-    {
-        return 1;
-    }
-    for (i = 0; i < data_size; i++)
-    {
-        data[i] = I2C_ReadByte();
-    }
-    if (I2C_Stop() != 0)
+    if (I2C_Transfer(&xfer, 1) != 0)
     {
         return 1;
     }
@@ -106,24 +155,7 @@ uint8_t TH_ReadData(uint8_t *data, uint8_t data_size)
  */
 uint8_t TH_ReadCmd(uint16_t cmd, uint8_t *data, uint8_t data_size)
 {
-    uint8_t i;
-
-    if (I2C_Start(TH_I2C_ADDR, 0, 2) != 0 ||
-        I2C_WriteByte(cmd >> 8) != 0 ||
-        I2C_WriteByte(cmd & 0x00FF) != 0 ||
-        I2C_Start(TH_I2C_ADDR, 1, data_size) != 0)
-    {
-        return 1;
-    }
-    for (i = 0; i < data_size; i++)
-    {
-        data[i] = I2C_ReadByte();
-    }
-    if (I2C_Stop() != 0)
-    {
-        return 1;
-    }
-    return 0;
+    return read_cmd_timeout(cmd, data, data_size, 0);
 }
 
 /**
@@ -135,28 +167,32 @@ uint8_t TH_ReadCmd(uint16_t cmd, uint8_t *data, uint8_t data_size)
 uint8_t TH_GetValue_SingleShotWithCS(uint8_t acc, struct TH_Value *value)
 {
     uint8_t ht_tmp[6];
-    uint16_t cmd;
+    uint16_t cmd, conv_time;
 
     switch (acc)
     {
     case TH_ACC_HIGH:
         cmd = 0x2C06;
+        conv_time = TH_CONV_TIME_HIGH_MS;
         break;
     case TH_ACC_MID:
         cmd = 0x2C0D;
+        conv_time = TH_CONV_TIME_MID_MS;
         break;
     case TH_ACC_LOW:
         cmd = 0x2C10;
+        conv_time = TH_CONV_TIME_LOW_MS;
         break;
     default:
         cmd = 0x2C06;
+        conv_time = TH_CONV_TIME_HIGH_MS;
         break;
     }
-    if (TH_ReadCmd(cmd, ht_tmp, sizeof(ht_tmp)) != 0)
+    if (read_cmd_timeout(cmd, ht_tmp, sizeof(ht_tmp), conv_time + I2C_TIMEOUT_MS) != 0)
     {
         return 1;
     }
-    if (crc8(ht_tmp, 2) != ht_tmp[2] || crc8(ht_tmp + 3, 2) != ht_tmp[5])
+    if (crc8_check_frame(ht_tmp) != 0)
     {
         return 2;
     }
@@ -208,7 +244,7 @@ uint8_t TH_GetValue_SingleShotWithoutCS(struct TH_Value *value)
     {
         return 1;
     }
-    if (crc8(ht_tmp, 2) != ht_tmp[2] || crc8(ht_tmp + 3, 2) != ht_tmp[5])
+    if (crc8_check_frame(ht_tmp) != 0)
     {
         return 1;
     }
@@ -288,7 +324,7 @@ uint8_t TH_GetValue_Periodic_ART(struct TH_Value *value)
     {
         return 1;
     }
-    if (crc8(ht_tmp, 2) != ht_tmp[2] || crc8(ht_tmp + 3, 2) != ht_tmp[5])
+    if (crc8_check_frame(ht_tmp) != 0)
     {
         return 1;
     }
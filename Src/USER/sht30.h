@@ -6,6 +6,9 @@
 
 /* 可修改 */
 #define TH_I2C_ADDR ((0x44 & 0xFE) << 1)
+#ifndef TH_CRC8_TABLE_SIZE
+#define TH_CRC8_TABLE_SIZE 256 /* CRC-8查表大小，256：速度优先（256字节ROM），16：ROM优先（16字节ROM） */
+#endif
 /* 结束 */
 
 #define TH_ACC_HIGH 0
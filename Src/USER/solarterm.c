@@ -0,0 +1,108 @@
+#include "solarterm.h"
+
+/*
+ * 节气时刻表示为2000年1月1日0时（北京时间）起的天数，单位为1/16384天（约5.3秒），右移14位即为日期：
+ * t = term_base[k] + y * (5984000 + term_rate[k]) - ((y * y * term_drift[k] + 4095) >> 12)
+ * 其中y为年份减2000，k为节气序号，二次项为近日点进动和ΔT带来的变化。
+ * 拟合残差在±30分钟以内，节气时刻距离0时很近时日期可能偏差1天，这些情况记录在term_fix中，日期加1。
+ * 表格由VSOP87（截断）计算的视太阳黄经生成，包含章动、光行差和ΔT修正，覆盖2000 ~ 2200年。
+ */
+#define TERM_SHIFT 14
+#define TERM_RATE_BASE 5984000UL /* 365.2422天 * 16384 的整数部分附近 */
+
+const static uint32_t term_base[24] = {
+    0x0156FC, 0x05064B, 0x08B677, 0x0C6BE9, 0x1026BB, 0x13E8CB, 0x17B385, 0x1B865F,
+    0x1F61C6, 0x234456, 0x272CA9, 0x2B193E, 0x2F08A1, 0x32F6A8, 0x36E24B, 0x3AC973,
+    0x3EA9A6, 0x4282F4, 0x46544A, 0x4A1BEC, 0x4DDB92, 0x51953F, 0x554962, 0x58F923};
+
+const static uint8_t term_rate[24] = {
+    137, 137, 136, 135, 133, 131, 128, 126, 123, 121, 120, 119,
+    118, 118, 119, 121, 123, 125, 127, 130, 132, 134, 136, 137};
+
+const static uint8_t term_drift[24] = {
+    10, 9, 7, 6, 5, 4, 4, 3, 3, 4, 5, 6,
+    7, 9, 11, 12, 14, 14, 15, 15, 15, 14, 13, 12};
+
+/* 需要加1天的节气，值为 年份减2000 * 24 + 节气序号，升序排列 */
+const static uint16_t term_fix[] = {
+    2336, 2813, 3605, 4043, 4430, 4512, 4597};
+
+/* 计算节气所在日期，2000年1月1日起的天数，y为年份减2000 */
+static uint32_t TermToDays(uint16_t y, uint8_t term)
+{
+    uint32_t t;
+    uint16_t index;
+    uint8_t i;
+
+    t = term_base[term] + y * (TERM_RATE_BASE + term_rate[term]) - ((y * y * (uint32_t)term_drift[term] + 4095) >> 12);
+    t >>= TERM_SHIFT;
+
+    index = y * 24 + term;
+    for (i = 0; i < sizeof(term_fix) / sizeof(term_fix[0]) && term_fix[i] <= index; i++)
+    {
+        if (term_fix[i] == index)
+        {
+            t += 1;
+            break;
+        }
+    }
+    return t;
+}
+
+/**
+ * @brief  获取当天的节气。
+ * @param  solar_year 公历年份，范围为TERM_YEAR_MIN ~ TERM_YEAR_MAX。
+ * @param  solar_month 公历月份。
+ * @param  solar_date 公历日期。
+ * @return 节气序号，可用于Term_NameString，TERM_NONE：当天不是节气。
+ */
+uint8_t TERM_GetTerm(uint16_t solar_year, uint8_t solar_month, uint8_t solar_date)
+{
+    uint8_t days, term;
+
+    term = TERM_GetNext(solar_year, solar_month, solar_date, &days);
+    if (term == TERM_NONE || days != 0)
+    {
+        return TERM_NONE;
+    }
+    return term;
+}
+
+/**
+ * @brief  获取当天或之后的下一个节气。
+ * @param  solar_year 公历年份，范围为TERM_YEAR_MIN ~ TERM_YEAR_MAX。
+ * @param  solar_month 公历月份。
+ * @param  solar_date 公历日期。
+ * @param  days 距离该节气的天数，0为当天。
+ * @return 节气序号，可用于Term_NameString，TERM_NONE：日期超出范围。
+ * @note   每月的两个节气分别在4 ~ 8日和19 ~ 23日附近，最多计算3个节气的日期，耗时固定。
+ */
+uint8_t TERM_GetNext(uint16_t solar_year, uint8_t solar_month, uint8_t solar_date, uint8_t *days)
+{
+    uint32_t today, term_days;
+    uint16_t y;
+    uint8_t term;
+
+    if (solar_year < TERM_YEAR_MIN || solar_year > TERM_YEAR_MAX || solar_month < 1 || solar_month > 12)
+    {
+        return TERM_NONE;
+    }
+    today = CAL_GetDays2000(solar_year, solar_month, solar_date);
+    y = solar_year - 2000;
+    term = (solar_month - 1) * 2; /* 本月第一个节气 */
+    while (1)
+    {
+        if (term == 24) /* 12月的冬至之后为下一年的小寒，表格包含2200年 */
+        {
+            term = 0;
+            y += 1;
+        }
+        term_days = TermToDays(y, term);
+        if (term_days >= today)
+        {
+            *days = term_days - today;
+            return term;
+        }
+        term += 1;
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef _SOLARTERM_H_
+#define _SOLARTERM_H_
+
+#include "main.h"
+#include "calendar.h"
+
+#define TERM_YEAR_MIN 2000
+#define TERM_YEAR_MAX 2199
+
+#define TERM_NONE 0xFF /* 不是节气或日期超出范围 */
+
+/* 节气序号，从每年的第一个节气小寒开始 */
+#define TERM_XIAOHAN 0
+#define TERM_QINGMING 6
+#define TERM_XIAZHI 11
+#define TERM_DONGZHI 23
+
+const static char Term_NameString[24][7] = {
+    "小寒", "大寒", "立春", "雨水", "惊蛰", "春分", "清明", "谷雨", "立夏", "小满", "芒种", "夏至",
+    "小暑", "大暑", "立秋", "处暑", "白露", "秋分", "寒露", "霜降", "立冬", "小雪", "大雪", "冬至"};
+
+uint8_t TERM_GetTerm(uint16_t solar_year, uint8_t solar_month, uint8_t solar_date);
+uint8_t TERM_GetNext(uint16_t solar_year, uint8_t solar_month, uint8_t solar_date, uint8_t *days);
+
+#endif
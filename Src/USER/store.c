@@ -0,0 +1,186 @@
+#include "store.h"
+
+#define STORE_CRC_MARK 0x5AA50000 /* 校验字高16位固定标记 */
+
+/**
+ * @brief  计算一个记录槽的校验值。
+ * @param  slot_addr 记录槽的EEPROM地址（四字节地址）。
+ * @param  header 记录头部。
+ * @return 校验字，高16位为固定标记，低16位为校验值。
+ */
+static uint32_t slot_crc(uint16_t slot_addr, uint32_t header)
+{
+    uint8_t i, data_dwords;
+    uint16_t crc;
+    uint32_t dword_tmp;
+
+    crc = CRC16_Calc(CRC16_INIT, (const uint8_t *)&header, 4);
+    data_dwords = (((header >> 8) & 0xFF) + 3) / 4;
+    for (i = 0; i < data_dwords; i++)
+    {
+        dword_tmp = EEPROM_ReadDWORD(slot_addr + 1 + i);
+        crc = CRC16_Calc(crc, (const uint8_t *)&dword_tmp, 4);
+    }
+    return STORE_CRC_MARK | crc;
+}
+
+/**
+ * @brief  检查一个记录槽是否有效。
+ * @param  slot 记录槽编号。
+ * @param  header 读取到的记录头部。
+ * @return 1：无效，0：有效。
+ */
+static uint8_t slot_check(uint8_t slot, uint32_t *header)
+{
+    uint16_t slot_addr;
+    uint8_t data_size;
+
+    slot_addr = STORE_EEPROM_ADDR_DWORD + slot * STORE_SLOT_DWORDS;
+    *header = EEPROM_ReadDWORD(slot_addr);
+    data_size = (*header >> 8) & 0xFF;
+    if (data_size == 0 || data_size > STORE_DATA_MAX_SIZE)
+    {
+        return 1;
+    }
+    if (EEPROM_ReadDWORD(slot_addr + 1 + (data_size + 3) / 4) != slot_crc(slot_addr, *header))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief  查找序号最新的有效记录。
+ * @param  seq 最新记录的序号。
+ * @return 最新记录的槽编号，STORE_SLOT_COUNT：没有有效记录。
+ * @note   只扫描固定数量的记录槽，序号回绕后仍能正确比较新旧。
+ */
+static uint8_t find_newest(uint16_t *seq)
+{
+    uint8_t i, newest;
+    uint32_t header;
+
+    newest = STORE_SLOT_COUNT;
+    *seq = 0;
+    for (i = 0; i < STORE_SLOT_COUNT; i++)
+    {
+        if (slot_check(i, &header) != 0)
+        {
+            continue;
+        }
+        if (newest == STORE_SLOT_COUNT || (int16_t)((header >> 16) - *seq) > 0)
+        {
+            newest = i;
+            *seq = header >> 16;
+        }
+    }
+    return newest;
+}
+
+/**
+ * @brief  读取最新的有效记录。
+ * @param  data 数据存储指针。
+ * @param  size 数据大小，最大为STORE_DATA_MAX_SIZE。
+ * @param  version 数据结构版本，与保存时不同则视为无效。
+ * @return 1：没有有效记录，0：读取成功。
+ */
+uint8_t STORE_Load(void *data, uint8_t size, uint8_t version)
+{
+    uint8_t i, slot;
+    uint16_t seq, slot_addr;
+    uint32_t header, dword_tmp;
+
+    dword_tmp = 0;
+    slot = find_newest(&seq);
+    if (slot == STORE_SLOT_COUNT)
+    {
+        return 1;
+    }
+    slot_addr = STORE_EEPROM_ADDR_DWORD + slot * STORE_SLOT_DWORDS;
+    header = EEPROM_ReadDWORD(slot_addr);
+    if ((header & 0xFF) != version || ((header >> 8) & 0xFF) != size)
+    {
+        return 1;
+    }
+    for (i = 0; i < size; i++)
+    {
+        if (i % 4 == 0)
+        {
+            dword_tmp = EEPROM_ReadDWORD(slot_addr + 1 + i / 4);
+        }
+        ((uint8_t *)data)[i] = dword_tmp >> ((i % 4) * 8);
+    }
+    return 0;
+}
+
+/**
+ * @brief  保存一条新记录。
+ * @param  data 要保存的数据指针。
+ * @param  size 数据大小，最大为STORE_DATA_MAX_SIZE。
+ * @param  version 数据结构版本。
+ * @return 1：保存失败，0：保存成功或数据没有变化。
+ * @note   新记录写入最新记录的下一个槽，最后写入头部，写入中途断电时旧记录仍然有效。
+ */
+uint8_t STORE_Save(const void *data, uint8_t size, uint8_t version)
+{
+    uint8_t i, slot;
+    uint16_t seq, slot_addr;
+    uint32_t header, dword_tmp;
+
+    if (size == 0 || size > STORE_DATA_MAX_SIZE)
+    {
+        return 1;
+    }
+    dword_tmp = 0;
+    slot = find_newest(&seq);
+    if (slot != STORE_SLOT_COUNT) /* 与最新记录相同则不写入 */
+    {
+        slot_addr = STORE_EEPROM_ADDR_DWORD + slot * STORE_SLOT_DWORDS;
+        header = EEPROM_ReadDWORD(slot_addr);
+        if ((header & 0xFF) == version && ((header >> 8) & 0xFF) == size)
+        {
+            for (i = 0; i < size; i++)
+            {
+                if (i % 4 == 0)
+                {
+                    dword_tmp = EEPROM_ReadDWORD(slot_addr + 1 + i / 4);
+                }
+                if (((uint8_t *)data)[i] != (uint8_t)(dword_tmp >> ((i % 4) * 8)))
+                {
+                    break;
+                }
+            }
+            if (i == size)
+            {
+                return 0;
+            }
+        }
+        slot = (slot + 1) % STORE_SLOT_COUNT;
+        seq += 1;
+    }
+    else
+    {
+        slot = 0;
+        seq = 1;
+    }
+
+    slot_addr = STORE_EEPROM_ADDR_DWORD + slot * STORE_SLOT_DWORDS;
+    if (EEPROM_WriteDWORD(slot_addr, 0) != 0) /* 先清除头部，使该槽在写入完成前无效 */
+    {
+        return 1;
+    }
+    if (EEPROM_WriteBuffer((slot_addr + 1) * 4, data, size) != 0) /* 补齐四字节的部分保留原内容，同样计入校验 */
+    {
+        return 1;
+    }
+    header = ((uint32_t)seq << 16) | ((uint32_t)size << 8) | version;
+    if (EEPROM_WriteDWORD(slot_addr + 1 + (size + 3) / 4, slot_crc(slot_addr, header)) != 0)
+    {
+        return 1;
+    }
+    if (EEPROM_WriteDWORD(slot_addr, header) != 0) /* 最后写入头部，写入完成后记录生效 */
+    {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,19 @@
+#ifndef _STORE_H_
+#define _STORE_H_
+
+#include "main.h"
+#include "eeprom.h"
+#include "crc16.h"
+
+/* 可修改 */
+#define STORE_EEPROM_ADDR_DWORD 0x00 /* 记录存储区在EEPROM中的起始地址（四字节地址），占用 STORE_SLOT_COUNT * STORE_SLOT_DWORDS 个四字节 */
+#define STORE_SLOT_COUNT 8           /* 记录槽数量，每次保存轮流写入下一个槽 */
+#define STORE_SLOT_DWORDS 16         /* 每个记录槽大小（四字节），包含1个四字节头部和1个四字节校验 */
+/* 结束 */
+
+#define STORE_DATA_MAX_SIZE ((STORE_SLOT_DWORDS - 2) * 4)
+
+uint8_t STORE_Load(void *data, uint8_t size, uint8_t version);
+uint8_t STORE_Save(const void *data, uint8_t size, uint8_t version);
+
+#endif
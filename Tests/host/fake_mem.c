@@ -0,0 +1,155 @@
+#include "fake_mem.h"
+#include <string.h>
+
+uint8_t FAKE_EEPROM[EEPROM_SIZE];
+uint8_t FAKE_BKPR[BKPR_SIZE];
+uint32_t FAKE_EEPROMWrites;
+
+/**
+ * @brief  清空EEPROM、备份寄存器和写入计数。
+ */
+void FAKE_ResetMem(void)
+{
+    memset(FAKE_EEPROM, 0, sizeof(FAKE_EEPROM));
+    memset(FAKE_BKPR, 0, sizeof(FAKE_BKPR));
+    FAKE_EEPROMWrites = 0;
+}
+
+static uint8_t eeprom_write(uint16_t addr, const void *data, uint16_t size)
+{
+    uint16_t i;
+
+    if (addr + size > EEPROM_SIZE)
+    {
+        return 1;
+    }
+    for (i = 0; i < size; i++)
+    {
+        if (FAKE_EEPROM[addr + i] != ((const uint8_t *)data)[i])
+        {
+            FAKE_EEPROM[addr + i] = ((const uint8_t *)data)[i];
+            FAKE_EEPROMWrites += 1;
+        }
+    }
+    return 0;
+}
+
+uint8_t EEPROM_ReadByte(uint16_t addr)
+{
+    return FAKE_EEPROM[addr];
+}
+
+uint16_t EEPROM_ReadWORD(uint16_t addr)
+{
+    uint16_t data;
+
+    memcpy(&data, FAKE_EEPROM + addr * 2, 2);
+    return data;
+}
+
+uint32_t EEPROM_ReadDWORD(uint16_t addr)
+{
+    uint32_t data;
+
+    memcpy(&data, FAKE_EEPROM + addr * 4, 4);
+    return data;
+}
+
+uint8_t EEPROM_WriteByte(uint16_t addr, uint8_t data)
+{
+    return eeprom_write(addr, &data, 1);
+}
+
+uint8_t EEPROM_WriteWORD(uint16_t addr, uint16_t data)
+{
+    return eeprom_write(addr * 2, &data, 2);
+}
+
+uint8_t EEPROM_WriteDWORD(uint16_t addr, uint32_t data)
+{
+    return eeprom_write(addr * 4, &data, 4);
+}
+
+uint8_t EEPROM_WriteBuffer(uint16_t addr, const void *data, uint16_t data_size)
+{
+    return eeprom_write(addr, data, data_size);
+}
+
+uint8_t EEPROM_EraseByte(uint16_t addr)
+{
+    return EEPROM_WriteByte(addr, 0);
+}
+
+uint8_t EEPROM_EraseWORD(uint16_t addr)
+{
+    return EEPROM_WriteWORD(addr, 0);
+}
+
+uint8_t EEPROM_EraseDWORD(uint16_t addr)
+{
+    return EEPROM_WriteDWORD(addr, 0);
+}
+
+uint16_t EEPROM_EraseRange(uint16_t start_addr_DWORD, uint16_t end_addr_DWORD)
+{
+    uint16_t i;
+
+    for (i = start_addr_DWORD; i <= end_addr_DWORD; i++)
+    {
+        if (EEPROM_EraseDWORD(i) != 0)
+        {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+uint16_t EEPROM_GetProgramTime(void)
+{
+    return 0;
+}
+
+uint8_t BKPR_ReadByte(uint8_t addr)
+{
+    return FAKE_BKPR[addr];
+}
+
+uint16_t BKPR_ReadWORD(uint8_t addr)
+{
+    uint16_t data;
+
+    memcpy(&data, FAKE_BKPR + addr * 2, 2);
+    return data;
+}
+
+uint32_t BKPR_ReadDWORD(uint8_t addr)
+{
+    uint32_t data;
+
+    memcpy(&data, FAKE_BKPR + addr * 4, 4);
+    return data;
+}
+
+uint8_t BKPR_WriteByte(uint8_t addr, uint8_t data)
+{
+    FAKE_BKPR[addr] = data;
+    return 0;
+}
+
+uint8_t BKPR_WriteWORD(uint8_t addr, uint16_t data)
+{
+    memcpy(FAKE_BKPR + addr * 2, &data, 2);
+    return 0;
+}
+
+uint8_t BKPR_WriteDWORD(uint8_t addr, uint32_t data)
+{
+    memcpy(FAKE_BKPR + addr * 4, &data, 4);
+    return 0;
+}
+
+uint8_t BKPR_ResetAll(void)
+{
+    memset(FAKE_BKPR, 0, sizeof(FAKE_BKPR));
+    return 0;
+}
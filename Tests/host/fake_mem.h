@@ -0,0 +1,14 @@
+#ifndef _FAKE_MEM_H_
+#define _FAKE_MEM_H_
+
+#include "eeprom.h"
+#include "bkpr.h"
+
+/* 主机端测试用的EEPROM和备份寄存器，用RAM数组代替，接口与eeprom.c、bkpr.c相同 */
+extern uint8_t FAKE_EEPROM[EEPROM_SIZE];
+extern uint8_t FAKE_BKPR[BKPR_SIZE];
+extern uint32_t FAKE_EEPROMWrites; /* 实际写入（内容有变化）的字节数 */
+
+void FAKE_ResetMem(void);
+
+#endif
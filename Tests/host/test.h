@@ -0,0 +1,28 @@
+#ifndef _TEST_H_
+#define _TEST_H_
+
+#include <stdio.h>
+
+/* 主机端测试的简单断言，只打印前20条失败信息，最后由TEST_END返回进程退出码 */
+static unsigned long test_total, test_fails;
+
+#define TEST_CHECK(cond, ...)                           \
+    do                                                  \
+    {                                                   \
+        test_total++;                                   \
+        if (!(cond) && test_fails++ < 20)               \
+        {                                               \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__);                        \
+            printf("\n");                               \
+        }                                               \
+    } while (0)
+
+#define TEST_END(name)                                                        \
+    do                                                                        \
+    {                                                                         \
+        printf("%s: %lu checks, %lu failed\n", name, test_total, test_fails); \
+        return test_fails != 0;                                               \
+    } while (0)
+
+#endif
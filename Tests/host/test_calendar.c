@@ -0,0 +1,162 @@
+#include <time.h>
+#include "calendar.c"
+#include "test.h"
+
+/*
+ * 检查calendar.c中代替除法的乘法加移位在注释给出的范围内与除法结果相同（x / 60的范围正好到74938为止），
+ * 日序号与逐年逐月累加的结果及原lunar.c中的SolarToInt()相同，以及年、月、日干支的周期和已知日期。
+ * 最后粗略比较与原来使用除法和取余的计算速度（主机有硬件除法，结果只作参考，目标芯片上差距更大）。
+ */
+
+/* 原lunar.c中的实现，用于对照 */
+static uint64_t solar_to_int_ref(uint16_t y, uint8_t m, uint8_t d)
+{
+    m = (m + 9) % 12;
+    y = y - m / 10;
+    return 365 * y + y / 4 - y / 100 + y / 400 + (m * 306 + 5) / 10 + (d - 1);
+}
+
+static uint32_t day_number_ref(uint16_t year, uint8_t month, uint8_t date)
+{
+    return (uint32_t)solar_to_int_ref(year, month, date);
+}
+
+static uint8_t mod60_ref(uint32_t x)
+{
+    return x % 60;
+}
+
+#define BENCH_ROUNDS 20000
+
+/* 2000 ~ 2199年每月的第1、15、28日 */
+static double bench_day_number(uint32_t (*func)(uint16_t, uint8_t, uint8_t), uint32_t *sum)
+{
+    unsigned long i;
+    uint16_t year;
+    uint8_t month;
+    clock_t start;
+
+    start = clock();
+    for (i = 0; i < BENCH_ROUNDS; i++)
+    {
+        year = 2000 + i % 200;
+        for (month = 1; month <= 12; month++)
+        {
+            *sum += func(year, month, 1) + func(year, month, 15) + func(year, month, 28);
+        }
+    }
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / (BENCH_ROUNDS * 36UL);
+}
+
+static double bench_mod60(uint8_t (*func)(uint32_t), uint32_t *sum)
+{
+    uint32_t x;
+    unsigned long i, count;
+    clock_t start;
+
+    count = 0;
+    start = clock();
+    for (i = 0; i < BENCH_ROUNDS / 20; i++)
+    {
+        for (x = i & 0xFF; x < 74939; x += 97) /* 覆盖Mod60()的全部有效范围 */
+        {
+            *sum += func(x);
+            count += 1;
+        }
+    }
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / count;
+}
+
+static uint8_t month_days(uint16_t year, uint8_t month)
+{
+    static const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    if (month == 2 && (year % 4) == 0 && ((year % 100) != 0 || (year % 400) == 0))
+    {
+        return 29;
+    }
+    return days[month - 1];
+}
+
+int main(void)
+{
+    uint32_t x, day_number, sum;
+    uint16_t year;
+    uint8_t month, date, term, cycle, prev_day, prev_month;
+    double cal_ns, ref_ns;
+
+    /* y / 100 = (y * 1311) >> 17，y < 2300 */
+    for (x = 0; x < 2300; x++)
+    {
+        TEST_CHECK(((x * 1311UL) >> 17) == x / 100, "century %u", x);
+    }
+
+    /* x % 60，x < 74939 */
+    for (x = 0; x < 74939; x++)
+    {
+        TEST_CHECK(Mod60(x) == x % 60, "mod60 %u = %u", x, Mod60(x));
+    }
+    TEST_CHECK(Mod60(74939) != 74939 % 60, "mod60 bound");
+    TEST_CHECK(CAL_GetDays2000(2199, 12, 31) + 58 < 74939, "days in range");
+
+    /* 天干和地支是干支序号分别对10和12取余 */
+    for (cycle = 0; cycle < 60; cycle++)
+    {
+        TEST_CHECK(CAL_GetStem(cycle) == cycle % 10 && CAL_GetBranch(cycle) == cycle % 12, "cycle %u", cycle);
+    }
+
+    /* 日序号从公元1年1月1日逐日累加 */
+    day_number = 306; /* 公元0年3月1日到公元1年1月1日 */
+    for (year = 1; year < 2300; year++)
+    {
+        for (month = 1; month <= 12; month++)
+        {
+            for (date = 1; date <= month_days(year, month); date++)
+            {
+                TEST_CHECK(CAL_GetDayNumber(year, month, date) == day_number, "day number %u-%u-%u", year, month, date);
+                TEST_CHECK(year < 1583 || day_number_ref(year, month, date) == day_number, "SolarToInt %u-%u-%u", year, month, date);
+                day_number += 1;
+            }
+        }
+    }
+    TEST_CHECK(CAL_GetDayNumber(2000, 1, 1) == CAL_DAY_NUMBER_2000 && CAL_GetDays2000(2000, 1, 1) == 0, "2000-1-1");
+
+    /* 1984年为甲子年，2000年为庚辰年 */
+    TEST_CHECK(CAL_GetYearCycle(1984) == CAL_CYCLE_JIAZI, "1984");
+    TEST_CHECK(CAL_GetStem(CAL_GetYearCycle(2000)) == 0 && CAL_GetBranch(CAL_GetYearCycle(2000)) == 8, "2000");
+
+    /* 日干支逐日加1，2000年1月1日为戊午日 */
+    TEST_CHECK(CAL_GetStem(CAL_GetDayCycle(2000, 1, 1)) == 8 && CAL_GetBranch(CAL_GetDayCycle(2000, 1, 1)) == 10, "2000-1-1 day");
+    /* 月干支只在“节”（偶数序号的节气）当天加1，2000年1月1日为丙子月，2000年2月4日立春后为戊寅月 */
+    TEST_CHECK(CAL_GetStem(CAL_GetMonthCycle(2000, 1, 1)) == 6 && CAL_GetBranch(CAL_GetMonthCycle(2000, 1, 1)) == 4, "2000-1 month");
+    TEST_CHECK(CAL_GetStem(CAL_GetMonthCycle(2000, 2, 4)) == 8 && CAL_GetBranch(CAL_GetMonthCycle(2000, 2, 4)) == 6, "2000-2 month");
+    prev_day = CAL_GetDayCycle(2000, 1, 1);
+    prev_month = CAL_GetMonthCycle(2000, 1, 1);
+    for (year = 2000; year < 2200; year++)
+    {
+        for (month = 1; month <= 12; month++)
+        {
+            for (date = 1; date <= month_days(year, month); date++)
+            {
+                cycle = CAL_GetDayCycle(year, month, date);
+                TEST_CHECK(year == 2000 && month == 1 && date == 1 ? cycle == prev_day : cycle == Mod60(prev_day + 1),
+                           "day cycle %u-%u-%u", year, month, date);
+                prev_day = cycle;
+                term = TERM_GetTerm(year, month, date);
+                cycle = CAL_GetMonthCycle(year, month, date);
+                TEST_CHECK(term != TERM_NONE && (term & 1) == 0 ? cycle == Mod60(prev_month + 1) : cycle == prev_month,
+                           "month cycle %u-%u-%u", year, month, date);
+                prev_month = cycle;
+            }
+        }
+    }
+
+    sum = 0;
+    cal_ns = bench_day_number(CAL_GetDayNumber, &sum);
+    ref_ns = bench_day_number(day_number_ref, &sum);
+    printf("day number: CAL_GetDayNumber %.2f ns, SolarToInt %.2f ns (%u)\n", cal_ns, ref_ns, sum);
+    cal_ns = bench_mod60(Mod60, &sum);
+    ref_ns = bench_mod60(mod60_ref, &sum);
+    printf("x %% 60: Mod60 %.2f ns, %% %.2f ns (%u)\n", cal_ns, ref_ns, sum);
+    TEST_END("calendar");
+}
@@ -0,0 +1,89 @@
+#include <time.h>
+#include "sht30.c"
+#include "test.h"
+
+/*
+ * 用逐位计算的CRC-8作为参考，穷举检查所有2字节输入和SHT30数据手册中的示例，
+ * 最后粗略比较查表与逐位计算的速度（主机上的结果只作参考）。
+ * 编译两次，分别使用256项和16项的表。
+ */
+
+uint8_t I2C_Transfer(const struct I2C_Xfer *xfer, uint8_t xfer_count)
+{
+    (void)xfer;
+    (void)xfer_count;
+    return 1;
+}
+
+static uint8_t crc8_ref(const uint8_t *data, uint8_t data_size)
+{
+    uint8_t crc, i;
+
+    crc = 0xFF;
+    while (data_size != 0)
+    {
+        crc ^= *data;
+        for (i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x80) != 0 ? (uint8_t)(crc << 1) ^ 0x31 : (uint8_t)(crc << 1);
+        }
+        data += 1;
+        data_size -= 1;
+    }
+    return crc;
+}
+
+#define BENCH_FRAMES 20000000UL
+
+static double bench(uint8_t (*func)(const uint8_t *, uint8_t), uint8_t *sum)
+{
+    uint8_t frame[2];
+    unsigned long i;
+    clock_t start;
+
+    start = clock();
+    for (i = 0; i < BENCH_FRAMES; i++)
+    {
+        frame[0] = (uint8_t)i;
+        frame[1] = (uint8_t)(i >> 8);
+        *sum += func(frame, 2);
+    }
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / BENCH_FRAMES;
+}
+
+int main(void)
+{
+    const uint8_t example[6] = {0xBE, 0xEF, 0x92, 0x66, 0x66, 0x93};
+    uint8_t data[3], frame[6], sum;
+    uint32_t i;
+    double table_ns, ref_ns;
+
+    /* 数据手册示例：0xBEEF的CRC为0x92 */
+    TEST_CHECK(crc8(example, 2) == 0x92, "example crc 0x%02X", crc8(example, 2));
+    TEST_CHECK(crc8_check_frame(example) == 0, "example frame");
+    TEST_CHECK(crc8(example, 0) == 0xFF, "empty crc");
+
+    for (i = 0; i < 0x10000; i++)
+    {
+        data[0] = (uint8_t)(i >> 8);
+        data[1] = (uint8_t)i;
+        TEST_CHECK(crc8(data, 2) == crc8_ref(data, 2), "crc 0x%04X", i);
+        TEST_CHECK(crc8(data, 1) == crc8_ref(data, 1), "crc 0x%02X", data[0]);
+        /* 附加正确的CRC后整帧校验通过，改动任意一位后校验失败 */
+        frame[0] = data[0];
+        frame[1] = data[1];
+        frame[2] = crc8_ref(data, 2);
+        frame[3] = data[1];
+        frame[4] = data[0];
+        frame[5] = crc8_ref(frame + 3, 2);
+        TEST_CHECK(crc8_check_frame(frame) == 0, "frame 0x%04X", i);
+        frame[i % 6] ^= (uint8_t)(1 << (i % 8));
+        TEST_CHECK(crc8_check_frame(frame) != 0, "corrupt frame 0x%04X", i);
+    }
+
+    sum = 0;
+    table_ns = bench(crc8, &sum);
+    ref_ns = bench(crc8_ref, &sum);
+    printf("crc8 table %d: %.2f ns/frame, bitwise: %.2f ns/frame (%u)\n", TH_CRC8_TABLE_SIZE, table_ns, ref_ns, sum);
+    TEST_END(TH_CRC8_TABLE_SIZE == 256 ? "crc8 (256)" : "crc8 (16)");
+}
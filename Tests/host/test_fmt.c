@@ -0,0 +1,224 @@
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "fmt.h"
+#include "test.h"
+
+/*
+ * 用snprintf作为参考检查FMT_Uint/FMT_Int/FMT_Fixed/FMT_Hex的输出：小数值穷举所有宽度、标志和小数位数，
+ * 32位数值用伪随机数覆盖。另外检查缓冲区截断、FMT_Scale的舍入，最后粗略比较主界面字符串的格式化速度（主机上的结果只作参考）。
+ */
+
+static char got[64], expect[64];
+
+static uint32_t random_next(void)
+{
+    static uint32_t seed = 1;
+
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) ^ (seed << 16);
+}
+
+/* 生成标志对应的printf格式，例如"%-+08.2f" */
+static void printf_format(char *format, uint8_t flags, uint8_t width, int decimals, char conv)
+{
+    char *p = format;
+
+    *p++ = '%';
+    if ((flags & FMT_LEFT) != 0)
+        *p++ = '-';
+    if ((flags & FMT_SIGN) != 0)
+        *p++ = '+';
+    if ((flags & FMT_ZERO) != 0)
+        *p++ = '0';
+    p += sprintf(p, "%u", width);
+    if (decimals >= 0)
+        p += sprintf(p, ".%d", decimals);
+    *p++ = conv;
+    *p = '\0';
+}
+
+static void check_int(int32_t value, uint8_t width, uint8_t flags)
+{
+    struct FMT_Buffer buf;
+    char format[16];
+
+    FMT_Init(&buf, got, sizeof(got));
+    FMT_Int(&buf, value, width, flags);
+    printf_format(format, flags, width, -1, 'd');
+    snprintf(expect, sizeof(expect), format, value);
+    TEST_CHECK(strcmp(got, expect) == 0, "%s %d: [%s]", format, value, got);
+}
+
+static void check_uint(uint32_t value, uint8_t width, uint8_t flags)
+{
+    struct FMT_Buffer buf;
+    char format[16];
+
+    flags &= ~FMT_SIGN; /* %u没有正号 */
+    FMT_Init(&buf, got, sizeof(got));
+    FMT_Uint(&buf, value, width, flags);
+    printf_format(format, flags, width, -1, 'u');
+    snprintf(expect, sizeof(expect), format, value);
+    TEST_CHECK(strcmp(got, expect) == 0, "%s %u: [%s]", format, value, got);
+}
+
+static void check_fixed(int32_t value, uint8_t decimals, uint8_t width, uint8_t flags)
+{
+    struct FMT_Buffer buf;
+    char format[16];
+
+    FMT_Init(&buf, got, sizeof(got));
+    FMT_Fixed(&buf, value, decimals, width, flags);
+    printf_format(format, flags, width, decimals, 'f');
+    snprintf(expect, sizeof(expect), format, value / pow(10, decimals));
+    TEST_CHECK(strcmp(got, expect) == 0, "%s %d: [%s]", format, value, got);
+}
+
+static void check_hex(uint32_t value, uint8_t digits)
+{
+    struct FMT_Buffer buf;
+
+    FMT_Init(&buf, got, sizeof(got));
+    FMT_Hex(&buf, value, digits);
+    snprintf(expect, sizeof(expect), "%0*X", digits, value);
+    TEST_CHECK(strcmp(got, expect) == 0, "%%0%uX %X: [%s]", digits, value, got);
+}
+
+/* FMT_Scale的参考：float乘以10^decimals后四舍五入（远离0） */
+static void check_scale(float value, uint8_t decimals)
+{
+    float scaled;
+
+    scaled = value * (float)pow(10, decimals);
+    scaled = (scaled < 0) ? scaled - 0.5f : scaled + 0.5f;
+    TEST_CHECK(FMT_Scale(value, decimals) == (int32_t)scaled, "scale %g %u: %d", value, decimals, FMT_Scale(value, decimals));
+}
+
+/* 主界面每次唤醒格式化的字符串，分别用snprintf和FMT_*生成 */
+static void home_printf(char *str, uint16_t size, int i)
+{
+    snprintf(str, size, "2%03d/%02d/%02d 星期%s|%02d:%02d|%04.1f℃|%04.1f％", i & 127, 1 + (i & 7), 1 + (i & 15), "一", i % 24, i % 60, (i % 400) / 10.0, (i % 1000) / 10.0);
+}
+
+static void home_fmt(char *str, uint16_t size, int i)
+{
+    struct FMT_Buffer buf;
+
+    FMT_Init(&buf, str, size);
+    FMT_Char(&buf, '2');
+    FMT_Uint(&buf, i & 127, 3, FMT_ZERO);
+    FMT_Char(&buf, '/');
+    FMT_Uint(&buf, 1 + (i & 7), 2, FMT_ZERO);
+    FMT_Char(&buf, '/');
+    FMT_Uint(&buf, 1 + (i & 15), 2, FMT_ZERO);
+    FMT_String(&buf, " 星期一|");
+    FMT_Uint(&buf, i % 24, 2, FMT_ZERO);
+    FMT_Char(&buf, ':');
+    FMT_Uint(&buf, i % 60, 2, FMT_ZERO);
+    FMT_Char(&buf, '|');
+    FMT_Fixed(&buf, i % 400, 1, 4, FMT_ZERO);
+    FMT_String(&buf, "℃|");
+    FMT_Fixed(&buf, i % 1000, 1, 4, FMT_ZERO);
+    FMT_String(&buf, "％");
+}
+
+static double bench(void (*func)(char *, uint16_t, int))
+{
+    const int count = 2000000;
+    char str[128];
+    clock_t start;
+    int i;
+
+    start = clock();
+    for (i = 0; i < count; i++)
+    {
+        func(str, sizeof(str), i);
+    }
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / count;
+}
+
+int main(void)
+{
+    struct FMT_Buffer buf;
+    char ref[128], str[128];
+    int32_t value;
+    uint32_t i, shift;
+    uint8_t width, flags, decimals;
+    double printf_ns, fmt_ns;
+
+    /* 小数值穷举 */
+    for (value = -1100; value <= 1100; value++)
+    {
+        for (width = 0; width <= 8; width++)
+        {
+            for (flags = 0; flags < 8; flags++)
+            {
+                check_int(value, width, flags);
+                check_uint(value + 1100, width, flags);
+                for (decimals = 0; decimals <= 4; decimals++)
+                {
+                    check_fixed(value, decimals, width, flags);
+                }
+            }
+        }
+    }
+    for (i = 0; i < 0x10000; i++)
+    {
+        for (width = 0; width <= 8; width++)
+        {
+            check_hex(i, width);
+        }
+    }
+
+    /* 32位数值 */
+    for (i = 0; i < 1000000; i++)
+    {
+        shift = random_next() % 32;
+        width = random_next() % 14;
+        flags = random_next() % 8;
+        decimals = random_next() % 5;
+        check_uint(random_next() >> shift, width, flags);
+        check_int((int32_t)random_next() >> shift, width, flags);
+        check_fixed((int32_t)random_next() >> (shift > 7 ? shift : 7), decimals, width, flags); /* 保证double中精确 */
+        check_hex(random_next() >> shift, width % 9);
+        check_scale((float)((int32_t)random_next() >> 12) / 1000.0f, decimals % 4);
+    }
+    check_uint(0xFFFFFFFF, 0, 0);
+    check_int(INT32_MIN, 0, FMT_SIGN);
+    check_int(INT32_MAX, 12, FMT_SIGN | FMT_ZERO);
+    check_fixed(-5, 1, 4, FMT_ZERO);
+
+    /* 截断与snprintf相同，UTF-8字符不会被截断一半 */
+    for (i = 1; i < 24; i++)
+    {
+        FMT_Init(&buf, got, i);
+        FMT_String(&buf, "ABC");
+        FMT_Int(&buf, -12345, 8, FMT_ZERO);
+        FMT_Char(&buf, 'x');
+        snprintf(expect, i, "ABC%08dx", -12345);
+        TEST_CHECK(strcmp(got, expect) == 0 && buf.Length == strlen(got), "truncate %u: [%s]", i, got);
+    }
+    FMT_Init(&buf, got, 8);
+    FMT_String(&buf, "温度℃");
+    TEST_CHECK(strcmp(got, "温度") == 0, "utf8 truncate: [%s]", got);
+    FMT_Init(&buf, got, sizeof(got));
+    FMT_String(&buf, "AB");
+    FMT_Pad(&buf, 6);
+    FMT_Char(&buf, '|');
+    TEST_CHECK(strcmp(got, "AB    |") == 0, "pad: [%s]", got);
+    FMT_Init(&buf, got, 4);
+    FMT_Pad(&buf, 60);
+    TEST_CHECK(strcmp(got, "   ") == 0, "pad truncate: [%s]", got);
+
+    for (i = 0; i < 100000; i++)
+    {
+        home_printf(ref, sizeof(ref), i);
+        home_fmt(str, sizeof(str), i);
+        TEST_CHECK(strcmp(ref, str) == 0, "home %u: [%s] [%s]", i, str, ref);
+    }
+    printf_ns = bench(home_printf);
+    fmt_ns = bench(home_fmt);
+    printf("home screen strings: snprintf %.0f ns, FMT %.0f ns\n", printf_ns, fmt_ns);
+    TEST_END("fmt");
+}
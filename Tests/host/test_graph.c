@@ -0,0 +1,154 @@
+#include <string.h>
+#include "gdeh029a1.h"
+
+/* 在包含驱动源文件前把用到的外设换成内存中的假寄存器，SPI总是空闲，发送立即完成 */
+static SPI_TypeDef fake_spi = {.SR = SPI_SR_TXE};
+static GPIO_TypeDef fake_gpioa, fake_gpiob;
+static SysTick_Type fake_systick;
+#undef SPI1
+#define SPI1 (&fake_spi)
+#undef GPIOA
+#define GPIOA (&fake_gpioa)
+#undef GPIOB
+#define GPIOB (&fake_gpiob)
+#undef SysTick
+#define SysTick (&fake_systick)
+
+#include "gdeh029a1.c"
+#include "test.h"
+
+/*
+ * 检查EPD_DrawGraph()生成的位图与预先确认过的图像一致（'#'为黑色像素）。
+ * 位图按列存放，每列y_size_x8字节，字节最高位为最上方像素，0为黑色。
+ */
+
+void LL_mDelay(uint32_t Delay)
+{
+    (void)Delay;
+}
+
+static void render(uint16_t x_size, uint8_t y_size_x8, char *image)
+{
+    uint16_t row, column;
+
+    for (row = 0; row < y_size_x8 * 8; row++)
+    {
+        for (column = 0; column < x_size; column++)
+        {
+            *image++ = (graph_buffer[column * y_size_x8 + row / 8] & (0x80 >> (row % 8))) == 0 ? '#' : '.';
+        }
+        *image++ = '\n';
+    }
+    *image = '\0';
+}
+
+static void check_graph(const char *name, uint16_t x_size, uint8_t y_size_x8, const int16_t *data, uint16_t data_count, uint8_t style, const char *golden)
+{
+    char image[(EPD_GRAPH_BUFFER_SIZE + 16) * 8 + 1];
+
+    TEST_CHECK(EPD_DrawGraph(0, 0, x_size, y_size_x8, data, data_count, style) == 0, "%s: draw failed", name);
+    render(x_size, y_size_x8, image);
+    TEST_CHECK(strcmp(image, golden) == 0, "%s: image differs\n%s", name, image);
+}
+
+static const char golden_ramp[] =
+    "...............#\n"
+    ".............###\n"
+    "...........###..\n"
+    ".........###....\n"
+    ".......###......\n"
+    ".....###........\n"
+    "...###..........\n"
+    "####............\n";
+
+static const char golden_wave[] =
+    "......####..............\n"
+    "......#..#..............\n"
+    "......#..#..............\n"
+    "......#..#..............\n"
+    "...####..####...........\n"
+    "...#........#...........\n"
+    "...#........#...........\n"
+    "...#........#...........\n"
+    "####........####........\n"
+    "...............#........\n"
+    "...............#........\n"
+    "...............#........\n"
+    "...............####..###\n"
+    "..................#..#..\n"
+    "..................#..#..\n"
+    "..................####..\n";
+
+static const char golden_bars[] =
+    "....##..........\n"
+    "....##..........\n"
+    "..######........\n"
+    "..######........\n"
+    "##########......\n"
+    "##########......\n"
+    "############..##\n"
+    "################\n";
+
+static const char golden_gap[] =
+    ".....##.....\n"
+    "......##....\n"
+    "..#....##...\n"
+    ".##.....#...\n"
+    "##..........\n"
+    "............\n"
+    "............\n"
+    "..........##\n";
+
+static const char golden_flat[] =
+    "........\n"
+    "........\n"
+    "........\n"
+    "........\n"
+    "########\n"
+    "........\n"
+    "........\n"
+    "........\n";
+
+static const char golden_dense[] =
+    "...........#\n"
+    ".........###\n"
+    "......######\n"
+    "...#########\n"
+    ".##########.\n"
+    "#########...\n"
+    "######......\n"
+    "###.........\n";
+
+int main(void)
+{
+    const int16_t ramp[16] = {0, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120, 130, 140, 150};
+    const int16_t wave[8] = {0, 30, 60, 30, 0, -30, -60, -30};
+    const int16_t gap[12] = {5, 6, 7, EPD_GRAPH_NO_DATA, EPD_GRAPH_NO_DATA, 9, 8, 7, 6, EPD_GRAPH_NO_DATA, 2, 1};
+    const int16_t flat[4] = {42, 42, 42, 42};
+    const int16_t none[4] = {EPD_GRAPH_NO_DATA, EPD_GRAPH_NO_DATA, EPD_GRAPH_NO_DATA, EPD_GRAPH_NO_DATA};
+    int16_t dense[48];
+    uint16_t i;
+
+    /* 数据与列数相同，上升的直线 */
+    check_graph("ramp", 16, 1, ramp, 16, EPD_GRAPH_STYLE_LINE, golden_ramp);
+    /* 数据少于列数，每个数据拉宽为3列，相邻列之间连接 */
+    check_graph("wave", 24, 2, wave, 8, EPD_GRAPH_STYLE_LINE, golden_wave);
+    /* 柱状图，柱高为每列数据的平均值 */
+    check_graph("bars", 16, 1, wave, 8, EPD_GRAPH_STYLE_BAR, golden_bars);
+    /* 无数据的列留空，曲线在此断开 */
+    check_graph("gap", 12, 1, gap, 12, EPD_GRAPH_STYLE_LINE, golden_gap);
+    /* 数据没有变化时显示在中间 */
+    check_graph("flat", 8, 1, flat, 4, EPD_GRAPH_STYLE_LINE, golden_flat);
+    /* 数据多于列数，每列显示4个数据的最小值到最大值 */
+    for (i = 0; i < 48; i++)
+    {
+        dense[i] = (i % 4) * 5 + i / 2;
+    }
+    check_graph("dense", 12, 1, dense, 48, EPD_GRAPH_STYLE_LINE, golden_dense);
+
+    TEST_CHECK(EPD_DrawGraph(0, 0, 8, 1, none, 4, EPD_GRAPH_STYLE_LINE) == 1, "no data");
+    TEST_CHECK(EPD_DrawGraph(0, 0, 0, 1, ramp, 16, EPD_GRAPH_STYLE_LINE) == 1, "zero width");
+    TEST_CHECK(EPD_DrawGraph(0, 0, 8, 17, ramp, 16, EPD_GRAPH_STYLE_LINE) == 1, "too high");
+    TEST_CHECK(EPD_DrawGraph(0, 0, EPD_GRAPH_BUFFER_SIZE / 2 + 1, 2, ramp, 16, EPD_GRAPH_STYLE_LINE) == 1, "buffer overflow");
+    TEST_END("graph");
+}
@@ -0,0 +1,130 @@
+#include "history.h"
+#include "fake_mem.h"
+#include "test.h"
+
+/*
+ * 从2000年到2199年逐小时加入采样，每小时两次，每小时检查24小时和7天统计。
+ * 覆盖小时时间戳超过16位、记录时间戳按HIST_STAMP_PERIOD回绕以及2100年不是闰年的情况。
+ */
+
+/* 第hour小时（2000年起）的采样值，单位为0.5度或0.5％，每小时第二次采样比第一次大1 */
+static int cel_of(uint32_t hour)
+{
+    return (int)((hour * 7) % 61) - 30;
+}
+
+static int rh_of(uint32_t hour)
+{
+    return (int)((hour * 13) % 101) + 40;
+}
+
+static uint8_t month_days(uint8_t year, uint8_t month)
+{
+    static const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    if (month == 2 && (year % 4) == 0 && year != 100)
+    {
+        return 29;
+    }
+    return days[month - 1];
+}
+
+static void next_hour(struct RTC_Time *time)
+{
+    if (++time->Hours < 24)
+    {
+        return;
+    }
+    time->Hours = 0;
+    if (++time->Date <= month_days(time->Year, time->Month))
+    {
+        return;
+    }
+    time->Date = 1;
+    if (++time->Month <= 12)
+    {
+        return;
+    }
+    time->Month = 1;
+    time->Year += 1;
+}
+
+/* 统计[first, last]小时内的最小值和最大值 */
+static void ref_range(uint32_t first, uint32_t last, int *cel_min, int *cel_max, int *rh_min, int *rh_max)
+{
+    uint32_t h;
+
+    *cel_min = 1000;
+    *cel_max = -1000;
+    *rh_min = 1000;
+    *rh_max = -1000;
+    for (h = first; h <= last; h++)
+    {
+        if (cel_of(h) < *cel_min)
+            *cel_min = cel_of(h);
+        if (cel_of(h) + 1 > *cel_max)
+            *cel_max = cel_of(h) + 1;
+        if (rh_of(h) < *rh_min)
+            *rh_min = rh_of(h);
+        if (rh_of(h) + 1 > *rh_max)
+            *rh_max = rh_of(h) + 1;
+    }
+}
+
+static void check_stats(const struct RTC_Time *time, uint32_t hour)
+{
+    struct HIST_Stats stats;
+    int16_t series[HIST_HOUR_COUNT];
+    int cel_min, cel_max, rh_min, rh_max;
+    uint32_t today;
+    uint8_t i;
+
+    ref_range(hour - (HIST_HOUR_COUNT - 1), hour, &cel_min, &cel_max, &rh_min, &rh_max);
+    TEST_CHECK(HIST_GetStats(time, HIST_RANGE_24H, &stats) == 0 && stats.Count == HIST_HOUR_COUNT,
+               "24h hour %u count %u", hour, stats.Count);
+    TEST_CHECK(stats.CEL_Min * 2 == cel_min && stats.CEL_Max * 2 == cel_max && stats.RH_Min * 2 == rh_min && stats.RH_Max * 2 == rh_max,
+               "24h hour %u min/max %g %g %g %g", hour, stats.CEL_Min, stats.CEL_Max, stats.RH_Min, stats.RH_Max);
+
+    today = hour - hour % 24;
+    ref_range(today - 24 * (HIST_DAY_COUNT - 1), hour, &cel_min, &cel_max, &rh_min, &rh_max);
+    TEST_CHECK(HIST_GetStats(time, HIST_RANGE_7D, &stats) == 0 && stats.Count == hour % 24 + HIST_DAY_COUNT,
+               "7d hour %u count %u", hour, stats.Count);
+    TEST_CHECK(stats.CEL_Min * 2 == cel_min && stats.CEL_Max * 2 == cel_max && stats.RH_Min * 2 == rh_min && stats.RH_Max * 2 == rh_max,
+               "7d hour %u min/max %g %g %g %g", hour, stats.CEL_Min, stats.CEL_Max, stats.RH_Min, stats.RH_Max);
+
+    TEST_CHECK(HIST_GetHourSeries(time, HIST_TYPE_CEL, series) == 0, "series hour %u", hour);
+    for (i = 0; i < HIST_HOUR_COUNT; i++)
+    {
+        /* 每小时平均值为两次采样的平均，向0取整 */
+        TEST_CHECK(series[i] == (cel_of(hour - (HIST_HOUR_COUNT - 1) + i) * 2 + 1) / 2,
+                   "series hour %u [%u] %d", hour, i, series[i]);
+    }
+}
+
+int main(void)
+{
+    struct RTC_Time time = {0, 0, 0, 1, 1, 1, 0, 0, 0};
+    struct TH_Value value;
+    uint32_t hour, stamp;
+
+    FAKE_ResetMem();
+    for (hour = 0; time.Year < 200; hour++, next_hour(&time))
+    {
+        stamp = HIST_GetHourStamp(&time);
+        TEST_CHECK(stamp == hour + 1, "stamp %u expect %u", stamp, hour + 1);
+        time.Minutes = 0;
+        value.CEL = cel_of(hour) / 2.0f;
+        value.RH = rh_of(hour) / 2.0f;
+        HIST_AddSample(&time, &value);
+        time.Minutes = 30;
+        value.CEL = (cel_of(hour) + 1) / 2.0f;
+        value.RH = (rh_of(hour) + 1) / 2.0f;
+        HIST_AddSample(&time, &value);
+        if (hour >= 24 * HIST_DAY_COUNT)
+        {
+            check_stats(&time, hour);
+        }
+    }
+    TEST_CHECK(hour > 65536 * 26, "hours %u", hour);
+    TEST_END("history");
+}
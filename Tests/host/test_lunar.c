@@ -0,0 +1,116 @@
+#include <string.h>
+#include "lunar.h"
+#include "fake_mem.h"
+#include "test.h"
+
+/*
+ * 从2000年到2199年逐日比较LUNAR_SolarToLunarCached()与完整计算LUNAR_SolarToLunar()的结果，
+ * 每天调用两次（模拟每分钟唤醒），再用伪随机的日期跳变检查完整计算的分支。
+ * 缓存键只有15位，相差32768天的日期键相同，所以不清除缓存的跳变限制在80年内，跨越200年的跳变先清除缓存（与设置时间后的处理相同）。
+ * 另外用几个已知的春节和闰月日期检查完整计算本身。
+ */
+
+static uint8_t month_days(uint16_t year, uint8_t month)
+{
+    static const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    if (month == 2 && (year % 4) == 0 && ((year % 100) != 0 || (year % 400) == 0))
+    {
+        return 29;
+    }
+    return days[month - 1];
+}
+
+static void next_day(uint16_t *year, uint8_t *month, uint8_t *date)
+{
+    if (++*date <= month_days(*year, *month))
+    {
+        return;
+    }
+    *date = 1;
+    if (++*month <= 12)
+    {
+        return;
+    }
+    *month = 1;
+    *year = (*year < 2199) ? *year + 1 : 2000;
+}
+
+static uint32_t random_next(uint32_t *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static void check_cached(uint16_t year, uint8_t month, uint8_t date)
+{
+    struct Lunar_Date full, cached;
+
+    LUNAR_SolarToLunar(&full, year, month, date);
+    LUNAR_SolarToLunarCached(&cached, year, month, date);
+    TEST_CHECK(full.Year == cached.Year && full.Month == cached.Month && full.IsLeap == cached.IsLeap && full.Date == cached.Date,
+               "%u-%u-%u full %u/%s%u/%u cached %u/%s%u/%u", year, month, date,
+               full.Year, full.IsLeap ? "L" : "", full.Month, full.Date, cached.Year, cached.IsLeap ? "L" : "", cached.Month, cached.Date);
+}
+
+static void check_known(uint16_t year, uint8_t month, uint8_t date, uint16_t lunar_year, uint8_t lunar_month, uint8_t is_leap, uint8_t lunar_date)
+{
+    struct Lunar_Date lunar;
+
+    LUNAR_SolarToLunar(&lunar, year, month, date);
+    TEST_CHECK(lunar.Year == lunar_year && lunar.Month == lunar_month && lunar.IsLeap == is_leap && lunar.Date == lunar_date,
+               "%u-%u-%u got %u/%s%u/%u", year, month, date, lunar.Year, lunar.IsLeap ? "L" : "", lunar.Month, lunar.Date);
+}
+
+int main(void)
+{
+    uint16_t year;
+    uint8_t month, date, invalidate;
+    uint32_t i, seed;
+
+    check_known(2000, 2, 5, 2000, 1, 0, 1);
+    check_known(2020, 1, 25, 2020, 1, 0, 1);
+    check_known(2020, 5, 23, 2020, 4, 1, 1);
+    check_known(2023, 3, 22, 2023, 2, 1, 1);
+    check_known(2024, 2, 10, 2024, 1, 0, 1);
+    check_known(2033, 12, 22, 2033, 11, 1, 1);
+
+    FAKE_ResetMem();
+    year = 2000;
+    month = 1;
+    date = 1;
+    do
+    {
+        check_cached(year, month, date);
+        check_cached(year, month, date);
+        next_day(&year, &month, &date);
+    } while (year != 2000 || month != 1 || date != 1);
+
+    for (invalidate = 0; invalidate < 2; invalidate++)
+    {
+        seed = 1;
+        for (i = 0; i < 200000; i++)
+        {
+            if (random_next(&seed) % 3 == 0) /* 时间跳变 */
+            {
+                year = 2000 + random_next(&seed) % (invalidate != 0 ? 200 : 80);
+                month = 1 + random_next(&seed) % 12;
+                date = 1 + random_next(&seed) % month_days(year, month);
+                if (invalidate != 0)
+                {
+                    LUNAR_InvalidateCache();
+                }
+            }
+            else
+            {
+                next_day(&year, &month, &date);
+            }
+            check_cached(year, month, date);
+        }
+    }
+
+    /* 超出表范围时与完整计算结果相同 */
+    check_cached(LUNAR_YEAR_MAX + 1, 1, 1);
+    check_cached(2024, 13, 1);
+    TEST_END("lunar");
+}
@@ -0,0 +1,284 @@
+#include "solarterm.h"
+#include "test.h"
+
+/*
+ * 用寿星万年历（资源/农历数据生成/农历数据表生成.htm）的qi_accurate()逐个计算2000年到2199年的节气时刻（北京时间），
+ * 检查TERM_GetTerm()在每个节气当天返回该节气、其他日期返回TERM_NONE，以及TERM_GetNext()到下一个节气的天数。
+ * 每个节气固定在第(序号 / 2 + 1)月，表中每个字符为节气的日期加'@'。
+ */
+
+static const char term_ref[200][25] = {
+    "FUDSETDTEUEUGVGWGWHWGVGU", /* 2000 */
+    "ETDRETETEUEUGWGWGWHWGVGV", /* 2001 */
+    "ETDSFUETFUFUGWHWHWHWGVGV", /* 2002 */
+    "FTDSFUETFUFVGWHWHWIXHWGV", /* 2003 */
+    "FUDSETDTEUEUGVGWGWHWGVGU", /* 2004 */
+    "ETDRETETEUEUGWGWGWHWGVGV", /* 2005 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2006 */
+    "FTDSFUETFUFVGWHWHWIXHWGV", /* 2007 */
+    "FUDSETDTEUEUGVGWGVHWGVGU", /* 2008 */
+    "ETDRETDTEUEUGWGWGWHWGVGV", /* 2009 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2010 */
+    "FTDSFUETFUFVGWHWHWHXHWGV", /* 2011 */
+    "FUDSETDTETEUGVGWGVHWGVGU", /* 2012 */
+    "ETDRETDTEUEUGVGWGWHWGVGV", /* 2013 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2014 */
+    "FTDSFUETFUFVGWHWHWHXHVGV", /* 2015 */
+    "FTDSETDSETEUGVGWGVHWGVGU", /* 2016 */
+    "ETCRETDTEUEUGVGWGWHWGVGV", /* 2017 */
+    "ETDSEUETEUFUGWGWHWHWGVGV", /* 2018 */
+    "ETDSFUETFUFUGWHWHWHXHVGV", /* 2019 */
+    "FTDSETDSETEUFVGVGVHWGVGU", /* 2020 */
+    "ETCRETDTEUEUGVGWGWHWGVGU", /* 2021 */
+    "ETDSETETEUFUGWGWGWHWGVGV", /* 2022 */
+    "ETDSFUETFUFUGWHWHWHXHVGV", /* 2023 */
+    "FTDSETDSETEUFVGVGVHWGVFU", /* 2024 */
+    "ETCRETDTEUEUGVGWGWHWGVGU", /* 2025 */
+    "ETDRETETEUEUGWGWGWHWGVGV", /* 2026 */
+    "ETDSFUETFUFUGWHWHWHWGVGV", /* 2027 */
+    "FTDSETDSETEUFVGVGVHWGVFU", /* 2028 */
+    "ETCRETDTEUEUGVGWGWHWGVGU", /* 2029 */
+    "ETDRETETEUEUGWGWGWHWGVGV", /* 2030 */
+    "ETDSFUETFUFUGWHWHWHWGVGV", /* 2031 */
+    "FTDSETDSETEUFVGVGVHWGVFU", /* 2032 */
+    "ETCRETDTEUEUGVGWGWHWGVGU", /* 2033 */
+    "ETDRETETEUEUGWGWGWHWGVGV", /* 2034 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2035 */
+    "FTDSETDSETEUFVGVGVHWGVFU", /* 2036 */
+    "ETCRETDTEUEUGVGWGWHWGVGU", /* 2037 */
+    "ETDRETETEUEUGWGWGWHWGVGV", /* 2038 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2039 */
+    "FTDSETDSETEUFVGVGVHWGVFU", /* 2040 */
+    "ETCRETDTETEUGVGWGVHWGVGU", /* 2041 */
+    "ETDRETDTEUEUGWGWGWHWGVGV", /* 2042 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2043 */
+    "FTDSETDSETEUFVGVGVGWGVFU", /* 2044 */
+    "ETCRETDSETEUGVGWGVHWGVGU", /* 2045 */
+    "ETDRETDTEUEUGVGWGWHWGVGV", /* 2046 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2047 */
+    "FTDSETDSETETFVGVGVGWGUFU", /* 2048 */
+    "ESCRETDSETEUFVGVGVHWGVGU", /* 2049 */
+    "ETCRETDTEUEUGVGWGWHWGVGV", /* 2050 */
+    "ETDSETETEUFUGWGWGWHWGVGV", /* 2051 */
+    "ETDSETDSETETFVGVGVGWGUFU", /* 2052 */
+    "ESCRETDSETEUFVGVGVHWGVGU", /* 2053 */
+    "ETCRETDTEUEUGVGWGWHWGVGV", /* 2054 */
+    "ETDSETETEUEUGWGWGWHWGVGV", /* 2055 */
+    "ETDSETDSETETFVGVGVGWGUFU", /* 2056 */
+    "ESCRETDSETEUFVGVGVHWGVFU", /* 2057 */
+    "ETCRETDTEUEUGVGWGWHWGVGU", /* 2058 */
+    "ETDSETETEUEUGWGWGWHWGVGV", /* 2059 */
+    "ETDSETDSETETFVGVGVGVFUFU", /* 2060 */
+    "ESCRETDSETEUFVGVGVHWGVFU", /* 2061 */
+    "ETCRETDTEUEUGVGWGWHWGVGU", /* 2062 */
+    "ETDRETETEUEUGWGWGWHWGVGV", /* 2063 */
+    "ETDSETDSETETFVGVGVGVFUFU", /* 2064 */
+    "ESCRETDSETEUFVGVGVHWGVFU", /* 2065 */
+    "ETCRETDTEUEUGVGWGWHWGVGU", /* 2066 */
+    "ETDRETETEUEUGWGWGWHWGVGV", /* 2067 */
+    "ETDSETDSDTETFVFVGVGVFUFU", /* 2068 */
+    "ESCRETDSETEUFVGVGVHWGVFU", /* 2069 */
+    "ETCRETDTETEUGVGWGVHWGVGU", /* 2070 */
+    "ETDRETETEUEUGWGWGWHWGVGV", /* 2071 */
+    "ETDSETDSDTETFVFVGVGVFUFU", /* 2072 */
+    "ESCRETDSETEUFVGVGVGWGVFU", /* 2073 */
+    "ETCRETDTETEUGVGWGVHWGVGU", /* 2074 */
+    "ETDRETDTEUEUGVGWGWHWGVGV", /* 2075 */
+    "ETDSETDSDTETFVFVGVGVFUFU", /* 2076 */
+    "ESCRETDSETEUFVGVGVGWGVFU", /* 2077 */
+    "ETCRETDSETEUFVGWGVHWGVGU", /* 2078 */
+    "ETDRETDTEUEUGVGWGWHWGVGV", /* 2079 */
+    "ETDSETDSDTETFVFVGVGVFUFU", /* 2080 */
+    "ESCRETDSETETFVGVGVGWGUFU", /* 2081 */
+    "ETCRETDSETEUFVGVGVHWGVGU", /* 2082 */
+    "ETCRETDTEUEUGVGWGWHWGVGV", /* 2083 */
+    "ETDSDSDSDTETFVFVFVGVFUFU", /* 2084 */
+    "DSCRETDSETETFVGVGVGWGUFU", /* 2085 */
+    "ESCRETDSETEUFVGVGVHWGVGU", /* 2086 */
+    "ETCRETDTEUEUGVGWGWHWGVGV", /* 2087 */
+    "ETDSDSDSDTDTFVFVFVGVFUFU", /* 2088 */
+    "DSCRETDSETETFVGVGVGWGUFU", /* 2089 */
+    "ESCRETDSETEUFVGVGVHWGVFU", /* 2090 */
+    "ETCRETDTEUEUGVGWGWHWGVGU", /* 2091 */
+    "ETDSDSDSDTDTFVFVFVGVFUFU", /* 2092 */
+    "DSCRETDSETETFVGVGVGVFUFU", /* 2093 */
+    "ESCRETDSETEUFVGVGVHWGVFU", /* 2094 */
+    "ETCRETDTEUEUGVGWGWHWGVGU", /* 2095 */
+    "ETDRDSDSDTDTFVFVFVGVFUFU", /* 2096 */
+    "DSCRETDSETETFVFVGVGVFUFU", /* 2097 */
+    "ESCRETDSETEUFVGVGVHWGVFU", /* 2098 */
+    "ETCRETDTEUEUGVGWGWHWGVGU", /* 2099 */
+    "ETDRETETEUEUGWGWGWHWGVGV", /* 2100 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2101 */
+    "FTDSFUETFUFVGWHWHWIXHWGV", /* 2102 */
+    "FUDSFUEUFUFVHWHXHWIXHWHV", /* 2103 */
+    "FUESETDTEUEUGVGWGWHWGVGV", /* 2104 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2105 */
+    "FTDSFUETFUFVGWHWHWHXHWGV", /* 2106 */
+    "FUDSFUEUFUFVGWHXHWIXHWHV", /* 2107 */
+    "FUESETDTEUEUGVGWGWHWGVGV", /* 2108 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2109 */
+    "FTDSFUETFUFUGWHWHWHXHWGV", /* 2110 */
+    "FUDSFUETFUFVGWHWHWIXHWHV", /* 2111 */
+    "FUESETDTEUEUGVGWGWHWGVGV", /* 2112 */
+    "ETDSFUETEUFUGWGWGWHWGVGV", /* 2113 */
+    "FTDSFUETFUFUGWHWHWHXHVGV", /* 2114 */
+    "FUDSFUETFUFVGWHWHWIXHWHV", /* 2115 */
+    "FUESETDTEUEUGVGWGWHWGVGV", /* 2116 */
+    "ETDSEUETEUEUGWGWGWHWGVGV", /* 2117 */
+    "FTDSFUETFUFUGWHWHWHXHVGV", /* 2118 */
+    "FTDSFUETFUFVGWHWHWIXHWHV", /* 2119 */
+    "FUDSETDTEUEUGVGWGWHWGVGV", /* 2120 */
+    "ETDSETETEUEUGWGWGWHWGVGV", /* 2121 */
+    "ETDSFUETFUFUGWHWHWHWHVGV", /* 2122 */
+    "FTDSFUETFUFVGWHWHWIXHWGV", /* 2123 */
+    "FUDSETDTEUEUGVGWGWHWGVGU", /* 2124 */
+    "ETDSETETEUEUGWGWGWHWGVGV", /* 2125 */
+    "ETDSFUETFUFUGWGWHWHWGVGV", /* 2126 */
+    "FTDSFUETFUFVGWHWHWIXHWGV", /* 2127 */
+    "FUDSETDTEUEUGVGWGWHWGVGU", /* 2128 */
+    "ETDRETETEUEUGWGWGWHWGVGV", /* 2129 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2130 */
+    "FTDSFUETFUFVGWHWHWIXHWGV", /* 2131 */
+    "FUDSETDTETEUGVGWGVHWGVGU", /* 2132 */
+    "ETDRETETEUEUGVGWGWHWGVGV", /* 2133 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2134 */
+    "FTDSFUETFUFVGWHWHWIXHWGV", /* 2135 */
+    "FUDSETDTETEUFVGWGVHWGVGU", /* 2136 */
+    "ETDRETDTEUEUGVGWGWHWGVGV", /* 2137 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2138 */
+    "FTDSFUETFUFUGWHWHWHXHWGV", /* 2139 */
+    "FUDSETDSETEUFVGVGVHWGVGU", /* 2140 */
+    "ETDRETDTEUEUGVGWGWHWGVGV", /* 2141 */
+    "ETDSFUETEUFUGWGWGWHWGVGV", /* 2142 */
+    "FTDSFUETFUFUGWHWHWHXHWGV", /* 2143 */
+    "FUDSETDSETEUFVGVGVHWGVGU", /* 2144 */
+    "ETDRETDTEUEUGVGWGWHWGVGV", /* 2145 */
+    "ETDSFUETEUEUGWGWGWHWGVGV", /* 2146 */
+    "FTDSFUETFUFUGWHWHWHXHVGV", /* 2147 */
+    "FUDSETDSETEUFVGVGVHWGVGU", /* 2148 */
+    "ETDRETDTEUEUGVGWGWHWGVGV", /* 2149 */
+    "ETDSEUETEUEUGWGWGWHWGVGV", /* 2150 */
+    "FTDSFUETFUFUGWHWHWHXHVGV", /* 2151 */
+    "FTDSETDSETEUFVGVGVHWGVGU", /* 2152 */
+    "ETCRETDTEUEUGVGWGWHWGVGV", /* 2153 */
+    "ETDSETETEUEUGWGWGWHWGVGV", /* 2154 */
+    "ETDSFUETFUFUGWGWHWHWHVGV", /* 2155 */
+    "FTDSETDSETEUFVGVGVHWGVFU", /* 2156 */
+    "ETCRETDTEUEUGVGWGWHWGVGU", /* 2157 */
+    "ETDSETETEUEUGWGWGWHWGVGV", /* 2158 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2159 */
+    "FTDSETDSETEUFVGVGVHWGVFU", /* 2160 */
+    "ETCRETDTETEUGVGWGWHWGVGU", /* 2161 */
+    "ETDRETETEUEUGVGWGWHWGVGV", /* 2162 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2163 */
+    "FTDSETDSETEUFVGVGVHWGVFU", /* 2164 */
+    "ETCRETDTETEUFVGWGVHWGVGU", /* 2165 */
+    "ETDRETETEUEUGVGWGWHWGVGV", /* 2166 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2167 */
+    "FTDSETDSETEUFVGVGVGWGVFU", /* 2168 */
+    "ETCRETDTETEUFVGWGVHWGVGU", /* 2169 */
+    "ETDRETDTEUEUGVGWGWHWGVGV", /* 2170 */
+    "ETDSFUETEUFUGWGWHWHWGVGV", /* 2171 */
+    "FTDSETDSETETFVGVGVGWGVFU", /* 2172 */
+    "ETCRETDSETEUFVGVGVHWGVGU", /* 2173 */
+    "ETDRETDTEUEUGVGWGWHWGVGV", /* 2174 */
+    "ETDSFUETEUEUGWGWGWHWGVGV", /* 2175 */
+    "FTDSETDSETETFVGVGVGWGVFU", /* 2176 */
+    "ETCRETDSETEUFVGVGVHWGVGU", /* 2177 */
+    "ETDRETDTEUEUGVGWGWHWGVGV", /* 2178 */
+    "ETDSFUETEUEUGWGWGWHWGVGV", /* 2179 */
+    "FTDSETDSETETFVGVGVGWGUFU", /* 2180 */
+    "ETCRETDSETEUFVGVGVHWGVGU", /* 2181 */
+    "ETDRETDTEUEUGVGWGWHWGVGV", /* 2182 */
+    "ETDSETETEUEUGWGWGWHWGVGV", /* 2183 */
+    "FTDSETDSETETFVGVGVGWGUFU", /* 2184 */
+    "ETCRETDSETEUFVGVGVHWGVGU", /* 2185 */
+    "ETCRETDTEUEUGVGWGWHWGVGV", /* 2186 */
+    "ETDSETETEUEUGWGWGWHWGVGV", /* 2187 */
+    "FTDSETDSETETFVFVGVGVGUFU", /* 2188 */
+    "ESCRETDSETEUFVGVGVHWGVGU", /* 2189 */
+    "ETCRETDTEUEUGVGWGWHWGVGV", /* 2190 */
+    "ETDSETETEUEUGWGWGWHWGVGV", /* 2191 */
+    "ETDSETDSDTETFVFVGVGVFUFU", /* 2192 */
+    "ESCRETDSETEUFVGVGVHWGVFU", /* 2193 */
+    "ETCRETDTETEUFVGWGVHWGVGU", /* 2194 */
+    "ETDRETETEUEUGVGWGWHWGVGV", /* 2195 */
+    "ETDSETDSDTETFVFVGVGVFUFU", /* 2196 */
+    "ESCRETDSETETFVGVGVHWGVFU", /* 2197 */
+    "ETCRETDTETEUFVGWGVHWGVGU", /* 2198 */
+    "ETDRETDTEUEUGVGWGWHWGVGV" /* 2199 */};
+
+#define TERM_REF_2200_XIAOHAN 5 /* 2200年小寒为1月5日 */
+
+static uint8_t month_days(uint16_t year, uint8_t month)
+{
+    static const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    if (month == 2 && (year % 4) == 0 && ((year % 100) != 0 || (year % 400) == 0))
+    {
+        return 29;
+    }
+    return days[month - 1];
+}
+
+/* 参考表中year年term节气的日期 */
+static uint8_t ref_date(uint16_t year, uint8_t term)
+{
+    if (year == TERM_YEAR_MAX + 1)
+    {
+        return TERM_REF_2200_XIAOHAN;
+    }
+    return term_ref[year - TERM_YEAR_MIN][term] - '@';
+}
+
+int main(void)
+{
+    uint16_t year, next_year;
+    uint8_t month, date, days, term, next, next_month, expect;
+
+    for (year = TERM_YEAR_MIN; year <= TERM_YEAR_MAX; year++)
+    {
+        for (month = 1; month <= 12; month++)
+        {
+            for (date = 1; date <= month_days(year, month); date++)
+            {
+                /* 当天或之后的第一个节气 */
+                next_year = year;
+                next = (month - 1) * 2;
+                if (date > ref_date(year, next))
+                {
+                    next += 1;
+                }
+                if (date > ref_date(year, next)) /* 本月两个节气都已过去，下一个为下月第一个节气 */
+                {
+                    next += 1;
+                    if (next == 24)
+                    {
+                        next = 0;
+                        next_year += 1;
+                    }
+                }
+                next_month = next / 2 + 1;
+                if (next_month == month)
+                {
+                    expect = ref_date(next_year, next) - date;
+                }
+                else
+                {
+                    expect = month_days(year, month) - date + ref_date(next_year, next);
+                }
+
+                term = TERM_GetNext(year, month, date, &days);
+                TEST_CHECK(term == next && days == expect, "%u-%u-%u next %u in %u, expect %u in %u", year, month, date, term, days, next, expect);
+                term = TERM_GetTerm(year, month, date);
+                TEST_CHECK(term == (expect == 0 ? next : TERM_NONE), "%u-%u-%u term %u", year, month, date, term);
+            }
+        }
+    }
+
+    TEST_CHECK(TERM_GetNext(TERM_YEAR_MIN - 1, 12, 31, &days) == TERM_NONE, "before range");
+    TEST_CHECK(TERM_GetNext(TERM_YEAR_MAX + 1, 1, 1, &days) == TERM_NONE, "after range");
+    TEST_CHECK(TERM_GetNext(2024, 13, 1, &days) == TERM_NONE, "bad month");
+    TEST_END("solarterm");
+}
@@ -0,0 +1,236 @@
+# -*- coding: utf-8 -*-
+# 通过串口的二进制模式读取时钟的全部数据，需要pyserial（pip install pyserial）
+# 用法：python 串口数据读取.py 串口号 [输出目录]          读取EEPROM、备份寄存器、RTC寄存器、历史记录和事件记录
+#       python 串口数据读取.py 串口号 --write-eeprom 地址 文件   将文件写入EEPROM的指定地址
+#       python 串口数据读取.py --decode-log eeprom.bin           从保存的EEPROM数据中解码事件记录，不需要连接时钟
+# 时钟每次唤醒时检测串口适配器，连接后最多等待1分钟（或按“设置”键唤醒）才会响应。
+# 帧格式和请求类型见Src/USER/frame.h和func.c中的“二进制数据交换”。
+import os
+import struct
+import sys
+import time
+
+import serial
+
+BAUDRATE = 115200
+FRAME_SOF = 0xA5
+FRAME_PAYLOAD_MAX = 130
+TYPE_PING = 0x01
+TYPE_READ_EEPROM = 0x02
+TYPE_WRITE_EEPROM = 0x03
+TYPE_READ_BKPR = 0x04
+TYPE_READ_RTC = 0x06
+TYPE_READ_HISTORY = 0x08
+TYPE_READ_LOG = 0x09
+TYPE_EXIT = 0x7E
+TYPE_ERROR = 0x7F
+TYPE_REPLY = 0x80
+ERROR_NAMES = {1: '未知的类型', 2: '数据长度错误', 3: '超出范围', 4: '读写失败', 5: 'CRC错误'}
+EVENT_NAMES = {1: 'RESET', 2: 'SETTING_RESET', 3: 'LOW_BATTERY', 4: 'I2C_RECOVER', 5: 'EPD_TIMEOUT', 6: 'SENSOR_FAIL', 7: 'ALARM', 8: 'I2C_FAIL'}
+EEPROM_SIZE = 2048
+BKPR_SIZE = 20
+RTC_REG_COUNT = 0x13
+HIST_HOUR_COUNT = 24
+HIST_DAY_COUNT = 7
+CHUNK = 128
+LOG_EEPROM_ADDR_DWORD = 0x140  # 与Src/USER/eventlog.h、eventlog.c相同
+LOG_BLOCK_COUNT = 11
+LOG_BLOCK_DWORDS = 16
+LOG_BLOCK_MARK = 0x4C47
+LOG_DATA_START = 8
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE，与frame.c相同"""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class Clock:
+    def __init__(self, port):
+        self.ser = serial.Serial(port, BAUDRATE, timeout=1)
+
+    def enter_binary(self, wait_s=70):
+        """发送空行唤醒串口命令行，收到回复后进入二进制模式"""
+        deadline = time.time() + wait_s
+        while time.time() < deadline:
+            self.ser.reset_input_buffer()
+            self.ser.write(b'\r\n')
+            time.sleep(0.05)  # 从Stop模式唤醒期间收到的数据可能丢失
+            self.ser.write(b'binary\r\n')
+            line = self.ser.readline()
+            while line and line.strip() != b'BINARY':
+                line = self.ser.readline()
+            if line:
+                return
+        sys.exit('时钟没有响应，请确认串口适配器已连接')
+
+    def request(self, frame_type, data=b''):
+        body = bytes([frame_type, len(data)]) + data
+        self.ser.write(bytes([FRAME_SOF]) + body + struct.pack('<H', crc16(body)))
+        while True:
+            sof = self.ser.read(1)
+            if not sof:
+                raise IOError('等待回复超时')
+            if sof[0] == FRAME_SOF:
+                break
+        head = self.ser.read(2)
+        reply = self.ser.read(head[1] + 2) if len(head) == 2 else b''
+        if len(reply) != (head[1] + 2 if len(head) == 2 else -1):
+            raise IOError('回复不完整')
+        if crc16(head + reply[:-2]) != struct.unpack('<H', reply[-2:])[0]:
+            raise IOError('回复CRC错误')
+        payload = reply[:-2]
+        if head[0] == TYPE_ERROR:
+            raise IOError('请求0x%02X失败：%s' % (payload[0], ERROR_NAMES.get(payload[1], payload[1])))
+        if head[0] != frame_type | TYPE_REPLY:
+            raise IOError('回复类型错误：0x%02X' % head[0])
+        return payload
+
+    def exit_binary(self):
+        self.request(TYPE_EXIT)
+        self.ser.readline()  # binary命令的"OK"
+
+    def ping(self):
+        return self.request(TYPE_PING).decode('ascii', 'replace')
+
+    def read_eeprom(self):
+        data = b''
+        for addr in range(0, EEPROM_SIZE, CHUNK):
+            data += self.request(TYPE_READ_EEPROM, struct.pack('<HB', addr, CHUNK))[2:]
+        return data
+
+    def write_eeprom(self, addr, data):
+        for offset in range(0, len(data), CHUNK):
+            self.request(TYPE_WRITE_EEPROM, struct.pack('<H', addr + offset) + data[offset:offset + CHUNK])
+
+    def read_bkpr(self):
+        return self.request(TYPE_READ_BKPR, bytes([0, BKPR_SIZE]))[1:]
+
+    def read_rtc(self):
+        return self.request(TYPE_READ_RTC, bytes([0, RTC_REG_COUNT]))[1:]
+
+    def read_history(self, day, count):
+        payload = self.request(TYPE_READ_HISTORY, bytes([day, 0, count]))[2:]
+        return [struct.unpack_from('<HbbbBBB', payload, i) for i in range(0, len(payload), 8)]
+
+    def read_log(self):
+        entries, cursor = [], 0
+        while True:
+            payload = self.request(TYPE_READ_LOG, struct.pack('<H', cursor))
+            cursor = struct.unpack_from('<H', payload)[0]
+            if len(payload) == 2:
+                return entries
+            entries += [struct.unpack_from('<IBI', payload, i) for i in range(2, len(payload), 9)]
+
+
+def varint_read(data, pos, end):
+    value, shift = 0, 0
+    while pos < end:
+        byte = data[pos]
+        pos += 1
+        if shift < 32:
+            value |= (byte & 0x7F) << shift
+        shift += 7
+        if byte & 0x80 == 0:
+            break
+    return value & 0xFFFFFFFF, pos
+
+
+def decode_log(eeprom):
+    """按eventlog.c的格式直接解码EEPROM中的事件记录块，顺序与LOG_ReadNext()相同，返回(分钟数+1, 事件, 参数)列表"""
+    blocks, newest = [], None
+    for block in range(LOG_BLOCK_COUNT):
+        addr = (LOG_EEPROM_ADDR_DWORD + block * LOG_BLOCK_DWORDS) * 4
+        seq, mark, base = struct.unpack_from('<HHI', eeprom, addr)
+        blocks.append((addr, mark == LOG_BLOCK_MARK, base))
+        # 序号为16位，按回绕比较，与find_newest()相同
+        if mark == LOG_BLOCK_MARK and (newest is None or 0 < ((seq - newest_seq) & 0xFFFF) < 0x8000):
+            newest, newest_seq = block, seq
+    entries = []
+    if newest is None:
+        return entries
+    for index in range(LOG_BLOCK_COUNT):
+        addr, valid, base = blocks[(newest + 1 + index) % LOG_BLOCK_COUNT]
+        if not valid:
+            continue
+        pos, end = addr + LOG_DATA_START, addr + LOG_BLOCK_DWORDS * 4
+        while pos < end and eeprom[pos] != 0:
+            event = eeprom[pos]
+            delta, pos = varint_read(eeprom, pos + 1, end)
+            arg, pos = varint_read(eeprom, pos, end)
+            entries.append(((base + delta) & 0xFFFFFFFF if base != 0 else 0, event, arg))
+    return entries
+
+
+def print_log(entries):
+    for minutes, event, arg in entries:
+        print('  %s  %-14s 0x%08X' % (minutes_to_text(minutes), EVENT_NAMES.get(event, '0x%02X' % event), arg))
+
+
+def minutes_to_text(minutes):
+    if minutes == 0:
+        return '----/--/-- --:--'
+    return time.strftime('%Y/%m/%d %H:%M', time.gmtime(946684800 + (minutes - 1) * 60))  # 固件保存的是分钟数+1
+
+
+def print_history(name, records):
+    print(name)
+    for slot, (stamp, t_min, t_max, t_avg, rh_min, rh_max, rh_avg) in enumerate(records):
+        if stamp != 0:
+            print('  %2d  %5d  T %5.1f %5.1f %5.1f  RH %5.1f %5.1f %5.1f' % (
+                slot, stamp, t_min / 2, t_max / 2, t_avg / 2, rh_min / 2, rh_max / 2, rh_avg / 2))
+
+
+def dump_all(clock, out_dir):
+    start = time.time()
+    version = clock.ping()
+    eeprom = clock.read_eeprom()
+    bkpr = clock.read_bkpr()
+    rtc = clock.read_rtc()
+    hours = clock.read_history(0, HIST_HOUR_COUNT)
+    days = clock.read_history(1, HIST_DAY_COUNT)
+    log = clock.read_log()
+    elapsed = time.time() - start
+
+    os.makedirs(out_dir, exist_ok=True)
+    for name, data in (('eeprom.bin', eeprom), ('bkpr.bin', bkpr), ('rtc.bin', rtc)):
+        open(os.path.join(out_dir, name), 'wb').write(data)
+    print('版本：%s，读取用时%.2f秒，已保存到%s' % (version, elapsed, out_dir))
+    print('RTC寄存器：' + ' '.join('%02X' % b for b in rtc))
+    print('备份寄存器：' + ' '.join('%02X' % b for b in bkpr))
+    print_history('小时记录：', hours)
+    print_history('日记录：', days)
+    print('事件记录：')
+    print_log(log)
+    if decode_log(eeprom) != log:
+        print('警告：EEPROM中直接解码的事件记录与时钟返回的不一致，可能在读取期间有新记录')
+
+
+def main():
+    if len(sys.argv) == 3 and sys.argv[1] == '--decode-log':
+        print('事件记录：')
+        print_log(decode_log(open(sys.argv[2], 'rb').read()))
+        return
+    if len(sys.argv) < 2:
+        sys.exit('用法：python 串口数据读取.py 串口号 [输出目录 | --write-eeprom 地址 文件] 或 --decode-log eeprom.bin')
+    clock = Clock(sys.argv[1])
+    clock.enter_binary()
+    try:
+        if len(sys.argv) == 5 and sys.argv[2] == '--write-eeprom':
+            data = open(sys.argv[4], 'rb').read()
+            clock.write_eeprom(int(sys.argv[3], 0), data)
+            print('已写入%d字节' % len(data))
+        else:
+            dump_all(clock, sys.argv[2] if len(sys.argv) > 2 else 'dump')
+    finally:
+        clock.exit_binary()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,138 @@
+// 运行农历数据表生成.htm中的寿星万年历算法，将每年的农历数据压缩为3字节，生成Src/USER/lunar_table.h
+// 用法：node 农历数据压缩.js [旧的lunar.c]
+// 指定旧的lunar.c（包含lunar_month_days和solar_1_1两个表）时，与旧表重叠的年份逐年比较
+'use strict';
+const fs = require('fs');
+const path = require('path');
+const vm = require('vm');
+
+const DIR = __dirname;
+const HTM_FILE = path.join(DIR, '农历数据表生成.htm');
+const OUT_FILE = path.join(DIR, '..', '..', 'Src', 'USER', 'lunar_table.h');
+const YEAR_MIN = 1900; // 与lunar.h中的LUNAR_YEAR_MIN、LUNAR_YEAR_MAX一致
+const YEAR_MAX = 2299;
+const TABLE_YEAR = YEAR_MIN - 1; // 公历1900年1月的日期属于农历1899年
+
+function fail(msg) {
+    console.error(msg);
+    process.exit(1);
+}
+
+// 读取calcNianLi()输出格式的表，第一个元素为表中第一年减1
+function readArray(text, name) {
+    const m = new RegExp(name + '\\[\\] = \\{(.*?)\\}', 's').exec(text);
+    if (!m) fail('找不到' + name);
+    const values = m[1].split(',').map(s => parseInt(s.trim()));
+    return { first: values[0] + 1, data: values.slice(1) };
+}
+
+function runHtm() {
+    const html = fs.readFileSync(HTM_FILE, 'utf8');
+    const scripts = [...html.matchAll(/<script[^>]*>([\s\S]*?)<\/script>/g)].map(m => m[1]);
+    // 网页脚本加载时会访问document等对象，这里用空对象代替
+    const stub = new Proxy(function () { }, {
+        get: (t, k) => (k === Symbol.toPrimitive ? () => '' : stub),
+        apply: () => stub,
+        construct: () => stub,
+        set: () => true,
+    });
+    const ctx = {
+        document: stub, navigator: { userAgent: '' }, alert: () => { }, escape, unescape,
+        beginYear: { value: String(TABLE_YEAR + 2) }, endYear: { value: String(YEAR_MAX) }, Cal7: {},
+    };
+    ctx.window = ctx;
+    vm.createContext(ctx);
+    scripts.forEach(s => vm.runInContext(s, ctx));
+    const text = vm.runInContext('calcNianLi()', ctx);
+    if (text.indexOf('wrong') >= 0) fail(text);
+    return { months: readArray(text, 'lunar_month_days'), solar11: readArray(text, 'solar_1_1') };
+}
+
+function dayNumber(y, m, d) {
+    return Date.UTC(y, m - 1, d) / 86400000;
+}
+
+// 农历年数据：位16 ~ 13为闰月，位12 ~ 0为各月大小；正月初一为公历年内的第几天（从0开始）
+function buildYears(raw) {
+    const years = [];
+    for (let y = TABLE_YEAR; y <= YEAR_MAX + 1; y++) {
+        const i = y - raw.months.first;
+        const months = raw.months.data[i];
+        const s = raw.solar11.data[i];
+        if (months === undefined || s === undefined) fail(y + '年没有数据');
+        if ((s >> 9) !== y) fail(y + '年的正月初一年份错误');
+        const newYear = dayNumber(y, (s >> 5) & 0xF, s & 0x1F) - dayNumber(y, 1, 1);
+        years.push({ year: y, months, newYear });
+    }
+    return years;
+}
+
+function check(years) {
+    for (let i = 0; i + 1 < years.length; i++) {
+        const y = years[i];
+        const leap = (y.months >> 13) & 0xF;
+        if (y.months >> 17 || leap > 12) fail(y.year + '年的月份数据超出范围');
+        if (leap === 0 && (y.months & 1)) fail(y.year + '年没有闰月，但第13个月不为0');
+        if (y.newYear >= 64) fail(y.year + '年的正月初一超出6位');
+        // 一年各月天数之和必须等于相邻两个正月初一的间隔
+        let days = 0;
+        for (let k = 0; k < (leap ? 13 : 12); k++) {
+            days += 29 + ((y.months >> (12 - k)) & 1);
+        }
+        const next = years[i + 1];
+        const gap = dayNumber(next.year, 1, 1) + next.newYear - dayNumber(y.year, 1, 1) - y.newYear;
+        if (days !== gap) fail(y.year + '年的天数与正月初一不符');
+    }
+}
+
+function compareOld(years, file) {
+    const text = fs.readFileSync(file, 'utf8');
+    const months = readArray(text, 'lunar_month_days');
+    const solar11 = readArray(text, 'solar_1_1');
+    let count = 0;
+    years.forEach(y => {
+        const i = y.year - months.first;
+        if (i < 0 || i >= months.data.length) return;
+        const s = solar11.data[i];
+        const newYear = dayNumber(s >> 9, (s >> 5) & 0xF, s & 0x1F) - dayNumber(y.year, 1, 1);
+        if (months.data[i] !== y.months || newYear !== y.newYear) fail(y.year + '年与旧表不同');
+        count++;
+    });
+    console.log('与旧表比较' + count + '年，全部相同');
+}
+
+function hex(v) {
+    return '0x' + v.toString(16).toUpperCase().padStart(2, '0');
+}
+
+function write(years) {
+    const bytes = [];
+    years.filter(y => y.year <= YEAR_MAX).forEach(y => {
+        const v = (y.newYear << 17) | y.months;
+        bytes.push(hex((v >> 16) & 0xFF), hex((v >> 8) & 0xFF), hex(v & 0xFF));
+    });
+    const lines = [];
+    for (let i = 0; i < bytes.length; i += 24) {
+        lines.push('    ' + bytes.slice(i, i + 24).join(', '));
+    }
+    const out = '/* 此文件由 资源/农历数据生成/农历数据压缩.js 根据 农历数据表生成.htm 生成，不要手动修改 */\n' +
+        '#ifndef _LUNAR_TABLE_H_\n' +
+        '#define _LUNAR_TABLE_H_\n' +
+        '\n' +
+        '#define LUNAR_TABLE_YEAR ' + TABLE_YEAR + ' /* 表中第一年 */\n' +
+        '\n' +
+        '/* ' + TABLE_YEAR + ' ~ ' + YEAR_MAX + '，每年3字节 */\n' +
+        'const static uint8_t lunar_year_data[] = {\n' +
+        lines.join(',\n') + '};\n' +
+        '\n' +
+        '#endif\n';
+    fs.writeFileSync(OUT_FILE, out);
+    console.log('已生成' + OUT_FILE + '，' + bytes.length + '字节');
+}
+
+const years = buildYears(runHtm());
+check(years);
+if (process.argv[2]) {
+    compareOld(years, process.argv[2]);
+}
+write(years);
@@ -0,0 +1,122 @@
+# -*- coding: utf-8 -*-
+# 根据节日规则.txt生成Src/USER/festival_table.h，用法：python 节日数据生成.py
+import os
+import re
+import sys
+
+DIR = os.path.dirname(os.path.abspath(__file__))
+USER_DIR = os.path.join(DIR, '..', '..', 'Src', 'USER')
+RULE_FILE = os.path.join(DIR, '节日规则.txt')
+OUT_FILE = os.path.join(USER_DIR, 'festival_table.h')
+NAME_SIZE = 10  # 3个汉字 + 结束符
+
+
+def error(line_no, msg):
+    sys.exit('节日规则.txt 第%d行：%s' % (line_no, msg))
+
+
+def read_term_names():
+    text = open(os.path.join(USER_DIR, 'solarterm.h'), encoding='utf-8').read()
+    block = re.search(r'Term_NameString\[24\]\[\d+\] = \{(.*?)\};', text, re.S).group(1)
+    names = re.findall(r'"(.*?)"', block)
+    assert len(names) == 24
+    return names
+
+
+def read_font_chars():
+    text = open(os.path.join(USER_DIR, 'gdeh029a1.h'), encoding='utf-8').read()
+    start = text.index('EPD_FontUTF8_16x16_B[]')
+    end = text.index('};', start)
+    return set(re.findall(r'UNICODE索引 - (.)', text[start:end]))
+
+
+def parse_rules(term_names, font_chars):
+    rules = {'公历': {}, '农历': {}, '星期': {}, '节气': {}}
+    for line_no, line in enumerate(open(RULE_FILE, encoding='utf-8'), 1):
+        line = line.split('#')[0].strip()
+        if not line:
+            continue
+        item = line.split()
+        kind = item[0]
+        if kind not in rules:
+            error(line_no, '未知的规则类型 %s' % kind)
+        try:
+            if kind == '公历' and len(item) == 4:
+                month, day, name = int(item[1]), int(item[2]), item[3]
+                if not (1 <= month <= 12 and 1 <= day <= 31):
+                    error(line_no, '日期超出范围')
+                key = (month, day)
+            elif kind == '农历' and len(item) == 4:
+                month, day, name = int(item[1]), int(item[2]), item[3]
+                if not (1 <= month <= 12 and 0 <= day <= 30):
+                    error(line_no, '日期超出范围')
+                key = (month, day)
+            elif kind == '星期' and len(item) == 5:
+                month, nth, week, name = int(item[1]), int(item[2]), int(item[3]), item[4]
+                if not (1 <= month <= 12 and 1 <= nth <= 4 and 1 <= week <= 7):
+                    error(line_no, '日期超出范围')
+                key = (month, (nth - 1) * 7 + week - 1)
+            elif kind == '节气' and len(item) == 3:
+                if item[1] not in term_names:
+                    error(line_no, '未知的节气 %s' % item[1])
+                key, name = (1, term_names.index(item[1])), item[2]
+            else:
+                error(line_no, '格式错误')
+        except ValueError:
+            error(line_no, '格式错误')
+        if len(name.encode('utf-8')) >= NAME_SIZE:
+            error(line_no, '名称过长')
+        missing = [c for c in name if c not in font_chars]
+        if missing:
+            error(line_no, '字库中缺少 %s' % ''.join(missing))
+        if key in rules[kind]:
+            error(line_no, '与 %s 重复' % rules[kind][key])
+        rules[kind][key] = name
+    return rules
+
+
+def build_map(rules, months, base):
+    """每月一个32位位图，节日序号为月起始序号加上位图中较低位置1的个数"""
+    maps, bases, names = [], [], []
+    for month in range(1, months + 1):
+        keys = sorted(bit for (m, bit) in rules if m == month)
+        maps.append(sum(1 << bit for bit in keys))
+        bases.append(base + len(names))
+        names += [rules[(month, bit)] for bit in keys]
+    return maps, bases, names
+
+
+def format_array(values, fmt, per_line):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(fmt % v for v in values[i:i + per_line]))
+    return ',\n'.join(lines)
+
+
+def main():
+    rules = parse_rules(read_term_names(), read_font_chars())
+    out = []
+    names = []
+    for kind, var, months in (('公历', 'solar', 12), ('农历', 'lunar', 12), ('星期', 'week', 12), ('节气', 'term', 1)):
+        maps, bases, kind_names = build_map(rules[kind], months, len(names))
+        names += kind_names
+        if months == 1:
+            out.append('const static uint32_t fest_%s_map[1] = {0x%08X};' % (var, maps[0]))
+            out.append('const static uint8_t fest_%s_base[1] = {%d};\n' % (var, bases[0]))
+        else:
+            out.append('const static uint32_t fest_%s_map[12] = {\n%s};' % (var, format_array(maps, '0x%08X', 6)))
+            out.append('const static uint8_t fest_%s_base[12] = {\n%s};\n' % (var, format_array(bases, '%d', 12)))
+    if len(names) >= 0xFF:
+        sys.exit('节日数量过多')
+    out.append('const static char fest_name[%d][%d] = {\n%s};' % (len(names), NAME_SIZE, format_array(names, '"%s"', 8)))
+
+    text = '/* 此文件由 资源/节日数据生成/节日数据生成.py 根据 节日规则.txt 生成，不要手动修改 */\n'
+    text += '#ifndef _FESTIVAL_TABLE_H_\n#define _FESTIVAL_TABLE_H_\n\n'
+    text += '#define FEST_COUNT %d\n\n' % len(names)
+    text += '\n'.join(out) + '\n\n#endif\n'
+    open(OUT_FILE, 'w', encoding='utf-8', newline='\n').write(text)
+    print('已生成 %d 个节日' % len(names))
+
+
+if __name__ == '__main__':
+    main()